@@ -0,0 +1,363 @@
+#include "load_generator.hpp"
+
+#include "options.hpp"
+#include "indexed_file_sink.hpp"
+#include "shm_log_ring.hpp"
+#include "text_escape.hpp"
+
+#include <spdlog/sinks/null_sink.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace project_template::app {
+
+using utils::log::IndexedRotatingFileSink;
+using utils::log::Level;
+using utils::log::Log;
+using utils::log::ShmRingSink;
+using utils::metrics::LatencyHistogram;
+using utils::metrics::process_usage;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::string_view usage = R"(usage: project_template_exec --loadgen [options]
+
+Log at a configurable rate from several threads through the application's
+logging pipeline, then report throughput, latency percentiles, CPU use and
+RSS as Google Benchmark JSON (compare two reports with
+tools/benchmark_runner.py compare-json).
+
+options:
+  --mode <mode>          sync, async, percpu or shared (default: async)
+  --level <level>        logger threshold (default: info)
+  --sink <sink>          file (rotating log file only), null or console (default: file)
+  --threads <n>          producer threads (default: 1)
+  --rate <n>             records per second over all threads (default: unthrottled)
+  --size <n>[-<m>]       message payload bytes, uniform in [n, m] (default: 64)
+  --levels <mix>         record levels and weights, e.g. info=80,warn=15,error=5 (default: info=1)
+  --duration <time>      run time, e.g. 10s, 500ms, 2m (default: 10s)
+  --ops <n>              stop after n records instead
+  --out <file>           write the JSON report to <file> (default: stdout)
+  -h, --help             show this help
+)";
+
+std::array<unsigned, 6> parse_level_mix(const std::string_view text) {
+    std::array<unsigned, 6> weights{};
+    for (std::size_t pos = 0; pos <= text.size();) {
+        const auto comma = std::min(text.find(',', pos), text.size());
+        const auto item  = text.substr(pos, comma - pos);
+        const auto equal = item.find('=');
+        if (equal == std::string_view::npos) {
+            throw std::invalid_argument("invalid --levels entry: " + std::string(item));
+        }
+        const auto weight = parse_number(item.substr(equal + 1), "--levels");
+        weights[static_cast<std::size_t>(parse_level(item.substr(0, equal)))] += static_cast<unsigned>(weight);
+        pos = comma + 1;
+    }
+    if (std::all_of(weights.begin(), weights.end(), [](const unsigned w) { return w == 0; })) {
+        throw std::invalid_argument("--levels needs at least one non-zero weight");
+    }
+    return weights;
+}
+
+/// Keep only the sinks `sink` asks for: the rotating file (or the collector's ring in shared mode), nothing, or all.
+void select_sinks(const std::string& sink) {
+    if (sink == "console") return;
+    for (const auto& attached : Log::sinks()) {
+        const bool keep = sink == "file" && (std::dynamic_pointer_cast<IndexedRotatingFileSink>(attached) ||
+                                             std::dynamic_pointer_cast<ShmRingSink>(attached));
+        if (!keep) Log::remove_sink(attached);
+    }
+    if (sink == "null") Log::add_sink(std::make_shared<spdlog::sinks::null_sink_mt>());
+}
+
+/// One record at `level`, through the same macros application code uses.
+void emit(const std::size_t level, const std::uint64_t seq, const std::string_view payload) {
+    switch (level) {
+    case 0: LOG_TRACE("loadgen seq={} {}", seq, payload); break;
+    case 1: LOG_DEBUG("loadgen seq={} {}", seq, payload); break;
+    case 2: LOG_INFO("loadgen seq={} {}", seq, payload); break;
+    case 3: LOG_WARN("loadgen seq={} {}", seq, payload); break;
+    case 4: LOG_ERROR("loadgen seq={} {}", seq, payload); break;
+    default: LOG_CRITICAL("loadgen seq={} {}", seq, payload); break;
+    }
+}
+
+/// Sleep most of the way to `due`, then spin: a sleep alone overshoots by the timer slack (tens of µs).
+void wait_until(const Clock::time_point due) {
+    for (auto now = Clock::now(); now < due; now = Clock::now()) {
+        if (due - now > std::chrono::microseconds{200}) {
+            std::this_thread::sleep_for(due - now - std::chrono::microseconds{100});
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+struct Producer {
+    LatencyHistogram latency;
+    std::uint64_t operations = 0;
+    Clock::time_point finished;
+};
+
+void produce(const LoadOptions& options, const std::size_t index, const std::uint64_t quota,
+             const Clock::time_point start, Producer& out) {
+    const std::string payload(options.max_size, 'x');
+    const auto deadline = options.operations == 0 ? start + options.duration : Clock::time_point::max();
+    const auto interval = options.rate > 0 ? std::chrono::nanoseconds{static_cast<std::int64_t>(
+                                                 1e9 * static_cast<double>(options.threads) / options.rate)}
+                                           : std::chrono::nanoseconds{0};
+
+    std::array<unsigned, 6> cumulative{};
+    unsigned total = 0;
+    for (std::size_t i = 0; i < cumulative.size(); ++i) {
+        cumulative[i] = total += options.level_weights[i];
+    }
+
+    std::uint64_t rng = 0x9E3779B97F4A7C15ULL * (index + 1); // xorshift64, distinct per thread
+    const auto next   = [&rng] {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        return rng;
+    };
+    const auto size_span = options.max_size - options.min_size + 1;
+
+    for (std::uint64_t i = 0; i < quota; ++i) {
+        Clock::time_point due;
+        if (interval.count() > 0) {
+            // threads are offset by a fraction of the interval, so their records interleave evenly
+            due = start + interval * static_cast<std::int64_t>(i) +
+                  interval * static_cast<std::int64_t>(index) / static_cast<std::int64_t>(options.threads);
+            if (due >= deadline) break;
+            wait_until(due);
+        } else {
+            due = Clock::now();
+            if (due >= deadline) break;
+        }
+
+        const auto pick  = static_cast<unsigned>(next() % total);
+        const auto level = static_cast<std::size_t>(
+            std::upper_bound(cumulative.begin(), cumulative.end(), pick) - cumulative.begin());
+        const auto size = options.min_size + static_cast<std::size_t>(next() % size_span);
+        emit(level, i, std::string_view{payload}.substr(0, size));
+
+        out.latency.record(static_cast<std::uint64_t>((Clock::now() - due).count()));
+        ++out.operations;
+    }
+    out.finished = Clock::now();
+}
+
+void append_escaped(std::string& out, const std::string_view text) {
+    spdlog::memory_buf_t buf;
+    utils::text::append_json_escaped(buf, text);
+    out.append(buf.data(), buf.size());
+}
+
+std::string level_mix(const std::array<unsigned, 6>& weights) {
+    std::string mix;
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        if (weights[i] == 0) continue;
+        if (!mix.empty()) mix += ',';
+        mix += std::string(level_name(static_cast<Level>(i))) + '=' + std::to_string(weights[i]);
+    }
+    return mix;
+}
+
+std::string date_now() {
+    const auto now = std::time(nullptr);
+    std::tm tm{};
+    localtime_r(&now, &tm);
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%S%z", &tm);
+    return text;
+}
+
+} // namespace
+
+LoadOptions parse_load_options(const std::span<const std::string_view> args) {
+    LoadOptions options;
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const auto arg = args[i];
+        if (i + 1 >= args.size()) throw std::invalid_argument("unknown option or missing value: " + std::string(arg));
+        const auto value = args[++i];
+
+        if (arg == "--mode") {
+            options.mode = parse_mode(value);
+        } else if (arg == "--level") {
+            options.level = parse_level(value);
+        } else if (arg == "--sink") {
+            if (value != "file" && value != "null" && value != "console") {
+                throw std::invalid_argument("unknown sink: " + std::string(value));
+            }
+            options.sink = value;
+        } else if (arg == "--threads") {
+            options.threads = parse_number(value, arg);
+            if (options.threads == 0) throw std::invalid_argument("--threads must be at least 1");
+        } else if (arg == "--rate") {
+            options.rate = static_cast<double>(parse_number(value, arg));
+        } else if (arg == "--size") {
+            const auto dash  = value.find('-');
+            options.min_size = parse_number(value.substr(0, dash), arg);
+            options.max_size =
+                dash == std::string_view::npos ? options.min_size : parse_number(value.substr(dash + 1), arg);
+            if (options.max_size < options.min_size) throw std::invalid_argument("--size: empty range");
+        } else if (arg == "--levels") {
+            options.level_weights = parse_level_mix(value);
+        } else if (arg == "--duration") {
+            options.duration = parse_duration(value, arg);
+        } else if (arg == "--ops") {
+            options.operations = parse_number(value, arg);
+        } else if (arg == "--out") {
+            options.output = value;
+        } else {
+            throw std::invalid_argument("unknown option: " + std::string(arg));
+        }
+    }
+    return options;
+}
+
+LoadReport run_load(const LoadOptions& options) {
+    Log::init(options.level, options.mode);
+    select_sinks(options.sink);
+
+    LoadReport report;
+    std::vector<Producer> producers(options.threads);
+    std::vector<std::thread> threads;
+    std::latch ready{static_cast<std::ptrdiff_t>(options.threads + 1)};
+    Clock::time_point start;
+
+    const auto base  = options.operations / options.threads;
+    const auto extra = options.operations % options.threads;
+    for (std::size_t t = 0; t < options.threads; ++t) {
+        const auto quota = options.operations == 0 ? UINT64_MAX : base + (t < extra ? 1 : 0);
+        threads.emplace_back([&, t, quota] {
+            ready.arrive_and_wait(); // `start` is set before the main thread arrives
+            produce(options, t, quota, start, producers[t]);
+        });
+    }
+
+    report.before = process_usage();
+    start         = Clock::now();
+    ready.arrive_and_wait();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto finished = start;
+    for (const auto& producer : producers) {
+        report.latency.merge(producer.latency);
+        report.operations += producer.operations;
+        finished = std::max(finished, producer.finished);
+    }
+    report.elapsed = finished - start;
+
+    Log::flush();
+    report.drain  = Clock::now() - finished;
+    report.after  = process_usage();
+    report.memory = Log::memory_usage(); // its `dropped` counts the records every mode refused
+    return report;
+}
+
+std::string load_report_json(const LoadOptions& options, const LoadReport& report) {
+    const auto ops        = static_cast<double>(std::max<std::uint64_t>(report.operations, 1));
+    const auto wall_ns    = static_cast<double>(report.elapsed.count());
+    const auto cpu_ns     = static_cast<double>(report.after.cpu_ns() - report.before.cpu_ns());
+    const auto total_ns   = static_cast<double>((report.elapsed + report.drain).count());
+    const auto mode       = mode_name(options.mode);
+    const auto rate       = std::to_string(static_cast<std::uint64_t>(options.rate));
+    const auto name       = "loadgen/" + std::string(mode) + "/threads:" + std::to_string(options.threads) +
+                      (options.rate > 0 ? "/rate:" + rate : "");
+
+    std::string json = "{\n  \"context\": {\n";
+    const auto context = [&json](const std::string_view key, const std::string& value, const bool last = false) {
+        json += "    \"" + std::string(key) + "\": \"";
+        append_escaped(json, value);
+        json += last ? "\"\n" : "\",\n";
+    };
+    context("date", date_now());
+    context("executable", "project_template_exec --loadgen");
+    context("num_cpus", std::to_string(std::thread::hardware_concurrency()));
+    context("mode", std::string(mode));
+    context("level", std::string(level_name(options.level)));
+    context("sink", options.sink);
+    context("threads", std::to_string(options.threads));
+    context("rate", options.rate > 0 ? rate : "unthrottled");
+    context("size", std::to_string(options.min_size) + "-" + std::to_string(options.max_size));
+    context("levels", level_mix(options.level_weights));
+    context("operations", std::to_string(report.operations));
+    context("drain_ms", std::to_string(static_cast<double>(report.drain.count()) / 1e6), true);
+    json += "  },\n  \"benchmarks\": [\n";
+
+    const auto entry = [&json, &report](const std::string& entry_name, const double real, const double cpu,
+                                        const std::string& counters) {
+        json += "    {\"name\": \"" + entry_name + "\", \"run_type\": \"iteration\", \"iterations\": " +
+                std::to_string(report.operations) + ", \"real_time\": " + std::to_string(real) +
+                ", \"cpu_time\": " + std::to_string(cpu) + ", \"time_unit\": \"ns\"" + counters + "}";
+    };
+    entry(name + "/per_record", wall_ns / ops, cpu_ns / ops,
+          ", \"items_per_second\": " + std::to_string(ops / (wall_ns / 1e9)) +
+              ", \"cpu_cores\": " + std::to_string(cpu_ns / total_ns) +
+              ", \"rss_bytes\": " + std::to_string(report.after.rss_bytes) +
+              ", \"peak_rss_bytes\": " + std::to_string(report.after.peak_rss_bytes) +
+              ", \"dropped\": " + std::to_string(report.memory.dropped));
+    constexpr std::array<std::pair<std::string_view, double>, 4> percentiles{
+        {{"p50", 50.0}, {"p90", 90.0}, {"p99", 99.0}, {"p999", 99.9}}};
+    for (const auto& [label, p] : percentiles) {
+        const auto ns = static_cast<double>(report.latency.percentile(p));
+        json += ",\n";
+        entry(name + "/latency_" + std::string(label), ns, ns, "");
+    }
+    json += ",\n";
+    const auto max_ns = static_cast<double>(report.latency.max());
+    entry(name + "/latency_max", max_ns, max_ns, "");
+    json += "\n  ]\n}\n";
+    return json;
+}
+
+int load_generator_main(const std::span<const std::string_view> args) {
+    if (std::find_if(args.begin(), args.end(), [](auto a) { return a == "-h" || a == "--help"; }) != args.end()) {
+        std::cout << usage;
+        return EXIT_SUCCESS;
+    }
+    try {
+        const auto options = parse_load_options(args);
+        const auto report  = run_load(options);
+        const auto json    = load_report_json(options, report);
+        Log::reset_logger();
+
+        if (options.output.empty()) {
+            std::cout << json;
+        } else {
+            std::ofstream out{options.output};
+            out << json;
+            if (!out) throw std::runtime_error("cannot write " + options.output);
+        }
+        std::cerr << "project_template_exec: " << report.operations << " records in "
+                  << static_cast<double>(report.elapsed.count()) / 1e9 << " s, p99 "
+                  << report.latency.percentile(99.0) << " ns\n";
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "project_template_exec: " << e.what() << "\n\n" << usage;
+        return EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        std::cerr << "project_template_exec: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+} // namespace project_template::app
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "latency_histogram.hpp"
+#include "log_memory.hpp"
+#include "logger.hpp"
+#include "process_usage.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace project_template::app {
+
+/**
+ * @brief Configuration of a load-generator run (`project_template_exec --loadgen ...`).
+ *
+ * The run drives the application's logging pipeline exactly as application
+ * code does (`Log::init`, `LOG_*` macros) from `threads` producer threads.
+ * It ends after `operations` records, or after `duration` if `operations`
+ * is 0.
+ */
+struct LoadOptions {
+    utils::log::Mode mode   = utils::log::Mode::Async;
+    utils::log::Level level = utils::log::Level::Info; ///< logger threshold; records below it are filtered
+    std::string sink        = "file";                  ///< "file", "null" or "console"
+    std::size_t threads     = 1;
+    double rate             = 0; ///< records per second over all threads, 0 = as fast as possible
+    std::size_t min_size    = 64; ///< message payload bytes, drawn uniformly from [min_size, max_size]
+    std::size_t max_size    = 64;
+    std::array<unsigned, 6> level_weights{0, 0, 1, 0, 0, 0}; ///< relative share of trace .. critical records
+    std::chrono::nanoseconds duration = std::chrono::seconds{10};
+    std::uint64_t operations          = 0;
+    std::string output; ///< JSON report file, empty = stdout
+};
+
+/**
+ * @brief Result of `run_load()`.
+ *
+ * Latency is the time from when a record was due to when its `LOG_*` call
+ * returned. With a `rate`, records are due on a fixed schedule. A call that
+ * stalls therefore also delays the records queued behind it, and those
+ * delays are counted rather than hidden (no coordinated omission).
+ * Unthrottled, a record is due when its call starts.
+ */
+struct LoadReport {
+    std::uint64_t operations = 0;
+    std::chrono::nanoseconds elapsed{0}; ///< first record due until the last producer finished
+    std::chrono::nanoseconds drain{0};   ///< `Log::flush()` afterwards (queued records reaching the sinks)
+    utils::metrics::LatencyHistogram latency;
+    utils::metrics::ProcessUsage before;
+    utils::metrics::ProcessUsage after; ///< after the drain
+    utils::log::LogMemoryBudget::Stats memory;
+};
+
+/// @brief Parse the `--loadgen` options (everything after `--loadgen`). Throws `std::invalid_argument`.
+LoadOptions parse_load_options(std::span<const std::string_view> args);
+
+/// @brief Initialize logging for `options` and generate the load; the logger stays configured afterwards.
+LoadReport run_load(const LoadOptions& options);
+
+/**
+ * @brief The report as Google Benchmark JSON, so `benchmark_runner.py compare-json` can compare two runs.
+ *
+ * Entries (times in ns, lower is better):
+ *  - `loadgen/<mode>/threads:<n>[/rate:<r>]/per_record`: wall and CPU
+ *    time per record, with `items_per_second`, `cpu_cores`, `rss_bytes`,
+ *    `peak_rss_bytes` and `dropped` as counters.
+ *  - `.../latency_p50`, `_p90`, `_p99`, `_p999`, `_max`.
+ *
+ * The options are recorded in `context`.
+ */
+std::string load_report_json(const LoadOptions& options, const LoadReport& report);
+
+/// @brief `project_template_exec --loadgen <args>`: parse, run, write the report. Returns the exit status.
+int load_generator_main(std::span<const std::string_view> args);
+
+} // namespace project_template::app
@@ -1,14 +1,31 @@
 #include "assertions.hpp"
+#include "load_generator.hpp"
 #include "logger.hpp"
+#include "service.hpp"
 
 #include <cstdlib>
 #include <string>
+#include <string_view>
+#include <vector>
 
 using project_template::utils::log::Level;
 using project_template::utils::log::Log;
 using project_template::utils::log::Mode;
 
-int main() {
+int main(int argc, char** argv) {
+    // ------------------------------------------------------------
+    // 0. Load-generator mode (sustained logging load, JSON report)
+    //    and service mode (worker pool until SIGTERM, then drain)
+    // ------------------------------------------------------------
+    if (argc > 1 && std::string_view{argv[1]} == "--loadgen") {
+        const std::vector<std::string_view> args(argv + 2, argv + argc);
+        return project_template::app::load_generator_main(args);
+    }
+    if (argc > 1 && std::string_view{argv[1]} == "--service") {
+        const std::vector<std::string_view> args(argv + 2, argv + argc);
+        return project_template::app::service_main(args);
+    }
+
     // ------------------------------------------------------------
     // 1. Logger initialization
     // ------------------------------------------------------------
@@ -0,0 +1,55 @@
+#include "options.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <stdexcept>
+#include <string>
+
+namespace project_template::app {
+
+namespace {
+constexpr std::array<std::string_view, 6> level_names{"trace", "debug", "info", "warn", "error", "critical"};
+constexpr std::array<std::string_view, 4> mode_names{"sync", "async", "percpu", "shared"};
+} // namespace
+
+std::uint64_t parse_number(const std::string_view text, const std::string_view option) {
+    std::uint64_t value  = 0;
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} || end != text.data() + text.size()) {
+        throw std::invalid_argument("invalid value for " + std::string(option) + ": " + std::string(text));
+    }
+    return value;
+}
+
+std::chrono::nanoseconds parse_duration(const std::string_view text, const std::string_view option) {
+    const auto digits = text.find_first_not_of("0123456789");
+    const auto count  = parse_number(text.substr(0, digits), option);
+    const auto unit   = digits == std::string_view::npos ? std::string_view{"s"} : text.substr(digits);
+    if (unit == "ms") return std::chrono::milliseconds{count};
+    if (unit == "s") return std::chrono::seconds{count};
+    if (unit == "m") return std::chrono::minutes{count};
+    throw std::invalid_argument("invalid value for " + std::string(option) + ": " + std::string(text));
+}
+
+utils::log::Mode parse_mode(const std::string_view text) {
+    const auto it = std::find(mode_names.begin(), mode_names.end(), text);
+    if (it == mode_names.end()) throw std::invalid_argument("unknown mode: " + std::string(text));
+    return static_cast<utils::log::Mode>(it - mode_names.begin());
+}
+
+utils::log::Level parse_level(const std::string_view text) {
+    const auto it = std::find(level_names.begin(), level_names.end(), text);
+    if (it == level_names.end()) throw std::invalid_argument("unknown level: " + std::string(text));
+    return static_cast<utils::log::Level>(it - level_names.begin());
+}
+
+std::string_view mode_name(const utils::log::Mode mode) {
+    return mode_names.at(static_cast<std::size_t>(mode));
+}
+
+std::string_view level_name(const utils::log::Level level) {
+    return level == utils::log::Level::Off ? "off" : level_names.at(static_cast<std::size_t>(level));
+}
+
+} // namespace project_template::app
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "logger.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+namespace project_template::app {
+
+/**
+ * @name Command-line values shared by the application modes
+ * Each parser throws `std::invalid_argument` naming `option` for a malformed value.
+ * @{
+ */
+/// @brief Non-negative decimal integer.
+std::uint64_t parse_number(std::string_view text, std::string_view option);
+
+/// @brief Duration such as `250ms`, `10s` or `2m`; a bare number is seconds.
+std::chrono::nanoseconds parse_duration(std::string_view text, std::string_view option);
+
+/// @brief `sync`, `async`, `percpu` or `shared`.
+utils::log::Mode parse_mode(std::string_view text);
+
+/// @brief `trace`, `debug`, `info`, `warn`, `error` or `critical`.
+utils::log::Level parse_level(std::string_view text);
+
+std::string_view mode_name(utils::log::Mode mode);
+std::string_view level_name(utils::log::Level level);
+/// @}
+
+} // namespace project_template::app
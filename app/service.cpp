@@ -0,0 +1,335 @@
+#include "service.hpp"
+
+#include "crc32c.hpp"
+#include "heap_profiler.hpp"
+#include "latency_histogram.hpp"
+#include "memory_accounting.hpp"
+#include "options.hpp"
+#include "process_usage.hpp"
+#include "timing_wheel.hpp"
+#include "worker_pool.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace project_template::app {
+
+using utils::concurrency::WorkerPool;
+using utils::log::Log;
+using utils::metrics::LatencyHistogram;
+using utils::metrics::MemorySample;
+using utils::metrics::MemorySampler;
+using utils::metrics::process_usage;
+using utils::metrics::ProcessUsage;
+using utils::profiling::HeapProfiler;
+using utils::timer::TimerThread;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::string_view usage = R"(usage: project_template_exec --service [options]
+
+Run as a long-lived service: a worker pool serves synthetic requests (CPU
+work plus one log record each) until SIGTERM or SIGINT, then drains the
+queue within a deadline and exits. Self-metrics (throughput, latency
+percentiles, rejected requests, CPU, RSS, logging memory) and a memory
+record (statm, smaps_rollup, peak RSS, per-subsystem accounts) are logged
+and optionally appended to a JSON-lines file every interval.
+
+options:
+  --mode <mode>              logging mode: sync, async, percpu or shared (default: async)
+  --level <level>            logger threshold (default: info)
+  --workers <n>              worker threads (default: hardware concurrency)
+  --queue <n>                queued requests before new ones are rejected (default: 4096)
+  --rate <n>                 requests per second, 0 = none (default: 1000)
+  --work-us <n>              CPU work per request in microseconds (default: 50)
+  --drain-timeout <time>     time to finish queued requests at shutdown (default: 5s)
+  --metrics-interval <time>  self-metrics period, e.g. 500ms, 10s (default: 10s)
+  --metrics-file <file>      append self-metrics as JSON lines to <file>
+  --ready-file <file>        create <file> (containing the pid) once serving; removed at shutdown
+  --run-for <time>           shut down on its own after <time> (default: run until signalled)
+  --heap-profile <bytes>     sample about one allocation per <bytes> allocated and write the profile as
+                             folded stacks on SIGUSR2 and at shutdown (needs -DENABLE_HEAP_PROFILER=ON)
+  --heap-profile-out <file>  heap profile file (default: heap_profile.<pid>.folded)
+  -h, --help                 show this help
+
+exit status: 0 after a complete drain, 1 if requests were abandoned at the deadline
+)";
+
+std::atomic<bool> stop_requested{false};
+
+extern "C" void request_stop(int /*signal*/) {
+    stop_requested.store(true, std::memory_order_relaxed);
+}
+
+/// Latency of the requests one worker finished since the last metrics record.
+struct WorkerSlot {
+    std::mutex mutex;
+    LatencyHistogram latency;
+};
+
+/// CPU-bound stand-in for request handling: CRC-32C over a 4 KiB buffer until `work` has passed.
+std::uint32_t busy_work(const std::chrono::microseconds work) {
+    static thread_local const std::array<std::byte, 4096> buffer{};
+    const auto until  = Clock::now() + work;
+    std::uint32_t crc = 0;
+    do {
+        crc = utils::checksum::crc32c(std::span<const std::byte>{buffer}, crc);
+    } while (Clock::now() < until);
+    return crc;
+}
+
+/// Periodic self-metrics: counters are turned into per-interval rates, latency histograms are taken and reset.
+/// Memory samples are published the same way, as records of their own.
+class MetricsReporter {
+  public:
+    MetricsReporter(const ServiceOptions& options, WorkerPool& pool, std::vector<std::unique_ptr<WorkerSlot>>& slots,
+                    const std::atomic<std::uint64_t>& rejected)
+      : options_(options), pool_(pool), slots_(slots), rejected_(rejected), started_(Clock::now()),
+        last_time_(started_), last_usage_(process_usage()) {}
+
+    void report(const std::string_view event) {
+        const std::lock_guard lock{mutex_};
+        LatencyHistogram latency;
+        for (const auto& slot : slots_) {
+            const std::lock_guard slot_lock{slot->mutex};
+            latency.merge(slot->latency);
+            slot->latency.reset();
+        }
+        const auto now       = Clock::now();
+        const auto process   = process_usage();
+        const auto completed = pool_.completed();
+        const auto rejected  = rejected_.load(std::memory_order_relaxed);
+        const auto seconds   = std::chrono::duration<double>(now - last_time_).count();
+        const auto memory    = Log::memory_usage();
+
+        char line[640];
+        std::snprintf(
+            line, sizeof(line),
+            "{\"event\": \"%.*s\", \"uptime_s\": %.3f, \"interval_s\": %.3f, \"completed\": %llu, "
+            "\"per_second\": %.1f, \"rejected\": %llu, \"queued\": %zu, \"latency_p50_us\": %.1f, "
+            "\"latency_p99_us\": %.1f, \"latency_max_us\": %.1f, \"cpu_cores\": %.3f, \"rss_bytes\": %llu, "
+            "\"peak_rss_bytes\": %llu, \"log_memory_bytes\": %zu, \"log_dropped\": %llu}",
+            static_cast<int>(event.size()), event.data(), std::chrono::duration<double>(now - started_).count(),
+            seconds, static_cast<unsigned long long>(completed - last_completed_),
+            seconds > 0 ? static_cast<double>(completed - last_completed_) / seconds : 0.0,
+            static_cast<unsigned long long>(rejected - last_rejected_), pool_.queued(),
+            static_cast<double>(latency.percentile(50)) / 1e3, static_cast<double>(latency.percentile(99)) / 1e3,
+            static_cast<double>(latency.max()) / 1e3,
+            seconds > 0 ? static_cast<double>(process.cpu_ns() - last_usage_.cpu_ns()) / (seconds * 1e9) : 0.0,
+            static_cast<unsigned long long>(process.rss_bytes), static_cast<unsigned long long>(process.peak_rss_bytes),
+            memory.usage, static_cast<unsigned long long>(memory.dropped));
+
+        publish_(line);
+        last_time_      = now;
+        last_usage_     = process;
+        last_completed_ = completed;
+        last_rejected_  = rejected;
+    }
+
+    void report_memory(const MemorySample& sample, const std::string_view event) {
+        const std::lock_guard lock{mutex_};
+        const auto json = utils::metrics::memory_sample_json(sample);
+        char header[96];
+        std::snprintf(header, sizeof(header), "{\"event\": \"%.*s\", \"uptime_s\": %.3f, ",
+                      static_cast<int>(event.size()), event.data(),
+                      std::chrono::duration<double>(Clock::now() - started_).count());
+        publish_(header + json.substr(1));
+    }
+
+  private:
+    void publish_(const std::string_view line) {
+        LOG_INFO("metrics {}", line);
+        if (!options_.metrics_file.empty()) {
+            std::ofstream out{options_.metrics_file, std::ios::app};
+            out << line << '\n';
+        }
+    }
+
+    const ServiceOptions& options_;
+    WorkerPool& pool_;
+    std::vector<std::unique_ptr<WorkerSlot>>& slots_;
+    const std::atomic<std::uint64_t>& rejected_;
+    std::mutex mutex_; ///< the timer thread and shutdown both report
+    Clock::time_point started_;
+    Clock::time_point last_time_;
+    ProcessUsage last_usage_;
+    std::uint64_t last_completed_ = 0;
+    std::uint64_t last_rejected_  = 0;
+};
+
+/// Write the readiness file atomically (temporary file + rename), so a watcher never sees it half written.
+void write_ready_file(const std::string& path) {
+    const auto temporary = path + ".tmp";
+    {
+        std::ofstream out{temporary, std::ios::trunc};
+        out << ::getpid() << '\n';
+        if (!out) throw std::runtime_error("cannot write readiness file " + temporary);
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("cannot create readiness file " + path);
+    }
+}
+
+} // namespace
+
+ServiceOptions parse_service_options(const std::span<const std::string_view> args) {
+    ServiceOptions options;
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const auto arg = args[i];
+        if (i + 1 >= args.size()) throw std::invalid_argument("unknown option or missing value: " + std::string(arg));
+        const auto value = args[++i];
+
+        if (arg == "--mode") {
+            options.mode = parse_mode(value);
+        } else if (arg == "--level") {
+            options.level = parse_level(value);
+        } else if (arg == "--workers") {
+            options.workers = parse_number(value, arg);
+        } else if (arg == "--queue") {
+            options.queue = parse_number(value, arg);
+        } else if (arg == "--rate") {
+            options.rate = static_cast<double>(parse_number(value, arg));
+        } else if (arg == "--work-us") {
+            options.work = std::chrono::microseconds{parse_number(value, arg)};
+        } else if (arg == "--drain-timeout") {
+            options.drain_timeout = parse_duration(value, arg);
+        } else if (arg == "--metrics-interval") {
+            options.metrics_interval = parse_duration(value, arg);
+            if (options.metrics_interval.count() == 0) throw std::invalid_argument("--metrics-interval must be > 0");
+        } else if (arg == "--metrics-file") {
+            options.metrics_file = value;
+        } else if (arg == "--ready-file") {
+            options.ready_file = value;
+        } else if (arg == "--run-for") {
+            options.run_for = parse_duration(value, arg);
+        } else if (arg == "--heap-profile") {
+            options.heap_profile = parse_number(value, arg);
+        } else if (arg == "--heap-profile-out") {
+            options.heap_profile_file = value;
+        } else {
+            throw std::invalid_argument("unknown option: " + std::string(arg));
+        }
+    }
+    return options;
+}
+
+int run_service(const ServiceOptions& options) {
+    std::signal(SIGINT, request_stop);
+    std::signal(SIGTERM, request_stop);
+
+    std::string heap_profile_file;
+    if (options.heap_profile > 0) {
+        if (!HeapProfiler::compiled_in()) {
+            throw std::runtime_error("--heap-profile needs a build with -DENABLE_HEAP_PROFILER=ON");
+        }
+        heap_profile_file = options.heap_profile_file.empty()
+                                ? "heap_profile." + std::to_string(::getpid()) + ".folded"
+                                : options.heap_profile_file;
+        HeapProfiler::dump_on_signal(SIGUSR2, heap_profile_file);
+        HeapProfiler::start(options.heap_profile);
+    }
+
+    Log::init(options.level, options.mode);
+    const auto workers = options.workers > 0 ? options.workers : std::max(1U, std::thread::hardware_concurrency());
+
+    std::vector<std::unique_ptr<WorkerSlot>> slots;
+    for (std::size_t i = 0; i < workers; ++i) {
+        slots.push_back(std::make_unique<WorkerSlot>());
+    }
+    std::atomic<std::uint64_t> rejected{0};
+    WorkerPool pool{workers, options.queue};
+    MetricsReporter metrics{options, pool, slots, rejected};
+    TimerThread timer{std::chrono::milliseconds{10}};
+    timer.schedule_every(options.metrics_interval, [&metrics] { metrics.report("interval"); });
+    MemorySampler memory{options.metrics_interval,
+                         [&metrics](const MemorySample& sample) { metrics.report_memory(sample, "memory"); }};
+
+    if (!options.ready_file.empty()) write_ready_file(options.ready_file);
+    LOG_INFO("service ready: {} workers, {} requests/s, pid {}", workers, options.rate, ::getpid());
+
+    // dispatch requests on a fixed schedule; latency counts from when a request was due
+    const auto interval = options.rate > 0 ? std::chrono::nanoseconds{static_cast<std::int64_t>(1e9 / options.rate)}
+                                           : std::chrono::nanoseconds{0};
+    const auto started  = Clock::now();
+    auto due            = started;
+    std::uint64_t id    = 0;
+    while (!stop_requested.load(std::memory_order_relaxed)) {
+        const auto now = Clock::now();
+        if (options.run_for.count() > 0 && now - started >= options.run_for) break;
+        if (interval.count() == 0 || now < due) {
+            // sleep in short steps to notice signals; requests that fall due meanwhile go out in a burst
+            const Clock::duration step = std::chrono::milliseconds{10};
+            std::this_thread::sleep_for(interval.count() == 0 ? step : std::min<Clock::duration>(due - now, step));
+            continue;
+        }
+        const auto accepted = pool.try_submit([&slots, work = options.work, request = id, due] {
+            const auto crc = busy_work(work);
+            LOG_INFO("request {} done (crc {:08x})", request, crc);
+            auto& slot = *slots[WorkerPool::worker_index()];
+            const std::lock_guard lock{slot.mutex};
+            slot.latency.record(static_cast<std::uint64_t>((Clock::now() - due).count()));
+        });
+        if (!accepted) rejected.fetch_add(1, std::memory_order_relaxed);
+        ++id;
+        due += interval;
+    }
+
+    // graceful shutdown: not ready any more, finish what is queued within the deadline
+    if (!options.ready_file.empty()) std::remove(options.ready_file.c_str());
+    LOG_INFO("shutting down: draining {} queued requests (deadline {} ms)", pool.queued(),
+             std::chrono::duration_cast<std::chrono::milliseconds>(options.drain_timeout).count());
+    const auto abandoned = pool.drain(Clock::now() + options.drain_timeout);
+    timer.stop();
+    memory.stop();
+    metrics.report("shutdown");
+    metrics.report_memory(utils::metrics::sample_memory(), "shutdown_memory");
+    if (!heap_profile_file.empty()) {
+        HeapProfiler::stop();
+        std::ofstream out{heap_profile_file, std::ios::trunc};
+        HeapProfiler::write_folded(out);
+        const auto heap = HeapProfiler::stats();
+        LOG_INFO("heap profile: {} samples, {} stacks, ~{} bytes allocated -> {}", heap.samples, heap.stacks,
+                 heap.estimated_bytes, heap_profile_file);
+    }
+    if (abandoned > 0) {
+        LOG_WARN("drain deadline passed: {} queued requests abandoned", abandoned);
+    }
+    LOG_INFO("service stopped after {} requests", pool.completed());
+    Log::reset_logger(); // writes what the async logger still holds
+    return abandoned > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int service_main(const std::span<const std::string_view> args) {
+    if (std::find_if(args.begin(), args.end(), [](auto a) { return a == "-h" || a == "--help"; }) != args.end()) {
+        std::cout << usage;
+        return EXIT_SUCCESS;
+    }
+    try {
+        return run_service(parse_service_options(args));
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "project_template_exec: " << e.what() << "\n\n" << usage;
+    } catch (const std::exception& e) {
+        std::cerr << "project_template_exec: " << e.what() << '\n';
+    }
+    return EXIT_FAILURE;
+}
+
+} // namespace project_template::app
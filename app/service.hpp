@@ -0,0 +1,55 @@
+#pragma once
+
+#include "logger.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace project_template::app {
+
+/**
+ * @brief Configuration of the long-running service mode (`project_template_exec --service ...`).
+ *
+ * The service runs a pool of `workers` threads. It feeds them synthetic
+ * requests at `rate` per second; each request does about `work` of CPU
+ * work and logs one record. This keeps the logging, metrics and pool code
+ * paths of a daemon busy, so their overhead can be measured end to end.
+ */
+struct ServiceOptions {
+    utils::log::Mode mode   = utils::log::Mode::Async;
+    utils::log::Level level = utils::log::Level::Info;
+    std::size_t workers     = 0;    ///< 0 = hardware concurrency
+    std::size_t queue       = 4096; ///< requests waiting for a worker; beyond that they are rejected
+    double rate             = 1000; ///< requests per second, 0 = none (idle until signalled)
+    std::chrono::microseconds work{50};
+    std::chrono::nanoseconds drain_timeout    = std::chrono::seconds{5};
+    std::chrono::nanoseconds metrics_interval = std::chrono::seconds{10};
+    std::chrono::nanoseconds run_for{0}; ///< stop on its own after this long, 0 = run until signalled
+    std::string ready_file;              ///< created once serving, removed when draining starts
+    std::string metrics_file;            ///< self-metrics appended as JSON lines (they are also logged)
+    std::size_t heap_profile = 0;        ///< sample about every n allocated bytes, 0 = off (ENABLE_HEAP_PROFILER)
+    std::string heap_profile_file;       ///< written on SIGUSR2 and at shutdown; default heap_profile.<pid>.folded
+};
+
+/// @brief Parse the `--service` options (everything after `--service`). Throws `std::invalid_argument`.
+ServiceOptions parse_service_options(std::span<const std::string_view> args);
+
+/**
+ * @brief Serve until SIGTERM / SIGINT (or `run_for`), then drain gracefully.
+ *
+ * Shutdown removes the readiness file and stops taking requests. It then
+ * lets the workers finish the queued ones until `drain_timeout`, writes a
+ * final metrics record, the heap profile if one is being taken, and
+ * flushes the logger.
+ *
+ * @return `EXIT_SUCCESS`, or `EXIT_FAILURE` if requests were abandoned at the drain deadline.
+ */
+int run_service(const ServiceOptions& options);
+
+/// @brief `project_template_exec --service <args>`: parse and run. Returns the exit status.
+int service_main(std::span<const std::string_view> args);
+
+} // namespace project_template::app
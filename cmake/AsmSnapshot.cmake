@@ -0,0 +1,121 @@
+# --------------------------------------------------------------------------------------------------
+# AsmSnapshot.cmake
+#
+# Normalized assembly listings of hot functions, so that codegen regressions (a loop that is no
+# longer vectorized, an extra call on a fast path) show up as a diff at review time.
+#
+# It provides two helper functions:
+#
+#     asm_snapshot_symbols(<target> <function>...)
+#         - Registers functions of an executable target for the snapshot. Each <function> is a
+#           qualified name as it appears demangled, without parameters, e.g.
+#               benchmark_example::sum_naive
+#               project_template::utils::checksum::(anonymous namespace)::update_sse42
+#           and matches every overload / template instantiation of that name.
+#
+#     add_asm_snapshot_target()
+#         - Creates a convenience target (call once, after all targets were registered):
+#
+#               asm-snapshot
+#
+#           that builds the registered executables and writes one listing per function name to:
+#
+#               ${CMAKE_BINARY_DIR}/asm/<target>/<function>.s
+#
+# Listings are produced by tools/asm_snapshot.py with objdump (addresses, raw bytes and padding
+# removed; branches use labels). If llvm-mca is found, each listing also carries a throughput
+# estimate of the function's innermost loop. tools/benchmark_runner.py compare-commits diffs the
+# listings of two commits.
+#
+# Requirements:
+#   - Python 3 and GNU objdump (binutils >= 2.32 for --disassemble=<symbol>), nm, c++filt.
+#   - Optional: llvm-mca.
+# --------------------------------------------------------------------------------------------------
+
+# Include the custom message wrappers
+include(Logging)
+
+set_property(GLOBAL PROPERTY ASM_SNAPSHOT_TARGETS "")
+
+# --------------------------------------------------------------------------------------------------
+# asm_snapshot_symbols(<target> <function>...)
+#
+# Arguments:
+#   <target>     : Executable target whose binary is disassembled.
+#   <function...>: Qualified function names (demangled, without parameters).
+#
+# Behavior:
+#   - May be called several times per target; the names accumulate.
+#   - Appends the target to the GLOBAL ASM_SNAPSHOT_TARGETS property.
+# --------------------------------------------------------------------------------------------------
+function(asm_snapshot_symbols target)
+  get_property(targets GLOBAL PROPERTY ASM_SNAPSHOT_TARGETS)
+  if(NOT target IN_LIST targets)
+    set_property(GLOBAL APPEND PROPERTY ASM_SNAPSHOT_TARGETS ${target})
+  endif()
+  set_property(GLOBAL APPEND PROPERTY ASM_SNAPSHOT_SYMBOLS_${target} ${ARGN})
+endfunction()
+
+# --------------------------------------------------------------------------------------------------
+# add_asm_snapshot_target()
+#
+# Behavior:
+#   - If no target registered or objdump / Python 3 are missing -> prints STATUS and returns.
+#   - Otherwise:
+#       * Writes the manifest ${CMAKE_BINARY_DIR}/asm_snapshot.json (binaries, functions, tools).
+#       * Defines target 'asm-snapshot', depending on every registered executable.
+# --------------------------------------------------------------------------------------------------
+function(add_asm_snapshot_target)
+  get_property(targets GLOBAL PROPERTY ASM_SNAPSHOT_TARGETS)
+  if(NOT targets)
+    log_status("add_asm_snapshot_target: no functions registered, not creating asm-snapshot")
+    return()
+  endif()
+
+  find_package(Python3 COMPONENTS Interpreter QUIET)
+  find_program(ASM_SNAPSHOT_OBJDUMP NAMES objdump HINTS ${CMAKE_OBJDUMP})
+  find_program(ASM_SNAPSHOT_LLVM_MCA NAMES llvm-mca)
+  if(NOT Python3_Interpreter_FOUND OR NOT ASM_SNAPSHOT_OBJDUMP)
+    log_status("add_asm_snapshot_target: Python 3 or objdump not found, not creating asm-snapshot")
+    return()
+  endif()
+
+  set(llvm_mca "")
+  if(ASM_SNAPSHOT_LLVM_MCA)
+    set(llvm_mca ${ASM_SNAPSHOT_LLVM_MCA})
+  endif()
+
+  set(entries "")
+  set(existing "")
+  foreach(target IN LISTS targets)
+    if(NOT TARGET ${target})
+      continue()
+    endif()
+    list(APPEND existing ${target})
+    get_property(symbols GLOBAL PROPERTY ASM_SNAPSHOT_SYMBOLS_${target})
+    list(TRANSFORM symbols PREPEND "\"")
+    list(TRANSFORM symbols APPEND "\"")
+    list(JOIN symbols ", " symbols_json)
+    list(APPEND entries
+         "{\"name\": \"${target}\", \"file\": \"$<TARGET_FILE:${target}>\", \"symbols\": [${symbols_json}]}")
+  endforeach()
+  list(JOIN entries ",\n    " entries_json)
+
+  set(manifest ${CMAKE_BINARY_DIR}/asm_snapshot.json)
+  file(
+    GENERATE
+    OUTPUT ${manifest}
+    CONTENT
+      "{\n  \"output\": \"${CMAKE_BINARY_DIR}/asm\",\n  \"objdump\": \"${ASM_SNAPSHOT_OBJDUMP}\",\n  \"llvm_mca\": \"${llvm_mca}\",\n  \"targets\": [\n    ${entries_json}\n  ]\n}\n"
+    )
+
+  add_custom_target(
+    asm-snapshot
+    COMMAND ${Python3_EXECUTABLE} ${PROJECT_SOURCE_DIR}/tools/asm_snapshot.py --manifest ${manifest}
+    COMMENT "Writing normalized assembly of hot functions to ${CMAKE_BINARY_DIR}/asm"
+    VERBATIM
+    )
+  add_dependencies(asm-snapshot ${existing})
+
+  log_status("Created assembly snapshot target: asm-snapshot (llvm-mca: ${ASM_SNAPSHOT_LLVM_MCA})")
+endfunction()
@@ -21,6 +21,9 @@
 #
 #               <target>_bench.json
 #
+#           and the manifest ${CMAKE_BINARY_DIR}/benchmark_executables.json, from which
+#           tools/benchmark_runner.py run --cores ... shards the benchmarks across pinned cores.
+#
 # Minimal usage in your top-level CMakeLists.txt:
 #
 #     list(APPEND CMAKE_MODULE_PATH "${CMAKE_SOURCE_DIR}/cmake")
@@ -122,6 +125,7 @@ endfunction()
 #           - Runs the executable with:
 #                 --benchmark_format=json --benchmark_out=<exec>_bench.json
 #           - Emits a small status echo after each run.
+#       * Writes benchmark_executables.json (name, binary, output directory of each exec).
 # --------------------------------------------------------------------------------------------------
 function(add_benchmark_aggregate_target)
   if(NOT BUILD_BENCHMARKS)
@@ -156,5 +160,18 @@ function(add_benchmark_aggregate_target)
       )
   endforeach()
 
+  # Manifest for the sharded runner (tools/benchmark_runner.py run --cores ...)
+  set(entries "")
+  foreach(exec IN LISTS bench_execs)
+    list(APPEND entries "{\"name\": \"${exec}\", \"file\": \"$<TARGET_FILE:${exec}>\"}")
+  endforeach()
+  list(JOIN entries ",\n    " entries_json)
+  file(
+    GENERATE
+    OUTPUT ${CMAKE_BINARY_DIR}/benchmark_executables.json
+    CONTENT
+      "{\n  \"output\": \"${CMAKE_CURRENT_BINARY_DIR}\",\n  \"executables\": [\n    ${entries_json}\n  ]\n}\n"
+    )
+
   log_status("Created aggregate benchmark target: run-benchmark")
 endfunction()
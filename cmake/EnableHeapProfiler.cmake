@@ -0,0 +1,41 @@
+# --------------------------------------------------------------------------------------------------
+# EnableHeapProfiler.cmake
+#
+# This module controls the **sampling heap profiler** in utils_lib (src/utils/heap_profiler.hpp).
+#
+# It respects the cache variable:
+#
+#     ENABLE_HEAP_PROFILER = ON|OFF
+#
+# When ENABLE_HEAP_PROFILER=ON:
+#   * utils_lib is compiled with PROJECT_TEMPLATE_HEAP_PROFILER and replaces the global
+#     operator new / operator delete of every executable it is linked into.
+#   * Executables export their symbols (-rdynamic via CMAKE_ENABLE_EXPORTS), so recorded
+#     stacks can be symbolized in-process.
+#
+# Sampling itself stays off until HeapProfiler::start() is called or the process is started
+# with PROJECT_TEMPLATE_HEAP_PROFILE=<mean bytes between samples>.
+#
+# Sanitizers replace the allocator themselves; combining them with this option is not supported.
+#
+# --------------------------------------------------------------------------------------------------
+
+# Include the custom message wrappers
+include(Logging)
+
+# Allow presets/toolchain to control ENABLE_HEAP_PROFILER. Only define the option if not set yet.
+if(NOT DEFINED ENABLE_HEAP_PROFILER)
+  option(ENABLE_HEAP_PROFILER "Replace operator new with the sampling heap profiler in utils_lib" OFF)
+endif()
+
+if(ENABLE_HEAP_PROFILER)
+  if(ENABLE_ASAN OR ENABLE_TSAN)
+    log_fatal("EnableHeapProfiler: ENABLE_HEAP_PROFILER=ON cannot be combined with ENABLE_ASAN/ENABLE_TSAN")
+  endif()
+
+  # Export executable symbols so backtrace_symbols() can name application frames.
+  set(CMAKE_ENABLE_EXPORTS ON)
+  log_status("Heap profiler: ENABLE_HEAP_PROFILER=ON, operator new is sampled (see PROJECT_TEMPLATE_HEAP_PROFILE)")
+else()
+  log_status("Heap profiler: ENABLE_HEAP_PROFILER=OFF")
+endif()
@@ -0,0 +1,154 @@
+#include "binary_log.hpp"
+#include "log_index.hpp"
+
+#include <spdlog/pattern_formatter.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using project_template::utils::log::binary_log_records;
+using project_template::utils::log::BinaryLogHeader;
+using project_template::utils::log::BinaryRecord;
+using project_template::utils::log::JsonRenderer;
+using project_template::utils::log::MappedFile;
+using project_template::utils::log::render_parallel;
+
+namespace {
+
+constexpr std::string_view usage = R"(usage: project_template_logcat [options] <binary log>...
+
+Decode binary log segments written by BinaryFileSink and print them as text
+or JSON lines, in file order.
+
+options:
+  --pattern <pattern>  spdlog pattern for text output (default: Log::init's "[%T.%f] [%^%l%$] %v")
+  --json               one JSON object per record instead of text
+  --threads <n>        decoder threads (default: hardware concurrency)
+  --chunk-mb <n>       bytes of records handed to a thread at a time (default: 4)
+  --stats              print decode throughput to stderr
+  -h, --help           show this help
+)";
+
+int fail(const std::string& message) {
+    std::cerr << "project_template_logcat: " << message << "\n\n" << usage;
+    return EXIT_FAILURE;
+}
+
+/// Positive integer option value, or 0 if invalid.
+std::size_t parse_count(const std::string_view text) {
+    std::size_t value = 0;
+    for (const char c : text) {
+        if (c < '0' || c > '9') return 0;
+        value = value * 10 + static_cast<std::size_t>(c - '0');
+    }
+    return value;
+}
+
+/// Text renderer: a private `spdlog::pattern_formatter` per decoder thread.
+class TextRenderer {
+  public:
+    explicit TextRenderer(const std::string& pattern)
+        : formatter_(std::make_unique<spdlog::pattern_formatter>(pattern, spdlog::pattern_time_type::local)) {}
+
+    void operator()(const BinaryRecord& record, spdlog::memory_buf_t& out) {
+        formatter_->format(record.to_log_msg(), out);
+    }
+
+  private:
+    std::unique_ptr<spdlog::pattern_formatter> formatter_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string pattern    = "[%T.%f] [%^%l%$] %v"; // Log::init's default
+    bool json              = false;
+    bool stats             = false;
+    std::size_t threads    = std::max(1U, std::thread::hardware_concurrency());
+    std::size_t chunk_size = std::size_t{4} << 20;
+    std::vector<std::string> files;
+
+    const std::vector<std::string_view> args(argv + 1, argv + argc);
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const auto arg       = args[i];
+        const auto has_value = i + 1 < args.size();
+
+        if (arg == "-h" || arg == "--help") {
+            std::cout << usage;
+            return EXIT_SUCCESS;
+        }
+        if (arg == "--json") {
+            json = true;
+        } else if (arg == "--stats") {
+            stats = true;
+        } else if (arg == "--pattern") {
+            if (!has_value) return fail("missing value for --pattern");
+            pattern = args[++i];
+        } else if (arg == "--threads") {
+            threads = has_value ? parse_count(args[++i]) : 0;
+            if (threads == 0) return fail("invalid or missing value for --threads");
+        } else if (arg == "--chunk-mb") {
+            chunk_size = (has_value ? parse_count(args[++i]) : 0) << 20;
+            if (chunk_size == 0) return fail("invalid or missing value for --chunk-mb");
+        } else if (arg.starts_with('-')) {
+            return fail("unknown option " + std::string(arg));
+        } else {
+            files.emplace_back(arg);
+        }
+    }
+    if (files.empty()) return fail("no input files");
+
+    const auto write = [](const std::string_view text) { std::fwrite(text.data(), 1, text.size(), stdout); };
+    const auto start = std::chrono::steady_clock::now();
+
+    int status                = EXIT_SUCCESS;
+    std::uint64_t total_bytes = 0;
+    for (const auto& file : files) {
+        try {
+            const MappedFile mapped{file};
+            const auto records = binary_log_records({mapped.data(), mapped.size()});
+            const auto workers = static_cast<unsigned>(threads);
+
+            const auto result =
+                json ? render_parallel(records, workers, chunk_size, [] { return JsonRenderer{}; }, write)
+                     : render_parallel(records, workers, chunk_size, [&] { return TextRenderer{pattern}; }, write);
+
+            total_bytes += result.decoded_bytes;
+            if (!result.corrupt.empty() || result.end != records.size()) std::fflush(stdout);
+            for (const auto& range : result.corrupt) {
+                // offsets into the file, past its header
+                std::cerr << "project_template_logcat: " << file << ": skipped " << range.length
+                          << " bytes of malformed records at offset " << sizeof(BinaryLogHeader) + range.offset
+                          << '\n';
+                status = EXIT_FAILURE;
+            }
+            if (result.end != records.size()) {
+                std::cerr << "project_template_logcat: " << file << ": stopped at malformed record, "
+                          << (records.size() - result.end) << " trailing bytes skipped\n";
+                status = EXIT_FAILURE;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "project_template_logcat: " << file << ": " << e.what() << '\n';
+            status = EXIT_FAILURE;
+        }
+    }
+    std::fflush(stdout);
+
+    if (stats) {
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cerr << "decoded " << total_bytes << " bytes in " << elapsed.count() << " s ("
+                  << static_cast<double>(total_bytes) / elapsed.count() / 1e6 << " MB/s, " << threads
+                  << " threads)\n";
+    }
+    return status;
+}
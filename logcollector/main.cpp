@@ -0,0 +1,139 @@
+#include "binary_log.hpp"
+#include "logger.hpp"
+#include "shm_log_ring.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using project_template::utils::log::BinaryRecord;
+using project_template::utils::log::BinaryRecordReader;
+using project_template::utils::log::Level;
+using project_template::utils::log::Log;
+using project_template::utils::log::Mode;
+using project_template::utils::log::ShmLogRing;
+
+namespace {
+
+constexpr std::string_view usage = R"(usage: project_template_logcollector [options]
+
+Create the shared-memory log ring and write every record that processes
+logging with Mode::Shared push into it to this process's console and
+rotating file sinks (the same sinks Log::init sets up).
+
+options:
+  --ring <name>        shared memory name (default: /project_template_log)
+  --slots <n>          ring size in 512-byte slots, power of two (default: 16384)
+  --pattern <pattern>  sink pattern (default: Log::init's "[%T.%f] [%^%l%$] %v")
+  --unlink             remove the ring on exit (default: keep it, so a restarted
+                       collector picks up where this one stopped)
+  -h, --help           show this help
+)";
+
+std::atomic<bool> stop_requested{false};
+
+extern "C" void request_stop(int /*signal*/) {
+    stop_requested.store(true, std::memory_order_relaxed);
+}
+
+int fail(const std::string& message) {
+    std::cerr << "project_template_logcollector: " << message << "\n\n" << usage;
+    return EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string ring_name = ShmLogRing::default_name;
+    std::string pattern   = "[%T.%f] [%^%l%$] %v";
+    std::size_t slots     = ShmLogRing::default_slot_count;
+    bool unlink_on_exit   = false;
+
+    const std::vector<std::string_view> args(argv + 1, argv + argc);
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const auto arg       = args[i];
+        const auto has_value = i + 1 < args.size();
+
+        if (arg == "-h" || arg == "--help") {
+            std::cout << usage;
+            return EXIT_SUCCESS;
+        }
+        if (arg == "--unlink") {
+            unlink_on_exit = true;
+        } else if (arg == "--ring" && has_value) {
+            ring_name = args[++i];
+        } else if (arg == "--pattern" && has_value) {
+            pattern = args[++i];
+        } else if (arg == "--slots" && has_value) {
+            const std::string value{args[++i]};
+            char* end = nullptr;
+            slots     = std::strtoull(value.c_str(), &end, 10);
+            if (*end != '\0' || slots == 0) return fail("invalid value for --slots");
+        } else {
+            return fail("unknown option or missing value: " + std::string(arg));
+        }
+    }
+
+    std::signal(SIGINT, request_stop);
+    std::signal(SIGTERM, request_stop);
+
+    try {
+        auto ring = ShmLogRing::create(ring_name, slots);
+
+        // producers filter by their own level; the collector writes whatever arrives
+        Log::init(Level::Trace, Mode::Sync, pattern);
+        const auto logger = Log::instance();
+        const auto& sinks = logger->sinks();
+
+        std::uint64_t records = 0;
+        bool unflushed        = false;
+        const auto forward    = [&](const std::span<const std::byte> bytes) {
+            BinaryRecordReader reader{bytes};
+            BinaryRecord record;
+            if (!reader.next(record)) return; // a producer wrote garbage; skip the slot
+            const auto msg = record.to_log_msg();
+            for (const auto& sink : sinks) {
+                if (sink->should_log(msg.level)) sink->log(msg);
+            }
+            ++records;
+            unflushed = true;
+        };
+
+        std::cerr << "project_template_logcollector: collecting from " << ring_name << " (" << ring.slot_count()
+                  << " slots)\n";
+
+        while (!stop_requested.load(std::memory_order_relaxed)) {
+            if (ring.drain(forward, 4096) > 0) continue;
+            // idle: make what we have visible, then poll again shortly
+            if (unflushed) {
+                logger->flush();
+                unflushed = false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+
+        while (ring.drain(forward, 4096) > 0) {
+        }
+        logger->flush();
+        std::cerr << "project_template_logcollector: " << records << " records written, " << ring.dropped()
+                  << " dropped by producers (ring full), " << ring.lost() << " lost to producer crashes\n";
+        Log::reset_logger();
+    } catch (const std::exception& e) {
+        std::cerr << "project_template_logcollector: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    if (unlink_on_exit) {
+        ShmLogRing::unlink(ring_name);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,182 @@
+#include "log_frame.hpp"
+#include "log_index.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using project_template::utils::log::ByteRange;
+using project_template::utils::log::LogFrameReader;
+using project_template::utils::log::LogQuery;
+using project_template::utils::log::LogSegment;
+using project_template::utils::log::rotated_segments;
+
+namespace {
+
+constexpr std::string_view usage = R"(usage: project_template_logquery [options] [log file]
+
+Print the records of a rotating log (default: logs/project_template.log and its
+rotated siblings, oldest first) that fall into a time window, using the .idx
+sidecar files to skip everything else.
+
+options:
+  --from <time>        first timestamp of interest
+  --to <time>          last timestamp of interest
+  --min-level <level>  trace | debug | info | warn | error | critical
+  --stats              print bytes touched vs. total bytes to stderr
+  -h, --help           show this help
+
+<time> is local time "YYYY-MM-DD HH:MM:SS[.frac]" (a 'T' separator is accepted)
+or "@<seconds since epoch>[.frac]".
+
+Matching is done per index block: a few neighbouring records outside the window
+or below the level may be printed along with the matching ones.
+
+Files written with checksummed framing are verified record by record: damaged
+records are skipped (and reported on stderr) and reading resumes at the next
+valid record.
+)";
+
+/// Parse "@<epoch>[.frac]" or a local "YYYY-MM-DD[ T]HH:MM:SS[.frac]" into ns since epoch.
+std::optional<std::int64_t> parse_time(std::string_view text) {
+    std::int64_t frac_ns = 0;
+    if (const auto dot = text.find('.'); dot != std::string_view::npos) {
+        const auto frac = text.substr(dot + 1);
+        if (frac.empty() || frac.size() > 9 || frac.find_first_not_of("0123456789") != std::string_view::npos) {
+            return std::nullopt;
+        }
+        frac_ns = std::stoll(std::string(frac));
+        for (auto i = frac.size(); i < 9; ++i) {
+            frac_ns *= 10;
+        }
+        text = text.substr(0, dot);
+    }
+
+    std::int64_t seconds = 0;
+    if (text.starts_with('@')) {
+        const auto digits = text.substr(1);
+        if (digits.empty() || digits.find_first_not_of("0123456789") != std::string_view::npos) {
+            return std::nullopt;
+        }
+        seconds = std::stoll(std::string(digits));
+    } else {
+        std::string normalized(text);
+        if (normalized.size() > 10 && normalized[10] == 'T') normalized[10] = ' ';
+        std::tm tm{};
+        tm.tm_isdst = -1; // let mktime decide
+        std::istringstream in(normalized);
+        in >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+        if (in.fail() || in.peek() != std::char_traits<char>::eof()) {
+            return std::nullopt;
+        }
+        seconds = static_cast<std::int64_t>(std::mktime(&tm));
+    }
+    return seconds * 1'000'000'000 + frac_ns;
+}
+
+/// Bits of all spdlog levels >= `name`, or nothing for an unknown name.
+std::optional<std::uint32_t> parse_min_level(const std::string_view name) {
+    constexpr std::string_view names[] = {"trace", "debug", "info", "warn", "error", "critical"};
+    for (std::uint32_t lvl = 0; lvl < std::size(names); ++lvl) {
+        if (names[lvl] == name) {
+            // every bit from `lvl` upwards (includes levels added later)
+            return ~((1U << lvl) - 1U);
+        }
+    }
+    return std::nullopt;
+}
+
+int fail(const std::string& message) {
+    std::cerr << "project_template_logquery: " << message << "\n\n" << usage;
+    return EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    LogQuery query;
+    bool stats = false;
+    std::filesystem::path base_file{"logs/project_template.log"};
+
+    const std::vector<std::string_view> args(argv + 1, argv + argc);
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const auto arg       = args[i];
+        const auto has_value = i + 1 < args.size();
+
+        if (arg == "-h" || arg == "--help") {
+            std::cout << usage;
+            return EXIT_SUCCESS;
+        }
+        if (arg == "--stats") {
+            stats = true;
+        } else if (arg == "--from" || arg == "--to") {
+            const auto ns = has_value ? parse_time(args[++i]) : std::nullopt;
+            if (!ns) return fail("invalid or missing time for " + std::string(arg));
+            (arg == "--from" ? query.from_ns : query.to_ns) = *ns;
+        } else if (arg == "--min-level") {
+            const auto mask = has_value ? parse_min_level(args[++i]) : std::nullopt;
+            if (!mask) return fail("invalid or missing level for --min-level");
+            query.level_mask = *mask;
+        } else if (arg.starts_with('-')) {
+            return fail("unknown option " + std::string(arg));
+        } else {
+            base_file = arg;
+        }
+    }
+
+    try {
+        std::uint64_t touched = 0;
+        std::uint64_t total   = 0;
+        std::uint64_t index   = 0;
+
+        for (const auto& path : rotated_segments(base_file)) {
+            const LogSegment segment{path};
+            std::size_t skipped = 0;
+            std::size_t damaged = 0;
+            for (const ByteRange& range : segment.query(query)) {
+                const auto bytes = segment.bytes(range);
+                if (segment.framed()) {
+                    // index blocks start on frame boundaries; damage only costs the frames it hits
+                    LogFrameReader reader{bytes};
+                    std::string_view payload;
+                    while (reader.next(payload)) {
+                        std::fwrite(payload.data(), 1, payload.size(), stdout);
+                    }
+                    skipped += reader.skipped_bytes();
+                    damaged += reader.corrupt_regions();
+                } else {
+                    std::fwrite(bytes.data(), 1, bytes.size(), stdout);
+                }
+                touched += range.length;
+            }
+            total += segment.data_size();
+            index += segment.index_size();
+            if (damaged > 0) {
+                std::fflush(stdout);
+                std::cerr << "project_template_logquery: " << path.string() << ": skipped " << skipped
+                          << " corrupt bytes in " << damaged << " region(s)\n";
+            }
+        }
+        std::fflush(stdout);
+
+        if (stats) {
+            std::cerr << "data bytes touched: " << touched << " of " << total << " ("
+                      << (total == 0 ? 0.0 : 100.0 * static_cast<double>(touched) / static_cast<double>(total))
+                      << "%), index bytes mapped: " << index << '\n';
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "project_template_logquery: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
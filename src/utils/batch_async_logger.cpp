@@ -0,0 +1,294 @@
+#include "batch_async_logger.hpp"
+
+#include "sink_group.hpp"
+#include "sink_registry.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <exception>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace project_template::utils::log {
+
+namespace {
+
+constexpr std::uint32_t initial_spin = 256;  ///< pause iterations before the first park
+constexpr std::uint32_t min_spin     = 16;   ///< floor while idle periods keep ending in a park
+constexpr std::uint32_t max_spin     = 4096; ///< ceiling while records keep arriving mid-spin
+
+constexpr std::size_t min_budget_capacity = 64; ///< smallest ring `capacity_for()` suggests
+constexpr std::size_t min_in_flight       = 16; ///< floor for `ShrinkRings`
+
+void cpu_relax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// Sleep while `word == expected`. Raw futex on Linux so that a wake is exactly
+// one syscall and only issued when somebody sleeps; std::atomic wait elsewhere.
+void futex_wait(std::atomic<std::uint32_t>& word, const std::uint32_t expected) {
+#if defined(__linux__)
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    word.wait(expected);
+#endif
+}
+
+void futex_wake(std::atomic<std::uint32_t>& word) {
+#if defined(__linux__)
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+    word.notify_one();
+#endif
+}
+
+} // namespace
+
+BatchAsyncLogger::BatchAsyncLogger(std::string name, std::vector<spdlog::sink_ptr> sinks, const std::size_t capacity,
+                                   const std::size_t max_batch, LogMemoryBudget& budget)
+    : spdlog::logger(std::move(name), sinks.begin(), sinks.end()),
+      mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1), max_batch_(std::max<std::size_t>(max_batch, 1)),
+      cells_(std::make_unique<Cell[]>(mask_ + 1)), budget_(&budget), in_flight_limit_(mask_ + 1),
+      spin_budget_(initial_spin) {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+        cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    budget_->charge((mask_ + 1) * sizeof(Cell));
+    shrink_hook_ = budget_->add_shrink_hook([this] { shrink_(); });
+    worker_      = std::thread([this] { run_(); });
+}
+
+BatchAsyncLogger::~BatchAsyncLogger() {
+    budget_->remove_shrink_hook(shrink_hook_);
+    stop_.store(true);
+    parked_.store(0);
+    futex_wake(parked_);
+    worker_.join();
+    budget_->release((mask_ + 1) * sizeof(Cell));
+}
+
+std::shared_ptr<spdlog::logger> BatchAsyncLogger::clone(std::string logger_name) {
+    auto cloned =
+        std::make_shared<BatchAsyncLogger>(std::move(logger_name), sinks_, mask_ + 1, max_batch_, *budget_);
+    cloned->set_level(level());
+    cloned->flush_on(flush_level());
+    return cloned;
+}
+
+BatchAsyncLogger::Stats BatchAsyncLogger::stats() const {
+    return {messages_.load(std::memory_order_relaxed), batches_.load(std::memory_order_relaxed),
+            parks_.load(std::memory_order_relaxed), wakeups_.load(std::memory_order_relaxed),
+            dropped_.load(std::memory_order_relaxed)};
+}
+
+std::size_t BatchAsyncLogger::capacity_for(const std::size_t bytes) {
+    return std::min(std::bit_floor(std::max(bytes / sizeof(Cell), min_budget_capacity)), default_capacity);
+}
+
+void BatchAsyncLogger::sink_it_(const spdlog::details::log_msg& msg) {
+    // longer records spill to the heap until the worker retires their cell
+    const auto bytes   = msg.logger_name.size() + msg.payload.size();
+    const auto charged = bytes > inline_record_bytes ? bytes : 0;
+    if (!budget_->try_charge(charged, msg.level)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    enqueue_(Kind::Record, &msg, 0, charged);
+}
+
+void BatchAsyncLogger::flush_() {
+    // wait until the worker has written everything before the marker and flushed the sinks
+    const auto ticket = flush_requested_.fetch_add(1, std::memory_order_relaxed) + 1;
+    enqueue_(Kind::Flush, nullptr, ticket, 0);
+    for (auto done = flush_done_.load(std::memory_order_acquire); done < ticket;
+         done      = flush_done_.load(std::memory_order_acquire)) {
+        flush_done_.wait(done, std::memory_order_acquire);
+    }
+}
+
+void BatchAsyncLogger::enqueue_(const Kind kind, const spdlog::details::log_msg* msg,
+                                const std::uint64_t flush_ticket, const std::size_t charged) {
+    // shrunk by the memory budget: keep fewer records in flight
+    if (const auto limit = in_flight_limit_.load(std::memory_order_relaxed); limit <= mask_) {
+        while (pending_.load(std::memory_order_relaxed) >= limit) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Vyukov-style claim: a cell is free for position `pos` when its seq equals `pos`
+    auto pos = head_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell           = &cells_[pos & mask_];
+        const auto seq = cell->seq.load(std::memory_order_acquire);
+        if (seq == pos) {
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (seq < pos) {
+            // full: block until the worker retires the cell one lap behind us
+            std::this_thread::yield();
+            pos = head_.load(std::memory_order_relaxed);
+        } else {
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->kind         = kind;
+    cell->flush_ticket = flush_ticket;
+    cell->charged      = charged;
+    if (msg) cell->msg = spdlog::details::log_msg_buffer{*msg};
+    cell->seq.store(pos + 1, std::memory_order_release);
+
+    // only the producer that makes the queue non-empty may need to wake the worker
+    if (pending_.fetch_add(1) == 0) wake_();
+}
+
+void BatchAsyncLogger::wake_() {
+    // pairs with park_(): either we see parked_ == 1, or the worker sees pending_ > 0
+    if (parked_.load() == 1 && parked_.exchange(0) == 1) {
+        wakeups_.fetch_add(1, std::memory_order_relaxed);
+        futex_wake(parked_);
+    }
+}
+
+void BatchAsyncLogger::run_() {
+    for (;;) {
+        if (drain_batch_() > 0) continue;
+        if (stop_.load(std::memory_order_acquire)) {
+            if (pending_.load() == 0) return;
+            continue;
+        }
+        if (spin_for_work_()) continue;
+        park_();
+    }
+}
+
+std::size_t BatchAsyncLogger::drain_batch_() {
+    // collect the run of ready records at the tail, stopping in front of a flush marker and at the end of the
+    // ring (a batch is contiguous, so one SinkGroupScope covers it)
+    std::size_t count = 0;
+    while (count < max_batch_) {
+        const auto pos = tail_ + count;
+        if (count > 0 && (pos & mask_) == 0) break;
+        const Cell& cell = cells_[pos & mask_];
+        if (cell.seq.load(std::memory_order_acquire) != pos + 1 || cell.kind == Kind::Flush) break;
+        ++count;
+    }
+
+    std::size_t retired = count;
+    if (count > 0) {
+        write_batch_(tail_, count);
+    } else {
+        // nothing ready, or a flush marker (a record may have become ready since the scan above)
+        const Cell& cell = cells_[tail_ & mask_];
+        if (cell.seq.load(std::memory_order_acquire) != tail_ + 1 || cell.kind != Kind::Flush) return 0;
+        flush_sinks_(cell.flush_ticket);
+        retired = 1;
+    }
+
+    for (std::size_t i = 0; i < retired; ++i) {
+        Cell& cell = cells_[(tail_ + i) & mask_];
+        if (cell.charged > 0) {
+            // hand the spilled buffer back now instead of when the cell is reused
+            cell.msg = spdlog::details::log_msg_buffer{};
+            budget_->release(cell.charged);
+            cell.charged = 0;
+        }
+        cell.seq.store(tail_ + i + mask_ + 1, std::memory_order_release);
+    }
+    tail_ += retired;
+    pending_.fetch_sub(retired);
+
+    if (const auto limit = in_flight_limit_.load(std::memory_order_relaxed);
+        limit <= mask_ && (budget_->limit() == 0 || budget_->usage() < budget_->limit() / 2)) {
+        in_flight_limit_.store(std::min(limit * 2, mask_ + 1), std::memory_order_relaxed);
+    }
+    return retired;
+}
+
+void BatchAsyncLogger::write_batch_(const std::uint64_t first, const std::size_t count) {
+    // sink-major: each sink takes its records in one pass while its state is hot; sinks of one formatting group
+    // share the text of each record
+    const SinkGroupScope scope{cells_[first & mask_].msg, sizeof(Cell), count};
+    for_each_sink(sinks_, [&](const spdlog::sink_ptr& sink) {
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& msg = cells_[(first + i) & mask_].msg;
+            if (!sink->should_log(msg.level)) continue;
+            try {
+                sink->log(msg);
+            } catch (const std::exception& e) {
+                err_handler_(e.what());
+            }
+        }
+    });
+
+    bool flush = false;
+    for (std::size_t i = 0; i < count && !flush; ++i) {
+        flush = should_flush_(cells_[(first + i) & mask_].msg);
+    }
+    if (flush) flush_sinks_(0);
+
+    messages_.fetch_add(count, std::memory_order_relaxed);
+    batches_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void BatchAsyncLogger::flush_sinks_(const std::uint64_t ticket) {
+    for_each_sink(sinks_, [this](const spdlog::sink_ptr& sink) {
+        try {
+            sink->flush();
+        } catch (const std::exception& e) {
+            err_handler_(e.what());
+        }
+    });
+    if (ticket > flush_done_.load(std::memory_order_relaxed)) {
+        flush_done_.store(ticket, std::memory_order_release);
+        flush_done_.notify_all();
+    }
+}
+
+bool BatchAsyncLogger::spin_for_work_() {
+    // spinning only pays off if a producer can run on another CPU meanwhile
+    static const bool multi_cpu = std::thread::hardware_concurrency() > 1;
+    if (multi_cpu) {
+        for (std::uint32_t i = 0; i < spin_budget_; ++i) {
+            if (pending_.load(std::memory_order_acquire) > 0) {
+                spin_budget_ = std::min(spin_budget_ * 2, max_spin);
+                return true;
+            }
+            cpu_relax();
+        }
+        spin_budget_ = std::max(spin_budget_ / 2, min_spin);
+    }
+    return pending_.load(std::memory_order_acquire) > 0;
+}
+
+void BatchAsyncLogger::park_() {
+    parked_.store(1);
+    if (pending_.load() == 0 && !stop_.load()) {
+        parks_.fetch_add(1, std::memory_order_relaxed);
+        futex_wait(parked_, 1);
+    }
+    parked_.store(0);
+}
+
+void BatchAsyncLogger::shrink_() {
+    const auto limit = in_flight_limit_.load(std::memory_order_relaxed);
+    in_flight_limit_.store(std::max(limit / 2, std::min(min_in_flight, mask_ + 1)), std::memory_order_relaxed);
+}
+
+} // namespace project_template::utils::log
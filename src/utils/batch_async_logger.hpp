@@ -0,0 +1,140 @@
+#pragma once
+
+#include "log_memory.hpp"
+
+#include <spdlog/details/log_msg_buffer.h>
+#include <spdlog/logger.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace project_template::utils::log {
+
+/**
+ * @brief Asynchronous logger with an adaptive spin-then-park worker and batched sink writes.
+ *
+ * spdlog's `async_logger` pushes every record through a mutex-protected queue
+ * and wakes its worker with a condition variable, so at moderate rates
+ * (worker idle between records) each record costs a futex wake on the
+ * producer and a sleep/wake pair on the worker.
+ *
+ * This backend instead:
+ *  - enqueues records into a bounded lock-free MPSC ring (no lock on the hot path)
+ *  - wakes the worker only on the empty → non-empty transition, and only with
+ *    a syscall if the worker is actually parked
+ *  - lets the idle worker spin briefly before parking on a futex; the spin
+ *    budget grows while records keep arriving during spins and shrinks while
+ *    they do not (no spinning at all on a single CPU)
+ *  - drains every ready record as one batch and writes it sink by sink,
+ *    straight out of the ring without copying
+ *
+ * Overflow policy is `block`: producers yield until the worker frees a slot.
+ * `flush()` enqueues a marker and returns once everything logged before it
+ * has been written and the sinks flushed; `flush_on()` levels are flushed by
+ * the worker after the batch containing them, without blocking the producer.
+ *
+ * Memory is charged to a `LogMemoryBudget`: the ring when it is created, and
+ * each record whose logger name and payload spill out of a cell's inline
+ * buffer until the worker has written it. Records the budget refuses are
+ * dropped and counted; under `BudgetPolicy::ShrinkRings` the logger halves
+ * the number of records it keeps in flight and grows back once usage falls
+ * below half the budget.
+ */
+class BatchAsyncLogger final : public spdlog::logger {
+  public:
+    static constexpr std::size_t default_capacity    = 8192;
+    static constexpr std::size_t default_max_batch   = 256;
+    static constexpr std::size_t inline_record_bytes = 250; ///< name + payload held without heap (`memory_buf_t`)
+
+    /// Worker activity counters (monotonic, relaxed).
+    struct Stats {
+        std::uint64_t messages = 0; ///< records written
+        std::uint64_t batches  = 0; ///< batches written
+        std::uint64_t parks    = 0; ///< times the worker parked on the futex
+        std::uint64_t wakeups  = 0; ///< wake syscalls issued by producers
+        std::uint64_t dropped  = 0; ///< records refused by the memory budget
+    };
+
+    /**
+     * @param name      Logger name.
+     * @param sinks     Sinks written by the worker thread.
+     * @param capacity  Ring capacity in records, rounded up to a power of two.
+     * @param max_batch Upper bound on records written per batch.
+     * @param budget    Budget the ring and spilled records are charged to.
+     */
+    BatchAsyncLogger(std::string name, std::vector<spdlog::sink_ptr> sinks, std::size_t capacity = default_capacity,
+                     std::size_t max_batch = default_max_batch, LogMemoryBudget& budget = LogMemoryBudget::global());
+
+    /// @brief Write everything still queued, then stop the worker.
+    ~BatchAsyncLogger() override;
+
+    BatchAsyncLogger(const BatchAsyncLogger&)            = delete;
+    BatchAsyncLogger& operator=(const BatchAsyncLogger&) = delete;
+
+    [[nodiscard]] std::shared_ptr<spdlog::logger> clone(std::string logger_name) override;
+
+    [[nodiscard]] Stats stats() const;
+
+    /// @brief Largest capacity (2^n, at most `default_capacity`) whose ring fits into `bytes`.
+    [[nodiscard]] static std::size_t capacity_for(std::size_t bytes);
+
+  protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override;
+
+  private:
+    enum class Kind : std::uint8_t { Record, Flush };
+
+    struct Cell {
+        std::atomic<std::uint64_t> seq{0}; ///< == position: free, == position + 1: ready
+        Kind kind                  = Kind::Record;
+        std::uint64_t flush_ticket = 0;
+        std::size_t charged        = 0; ///< budget bytes held by a spilled record
+        spdlog::details::log_msg_buffer msg;
+    };
+
+    void enqueue_(Kind kind, const spdlog::details::log_msg* msg, std::uint64_t flush_ticket, std::size_t charged);
+    void wake_();
+    void run_();
+    /// @brief Write the next batch of ready records; returns the number of cells retired.
+    std::size_t drain_batch_();
+    void write_batch_(std::uint64_t first, std::size_t count);
+    void flush_sinks_(std::uint64_t ticket);
+    /// @brief Spin for up to the current budget; true if work arrived meanwhile.
+    bool spin_for_work_();
+    void park_();
+    /// @brief Budget shrink hook: halve the records kept in flight.
+    void shrink_();
+
+    std::size_t mask_;
+    std::size_t max_batch_;
+    std::unique_ptr<Cell[]> cells_;
+    LogMemoryBudget* budget_;
+    std::uint64_t shrink_hook_ = 0;
+
+    alignas(64) std::atomic<std::uint64_t> head_{0};    ///< next position claimed by a producer
+    alignas(64) std::atomic<std::uint64_t> pending_{0}; ///< published, not yet retired records
+    alignas(64) std::atomic<std::uint32_t> parked_{0};  ///< futex word: 1 while the worker sleeps
+    std::atomic<bool> stop_{false};
+    std::atomic<std::uint64_t> flush_requested_{0};
+    std::atomic<std::uint64_t> flush_done_{0};
+    std::atomic<std::size_t> in_flight_limit_{0}; ///< producers wait while this many records are pending
+
+    alignas(64) std::uint64_t tail_ = 0; ///< worker-only
+    std::uint32_t spin_budget_      = 0; ///< worker-only, adapted per idle period
+
+    std::atomic<std::uint64_t> messages_{0};
+    std::atomic<std::uint64_t> batches_{0};
+    std::atomic<std::uint64_t> parks_{0};
+    std::atomic<std::uint64_t> wakeups_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+
+    std::thread worker_;
+};
+
+} // namespace project_template::utils::log
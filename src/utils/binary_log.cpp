@@ -0,0 +1,243 @@
+#include "binary_log.hpp"
+
+#include "text_escape.hpp"
+
+#include <spdlog/common.h>
+
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+
+namespace project_template::utils::log {
+
+namespace {
+
+constexpr std::size_t max_name_len = 0xFFFF;
+
+template <class T> void append_raw(spdlog::memory_buf_t& out, const T& value) {
+    const auto* begin = reinterpret_cast<const char*>(&value);
+    out.append(begin, begin + sizeof(T));
+}
+
+/// Length of a NUL-terminated field as stored (including the NUL), 0 for "unknown".
+std::uint16_t stored_len(const char* text) {
+    if (text == nullptr) return 0;
+    return static_cast<std::uint16_t>(std::min(std::strlen(text), max_name_len - 1) + 1);
+}
+
+/// Store `len - 1` characters of `text` followed by a NUL (the source may be longer).
+void append_c_string(spdlog::memory_buf_t& out, const char* text, const std::uint16_t len) {
+    if (len == 0) return;
+    out.append(text, text + len - 1);
+    out.push_back('\0');
+}
+
+/// A stored C string is valid if it is empty (unknown) or ends in NUL.
+const char* c_string_at(const char* data, const std::uint16_t len) {
+    if (len == 0) return "";
+    return data[len - 1] == '\0' ? data : nullptr;
+}
+
+void append(spdlog::memory_buf_t& out, const std::string_view text) {
+    out.append(text.data(), text.data() + text.size());
+}
+
+/// Append `value` as exactly `width` decimal digits.
+void append_fixed(spdlog::memory_buf_t& out, std::uint64_t value, const std::size_t width) {
+    std::array<char, 20> digits{};
+    for (std::size_t i = width; i > 0; --i) {
+        digits[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    out.append(digits.data(), digits.data() + width);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Encoding
+// ---------------------------------------------------------------------------
+
+spdlog::details::log_msg BinaryRecord::to_log_msg() const {
+    const auto time = spdlog::log_clock::time_point{
+        std::chrono::duration_cast<spdlog::log_clock::duration>(std::chrono::nanoseconds{ts_ns})};
+    const spdlog::source_loc loc{*file == '\0' ? nullptr : file, static_cast<int>(line),
+                                 *func == '\0' ? nullptr : func};
+
+    spdlog::details::log_msg msg{time, loc, spdlog::string_view_t{logger.data(), logger.size()}, level,
+                                 spdlog::string_view_t{payload.data(), payload.size()}};
+    msg.thread_id = static_cast<std::size_t>(thread_id);
+    return msg;
+}
+
+void encode_record(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& out) {
+    BinaryRecordHeader header;
+    header.level      = static_cast<std::uint8_t>(msg.level);
+    header.logger_len = static_cast<std::uint16_t>(std::min(msg.logger_name.size(), max_name_len));
+    header.line       = static_cast<std::uint32_t>(msg.source.line);
+    header.file_len   = stored_len(msg.source.filename);
+    header.func_len   = stored_len(msg.source.funcname);
+    header.ts_ns      = std::chrono::duration_cast<std::chrono::nanoseconds>(msg.time.time_since_epoch()).count();
+    header.thread_id  = msg.thread_id;
+    header.size       = static_cast<std::uint32_t>(sizeof(header) + header.logger_len + header.file_len +
+                                             header.func_len + msg.payload.size());
+
+    append_raw(out, header);
+    out.append(msg.logger_name.data(), msg.logger_name.data() + header.logger_len);
+    append_c_string(out, msg.source.filename, header.file_len);
+    append_c_string(out, msg.source.funcname, header.func_len);
+    out.append(msg.payload.data(), msg.payload.data() + msg.payload.size());
+}
+
+// ---------------------------------------------------------------------------
+// Decoding
+// ---------------------------------------------------------------------------
+
+std::span<const std::byte> binary_log_records(const std::span<const std::byte> segment) {
+    BinaryLogHeader header;
+    if (segment.size() < sizeof(header)) {
+        throw std::runtime_error("binary log too short");
+    }
+    std::memcpy(&header, segment.data(), sizeof(header));
+    if (header.magic != binary_log_magic) {
+        throw std::runtime_error("not a binary log");
+    }
+    if (header.version != binary_log_version) {
+        throw std::runtime_error("unsupported binary log version " + std::to_string(header.version));
+    }
+    return segment.subspan(sizeof(header));
+}
+
+bool BinaryRecordReader::next(BinaryRecord& record) {
+    const auto remaining = data_.size() - offset_;
+    if (remaining < sizeof(BinaryRecordHeader)) return false;
+
+    BinaryRecordHeader header;
+    const auto* base = reinterpret_cast<const char*>(data_.data() + offset_);
+    std::memcpy(&header, base, sizeof(header));
+
+    const std::size_t fixed = sizeof(header) + header.logger_len + header.file_len + header.func_len;
+    if (header.size < fixed || header.size > remaining || header.level >= spdlog::level::n_levels) return false;
+
+    const char* p     = base + sizeof(header);
+    const auto logger = std::string_view{p, header.logger_len};
+    p += header.logger_len;
+    const char* file = c_string_at(p, header.file_len);
+    p += header.file_len;
+    const char* func = c_string_at(p, header.func_len);
+    p += header.func_len;
+    if (file == nullptr || func == nullptr) return false;
+
+    record.ts_ns     = header.ts_ns;
+    record.thread_id = header.thread_id;
+    record.level     = static_cast<spdlog::level::level_enum>(header.level);
+    record.line      = header.line;
+    record.file      = file;
+    record.func      = func;
+    record.logger    = logger;
+    record.payload   = std::string_view{p, header.size - fixed};
+
+    offset_ += header.size;
+    return true;
+}
+
+bool BinaryRecordReader::skip() {
+    const auto remaining = data_.size() - offset_;
+    if (remaining < sizeof(BinaryRecordHeader)) return false;
+
+    std::uint32_t size = 0;
+    std::memcpy(&size, data_.data() + offset_, sizeof(size));
+    if (size < sizeof(BinaryRecordHeader) || size > remaining) return false;
+
+    offset_ += size;
+    return true;
+}
+
+std::vector<std::size_t> split_records(const std::span<const std::byte> records, const std::size_t chunk_bytes) {
+    std::vector<std::size_t> bounds{0};
+    std::size_t offset      = 0;
+    std::size_t chunk_start = 0;
+    while (records.size() - offset >= sizeof(BinaryRecordHeader)) {
+        std::uint32_t size = 0;
+        std::memcpy(&size, records.data() + offset, sizeof(size));
+        if (size < sizeof(BinaryRecordHeader) || size > records.size() - offset) break;
+        offset += size;
+        if (offset - chunk_start >= chunk_bytes) {
+            bounds.push_back(offset);
+            chunk_start = offset;
+        }
+    }
+    if (bounds.back() != offset || bounds.size() == 1) {
+        bounds.push_back(offset);
+    }
+    return bounds;
+}
+
+// ---------------------------------------------------------------------------
+// JSON rendering
+// ---------------------------------------------------------------------------
+
+void JsonRenderer::operator()(const BinaryRecord& record, spdlog::memory_buf_t& out) {
+    constexpr std::int64_t ns_per_second = 1'000'000'000;
+    auto seconds                         = record.ts_ns / ns_per_second;
+    auto nanos                           = record.ts_ns % ns_per_second;
+    if (nanos < 0) {
+        seconds -= 1;
+        nanos += ns_per_second;
+    }
+    // the date part only changes once per second, so cache it like spdlog's pattern formatter does
+    if (seconds != cached_second_) {
+        const auto t = static_cast<std::time_t>(seconds);
+        std::tm tm{};
+        ::gmtime_r(&t, &tm);
+        std::strftime(cached_time_.data(), cached_time_.size(), "%Y-%m-%dT%H:%M:%S", &tm);
+        cached_second_ = seconds;
+    }
+
+    append(out, R"({"time":")");
+    out.append(cached_time_.data(), cached_time_.data() + 19);
+    out.push_back('.');
+    append_fixed(out, static_cast<std::uint64_t>(nanos), 9);
+    append(out, R"(Z","level":")");
+    const auto level = spdlog::level::to_string_view(record.level);
+    out.append(level.data(), level.data() + level.size());
+    append(out, R"(","logger":")");
+    text::append_json_escaped(out, record.logger);
+    append(out, R"(","thread":)");
+    append(out, spdlog::fmt_lib::format_int(record.thread_id).c_str());
+    append(out, R"(,"file":")");
+    text::append_json_escaped(out, record.file);
+    append(out, R"(","line":)");
+    append(out, spdlog::fmt_lib::format_int(record.line).c_str());
+    append(out, R"(,"func":")");
+    text::append_json_escaped(out, record.func);
+    append(out, R"(","msg":")");
+    text::append_json_escaped(out, record.payload);
+    append(out, "\"}\n");
+}
+
+// ---------------------------------------------------------------------------
+// BinaryFileSink
+// ---------------------------------------------------------------------------
+
+BinaryFileSink::BinaryFileSink(const spdlog::filename_t& filename, const bool truncate) {
+    file_.open(filename, truncate);
+    if (file_.size() == 0) {
+        buffer_.clear();
+        append_raw(buffer_, BinaryLogHeader{});
+        file_.write(buffer_);
+    }
+}
+
+void BinaryFileSink::sink_it_(const spdlog::details::log_msg& msg) {
+    buffer_.clear();
+    encode_record(msg, buffer_);
+    file_.write(buffer_);
+}
+
+void BinaryFileSink::flush_() {
+    file_.flush();
+}
+
+} // namespace project_template::utils::log
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <spdlog/details/file_helper.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace project_template::utils::log {
+
+/**
+ * @name Binary log format
+ *
+ * A binary log segment stores records exactly as the logger saw them
+ * (timestamp, level, thread, source location, logger name, payload) and
+ * defers all pattern formatting to the reader (`project_template_logcat`):
+ *
+ *   BinaryLogHeader
+ *   record*            BinaryRecordHeader, logger name, file\0, function\0, payload
+ *
+ * All integers are stored in host byte order; records are packed without
+ * padding, so readers must `memcpy` the header out. `file_len` / `func_len`
+ * include the terminating NUL so decoded records can hand out C strings that
+ * point straight into the mapped file.
+ */
+/// @{
+
+inline constexpr std::array<char, 8> binary_log_magic = {'P', 'T', 'L', 'O', 'G', 'B', 'I', 'N'};
+inline constexpr std::uint32_t binary_log_version     = 1;
+
+struct BinaryLogHeader {
+    std::array<char, 8> magic = binary_log_magic;
+    std::uint32_t version     = binary_log_version;
+    std::uint32_t reserved    = 0;
+};
+
+struct BinaryRecordHeader {
+    std::uint32_t size       = 0; ///< whole record including this header
+    std::uint8_t level       = 0; ///< spdlog::level::level_enum
+    std::uint8_t reserved    = 0;
+    std::uint16_t logger_len = 0;
+    std::uint32_t line       = 0;
+    std::uint16_t file_len   = 0; ///< including NUL, 0 if unknown
+    std::uint16_t func_len   = 0; ///< including NUL, 0 if unknown
+    std::int64_t ts_ns       = 0; ///< ns since epoch (system clock)
+    std::uint64_t thread_id  = 0;
+};
+
+static_assert(sizeof(BinaryLogHeader) == 16);
+static_assert(sizeof(BinaryRecordHeader) == 32);
+
+/// @}
+
+/// @brief A decoded record; all views point into the segment it was read from.
+struct BinaryRecord {
+    std::int64_t ts_ns              = 0;
+    std::uint64_t thread_id         = 0;
+    spdlog::level::level_enum level = spdlog::level::info;
+    std::uint32_t line              = 0;
+    const char* file                = ""; ///< NUL-terminated
+    const char* func                = ""; ///< NUL-terminated
+    std::string_view logger;
+    std::string_view payload;
+
+    /// @brief Rebuild the spdlog message, e.g. to run it through a `spdlog::pattern_formatter`.
+    [[nodiscard]] spdlog::details::log_msg to_log_msg() const;
+};
+
+/// @brief Append the binary encoding of `msg` to `out`.
+void encode_record(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& out);
+
+/**
+ * @brief Records of a segment without its file header.
+ *
+ * Throws `std::runtime_error` if `segment` does not start with a valid
+ * `BinaryLogHeader`.
+ */
+std::span<const std::byte> binary_log_records(std::span<const std::byte> segment);
+
+/**
+ * @brief Sequential decoder over the record area of a segment.
+ *
+ * `next()` stops at the end of the data or at the first record that does
+ * not frame correctly (e.g. a torn write at the tail); `offset()` then tells
+ * how many bytes were consumed.
+ */
+class BinaryRecordReader {
+  public:
+    explicit BinaryRecordReader(std::span<const std::byte> records) : data_(records) {}
+
+    bool next(BinaryRecord& record);
+
+    /**
+     * @brief Step over the record at `offset()` that `next()` rejected, using only its size field.
+     *
+     * False if the size does not frame a record either; nothing is skipped then.
+     */
+    bool skip();
+
+    [[nodiscard]] std::size_t offset() const {
+        return offset_;
+    }
+
+    /// @brief True if decoding stopped before the end of the data.
+    [[nodiscard]] bool truncated() const {
+        return offset_ != data_.size();
+    }
+
+  private:
+    std::span<const std::byte> data_;
+    std::size_t offset_ = 0;
+};
+
+/**
+ * @brief Cut the record area into chunks of roughly `chunk_bytes` on record boundaries.
+ *
+ * Only the size fields are read, so this pass is much cheaper than decoding.
+ * Returns the chunk start offsets plus the end of the last well-framed record.
+ */
+std::vector<std::size_t> split_records(std::span<const std::byte> records, std::size_t chunk_bytes);
+
+/**
+ * @brief Renders records as one JSON object per line.
+ *
+ * Fields: `time` (UTC, ns precision), `level`, `logger`, `thread`, `file`,
+ * `line`, `func`, `msg`. Strings go through `text::append_json_escaped()`,
+ * so ill-formed UTF-8 becomes U+FFFD and every line is valid JSON.
+ * Not thread-safe; use one renderer per thread.
+ */
+class JsonRenderer {
+  public:
+    void operator()(const BinaryRecord& record, spdlog::memory_buf_t& out);
+
+  private:
+    std::int64_t cached_second_ = -1;
+    std::array<char, 20> cached_time_{}; ///< "YYYY-MM-DDTHH:MM:SS"
+};
+
+/// @brief Bytes of a record area that could not be decoded, as offsets into the record area.
+struct CorruptRange {
+    std::size_t offset = 0;
+    std::size_t length = 0;
+};
+
+/// @brief Outcome of `render_parallel()`.
+struct RenderResult {
+    std::size_t decoded_bytes = 0;     ///< bytes of the records that were rendered
+    std::size_t end           = 0;     ///< end of the last well-framed record; what follows is a torn tail
+    std::vector<CorruptRange> corrupt; ///< well-framed but malformed records that were skipped, in file order
+};
+
+namespace detail {
+
+/// Append `range`, merging it into the last range if they touch.
+inline void add_corrupt_range(std::vector<CorruptRange>& ranges, const CorruptRange range) {
+    if (!ranges.empty() && ranges.back().offset + ranges.back().length == range.offset) {
+        ranges.back().length += range.length;
+    } else {
+        ranges.push_back(range);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Render a record area on `threads` threads while keeping record order.
+ *
+ * `make_renderer()` is called once per worker and must return a callable
+ * `(const BinaryRecord&, spdlog::memory_buf_t&)`. Each chunk is rendered into
+ * its own buffer and handed to `write(std::string_view)` in file order. Work
+ * proceeds in waves of `threads` chunks so memory stays bounded by
+ * `threads * chunk_bytes` times the expansion factor of the renderer.
+ *
+ * Records are framed by their size field, so a record whose other fields are
+ * malformed costs only itself: it is skipped, reported in
+ * `RenderResult::corrupt` (adjacent ones as one range), and rendering goes on
+ * with the next record. Decoding stops where the framing breaks.
+ */
+template <class MakeRenderer, class Write>
+RenderResult render_parallel(const std::span<const std::byte> records, const unsigned threads,
+                             const std::size_t chunk_bytes, MakeRenderer make_renderer, Write write) {
+    const auto bounds  = split_records(records, chunk_bytes);
+    const auto chunks  = bounds.size() - 1;
+    const auto workers = std::max(1U, threads);
+
+    using Renderer = decltype(make_renderer());
+    std::vector<Renderer> renderers;
+    renderers.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i) {
+        renderers.push_back(make_renderer());
+    }
+    std::vector<spdlog::memory_buf_t> buffers(workers);
+    std::vector<std::vector<CorruptRange>> corrupt(workers);
+
+    const auto render_chunk = [&](const std::size_t chunk, const unsigned worker) {
+        auto& buf    = buffers[worker];
+        auto& ranges = corrupt[worker];
+        buf.clear();
+        ranges.clear();
+        BinaryRecordReader reader{records.subspan(bounds[chunk], bounds[chunk + 1] - bounds[chunk])};
+        BinaryRecord record;
+        for (;;) {
+            while (reader.next(record)) {
+                renderers[worker](record, buf);
+            }
+            // split_records() checked the framing, so only the record itself is malformed
+            const auto offset = bounds[chunk] + reader.offset();
+            if (!reader.truncated() || !reader.skip()) break;
+            detail::add_corrupt_range(ranges, {offset, bounds[chunk] + reader.offset() - offset});
+        }
+    };
+
+    RenderResult result;
+    result.end = bounds.back();
+
+    for (std::size_t first = 0; first < chunks; first += workers) {
+        const auto wave = static_cast<unsigned>(std::min<std::size_t>(workers, chunks - first));
+        {
+            std::vector<std::jthread> pool;
+            pool.reserve(wave - 1);
+            for (unsigned w = 1; w < wave; ++w) {
+                pool.emplace_back(render_chunk, first + w, w);
+            }
+            render_chunk(first, 0); // the calling thread takes the first chunk
+        }
+        for (unsigned w = 0; w < wave; ++w) {
+            write(std::string_view{buffers[w].data(), buffers[w].size()});
+            for (const auto& range : corrupt[w]) {
+                detail::add_corrupt_range(result.corrupt, range);
+            }
+        }
+    }
+
+    std::size_t skipped = 0;
+    for (const auto& range : result.corrupt) {
+        skipped += range.length;
+    }
+    result.decoded_bytes = result.end - skipped;
+    return result;
+}
+
+/**
+ * @brief File sink that appends records in the binary log format.
+ *
+ * Logging costs a `memcpy` of the payload and a few fields; no pattern is
+ * applied (`set_pattern()` has no effect). Decode with
+ * `project_template_logcat`, which applies the pattern at read time.
+ */
+class BinaryFileSink final : public spdlog::sinks::base_sink<std::mutex> {
+  public:
+    explicit BinaryFileSink(const spdlog::filename_t& filename, bool truncate = false);
+
+    /// @brief Name of the file written to.
+    const spdlog::filename_t& filename() const {
+        return file_.filename();
+    }
+
+  protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override;
+
+  private:
+    spdlog::details::file_helper file_;
+    spdlog::memory_buf_t buffer_;
+};
+
+} // namespace project_template::utils::log
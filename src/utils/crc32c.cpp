@@ -0,0 +1,144 @@
+#include "crc32c.hpp"
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <nmmintrin.h>
+#define PROJECT_TEMPLATE_CRC32C_SSE42 1
+#endif
+
+#if defined(__GNUC__) && defined(__aarch64__)
+#include <arm_acle.h>
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#define PROJECT_TEMPLATE_CRC32C_ARMV8 1
+#endif
+
+namespace project_template::utils::checksum {
+
+namespace {
+
+constexpr std::uint32_t polynomial = 0x82F63B78; ///< Castagnoli, bit-reflected
+
+/// Slice-by-8 tables: `tables[k][b]` is the CRC of byte `b` followed by `k` zero bytes.
+constexpr auto tables = [] {
+    std::array<std::array<std::uint32_t, 256>, 8> t{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1U) != 0 ? (crc >> 1) ^ polynomial : crc >> 1;
+        }
+        t[0][i] = crc;
+    }
+    for (std::size_t i = 0; i < 256; ++i) {
+        for (std::size_t k = 1; k < 8; ++k) {
+            t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+        }
+    }
+    return t;
+}();
+
+using Update = std::uint32_t (*)(std::uint32_t crc, const std::byte* data, std::size_t size);
+
+std::uint32_t load_byte(const std::byte* data) {
+    return std::to_integer<std::uint32_t>(*data);
+}
+
+std::uint64_t load_word(const std::byte* data) {
+    std::uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+std::uint32_t update_portable(std::uint32_t crc, const std::byte* data, std::size_t size) {
+    if constexpr (std::endian::native == std::endian::little) {
+        for (; size >= 8; data += 8, size -= 8) {
+            const auto word = load_word(data) ^ crc;
+            crc = tables[7][word & 0xFF] ^ tables[6][(word >> 8) & 0xFF] ^ tables[5][(word >> 16) & 0xFF] ^
+                  tables[4][(word >> 24) & 0xFF] ^ tables[3][(word >> 32) & 0xFF] ^ tables[2][(word >> 40) & 0xFF] ^
+                  tables[1][(word >> 48) & 0xFF] ^ tables[0][word >> 56];
+        }
+    }
+    for (; size > 0; ++data, --size) {
+        crc = (crc >> 8) ^ tables[0][(crc ^ load_byte(data)) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(PROJECT_TEMPLATE_CRC32C_SSE42)
+__attribute__((target("sse4.2"))) std::uint32_t update_sse42(std::uint32_t crc, const std::byte* data,
+                                                             std::size_t size) {
+#if defined(__x86_64__)
+    std::uint64_t crc64 = crc;
+    for (; size >= 8; data += 8, size -= 8) {
+        crc64 = _mm_crc32_u64(crc64, load_word(data));
+    }
+    crc = static_cast<std::uint32_t>(crc64);
+#endif
+    for (; size > 0; ++data, --size) {
+        crc = _mm_crc32_u8(crc, static_cast<std::uint8_t>(load_byte(data)));
+    }
+    return crc;
+}
+#endif
+
+#if defined(PROJECT_TEMPLATE_CRC32C_ARMV8)
+#if defined(__clang__)
+__attribute__((target("crc")))
+#else
+__attribute__((target("+crc")))
+#endif
+std::uint32_t update_armv8(std::uint32_t crc, const std::byte* data, std::size_t size) {
+    for (; size >= 8; data += 8, size -= 8) {
+        crc = __crc32cd(crc, load_word(data));
+    }
+    for (; size > 0; ++data, --size) {
+        crc = __crc32cb(crc, static_cast<std::uint8_t>(load_byte(data)));
+    }
+    return crc;
+}
+#endif
+
+struct Implementation {
+    Update update;
+    std::string_view name;
+};
+
+Implementation select_implementation() {
+#if defined(PROJECT_TEMPLATE_CRC32C_SSE42)
+    if (__builtin_cpu_supports("sse4.2")) return {update_sse42, "sse4.2"};
+#endif
+#if defined(PROJECT_TEMPLATE_CRC32C_ARMV8)
+#if defined(__ARM_FEATURE_CRC32)
+    return {update_armv8, "armv8"};
+#elif defined(__linux__)
+    if ((::getauxval(AT_HWCAP) & HWCAP_CRC32) != 0) return {update_armv8, "armv8"};
+#endif
+#endif
+    return {update_portable, "portable"};
+}
+
+const Implementation& implementation() {
+    static const Implementation selected = select_implementation();
+    return selected;
+}
+
+} // namespace
+
+std::uint32_t crc32c(const std::span<const std::byte> data, const std::uint32_t crc) {
+    return ~implementation().update(~crc, data.data(), data.size());
+}
+
+std::uint32_t crc32c_portable(const std::span<const std::byte> data, const std::uint32_t crc) {
+    return ~update_portable(~crc, data.data(), data.size());
+}
+
+std::string_view crc32c_implementation() {
+    return implementation().name;
+}
+
+} // namespace project_template::utils::checksum
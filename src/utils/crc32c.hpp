@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace project_template::utils::checksum {
+
+/**
+ * @brief CRC-32C (Castagnoli) of `data`.
+ *
+ * Uses the CPU's CRC instructions when available (SSE4.2 `crc32` on x86-64,
+ * the ARMv8 CRC extension on AArch64, detected once at run time) and a
+ * slice-by-8 table implementation otherwise; all produce identical results.
+ *
+ * Pass a previous result as `crc` to checksum data in pieces:
+ * `crc32c(b, crc32c(a)) == crc32c(a + b)`.
+ */
+std::uint32_t crc32c(std::span<const std::byte> data, std::uint32_t crc = 0);
+
+inline std::uint32_t crc32c(const std::string_view text, const std::uint32_t crc = 0) {
+    return crc32c(std::as_bytes(std::span{text.data(), text.size()}), crc);
+}
+
+/// @brief Table-driven CRC-32C, regardless of the CPU (reference for tests and benchmarks).
+std::uint32_t crc32c_portable(std::span<const std::byte> data, std::uint32_t crc = 0);
+
+/// @brief Implementation used by `crc32c()`: "sse4.2", "armv8" or "portable".
+std::string_view crc32c_implementation();
+
+} // namespace project_template::utils::checksum
@@ -0,0 +1,769 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PROJECT_TEMPLATE_FLAT_HASH_SSE2 1
+#endif
+
+namespace project_template::utils::container {
+
+/**
+ * @brief Transparent hasher for string-like keys.
+ *
+ * Lets `FlatHashMap<std::string, V>` be queried with `std::string_view` or
+ * string literals without materializing a temporary `std::string`.
+ */
+struct StringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(const std::string_view s) const noexcept {
+        return std::hash<std::string_view>{}(s);
+    }
+};
+
+namespace detail {
+
+template <class T>
+inline constexpr bool is_string_like_v = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+template <class Key>
+using default_hash_t = std::conditional_t<is_string_like_v<Key>, StringHash, std::hash<Key>>;
+
+template <class Key>
+using default_equal_t = std::conditional_t<is_string_like_v<Key>, std::equal_to<>, std::equal_to<Key>>;
+
+/// Heterogeneous lookup is only enabled when both hasher and comparator opt in.
+template <class Hash, class KeyEqual>
+concept transparent = requires {
+    typename Hash::is_transparent;
+    typename KeyEqual::is_transparent;
+};
+
+/**
+ * Control bytes, one per slot:
+ *   - full:    0b0xxxxxxx (the 7 low bits of the hash, "H2")
+ *   - empty:   0b10000000
+ *   - deleted: 0b11111110
+ */
+using ctrl_t                         = std::int8_t;
+inline constexpr ctrl_t ctrl_empty   = -128;
+inline constexpr ctrl_t ctrl_deleted = -2;
+
+/// Post-mix so that weak hashes (libstdc++'s identity hash for integers) spread over H1 and H2.
+inline std::size_t mix_hash(const std::size_t h) noexcept {
+    const auto x = static_cast<std::uint64_t>(h) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<std::size_t>(x ^ (x >> 32));
+}
+
+/// Iterable set of slot offsets within a group; `shift` converts bit positions to offsets.
+template <class T, int shift> class BitMask {
+  public:
+    explicit BitMask(const T mask) : mask_(mask) {}
+
+    explicit operator bool() const {
+        return mask_ != 0;
+    }
+
+    [[nodiscard]] std::size_t lowest() const {
+        return static_cast<std::size_t>(std::countr_zero(mask_)) >> shift;
+    }
+
+    BitMask begin() const {
+        return *this;
+    }
+
+    BitMask end() const {
+        return BitMask{0};
+    }
+
+    std::size_t operator*() const {
+        return lowest();
+    }
+
+    BitMask& operator++() {
+        mask_ &= static_cast<T>(mask_ - 1);
+        return *this;
+    }
+
+    bool operator!=(const BitMask& other) const {
+        return mask_ != other.mask_;
+    }
+
+  private:
+    T mask_;
+};
+
+#ifdef PROJECT_TEMPLATE_FLAT_HASH_SSE2
+
+/// 16 control bytes probed in parallel with SSE2.
+class Group {
+  public:
+    static constexpr std::size_t width = 16;
+
+    explicit Group(const ctrl_t* pos) : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+    [[nodiscard]] BitMask<std::uint32_t, 0> match(const ctrl_t h2) const {
+        return mask_of(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(h2)), ctrl_));
+    }
+
+    [[nodiscard]] BitMask<std::uint32_t, 0> match_empty() const {
+        return mask_of(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(ctrl_empty)), ctrl_));
+    }
+
+    [[nodiscard]] BitMask<std::uint32_t, 0> match_empty_or_deleted() const {
+        // empty and deleted are the only control values below -1
+        return mask_of(_mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(-1)), ctrl_));
+    }
+
+  private:
+    __m128i ctrl_;
+
+    static BitMask<std::uint32_t, 0> mask_of(const __m128i v) {
+        return BitMask<std::uint32_t, 0>{static_cast<std::uint32_t>(_mm_movemask_epi8(v))};
+    }
+};
+
+#else
+
+/// Portable fallback: 8 control bytes probed in parallel with 64-bit SWAR arithmetic.
+class Group {
+  public:
+    static constexpr std::size_t width = 8;
+
+    explicit Group(const ctrl_t* pos) {
+        for (std::size_t i = 0; i < width; ++i) {
+            ctrl_ |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(pos[i])) << (8 * i);
+        }
+    }
+
+    // may report false positives right after a true match; callers compare keys anyway
+    [[nodiscard]] BitMask<std::uint64_t, 3> match(const ctrl_t h2) const {
+        const auto x = ctrl_ ^ (lsbs * static_cast<std::uint64_t>(static_cast<std::uint8_t>(h2)));
+        return BitMask<std::uint64_t, 3>{(x - lsbs) & ~x & msbs};
+    }
+
+    [[nodiscard]] BitMask<std::uint64_t, 3> match_empty() const {
+        return BitMask<std::uint64_t, 3>{ctrl_ & ~(ctrl_ << 6) & msbs};
+    }
+
+    [[nodiscard]] BitMask<std::uint64_t, 3> match_empty_or_deleted() const {
+        return BitMask<std::uint64_t, 3>{ctrl_ & ~(ctrl_ << 7) & msbs};
+    }
+
+  private:
+    static constexpr std::uint64_t lsbs = 0x0101010101010101ULL;
+    static constexpr std::uint64_t msbs = 0x8080808080808080ULL;
+    std::uint64_t ctrl_                 = 0;
+};
+
+#endif
+
+/// Shared all-empty group used by tables without storage, so lookups need no capacity check.
+inline ctrl_t* empty_group() {
+    alignas(16) static std::array<ctrl_t, 16> group = [] {
+        std::array<ctrl_t, 16> g{};
+        g.fill(ctrl_empty);
+        return g;
+    }();
+    return group.data();
+}
+
+/**
+ * @brief Open-addressing table shared by FlatHashMap and FlatHashSet.
+ *
+ * Slots are stored in one flat array next to a parallel array of control
+ * bytes. A lookup hashes once, then probes whole groups of control bytes at
+ * a time (16 with SSE2) for the 7-bit hash tag, so most misses and hits
+ * touch a single cache line of metadata and at most one slot.
+ *
+ * The control array holds `capacity + Group::width` bytes; the tail mirrors
+ * the first group so that unaligned group loads near the end never wrap.
+ *
+ * Erased slots become tombstones, which are reclaimed on the next rehash.
+ * Value types should be nothrow-move-constructible; a throwing move during
+ * rehash leaves the table in a valid but unspecified state.
+ */
+template <class Value, class Key, class KeyOf, class Hash, class KeyEqual> class FlatTable {
+    template <bool is_const> class BasicIterator;
+
+  public:
+    using key_type        = Key;
+    using value_type      = Value;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher          = Hash;
+    using key_equal       = KeyEqual;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using iterator        = BasicIterator<false>;
+    using const_iterator  = BasicIterator<true>;
+
+    FlatTable() = default;
+
+    explicit FlatTable(const size_type bucket_count, const Hash& hash = Hash{}, const KeyEqual& equal = KeyEqual{})
+      : hash_(hash), equal_(equal) {
+        reserve(bucket_count);
+    }
+
+    FlatTable(const FlatTable& other) : hash_(other.hash_), equal_(other.equal_) {
+        reserve(other.size());
+        for (const auto& value : other) {
+            insert_new(KeyOf{}(value), value);
+        }
+    }
+
+    FlatTable(FlatTable&& other) noexcept {
+        swap(other);
+    }
+
+    FlatTable& operator=(FlatTable other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~FlatTable() {
+        destroy_all();
+        deallocate();
+    }
+
+    // ---------------------------------------------------------------------
+    // Iteration
+    // ---------------------------------------------------------------------
+
+    iterator begin() {
+        return iterator{this, next_full(0)};
+    }
+
+    iterator end() {
+        return iterator{this, capacity_};
+    }
+
+    const_iterator begin() const {
+        return const_iterator{this, next_full(0)};
+    }
+
+    const_iterator end() const {
+        return const_iterator{this, capacity_};
+    }
+
+    const_iterator cbegin() const {
+        return begin();
+    }
+
+    const_iterator cend() const {
+        return end();
+    }
+
+    // ---------------------------------------------------------------------
+    // Capacity
+    // ---------------------------------------------------------------------
+
+    [[nodiscard]] bool empty() const {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] size_type size() const {
+        return size_;
+    }
+
+    /// @brief Number of slots (not elements); the table grows at 7/8 occupancy.
+    [[nodiscard]] size_type capacity() const {
+        return capacity_;
+    }
+
+    /// @brief Make room for at least `count` elements without further rehashing.
+    void reserve(const size_type count) {
+        const auto wanted = capacity_for(count);
+        if (wanted > capacity_) rehash(wanted);
+    }
+
+    // ---------------------------------------------------------------------
+    // Modifiers
+    // ---------------------------------------------------------------------
+
+    /// @brief Destroy all elements; keeps the allocated capacity.
+    void clear() {
+        destroy_all();
+        if (capacity_ > 0) std::fill_n(ctrl_, capacity_ + Group::width, ctrl_empty);
+        size_    = 0;
+        deleted_ = 0;
+    }
+
+    iterator erase(const_iterator pos) {
+        erase_at(pos.index_);
+        return iterator{this, next_full(pos.index_ + 1)};
+    }
+
+    iterator erase(iterator pos) {
+        erase_at(pos.index_);
+        return iterator{this, next_full(pos.index_ + 1)};
+    }
+
+    size_type erase(const key_type& key) {
+        return erase_key(key);
+    }
+
+    template <class K>
+        requires transparent<Hash, KeyEqual>
+    size_type erase(const K& key) {
+        return erase_key(key);
+    }
+
+    void swap(FlatTable& other) noexcept {
+        using std::swap;
+        swap(ctrl_, other.ctrl_);
+        swap(slots_, other.slots_);
+        swap(capacity_, other.capacity_);
+        swap(size_, other.size_);
+        swap(deleted_, other.deleted_);
+        swap(hash_, other.hash_);
+        swap(equal_, other.equal_);
+    }
+
+    // ---------------------------------------------------------------------
+    // Lookup
+    // ---------------------------------------------------------------------
+
+    iterator find(const key_type& key) {
+        return iterator{this, index_or_end(key)};
+    }
+
+    const_iterator find(const key_type& key) const {
+        return const_iterator{this, index_or_end(key)};
+    }
+
+    template <class K>
+        requires transparent<Hash, KeyEqual>
+    iterator find(const K& key) {
+        return iterator{this, index_or_end(key)};
+    }
+
+    template <class K>
+        requires transparent<Hash, KeyEqual>
+    const_iterator find(const K& key) const {
+        return const_iterator{this, index_or_end(key)};
+    }
+
+    bool contains(const key_type& key) const {
+        return find_index(key, hash_of(key)) != npos;
+    }
+
+    template <class K>
+        requires transparent<Hash, KeyEqual>
+    bool contains(const K& key) const {
+        return find_index(key, hash_of(key)) != npos;
+    }
+
+    size_type count(const key_type& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template <class K>
+        requires transparent<Hash, KeyEqual>
+    size_type count(const K& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    hasher hash_function() const {
+        return hash_;
+    }
+
+    key_equal key_eq() const {
+        return equal_;
+    }
+
+  protected:
+    /**
+     * @brief Insert `Value(args...)` under `key` unless `key` is already present.
+     *
+     * The value is only constructed when the insertion actually happens.
+     */
+    template <class K, class... Args> std::pair<iterator, bool> emplace_key(const K& key, Args&&... args) {
+        const auto hash = hash_of(key);
+        if (const auto index = find_index(key, hash); index != npos) return {iterator{this, index}, false};
+        return {iterator{this, insert_hashed(hash, std::forward<Args>(args)...)}, true};
+    }
+
+    /// @brief Index of the slot holding `key`, or capacity() if absent.
+    template <class K> size_type index_or_end(const K& key) const {
+        const auto index = find_index(key, hash_of(key));
+        return index == npos ? capacity_ : index;
+    }
+
+    value_type& slot(const size_type index) {
+        return slots_[index];
+    }
+
+  private:
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    ctrl_t* ctrl_       = empty_group();
+    value_type* slots_  = nullptr;
+    size_type capacity_ = 0; ///< 0 or a power of two >= Group::width
+    size_type size_     = 0;
+    size_type deleted_  = 0;
+    [[no_unique_address]] Hash hash_{};
+    [[no_unique_address]] KeyEqual equal_{};
+
+    static ctrl_t h2(const std::size_t hash) {
+        return static_cast<ctrl_t>(hash & 0x7F);
+    }
+
+    static size_type capacity_for(const size_type count) {
+        if (count == 0) return 0;
+        // keep occupancy below 7/8
+        const auto slots = count + count / 7 + 1;
+        return std::max<size_type>(Group::width, std::bit_ceil(slots));
+    }
+
+    size_type growth_limit() const {
+        return capacity_ - capacity_ / 8;
+    }
+
+    template <class K> std::size_t hash_of(const K& key) const {
+        return mix_hash(hash_(key));
+    }
+
+    template <class K> size_type find_index(const K& key, const std::size_t hash) const {
+        const auto mask = capacity_ == 0 ? 0 : capacity_ - 1;
+        auto pos        = (hash >> 7) & mask;
+        size_type step  = 0;
+        while (true) {
+            const Group group{ctrl_ + pos};
+            for (const auto offset : group.match(h2(hash))) {
+                const auto index = (pos + offset) & mask;
+                if (equal_(KeyOf{}(slots_[index]), key)) return index;
+            }
+            if (group.match_empty()) return npos;
+            // triangular probing over groups visits every group once for power-of-two capacities
+            step += Group::width;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    size_type find_non_full(const std::size_t hash) const {
+        const auto mask = capacity_ - 1;
+        auto pos        = (hash >> 7) & mask;
+        size_type step  = 0;
+        while (true) {
+            if (const auto free = Group{ctrl_ + pos}.match_empty_or_deleted()) return (pos + free.lowest()) & mask;
+            step += Group::width;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    template <class... Args> size_type insert_hashed(const std::size_t hash, Args&&... args) {
+        if (size_ + deleted_ + 1 > growth_limit() || capacity_ == 0) {
+            // plenty of tombstones: rehashing in place is enough to reclaim them
+            rehash(capacity_ == 0 ? Group::width : (deleted_ * 2 >= size_ ? capacity_ : capacity_ * 2));
+        }
+        const auto index = find_non_full(hash);
+        std::construct_at(slots_ + index, std::forward<Args>(args)...);
+        if (ctrl_[index] == ctrl_deleted) --deleted_;
+        set_ctrl(index, h2(hash));
+        ++size_;
+        return index;
+    }
+
+    template <class K, class V> void insert_new(const K& key, V&& value) {
+        insert_hashed(hash_of(key), std::forward<V>(value));
+    }
+
+    void set_ctrl(const size_type index, const ctrl_t value) {
+        ctrl_[index] = value;
+        if (index < Group::width) ctrl_[capacity_ + index] = value; // keep the mirrored tail in sync
+    }
+
+    template <class K> size_type erase_key(const K& key) {
+        const auto index = find_index(key, hash_of(key));
+        if (index == npos) return 0;
+        erase_at(index);
+        return 1;
+    }
+
+    void erase_at(const size_type index) {
+        std::destroy_at(slots_ + index);
+        set_ctrl(index, ctrl_deleted);
+        --size_;
+        ++deleted_;
+    }
+
+    size_type next_full(size_type index) const {
+        while (index < capacity_ && ctrl_[index] < 0) {
+            ++index;
+        }
+        return index;
+    }
+
+    void rehash(const size_type new_capacity) {
+        auto* const old_ctrl    = ctrl_;
+        auto* const old_slots   = slots_;
+        const auto old_capacity = capacity_;
+
+        ctrl_     = std::allocator<ctrl_t>{}.allocate(new_capacity + Group::width);
+        slots_    = std::allocator<value_type>{}.allocate(new_capacity);
+        capacity_ = new_capacity;
+        deleted_  = 0;
+        std::fill_n(ctrl_, new_capacity + Group::width, ctrl_empty);
+
+        for (size_type i = 0; i < old_capacity; ++i) {
+            if (old_ctrl[i] < 0) continue;
+            const auto hash  = hash_of(KeyOf{}(old_slots[i]));
+            const auto index = find_non_full(hash);
+            std::construct_at(slots_ + index, std::move(old_slots[i]));
+            std::destroy_at(old_slots + i);
+            set_ctrl(index, h2(hash));
+        }
+
+        if (old_capacity > 0) {
+            std::allocator<ctrl_t>{}.deallocate(old_ctrl, old_capacity + Group::width);
+            std::allocator<value_type>{}.deallocate(old_slots, old_capacity);
+        }
+    }
+
+    void destroy_all() {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (size_type i = 0; i < capacity_; ++i) {
+                if (ctrl_[i] >= 0) std::destroy_at(slots_ + i);
+            }
+        }
+    }
+
+    void deallocate() {
+        if (capacity_ == 0) return;
+        std::allocator<ctrl_t>{}.deallocate(ctrl_, capacity_ + Group::width);
+        std::allocator<value_type>{}.deallocate(slots_, capacity_);
+        ctrl_     = empty_group();
+        slots_    = nullptr;
+        capacity_ = 0;
+    }
+
+    template <bool is_const> class BasicIterator {
+        friend class FlatTable;
+        template <bool> friend class BasicIterator;
+        using table_type = std::conditional_t<is_const, const FlatTable, FlatTable>;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = typename FlatTable::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<is_const, const value_type*, value_type*>;
+        using reference         = std::conditional_t<is_const, const value_type&, value_type&>;
+
+        BasicIterator() = default;
+
+        // iterator -> const_iterator
+        template <bool other_const>
+            requires(is_const && !other_const)
+        BasicIterator(const BasicIterator<other_const>& other) : table_(other.table_), index_(other.index_) {}
+
+        reference operator*() const {
+            return table_->slots_[index_];
+        }
+
+        pointer operator->() const {
+            return table_->slots_ + index_;
+        }
+
+        BasicIterator& operator++() {
+            index_ = table_->next_full(index_ + 1);
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+            return a.index_ == b.index_;
+        }
+
+      private:
+        table_type* table_ = nullptr;
+        size_type index_   = 0;
+
+        BasicIterator(table_type* table, const size_type index) : table_(table), index_(index) {}
+    };
+};
+
+/// Key extractors for the two table flavours.
+struct MapKeyOf {
+    template <class Pair> const auto& operator()(const Pair& value) const {
+        return value.first;
+    }
+};
+
+struct SetKeyOf {
+    template <class T> const T& operator()(const T& value) const {
+        return value;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Flat (open-addressing) hash map with SIMD group probing.
+ *
+ * Drop-in for the common subset of `std::unordered_map` on hot paths such as
+ * per-call-site state, counters or named lookups. Elements live inline in a
+ * single array, so iteration and lookups are cache friendly; the price is that
+ * references and iterators are invalidated by any insertion that rehashes.
+ *
+ * For `std::string` keys the default hasher/comparator are transparent, so
+ * `find()`, `contains()`, `count()` and `erase()` accept `std::string_view`
+ * and `const char*` directly:
+ *
+ *   FlatHashMap<std::string, int> counters;
+ *   counters["flush"] += 1;
+ *   if (auto it = counters.find(std::string_view{"flush"}); it != counters.end()) { ... }
+ */
+template <class Key, class T, class Hash = detail::default_hash_t<Key>, class KeyEqual = detail::default_equal_t<Key>>
+class FlatHashMap : public detail::FlatTable<std::pair<const Key, T>, Key, detail::MapKeyOf, Hash, KeyEqual> {
+    using base = detail::FlatTable<std::pair<const Key, T>, Key, detail::MapKeyOf, Hash, KeyEqual>;
+
+  public:
+    using mapped_type = T;
+    using typename base::iterator;
+    using typename base::key_type;
+    using typename base::value_type;
+
+    using base::base;
+
+    FlatHashMap() = default;
+
+    FlatHashMap(const std::initializer_list<value_type> init) {
+        this->reserve(init.size());
+        for (const auto& value : init) {
+            insert(value);
+        }
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return this->emplace_key(value.first, value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return this->emplace_key(value.first, std::move(value));
+    }
+
+    template <class... Args> std::pair<iterator, bool> emplace(Args&&... args) {
+        value_type value(std::forward<Args>(args)...);
+        return this->emplace_key(value.first, std::move(value));
+    }
+
+    /// @brief Construct the mapped value in place only if `key` is absent.
+    template <class... Args> std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        return this->emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                 std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    /// @brief Heterogeneous try_emplace: `key_type` is built from `key` only on insertion.
+    template <class K, class... Args>
+        requires detail::transparent<Hash, KeyEqual> && std::constructible_from<Key, const K&>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+        return this->emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                 std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <class M> std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& value) {
+        auto result = try_emplace(key, std::forward<M>(value));
+        if (!result.second) result.first->second = std::forward<M>(value);
+        return result;
+    }
+
+    T& operator[](const key_type& key) {
+        return try_emplace(key).first->second;
+    }
+
+    template <class K>
+        requires detail::transparent<Hash, KeyEqual> && std::constructible_from<Key, const K&>
+    T& operator[](const K& key) {
+        return try_emplace(key).first->second;
+    }
+
+    T& at(const key_type& key) {
+        return checked(this->index_or_end(key));
+    }
+
+    const T& at(const key_type& key) const {
+        return const_cast<FlatHashMap*>(this)->at(key);
+    }
+
+    template <class K>
+        requires detail::transparent<Hash, KeyEqual>
+    T& at(const K& key) {
+        return checked(this->index_or_end(key));
+    }
+
+  private:
+    T& checked(const std::size_t index) {
+        if (index == this->capacity()) throw std::out_of_range("FlatHashMap::at: key not found");
+        return this->slot(index).second;
+    }
+};
+
+/**
+ * @brief Flat (open-addressing) hash set with SIMD group probing.
+ *
+ * Same storage scheme and invalidation rules as FlatHashMap.
+ */
+template <class Key, class Hash = detail::default_hash_t<Key>, class KeyEqual = detail::default_equal_t<Key>>
+class FlatHashSet : public detail::FlatTable<Key, Key, detail::SetKeyOf, Hash, KeyEqual> {
+    using base = detail::FlatTable<Key, Key, detail::SetKeyOf, Hash, KeyEqual>;
+
+  public:
+    using typename base::iterator;
+    using typename base::value_type;
+
+    using base::base;
+
+    FlatHashSet() = default;
+
+    FlatHashSet(const std::initializer_list<value_type> init) {
+        this->reserve(init.size());
+        for (const auto& value : init) {
+            insert(value);
+        }
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return this->emplace_key(value, value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return this->emplace_key(value, std::move(value));
+    }
+
+    template <class... Args> std::pair<iterator, bool> emplace(Args&&... args) {
+        value_type value(std::forward<Args>(args)...);
+        return this->emplace_key(value, std::move(value));
+    }
+
+    /// @brief Heterogeneous insert: `Key` is built from `key` only on insertion.
+    template <class K>
+        requires detail::transparent<Hash, KeyEqual> && std::constructible_from<Key, const K&>
+    std::pair<iterator, bool> insert(const K& key) {
+        return this->emplace_key(key, key);
+    }
+};
+
+} // namespace project_template::utils::container
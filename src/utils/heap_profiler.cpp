@@ -0,0 +1,397 @@
+#include "heap_profiler.hpp"
+
+#if defined(PROJECT_TEMPLATE_HEAP_PROFILER)
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace project_template::utils::profiling {
+
+#if defined(PROJECT_TEMPLATE_HEAP_PROFILER)
+
+namespace {
+
+/// Bytes between two looks at whether sampling was switched on, while it is off.
+constexpr std::int64_t idle_countdown = 64 * 1024;
+
+struct StackEntry {
+    std::uint64_t hash = 0; ///< 0 = free slot
+    std::uint32_t depth = 0;
+    void* frames[HeapProfiler::max_frames];
+    std::uint64_t samples = 0;
+    double bytes          = 0;
+};
+
+// fixed table in static storage: recording a sample must not allocate
+constexpr std::size_t table_size = 4096; // power of two
+constexpr std::size_t max_probe  = 64;
+StackEntry table[table_size];
+std::mutex table_mutex;
+std::uint64_t table_stacks = 0; ///< guarded by table_mutex
+
+std::atomic<std::size_t> interval{0};
+std::atomic<std::uint64_t> total_samples{0};
+std::atomic<std::uint64_t> total_bytes{0};
+std::atomic<std::uint64_t> lost_samples{0};
+
+struct ThreadState {
+    std::int64_t until_sample = idle_countdown;
+    std::uint64_t rng         = 0;
+    bool busy                 = false; ///< sampling or dumping on this thread: allocations are not sampled
+};
+constinit thread_local ThreadState thread_state{};
+
+/// Exponentially distributed countdown with mean `mean`: sampling becomes a Poisson process over the bytes.
+std::int64_t draw_countdown(ThreadState& state, const std::size_t mean) {
+    if (state.rng == 0) state.rng = reinterpret_cast<std::uintptr_t>(&state) | 1;
+    state.rng ^= state.rng << 13;
+    state.rng ^= state.rng >> 7;
+    state.rng ^= state.rng << 17;
+    const double uniform = (static_cast<double>(state.rng >> 11) + 0.5) / 9007199254740992.0; // (0, 1)
+    return static_cast<std::int64_t>(-std::log(uniform) * static_cast<double>(mean)) + 1;
+}
+
+void record(const double weight, const void* const caller) {
+    void* frames[HeapProfiler::max_frames + 8];
+    const int captured = ::backtrace(frames, static_cast<int>(std::size(frames)));
+
+    // drop the profiler's own frames: keep everything from the caller of operator new
+    int first = 0;
+    for (int i = 0; i < std::min(captured, 8); ++i) {
+        if (frames[i] == caller) {
+            first = i;
+            break;
+        }
+    }
+    const auto depth = static_cast<std::uint32_t>(
+        std::min<int>(captured - first, static_cast<int>(HeapProfiler::max_frames)));
+
+    std::uint64_t hash = 1469598103934665603ULL; // FNV-1a over the frame addresses
+    for (std::uint32_t i = 0; i < depth; ++i) {
+        hash = (hash ^ reinterpret_cast<std::uintptr_t>(frames[first + static_cast<int>(i)])) * 1099511628211ULL;
+    }
+    hash |= 1;
+
+    total_samples.fetch_add(1, std::memory_order_relaxed);
+    total_bytes.fetch_add(static_cast<std::uint64_t>(weight), std::memory_order_relaxed);
+
+    const std::lock_guard lock{table_mutex};
+    for (std::size_t probe = 0; probe < max_probe; ++probe) {
+        auto& entry = table[(hash + probe) & (table_size - 1)];
+        if (entry.hash == 0) {
+            entry.hash  = hash;
+            entry.depth = depth;
+            std::copy_n(frames + first, depth, entry.frames);
+            ++table_stacks;
+        } else if (entry.hash != hash || entry.depth != depth ||
+                   !std::equal(entry.frames, entry.frames + depth, frames + first)) {
+            continue;
+        }
+        ++entry.samples;
+        entry.bytes += weight;
+        return;
+    }
+    lost_samples.fetch_add(1, std::memory_order_relaxed);
+}
+
+[[gnu::noinline]] void sample(const std::size_t size, const void* const caller) {
+    auto& state     = thread_state;
+    const auto mean = interval.load(std::memory_order_relaxed);
+    if (mean == 0 || state.busy) {
+        state.until_sample = mean == 0 ? idle_countdown : draw_countdown(state, mean);
+        return;
+    }
+    state.busy = true;
+    // an allocation of `size` bytes is sampled with probability 1 - exp(-size / mean); weigh it by the inverse
+    const double probability = -std::expm1(-static_cast<double>(size) / static_cast<double>(mean));
+    record(probability > 0 ? static_cast<double>(size) / probability : static_cast<double>(mean), caller);
+    state.until_sample = draw_countdown(state, mean);
+    state.busy         = false;
+}
+
+[[gnu::always_inline]] inline void* allocate(std::size_t size, const std::size_t alignment, const void* const caller) {
+    if (size == 0) size = 1;
+    for (;;) {
+        void* const ptr = alignment <= alignof(std::max_align_t)
+                              ? std::malloc(size)
+                              : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+        if (ptr != nullptr) [[likely]] {
+            auto& state = thread_state;
+            if ((state.until_sample -= static_cast<std::int64_t>(size)) < 0) [[unlikely]] {
+                sample(size, caller);
+            }
+            return ptr;
+        }
+        const auto handler = std::get_new_handler();
+        if (handler == nullptr) throw std::bad_alloc{};
+        handler();
+    }
+}
+
+[[gnu::always_inline]] inline void* allocate_nothrow(const std::size_t size, const std::size_t alignment,
+                                                     const void* const caller) noexcept {
+    try {
+        return allocate(size, alignment, caller);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+/// Demangled function name without its parameter list, or `binary+0xoffset` if the frame has no symbol.
+std::string frame_name(const std::string_view symbol) {
+    // backtrace_symbols: "path(mangled+0xoff) [0xaddr]" or "path(+0xoff) [0xaddr]"
+    const auto open  = symbol.find('(');
+    const auto plus  = symbol.find('+', open);
+    const auto close = symbol.find(')', open);
+    if (open == std::string_view::npos || close == std::string_view::npos) return std::string(symbol);
+
+    const auto mangled = symbol.substr(open + 1, std::min(plus, close) - open - 1);
+    if (mangled.empty()) {
+        const auto path = symbol.substr(0, open);
+        const auto base = path.substr(path.find_last_of('/') + 1);
+        return std::string(base) + std::string(symbol.substr(plus, close - plus));
+    }
+    int status       = 0;
+    char* demangled  = abi::__cxa_demangle(std::string(mangled).c_str(), nullptr, nullptr, &status);
+    std::string name = status == 0 && demangled != nullptr ? demangled : std::string(mangled);
+    std::free(demangled);
+
+    // cut the parameter list: the last balanced "(...)" (keeps "operator()")
+    auto end = name.size();
+    if (name.ends_with(" const")) end -= 6;
+    if (end > 0 && name[end - 1] == ')') {
+        int level = 0;
+        for (auto i = end; i-- > 0;) {
+            if (name[i] == ')') ++level;
+            if (name[i] == '(' && --level == 0) {
+                name.resize(i);
+                break;
+            }
+        }
+    }
+    std::replace(name.begin(), name.end(), ';', ':'); // ';' separates frames
+    return name;
+}
+
+int dump_pipe[2] = {-1, -1};
+
+extern "C" void request_dump(int /*signal*/) {
+    const char byte = 1;
+    [[maybe_unused]] const auto written = ::write(dump_pipe[1], &byte, 1);
+}
+
+// PROJECT_TEMPLATE_HEAP_PROFILE=<mean bytes> starts sampling with the process
+const bool started_from_environment = [] {
+    const char* value = std::getenv("PROJECT_TEMPLATE_HEAP_PROFILE");
+    if (value == nullptr) return false;
+    const auto mean = std::strtoull(value, nullptr, 10);
+    if (mean > 0) HeapProfiler::start(mean);
+    return mean > 0;
+}();
+
+} // namespace
+
+bool HeapProfiler::compiled_in() noexcept {
+    return true;
+}
+
+void HeapProfiler::start(const std::size_t mean_bytes) {
+    auto& state = thread_state;
+    state.busy  = true;
+    void* warm_up[1];
+    ::backtrace(warm_up, 1); // the first call loads the unwinder (and allocates); do it here, not while sampling
+    {
+        const std::lock_guard lock{table_mutex};
+        std::fill(std::begin(table), std::end(table), StackEntry{});
+        table_stacks = 0;
+    }
+    total_samples.store(0, std::memory_order_relaxed);
+    total_bytes.store(0, std::memory_order_relaxed);
+    lost_samples.store(0, std::memory_order_relaxed);
+    interval.store(std::max<std::size_t>(mean_bytes, 1), std::memory_order_relaxed);
+    state.until_sample = draw_countdown(state, std::max<std::size_t>(mean_bytes, 1));
+    state.busy         = false;
+}
+
+void HeapProfiler::stop() noexcept {
+    interval.store(0, std::memory_order_relaxed);
+}
+
+std::size_t HeapProfiler::sample_interval() noexcept {
+    return interval.load(std::memory_order_relaxed);
+}
+
+HeapProfiler::Stats HeapProfiler::stats() noexcept {
+    Stats stats;
+    stats.samples         = total_samples.load(std::memory_order_relaxed);
+    stats.estimated_bytes = total_bytes.load(std::memory_order_relaxed);
+    stats.lost_samples    = lost_samples.load(std::memory_order_relaxed);
+    const std::lock_guard lock{table_mutex};
+    stats.stacks = table_stacks;
+    return stats;
+}
+
+void HeapProfiler::write_folded(std::ostream& out) {
+    auto& state       = thread_state;
+    const bool nested = std::exchange(state.busy, true); // our own allocations below are not sampled
+
+    std::vector<StackEntry> entries;
+    entries.reserve(table_size);
+    {
+        const std::lock_guard lock{table_mutex};
+        std::copy_if(std::begin(table), std::end(table), std::back_inserter(entries),
+                     [](const StackEntry& entry) { return entry.hash != 0; });
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.bytes > b.bytes; });
+
+    for (const auto& entry : entries) {
+        char** symbols = ::backtrace_symbols(entry.frames, static_cast<int>(entry.depth));
+        std::string line;
+        for (auto i = entry.depth; i-- > 0;) { // root first
+            if (!line.empty()) line += ';';
+            line += symbols != nullptr ? frame_name(symbols[i]) : "?";
+        }
+        std::free(symbols);
+        out << line << ' ' << static_cast<std::uint64_t>(std::llround(entry.bytes)) << '\n';
+    }
+    state.busy = nested;
+}
+
+void HeapProfiler::dump_on_signal(const int signal, const std::string& path) {
+    if (dump_pipe[0] >= 0) throw std::logic_error("HeapProfiler::dump_on_signal() may only be called once");
+    if (::pipe2(dump_pipe, O_CLOEXEC) != 0) throw std::runtime_error("HeapProfiler: cannot create pipe");
+
+    std::thread{[path] {
+        for (char byte = 0; ::read(dump_pipe[0], &byte, 1) > 0;) {
+            const auto temporary = path + ".tmp";
+            {
+                std::ofstream out{temporary, std::ios::trunc};
+                write_folded(out);
+            }
+            std::rename(temporary.c_str(), path.c_str());
+        }
+    }}.detach();
+
+    struct sigaction action{};
+    action.sa_handler = request_dump;
+    action.sa_flags   = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(signal, &action, nullptr);
+}
+
+#else // !PROJECT_TEMPLATE_HEAP_PROFILER
+
+bool HeapProfiler::compiled_in() noexcept {
+    return false;
+}
+
+void HeapProfiler::start(std::size_t /*mean_bytes*/) {}
+
+void HeapProfiler::stop() noexcept {}
+
+std::size_t HeapProfiler::sample_interval() noexcept {
+    return 0;
+}
+
+HeapProfiler::Stats HeapProfiler::stats() noexcept {
+    return {};
+}
+
+void HeapProfiler::write_folded(std::ostream& /*out*/) {}
+
+void HeapProfiler::dump_on_signal(int /*signal*/, const std::string& /*path*/) {}
+
+#endif
+
+} // namespace project_template::utils::profiling
+
+#if defined(PROJECT_TEMPLATE_HEAP_PROFILER)
+
+// ---------------------------------------------------------------------------
+// Replaced global allocation functions (every form forwards to malloc/free)
+// ---------------------------------------------------------------------------
+
+namespace profiling = project_template::utils::profiling;
+
+void* operator new(const std::size_t size) {
+    return profiling::allocate(size, 0, __builtin_return_address(0));
+}
+void* operator new[](const std::size_t size) {
+    return profiling::allocate(size, 0, __builtin_return_address(0));
+}
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+    return profiling::allocate(size, static_cast<std::size_t>(alignment), __builtin_return_address(0));
+}
+void* operator new[](const std::size_t size, const std::align_val_t alignment) {
+    return profiling::allocate(size, static_cast<std::size_t>(alignment), __builtin_return_address(0));
+}
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept {
+    return profiling::allocate_nothrow(size, 0, __builtin_return_address(0));
+}
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept {
+    return profiling::allocate_nothrow(size, 0, __builtin_return_address(0));
+}
+void* operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return profiling::allocate_nothrow(size, static_cast<std::size_t>(alignment), __builtin_return_address(0));
+}
+void* operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return profiling::allocate_nothrow(size, static_cast<std::size_t>(alignment), __builtin_return_address(0));
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+#endif
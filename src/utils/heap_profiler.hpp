@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace project_template::utils::profiling {
+
+/**
+ * @brief Sampled allocation profile: which call stacks allocate how many bytes.
+ *
+ * With the CMake option `ENABLE_HEAP_PROFILER`, utils_lib replaces the
+ * global `operator new` / `operator delete`. Every thread counts down the
+ * bytes it allocates. Once the countdown runs out, the allocation is
+ * sampled: its call stack is recorded together with an estimate of the
+ * bytes it stands for, and a new countdown is drawn at random with mean
+ * `sample_interval()`. So about one allocation per `sample_interval()`
+ * bytes is sampled, large allocations almost always and small ones rarely,
+ * in proportion to their size. The estimates add up to the true
+ * allocation volume per stack on average. The unsampled path is one
+ * thread-local subtraction and a branch; `operator delete` is unchanged.
+ *
+ * The profile counts allocations since `start()` (what pprof calls
+ * `alloc_space`), not the memory still in use. It is written as folded
+ * stacks, one line per call stack from the root to the allocating
+ * function, followed by the estimated bytes:
+ *
+ *     main;run_service;WorkerPool::run_;std::__cxx11::basic_string<...>::_M_create 1048576
+ *
+ * That is the input format of flamegraph.pl, speedscope, inferno and
+ * `pprof`-style folded-stack viewers. Frames without a dynamic symbol
+ * (static functions, or executables linked without `-rdynamic`, which the
+ * CMake option adds) appear as `binary+0xoffset`, for `addr2line`.
+ *
+ * Sampling is off until `start()` is called, or until the environment
+ * variable `PROJECT_TEMPLATE_HEAP_PROFILE=<mean bytes>` is set at startup.
+ * Without the CMake option every function is a no-op and `compiled_in()`
+ * is false. Only C++ allocations are seen: plain `malloc()` calls are not
+ * interposed.
+ */
+class HeapProfiler {
+  public:
+    HeapProfiler() = delete;
+
+    static constexpr std::size_t default_sample_interval = 512 * 1024;
+    static constexpr std::size_t max_frames              = 32; ///< deeper stacks are truncated at the root side
+
+    struct Stats {
+        std::uint64_t samples         = 0; ///< sampled allocations
+        std::uint64_t estimated_bytes = 0; ///< bytes they stand for
+        std::uint64_t stacks          = 0; ///< distinct call stacks
+        std::uint64_t lost_samples    = 0; ///< samples not recorded because the stack table was full
+    };
+
+    /// @brief True if utils_lib was built with `ENABLE_HEAP_PROFILER`.
+    static bool compiled_in() noexcept;
+
+    /// @brief Clear the profile and sample about every `mean_bytes` allocated bytes from now on.
+    static void start(std::size_t mean_bytes = default_sample_interval);
+
+    /// @brief Stop sampling; the profile is kept until the next `start()`.
+    static void stop() noexcept;
+
+    /// @brief Mean bytes between samples, 0 while not sampling.
+    static std::size_t sample_interval() noexcept;
+
+    static Stats stats() noexcept;
+
+    /// @brief Write the profile as folded stacks (heaviest first). Allocates; not for signal handlers.
+    static void write_folded(std::ostream& out);
+
+    /**
+     * @brief Write the profile to `path` whenever the process receives `signal` (e.g. `SIGUSR2`).
+     *
+     * The handler only wakes a background thread, which symbolizes the
+     * stacks and replaces `path` (temporary file + rename). Call once.
+     */
+    static void dump_on_signal(int signal, const std::string& path);
+};
+
+} // namespace project_template::utils::profiling
@@ -0,0 +1,250 @@
+#include "indexed_file_sink.hpp"
+
+#include "log_frame.hpp"
+
+#include <spdlog/details/os.h>
+#include <spdlog/sinks/rotating_file_sink.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+namespace project_template::utils::log {
+
+namespace {
+
+using spdlog::sinks::rotating_file_sink_mt;
+
+constexpr std::uint32_t all_levels = 0xFFFFFFFFU;
+
+std::int64_t to_ns(const std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+/// Last modification time of `path` in ns since epoch (upper bound for every record in the file).
+std::int64_t mtime_ns(const std::filesystem::path& path) {
+    std::error_code ec;
+    const auto ftime = std::filesystem::last_write_time(path, ec);
+    if (ec) return to_ns(std::chrono::system_clock::now());
+    return to_ns(std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+        std::chrono::file_clock::to_sys(ftime)));
+}
+
+/// Whole, valid entries of an existing index, or nothing if it is missing or foreign.
+std::vector<LogIndexEntry> read_entries(const std::filesystem::path& idx_path, const std::uint32_t interval) {
+    std::ifstream in(idx_path, std::ios::binary);
+    LogIndexHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != log_index_magic ||
+        header.version != log_index_version || header.interval != interval) {
+        return {};
+    }
+    std::vector<LogIndexEntry> entries;
+    LogIndexEntry entry;
+    while (in.read(reinterpret_cast<char*>(&entry), sizeof(entry))) {
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+/// True if the existing data file starts with a record frame.
+bool file_is_framed(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::array<char, log_frame_magic.size()> head{};
+    return in.read(head.data(), head.size()) && head == log_frame_magic;
+}
+
+template <class T> void append_bytes(spdlog::memory_buf_t& buf, const T& value) {
+    const auto* begin = reinterpret_cast<const char*>(&value);
+    buf.append(begin, begin + sizeof(T));
+}
+
+} // namespace
+
+IndexedRotatingFileSink::IndexedRotatingFileSink(spdlog::filename_t base_filename, const std::size_t max_size,
+                                                 const std::size_t max_files, const std::uint32_t index_interval,
+                                                 const bool framed)
+    : base_filename_(std::move(base_filename)), max_size_(max_size), max_files_(max_files), interval_(index_interval),
+      framed_(framed) {
+    if (max_size == 0) {
+        spdlog::throw_spdlog_ex("indexed rotating sink constructor: max_size arg cannot be zero");
+    }
+    if (max_files > 200000) {
+        spdlog::throw_spdlog_ex("indexed rotating sink constructor: max_files arg cannot exceed 200000");
+    }
+    if (index_interval == 0) {
+        spdlog::throw_spdlog_ex("indexed rotating sink constructor: index_interval arg cannot be zero");
+    }
+    data_file_.open(rotating_file_sink_mt::calc_filename(base_filename_, 0));
+    current_size_ = data_file_.size(); // expensive. called only once
+    open_index_();
+
+    // one format per file: move a file written with the other setting out of the way
+    if (current_size_ > 0 && file_is_framed(data_file_.filename()) != framed_) {
+        rotate_();
+    }
+}
+
+IndexedRotatingFileSink::~IndexedRotatingFileSink() {
+    try {
+        const std::lock_guard lock(mutex_);
+        seal_block_();
+        data_file_.flush();
+        index_file_.flush();
+    } catch (...) {
+        // never throw from a destructor; the unsealed block is re-indexed on the next open
+    }
+}
+
+spdlog::filename_t IndexedRotatingFileSink::filename() {
+    const std::lock_guard lock(mutex_);
+    return data_file_.filename();
+}
+
+void IndexedRotatingFileSink::sink_it_(const spdlog::details::log_msg& msg) {
+    spdlog::memory_buf_t formatted;
+    if (framed_) {
+        // format straight behind the header; sealing only fills in the header
+        formatted.resize(sizeof(LogFrameHeader));
+        formatter_->format(msg, formatted);
+        seal_frame(formatted, 0);
+    } else {
+        formatter_->format(msg, formatted);
+    }
+    auto new_size = current_size_ + formatted.size();
+
+    // same rotation rule as spdlog's rotating_file_sink
+    if (new_size > max_size_) {
+        data_file_.flush();
+        if (data_file_.size() > 0) {
+            rotate_();
+            new_size = formatted.size();
+        }
+    }
+
+    const auto ts = to_ns(msg.time);
+    if (block_.records == 0) {
+        block_ = LogIndexEntry{.min_ts_ns = ts, .offset = current_size_};
+    }
+    running_max_ns_ = std::max(running_max_ns_, ts);
+    block_.min_ts_ns = std::min(block_.min_ts_ns, ts);
+    block_.length += formatted.size();
+    block_.records += 1;
+    block_.level_mask |= 1U << static_cast<unsigned>(msg.level);
+
+    data_file_.write(formatted);
+    current_size_ = new_size;
+
+    if (block_.records == interval_) {
+        seal_block_();
+    }
+}
+
+void IndexedRotatingFileSink::flush_() {
+    data_file_.flush();
+    index_file_.flush();
+}
+
+void IndexedRotatingFileSink::open_index_() {
+    const std::filesystem::path data_path = data_file_.filename();
+    const auto idx_path                   = index_path_for(data_path);
+    auto entries                          = read_entries(idx_path, interval_);
+
+    // drop entries that point past the data (index flushed ahead of a lost data write)
+    while (!entries.empty() && entries.back().offset + entries.back().length > current_size_) {
+        entries.pop_back();
+    }
+
+    // rewrite the index so a torn trailing entry or a foreign file does not survive
+    index_file_.open(idx_path, true);
+    reset_index_();
+    for (const auto& e : entries) {
+        append_entry_(e);
+    }
+    running_max_ns_ = entries.empty() ? std::numeric_limits<std::int64_t>::min() : entries.back().max_ts_ns;
+
+    // bytes nobody indexed (previous run crashed, or the file predates the index):
+    // cover them with one coarse block bounded by the file's mtime
+    const std::uint64_t indexed_end = entries.empty() ? 0 : entries.back().offset + entries.back().length;
+    if (current_size_ > indexed_end) {
+        const auto newest = std::max(running_max_ns_, mtime_ns(data_path));
+        append_entry_(LogIndexEntry{.min_ts_ns  = running_max_ns_,
+                                    .max_ts_ns  = newest,
+                                    .offset     = indexed_end,
+                                    .length     = current_size_ - indexed_end,
+                                    .records    = 0,
+                                    .level_mask = all_levels});
+        running_max_ns_ = newest;
+    }
+    block_ = {};
+}
+
+void IndexedRotatingFileSink::reset_index_() {
+    spdlog::memory_buf_t buf;
+    append_bytes(buf, LogIndexHeader{.interval = interval_});
+    index_file_.write(buf);
+}
+
+void IndexedRotatingFileSink::append_entry_(const LogIndexEntry& entry) {
+    spdlog::memory_buf_t buf;
+    append_bytes(buf, entry);
+    index_file_.write(buf);
+}
+
+void IndexedRotatingFileSink::seal_block_() {
+    if (block_.records == 0) return;
+    block_.max_ts_ns = running_max_ns_;
+    append_entry_(block_);
+    block_ = {};
+}
+
+// Rotate data files and their indexes together:
+// log.txt     -> log.1.txt,     log.txt.idx     -> log.1.txt.idx
+// log.1.txt   -> log.2.txt,     log.1.txt.idx   -> log.2.txt.idx
+// log.<max>.txt -> delete
+void IndexedRotatingFileSink::rotate_() {
+    using spdlog::details::os::filename_to_str;
+
+    seal_block_();
+    data_file_.close();
+    index_file_.close();
+
+    for (auto i = max_files_; i > 0; --i) {
+        const std::filesystem::path src = rotating_file_sink_mt::calc_filename(base_filename_, i - 1);
+        if (!std::filesystem::exists(src)) {
+            continue;
+        }
+        const std::filesystem::path target = rotating_file_sink_mt::calc_filename(base_filename_, i);
+
+        std::error_code ec;
+        std::filesystem::rename(src, target, ec);
+        if (ec) {
+            data_file_.reopen(true); // truncate anyway to keep the file within its limit
+            index_file_.reopen(true);
+            reset_index_();
+            current_size_   = 0;
+            block_          = {};
+            running_max_ns_ = std::numeric_limits<std::int64_t>::min();
+            spdlog::throw_spdlog_ex("indexed rotating sink: failed renaming " + filename_to_str(src.native()) +
+                                        " to " + filename_to_str(target.native()),
+                                    ec.value());
+        }
+        // the index follows its data file; a stale one must not describe the renamed file
+        std::filesystem::remove(index_path_for(target), ec);
+        std::filesystem::rename(index_path_for(src), index_path_for(target), ec);
+    }
+
+    data_file_.reopen(true);
+    index_file_.reopen(true);
+    reset_index_();
+    current_size_   = 0;
+    block_          = {};
+    running_max_ns_ = std::numeric_limits<std::int64_t>::min();
+}
+
+} // namespace project_template::utils::log
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "log_index.hpp"
+
+#include <spdlog/details/file_helper.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace project_template::utils::log {
+
+/**
+ * @brief Rotating file sink that maintains a sparse time/level index per file.
+ *
+ * Writes and rotates exactly like `spdlog::sinks::rotating_file_sink_mt`
+ * (same file naming, same size limit), and additionally appends one
+ * `LogIndexEntry` to `<file>.idx` for every `index_interval` records. The
+ * index costs one 40-byte write per block on the logging path, and lets
+ * `LogSegment::query()` answer "what happened between t1 and t2" by binary
+ * search instead of a full scan (see the `logquery` tool).
+ *
+ * Blocks still being filled are sealed on rotation and on destruction, but
+ * not on `flush()`, so the index only ever grows by whole blocks. Records of
+ * a block that was never sealed (e.g. after a crash) are indexed as one
+ * coarse block the next time the file is opened.
+ *
+ * With `framed`, every record is written as a `LogFrameHeader` (length and
+ * CRC-32C) followed by the formatted text, so readers can detect a torn or
+ * corrupted record and resynchronize on the next valid one; index offsets
+ * then refer to frame boundaries. An existing file written with the other
+ * setting is rotated away on open, so each file has a single format.
+ */
+class IndexedRotatingFileSink final : public spdlog::sinks::base_sink<std::mutex> {
+  public:
+    static constexpr std::uint32_t default_index_interval = 64;
+
+    IndexedRotatingFileSink(spdlog::filename_t base_filename, std::size_t max_size, std::size_t max_files,
+                            std::uint32_t index_interval = default_index_interval, bool framed = false);
+    ~IndexedRotatingFileSink() override;
+
+    IndexedRotatingFileSink(const IndexedRotatingFileSink&)            = delete;
+    IndexedRotatingFileSink& operator=(const IndexedRotatingFileSink&) = delete;
+
+    /// @brief Name of the file currently written to.
+    spdlog::filename_t filename();
+
+  protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override;
+
+  private:
+    /// @brief Open the index next to the current data file, repairing it if needed.
+    void open_index_();
+    /// @brief Start a fresh index file (header only).
+    void reset_index_();
+    void append_entry_(const LogIndexEntry& entry);
+    /// @brief Write the block being filled (if any) to the index.
+    void seal_block_();
+    void rotate_();
+
+    spdlog::filename_t base_filename_;
+    std::size_t max_size_;
+    std::size_t max_files_;
+    std::uint32_t interval_;
+    bool framed_;
+
+    spdlog::details::file_helper data_file_;
+    spdlog::details::file_helper index_file_;
+    std::size_t current_size_ = 0;
+
+    LogIndexEntry block_{};           ///< block being filled (records == 0 → none)
+    std::int64_t running_max_ns_ = 0; ///< newest timestamp seen in the current file
+};
+
+} // namespace project_template::utils::log
@@ -0,0 +1,51 @@
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace project_template::utils::metrics {
+
+std::size_t LatencyHistogram::bucket_of(const std::uint64_t value) noexcept {
+    if (value < 2 * sub_bucket_count) return static_cast<std::size_t>(value);
+    // shift the value into [32, 64); the shift picks the power of two, the rest the sub-bucket
+    const auto shift = static_cast<unsigned>(std::bit_width(value)) - (sub_bucket_bits + 1);
+    return shift * sub_bucket_count + static_cast<std::size_t>(value >> shift);
+}
+
+std::uint64_t LatencyHistogram::bucket_upper_bound(const std::size_t index) noexcept {
+    if (index < 2 * sub_bucket_count) return index;
+    const auto shift    = static_cast<unsigned>(index / sub_bucket_count) - 1;
+    const auto mantissa = static_cast<std::uint64_t>(index - shift * sub_bucket_count);
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) noexcept {
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::reset() noexcept {
+    *this = LatencyHistogram{};
+}
+
+std::uint64_t LatencyHistogram::percentile(const double p) const noexcept {
+    if (count_ == 0) return 0;
+    const double clamped = std::clamp(p, 0.0, 100.0);
+    // rank of the value to find, 1-based: p = 0 is the minimum, p = 100 the maximum
+    const auto rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(count_))));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        seen += counts_[i];
+        if (seen >= rank) return std::clamp(bucket_upper_bound(i), min_, max_);
+    }
+    return max_;
+}
+
+} // namespace project_template::utils::metrics
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace project_template::utils::metrics {
+
+/**
+ * @brief Log-linear histogram of durations (or any non-negative integers) with bounded relative error.
+ *
+ * Values below 64 are counted exactly. Above that, every power of two is
+ * split into 32 equal buckets, so a percentile is off by at most 1/32
+ * (~3%) of its value. That holds over the whole `std::uint64_t` range, in
+ * a fixed ~15 KiB of counters and without allocating while recording.
+ *
+ * The histogram is not synchronized: give every thread its own and
+ * `merge()` them afterwards.
+ *
+ *   LatencyHistogram latency;
+ *   for (...) latency.record(elapsed_ns);
+ *   total.merge(latency);
+ *   total.percentile(99.9);
+ */
+class LatencyHistogram {
+  public:
+    static constexpr unsigned sub_bucket_bits    = 5; ///< 32 buckets per power of two
+    static constexpr std::size_t sub_bucket_count = std::size_t{1} << sub_bucket_bits;
+    static constexpr std::size_t bucket_count     = (65 - sub_bucket_bits) * sub_bucket_count;
+
+    /// @brief Count one value.
+    void record(std::uint64_t value) noexcept {
+        ++counts_[bucket_of(value)];
+        ++count_;
+        sum_ += value;
+        if (value < min_) min_ = value;
+        if (value > max_) max_ = value;
+    }
+
+    /// @brief Add the counts of `other`.
+    void merge(const LatencyHistogram& other) noexcept;
+
+    /// @brief Forget every recorded value.
+    void reset() noexcept;
+
+    /**
+     * @brief Smallest recorded value such that `p` percent of the values are at or below it.
+     *
+     * The result is the upper bound of the bucket holding that value, capped
+     * at `max()`; `p` is clamped to [0, 100]. Returns 0 if nothing was recorded.
+     */
+    [[nodiscard]] std::uint64_t percentile(double p) const noexcept;
+
+    [[nodiscard]] std::uint64_t count() const noexcept {
+        return count_;
+    }
+    [[nodiscard]] std::uint64_t min() const noexcept {
+        return count_ == 0 ? 0 : min_;
+    }
+    [[nodiscard]] std::uint64_t max() const noexcept {
+        return max_;
+    }
+    [[nodiscard]] double mean() const noexcept {
+        return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_);
+    }
+
+    /// @brief Bucket counting `value`.
+    static std::size_t bucket_of(std::uint64_t value) noexcept;
+
+    /// @brief Largest value counted in bucket `index`.
+    static std::uint64_t bucket_upper_bound(std::size_t index) noexcept;
+
+  private:
+    std::array<std::uint64_t, bucket_count> counts_{};
+    std::uint64_t count_ = 0;
+    std::uint64_t sum_   = 0; ///< wraps only after ~584 years of nanoseconds
+    std::uint64_t min_   = UINT64_MAX;
+    std::uint64_t max_   = 0;
+};
+
+} // namespace project_template::utils::metrics
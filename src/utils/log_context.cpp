@@ -0,0 +1,27 @@
+#include "log_context.hpp"
+
+namespace project_template::utils::log {
+
+LogContext::LogContext(const std::initializer_list<Field> fields) : parent_(current_) {
+    prefix_ = "[";
+    if (parent_ != nullptr) prefix_.append(parent_->fields());
+    for (const auto& field : fields) {
+        if (prefix_.size() > 1) prefix_.push_back(' ');
+        prefix_.append(field.key);
+        prefix_.push_back('=');
+        prefix_.append(field.text);
+    }
+    // no fields at any level: no "[] " in front of every line
+    if (prefix_.size() == 1) {
+        prefix_.clear();
+    } else {
+        prefix_.append("] ");
+    }
+    current_ = this;
+}
+
+LogContext::~LogContext() {
+    current_ = parent_;
+}
+
+} // namespace project_template::utils::log
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <spdlog/common.h>
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+namespace project_template::utils::log {
+
+/**
+ * @brief Scoped, thread-local context fields (MDC) added to every record the thread logs.
+ *
+ * Request and tenant ids belong on most lines of a request, but passing them
+ * as format arguments to every `LOG_*` call formats them again each time.
+ * A `LogContext` renders its fields once, when the scope is entered, into a
+ * prefix such as `[req=42 tenant=acme] `. The `LOG_*` macros (and `Log`'s
+ * logging functions) then copy that prefix in front of the message text of
+ * each record:
+ *
+ *   const LogContext request{{"req", request.id}, {"tenant", request.tenant}};
+ *   LOG_INFO("loaded {} rows", rows);   // [..] [info] [req=42 tenant=acme] [db.cpp@line:17] loaded 12 rows
+ *
+ * Scopes nest: an inner context renders the outer fields followed by its
+ * own. A context without fields at any level adds nothing. Contexts must be
+ * destroyed in reverse order on the thread that created them, which holds
+ * for local variables.
+ *
+ * The prefix is added where the message text is formatted, on the calling
+ * thread, so it reaches every mode and sink: an async worker or the log
+ * collector never sees the thread-local context, only the finished text.
+ * Values are formatted with `{}` and written verbatim.
+ */
+class LogContext {
+  public:
+    /// One `key=value` pair; the value is formatted when the field is created.
+    struct Field {
+        template <class T>
+        Field(const std::string_view field_key, const T& value)
+          : key(field_key), text(spdlog::fmt_lib::format("{}", value)) {}
+
+        std::string_view key;
+        std::string text;
+    };
+
+    LogContext(std::initializer_list<Field> fields);
+    ~LogContext();
+
+    LogContext(const LogContext&)            = delete;
+    LogContext& operator=(const LogContext&) = delete;
+
+    /// @brief The calling thread's rendered context, e.g. `[req=42 tenant=acme] `; empty outside any context.
+    [[nodiscard]] static std::string_view prefix() noexcept {
+        return current_ != nullptr ? std::string_view{current_->prefix_} : std::string_view{};
+    }
+
+    /// @brief This scope's fields including the enclosing scopes', e.g. `req=42 tenant=acme`.
+    [[nodiscard]] std::string_view fields() const noexcept {
+        return prefix_.empty() ? std::string_view{} : std::string_view{prefix_}.substr(1, prefix_.size() - 3);
+    }
+
+  private:
+    static inline thread_local const LogContext* current_ = nullptr;
+
+    const LogContext* parent_;
+    std::string prefix_; ///< "[" fields "] ", or empty without fields
+};
+
+/// @brief Append the calling thread's context prefix to `buf` (nothing outside a `LogContext`).
+inline void append_log_context(spdlog::memory_buf_t& buf) {
+    const auto prefix = LogContext::prefix();
+    buf.append(prefix.data(), prefix.data() + prefix.size());
+}
+
+} // namespace project_template::utils::log
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <spdlog/common.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace project_template::utils::log {
+
+/**
+ * @name Checksummed record framing
+ *
+ * With framing enabled, `IndexedRotatingFileSink` writes every formatted
+ * record as
+ *
+ *   LogFrameHeader     magic, CRC-32C, payload length
+ *   payload            the formatted record (usually one text line)
+ *
+ * The CRC covers the (adjacent) length field and the payload, so a reader can tell a
+ * torn or overwritten record from a valid one and, after damage, find the
+ * next valid frame by scanning for the magic (`LogFrameReader`). The magic
+ * starts with 0xFF, which never occurs in UTF-8 text. Integers are in host
+ * byte order, headers are unaligned.
+ */
+/// @{
+
+inline constexpr std::array<char, 4> log_frame_magic = {'\xFF', 'P', 'T', 'F'};
+inline constexpr std::uint32_t max_frame_payload     = std::uint32_t{16} << 20; ///< longer lengths are corrupt
+
+struct LogFrameHeader {
+    std::array<char, 4> magic = log_frame_magic;
+    std::uint32_t crc         = 0; ///< CRC-32C of `length` followed by the payload
+    std::uint32_t length      = 0; ///< payload bytes
+};
+
+static_assert(sizeof(LogFrameHeader) == 12);
+
+/// @}
+
+/**
+ * @brief Turn `buf[frame_start + sizeof(LogFrameHeader), end)` into a frame.
+ *
+ * The caller reserves `sizeof(LogFrameHeader)` bytes at `frame_start` and
+ * appends the payload behind them (e.g. by formatting into the buffer); this
+ * fills in the header, so framing costs no copy of the payload.
+ */
+void seal_frame(spdlog::memory_buf_t& buf, std::size_t frame_start);
+
+/// @brief True if `data` starts with a frame magic (i.e. was written with framing).
+bool starts_with_frame(std::string_view data);
+
+/**
+ * @brief Iterates the valid frames of a byte range, resynchronizing after damage.
+ *
+ * When the bytes at the current position are not a valid frame (bad magic,
+ * implausible length, CRC mismatch or truncated), the reader skips forward
+ * to the next offset that holds a valid frame. Skipped bytes and the number
+ * of damaged regions are counted, so tools can report them.
+ */
+class LogFrameReader {
+  public:
+    explicit LogFrameReader(std::string_view data) : data_(data) {}
+
+    /// @brief Next valid frame's payload; false once the data is exhausted.
+    bool next(std::string_view& payload);
+
+    /// @brief Bytes skipped because they did not belong to a valid frame.
+    [[nodiscard]] std::size_t skipped_bytes() const {
+        return skipped_bytes_;
+    }
+
+    /// @brief Number of separate damaged regions skipped.
+    [[nodiscard]] std::size_t corrupt_regions() const {
+        return corrupt_regions_;
+    }
+
+  private:
+    /// @brief True if a valid frame starts at `offset`; its payload length is stored in `length`.
+    [[nodiscard]] bool valid_frame_at_(std::size_t offset, std::uint32_t& length) const;
+
+    std::string_view data_;
+    std::size_t offset_          = 0;
+    std::size_t skipped_bytes_   = 0;
+    std::size_t corrupt_regions_ = 0;
+};
+
+} // namespace project_template::utils::log
@@ -0,0 +1,185 @@
+#include "log_index.hpp"
+
+#include "log_frame.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace project_template::utils::log {
+
+std::filesystem::path index_path_for(const std::filesystem::path& data_file) {
+    auto idx = data_file;
+    idx += ".idx";
+    return idx;
+}
+
+// ---------------------------------------------------------------------------
+// MappedFile
+// ---------------------------------------------------------------------------
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "open " + path.string());
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        const int err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), "fstat " + path.string());
+    }
+
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0) {
+        void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            const int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "mmap " + path.string());
+        }
+        data_ = static_cast<const std::byte*>(addr);
+    }
+    // the mapping keeps the file alive
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<std::byte*>(data_), size_);
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+    return *this;
+}
+
+// ---------------------------------------------------------------------------
+// LogSegment
+// ---------------------------------------------------------------------------
+
+LogSegment::LogSegment(const std::filesystem::path& data_file) : path_(data_file), data_(data_file) {
+    framed_ = starts_with_frame({reinterpret_cast<const char*>(data_.data()), data_.size()});
+
+    const auto idx_path = index_path_for(data_file);
+    if (!std::filesystem::exists(idx_path)) {
+        return; // unindexed file: the whole file is the tail
+    }
+
+    index_ = MappedFile(idx_path);
+    if (index_.size() < sizeof(LogIndexHeader)) {
+        throw std::runtime_error("log index too short: " + idx_path.string());
+    }
+
+    LogIndexHeader header;
+    std::memcpy(&header, index_.data(), sizeof(header));
+    if (header.magic != log_index_magic) {
+        throw std::runtime_error("not a log index: " + idx_path.string());
+    }
+    if (header.version != log_index_version) {
+        throw std::runtime_error("unsupported log index version " + std::to_string(header.version) + ": " +
+                                 idx_path.string());
+    }
+    interval_ = header.interval;
+
+    // a torn final entry (crash mid-write) is ignored
+    const auto count = (index_.size() - sizeof(LogIndexHeader)) / sizeof(LogIndexEntry);
+    // the header is 16 bytes and the mapping page-aligned, so entries are 8-byte aligned
+    entries_ = {reinterpret_cast<const LogIndexEntry*>(index_.data() + sizeof(LogIndexHeader)), count};
+
+    // never point past the data we actually have (index flushed ahead of data)
+    while (!entries_.empty() && entries_.back().offset + entries_.back().length > data_.size()) {
+        entries_ = entries_.first(entries_.size() - 1);
+    }
+
+    // block start times are not sorted; this bounds the forward walk of query()
+    later_min_ts_.resize(entries_.size());
+    auto later_min = std::numeric_limits<std::int64_t>::max();
+    for (auto i = entries_.size(); i-- > 0;) {
+        later_min        = std::min(later_min, entries_[i].min_ts_ns);
+        later_min_ts_[i] = later_min;
+    }
+}
+
+std::vector<ByteRange> LogSegment::query(const LogQuery& query) const {
+    std::vector<ByteRange> ranges;
+    const auto add = [&ranges](const std::uint64_t offset, const std::uint64_t length) {
+        if (length == 0) return;
+        if (!ranges.empty() && ranges.back().offset + ranges.back().length == offset) {
+            ranges.back().length += length; // coalesce adjacent blocks
+        } else {
+            ranges.push_back({offset, length});
+        }
+    };
+
+    // max_ts_ns is a running max, so it is sorted: every block before `first`
+    // only holds records older than `from_ns`
+    const auto first = std::ranges::lower_bound(entries_, query.from_ns, {}, &LogIndexEntry::max_ts_ns);
+
+    // a later block may start before an earlier one (clock stepped back), so skip rather than stop
+    for (auto i = static_cast<std::size_t>(first - entries_.begin());
+         i < entries_.size() && later_min_ts_[i] <= query.to_ns; ++i) {
+        const auto& entry = entries_[i];
+        if (entry.min_ts_ns <= query.to_ns && (entry.level_mask & query.level_mask) != 0) {
+            add(entry.offset, entry.length);
+        }
+    }
+
+    // the unsealed tail is newer than every indexed block; its level mix is unknown
+    const std::uint64_t tail_begin = entries_.empty() ? 0 : entries_.back().offset + entries_.back().length;
+    const std::int64_t last_max    = entries_.empty() ? query.to_ns : entries_.back().max_ts_ns;
+    if (query.to_ns >= last_max) {
+        add(tail_begin, data_.size() - tail_begin);
+    }
+    return ranges;
+}
+
+std::string_view LogSegment::bytes(const ByteRange& range) const {
+    if (range.offset + range.length > data_.size()) {
+        throw std::out_of_range("byte range outside of " + path_.string());
+    }
+    return {reinterpret_cast<const char*>(data_.data()) + range.offset, static_cast<std::size_t>(range.length)};
+}
+
+// ---------------------------------------------------------------------------
+// rotated_segments
+// ---------------------------------------------------------------------------
+
+std::vector<std::filesystem::path> rotated_segments(const std::filesystem::path& base_file) {
+    // spdlog names rotated files "<stem>.<n><ext>", newest rotation being .1
+    const auto dir  = base_file.parent_path();
+    const auto stem = base_file.stem().string();
+    const auto ext  = base_file.extension().string();
+
+    std::vector<std::filesystem::path> files;
+    for (std::size_t n = 1;; ++n) {
+        auto candidate = dir / (stem + "." + std::to_string(n) + ext);
+        if (!std::filesystem::exists(candidate)) break;
+        files.push_back(std::move(candidate));
+    }
+    std::ranges::reverse(files);
+    if (std::filesystem::exists(base_file)) {
+        files.push_back(base_file);
+    }
+    return files;
+}
+
+} // namespace project_template::utils::log
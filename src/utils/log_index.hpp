@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace project_template::utils::log {
+
+/**
+ * @name Sidecar log index format
+ *
+ * Every data file written by `IndexedRotatingFileSink` (e.g.
+ * `logs/project_template.log`, `logs/project_template.1.log`, ...) has a
+ * binary sidecar `<data file>.idx`:
+ *
+ *   LogIndexHeader
+ *   LogIndexEntry[]   one entry per block of `interval` records
+ *
+ * An entry describes a contiguous byte range of the data file. `max_ts_ns`
+ * is the running maximum over the whole file (not just the block), so it is
+ * non-decreasing and can be binary-searched even when records from different
+ * threads arrive slightly out of timestamp order.
+ *
+ * Records written after the last sealed block (the "tail") are not indexed
+ * yet; readers treat them as newer than every indexed block.
+ */
+/// @{
+
+inline constexpr std::array<char, 8> log_index_magic = {'P', 'T', 'L', 'O', 'G', 'I', 'D', 'X'};
+inline constexpr std::uint32_t log_index_version     = 1;
+
+struct LogIndexHeader {
+    std::array<char, 8> magic = log_index_magic;
+    std::uint32_t version     = log_index_version;
+    std::uint32_t interval    = 0; ///< records per block
+};
+
+struct LogIndexEntry {
+    std::int64_t min_ts_ns   = 0; ///< oldest record in the block (ns since epoch)
+    std::int64_t max_ts_ns   = 0; ///< newest record in the file so far (running max)
+    std::uint64_t offset     = 0; ///< byte offset of the block in the data file
+    std::uint64_t length     = 0; ///< byte length of the block
+    std::uint32_t records    = 0; ///< records in the block
+    std::uint32_t level_mask = 0; ///< bit `n` set if the block holds a record of spdlog level `n`
+};
+
+static_assert(sizeof(LogIndexHeader) == 16);
+static_assert(sizeof(LogIndexEntry) == 40);
+
+/// @brief Sidecar index path for a data file: `<data file>.idx`.
+std::filesystem::path index_path_for(const std::filesystem::path& data_file);
+
+/// @}
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Empty files map to an empty view. Throws `std::system_error` if the file
+ * cannot be opened or mapped.
+ */
+class MappedFile {
+  public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] const std::byte* data() const {
+        return data_;
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return size_;
+    }
+
+  private:
+    const std::byte* data_ = nullptr;
+    std::size_t size_      = 0;
+};
+
+/// Half-open byte range `[offset, offset + length)` within a data file.
+struct ByteRange {
+    std::uint64_t offset = 0;
+    std::uint64_t length = 0;
+};
+
+/// Time window and level filter for `LogSegment::query()`.
+struct LogQuery {
+    std::int64_t from_ns     = std::numeric_limits<std::int64_t>::min();
+    std::int64_t to_ns       = std::numeric_limits<std::int64_t>::max();
+    std::uint32_t level_mask = 0xFFFFFFFFU;
+};
+
+/**
+ * @brief One data file plus its sidecar index, both memory-mapped.
+ *
+ * `query()` binary-searches the index for the first block that may contain
+ * records at or after `from_ns`, then walks forward, returning every block
+ * whose `min_ts_ns` is not after `to_ns` and that holds a record of a
+ * requested level. Block start times need not increase (the clock may step
+ * back, writers may overlap): the walk only stops once no later block starts
+ * inside the window, which a suffix minimum of `min_ts_ns` computed on open
+ * tells at once. Only the index and the matching data pages are touched.
+ *
+ * The unsealed tail has no time bounds yet; it is returned for windows
+ * reaching the newest indexed record, so tail records stamped earlier than
+ * that after a clock step are only found once their block is sealed.
+ *
+ * Results have block granularity: a returned range may include a few records
+ * just outside the window or of other levels from the same block.
+ */
+class LogSegment {
+  public:
+    /// @brief Map `data_file` and, if present, its `.idx` sidecar.
+    explicit LogSegment(const std::filesystem::path& data_file);
+
+    [[nodiscard]] std::vector<ByteRange> query(const LogQuery& query) const;
+
+    /// @brief Raw bytes of a range previously returned by `query()`.
+    [[nodiscard]] std::string_view bytes(const ByteRange& range) const;
+
+    [[nodiscard]] const std::filesystem::path& path() const {
+        return path_;
+    }
+
+    [[nodiscard]] std::span<const LogIndexEntry> entries() const {
+        return entries_;
+    }
+
+    /// @brief Records per block as recorded in the header (0 if there is no index).
+    [[nodiscard]] std::uint32_t interval() const {
+        return interval_;
+    }
+
+    [[nodiscard]] std::size_t data_size() const {
+        return data_.size();
+    }
+
+    /// @brief True if the records are checksummed frames (read them with `LogFrameReader`).
+    [[nodiscard]] bool framed() const {
+        return framed_;
+    }
+
+    [[nodiscard]] std::size_t index_size() const {
+        return index_.size();
+    }
+
+  private:
+    std::filesystem::path path_;
+    MappedFile data_;
+    MappedFile index_;
+    std::span<const LogIndexEntry> entries_;
+    std::vector<std::int64_t> later_min_ts_; ///< `later_min_ts_[i]`: lowest `min_ts_ns` of entries `i..end`
+    std::uint32_t interval_ = 0;
+    bool framed_            = false;
+};
+
+/**
+ * @brief Existing data files of a rotating log, oldest first.
+ *
+ * For `logs/project_template.log` this returns e.g.
+ * `logs/project_template.2.log`, `logs/project_template.1.log`,
+ * `logs/project_template.log` (spdlog's rotation naming).
+ */
+std::vector<std::filesystem::path> rotated_segments(const std::filesystem::path& base_file);
+
+} // namespace project_template::utils::log
@@ -0,0 +1,106 @@
+#include "log_memory.hpp"
+
+namespace project_template::utils::log {
+
+LogMemoryBudget::LogMemoryBudget(const std::size_t limit, const BudgetPolicy policy) : settings_({limit, policy}) {}
+
+LogMemoryBudget& LogMemoryBudget::global() {
+    static LogMemoryBudget budget;
+    return budget;
+}
+
+void LogMemoryBudget::configure(const std::size_t limit, const BudgetPolicy policy) {
+    settings_.store({limit, policy});
+    notify_();
+}
+
+void LogMemoryBudget::charge(const std::size_t bytes) {
+    raise_peak_(usage_.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    account_.add(bytes);
+}
+
+bool LogMemoryBudget::try_charge(const std::size_t bytes, const spdlog::level::level_enum level) {
+    for (bool shrunk = false;;) {
+        // read the epoch first: a release() after this point makes the wait below return at once
+        const auto epoch  = epoch_.load();
+        const auto [limit, policy] = settings_.load();
+        auto current               = usage_.load();
+        if (limit == 0) {
+            if (bytes > 0) charge(bytes);
+            return true;
+        }
+
+        if (policy == BudgetPolicy::DropLowSeverity && level < spdlog::level::warn && current >= limit / 4 * 3) {
+            return drop_();
+        }
+        if (bytes == 0) return true;
+        if (bytes > limit) return drop_(); // could never fit; waiting or shrinking would not help
+
+        while (current + bytes <= limit) {
+            if (usage_.compare_exchange_weak(current, current + bytes, std::memory_order_relaxed)) {
+                raise_peak_(current + bytes);
+                account_.add(bytes);
+                return true;
+            }
+        }
+
+        if (policy == BudgetPolicy::Block) {
+            waiters_.fetch_add(1);
+            epoch_.wait(epoch);
+            waiters_.fetch_sub(1);
+            continue;
+        }
+        if (policy == BudgetPolicy::ShrinkRings && !shrunk) {
+            shrunk = true;
+            shrinks_.fetch_add(1, std::memory_order_relaxed);
+            const std::scoped_lock lock(hooks_mutex_);
+            for (const auto& [id, hook] : hooks_) {
+                hook();
+            }
+            continue;
+        }
+        return drop_();
+    }
+}
+
+void LogMemoryBudget::release(const std::size_t bytes) {
+    usage_.fetch_sub(bytes);
+    account_.sub(bytes);
+    notify_();
+}
+
+std::uint64_t LogMemoryBudget::add_shrink_hook(std::function<void()> hook) {
+    const std::scoped_lock lock(hooks_mutex_);
+    hooks_.emplace_back(next_hook_id_, std::move(hook));
+    return next_hook_id_++;
+}
+
+void LogMemoryBudget::remove_shrink_hook(const std::uint64_t id) {
+    const std::scoped_lock lock(hooks_mutex_);
+    std::erase_if(hooks_, [id](const auto& entry) { return entry.first == id; });
+}
+
+LogMemoryBudget::Stats LogMemoryBudget::stats() const {
+    const auto settings = settings_.load();
+    return {usage_.load(std::memory_order_relaxed),   peak_.load(std::memory_order_relaxed),
+            settings.limit,                           settings.policy,
+            dropped_.load(std::memory_order_relaxed), shrinks_.load(std::memory_order_relaxed)};
+}
+
+bool LogMemoryBudget::drop_() {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void LogMemoryBudget::raise_peak_(const std::size_t value) {
+    auto peak = peak_.load(std::memory_order_relaxed);
+    while (peak < value && !peak_.compare_exchange_weak(peak, value, std::memory_order_relaxed)) {}
+}
+
+void LogMemoryBudget::notify_() {
+    // pairs with try_charge(): either we see the waiter, or it sees the new epoch
+    epoch_.fetch_add(1);
+    if (waiters_.load() > 0) epoch_.notify_all();
+}
+
+} // namespace project_template::utils::log
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "memory_accounting.hpp"
+#include "seqlock.hpp"
+
+#include <spdlog/common.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace project_template::utils::log {
+
+/**
+ * @brief What happens to a record whose buffers would exceed the logging memory budget.
+ *
+ * - **DropLowSeverity**
+ *   Records below `warn` are dropped once usage reaches 75% of the budget,
+ *   keeping the rest for warnings and errors; any record that would exceed
+ *   the budget is dropped.
+ *
+ * - **ShrinkRings**
+ *   Async queues are asked to shrink (halve the records they keep in
+ *   flight and return spilled record buffers as they drain), then the
+ *   record is retried once and dropped if it still does not fit. Queues
+ *   grow back once usage falls below half the budget.
+ *
+ * - **Block**
+ *   The logging thread waits until the backend has written enough records
+ *   to make room. Records larger than the whole budget are dropped.
+ */
+enum class BudgetPolicy : std::uint8_t { DropLowSeverity, ShrinkRings, Block };
+
+/**
+ * @brief Byte budget shared by all logging buffers (async queues, per-CPU rings, spilled record buffers).
+ *
+ * Components charge fixed allocations with `charge()` when they create them
+ * and ask `try_charge()` for per-record memory, which applies the policy;
+ * both are returned with `release()`. Usage is always tracked, also without
+ * a limit, so it can be queried (`stats()`, `Log::memory_usage()`).
+ *
+ * Fixed allocations are never refused: `Log::init` sizes its rings to half
+ * the budget, the other half is left for records in flight.
+ *
+ * Charges are mirrored into the memory account `log.buffers`
+ * (`metrics::MemoryRegistry`), next to the other subsystems.
+ */
+class LogMemoryBudget {
+  public:
+    struct Stats {
+        std::size_t usage     = 0; ///< bytes currently charged
+        std::size_t peak      = 0; ///< highest usage seen
+        std::size_t limit     = 0; ///< 0 = unlimited
+        BudgetPolicy policy   = BudgetPolicy::DropLowSeverity;
+        std::uint64_t dropped = 0; ///< records refused by the policy
+        std::uint64_t shrinks = 0; ///< times queues were asked to shrink
+    };
+
+    LogMemoryBudget() = default;
+    explicit LogMemoryBudget(std::size_t limit, BudgetPolicy policy = BudgetPolicy::DropLowSeverity);
+
+    LogMemoryBudget(const LogMemoryBudget&)            = delete;
+    LogMemoryBudget& operator=(const LogMemoryBudget&) = delete;
+
+    /// @brief Budget used by `Log` and, by default, by every logging component.
+    static LogMemoryBudget& global();
+
+    /// @brief Change limit (0 = unlimited) and policy; current charges are kept.
+    void configure(std::size_t limit, BudgetPolicy policy);
+
+    /// @brief Charge a fixed allocation (ring, buffer); never refused.
+    void charge(std::size_t bytes);
+
+    /**
+     * @brief Admit a record that needs `bytes` of additional memory, applying the policy.
+     *
+     * `bytes` may be 0 for records that fit into preallocated storage; they
+     * are only subject to `DropLowSeverity`'s early drop. May block under
+     * `BudgetPolicy::Block`. Returns false if the record must be dropped.
+     */
+    bool try_charge(std::size_t bytes, spdlog::level::level_enum level);
+
+    void release(std::size_t bytes);
+
+    /// @brief Register a callback run (on the logging thread) when `ShrinkRings` needs memory.
+    std::uint64_t add_shrink_hook(std::function<void()> hook);
+    void remove_shrink_hook(std::uint64_t id);
+
+    [[nodiscard]] std::size_t usage() const {
+        return usage_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t limit() const {
+        return settings_.load().limit;
+    }
+
+    [[nodiscard]] Stats stats() const;
+
+  private:
+    struct Settings {
+        std::size_t limit   = 0;
+        BudgetPolicy policy = BudgetPolicy::DropLowSeverity;
+    };
+
+    bool drop_();
+    void raise_peak_(std::size_t value);
+    /// @brief Wake producers blocked in `try_charge()` to re-check.
+    void notify_();
+
+    std::atomic<std::size_t> usage_{0};
+    std::atomic<std::size_t> peak_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> shrinks_{0};
+    std::atomic<std::uint32_t> waiters_{0};
+    std::atomic<std::uint32_t> epoch_{0}; ///< bumped on every release/configure; blocked producers wait on it
+    metrics::MemoryAccount account_{"log.buffers"};
+    concurrency::SeqLock<Settings> settings_; ///< read on every record, so limit and policy always match
+
+    std::mutex hooks_mutex_;
+    std::uint64_t next_hook_id_ = 1;
+    std::vector<std::pair<std::uint64_t, std::function<void()>>> hooks_;
+};
+
+} // namespace project_template::utils::log
@@ -1,76 +1,139 @@
 #include "logger.hpp"
 
+#include "batch_async_logger.hpp"
+#include "indexed_file_sink.hpp"
+#include "per_cpu_logger.hpp"
+#include "shm_log_ring.hpp"
+#include "terminal_safe_sink.hpp"
+
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+#include <exception>
+#include <utility>
+#include <vector>
+
 namespace project_template::utils::log {
 
 // definitions of our statics
 std::shared_ptr<spdlog::logger> Log::spd_logger_ = nullptr;
+std::shared_ptr<SinkRegistry> Log::sinks_        = nullptr;
 std::string Log::pattern_                        = "";
 Mode Log::mode_                                  = Mode::Sync;
+LogOptions Log::options_                         = {};
 
-void Log::init(const Level level, const Mode mode, const std::string& pattern) {
+void Log::init(const Level level, const Mode mode, const std::string& pattern, const LogOptions& options) {
     // remember the pattern for everyone
     pattern_ = pattern;
+    LogMemoryBudget::global().configure(options.memory_budget, options.budget_policy);
 
-    // decide if we need a full rebuild (no logger yet, or mode switched)
-    if (const bool need_rebuild = !spd_logger_ || (mode != mode_); !need_rebuild) {
+    // decide if we need a full rebuild (no logger yet, mode switched, or rings to resize)
+    if (const bool need_rebuild = !spd_logger_ || (mode != mode_) || (options != options_); !need_rebuild) {
         // same mode → just reconfigure existing sinks & level
-        for (const auto& s : spd_logger_->sinks())
-            s->set_pattern(pattern_);
+        sinks_->set_pattern(pattern_);
         const auto lvl = to_spdlog_level(level);
         spd_logger_->set_level(lvl);
         spd_logger_->flush_on(spdlog::level::err);
         return;
     }
-    // mode changed (or first time) → full teardown + rebuild
-    mode_ = mode;
+    // mode or options changed (or first time) → full teardown + rebuild
+    mode_    = mode;
+    options_ = options;
     spdlog::shutdown();
     spd_logger_.reset();
+    sinks_.reset();
 
-    // make two sinks
-    auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-    console_sink->set_pattern(pattern_);
-
-    auto file_sink =
-        std::make_shared<spdlog::sinks::rotating_file_sink_mt>("logs/project_template.log", 1024 * 1024 * 5, 3);
-    file_sink->set_pattern(pattern_);
-
-    // pick sync vs async
-    if (mode == Mode::Async) {
-        spdlog::init_thread_pool(8192, 1);
-        spd_logger_ =
-            std::make_shared<spdlog::async_logger>("project_template", spdlog::sinks_init_list{console_sink, file_sink},
-                                                   spdlog::thread_pool(), spdlog::async_overflow_policy::block);
+    // shared mode: the collector process owns the sinks, we only feed its ring
+    std::string fallback_reason;
+    if (mode == Mode::Shared) {
+        try {
+            sinks_ = std::make_shared<SinkRegistry>(std::vector<spdlog::sink_ptr>{
+                std::make_shared<ShmRingSink>(ShmLogRing::attach(ShmLogRing::default_name))});
+            spd_logger_ = std::make_shared<spdlog::logger>("project_template", sinks_);
+            spdlog::register_logger(spd_logger_);
+        } catch (const std::exception& e) {
+            // no collector: keep logging locally rather than losing everything
+            fallback_reason = e.what();
+            init_local_sinks(Mode::Sync);
+        }
     } else {
-        spd_logger_ =
-            std::make_shared<spdlog::logger>("project_template", spdlog::sinks_init_list{console_sink, file_sink});
-        spdlog::register_logger(spd_logger_);
+        init_local_sinks(mode);
     }
 
+    // pattern for the current sinks and those attached later
+    sinks_->set_pattern(pattern_);
+
     // apply level + always flush on errors/criticals
     const auto lvl = to_spdlog_level(level);
     spd_logger_->set_level(lvl);
     spd_logger_->flush_on(spdlog::level::err);
+
+    if (!fallback_reason.empty()) {
+        spd_logger_->warn("shared log ring unavailable ({}), logging locally", fallback_reason);
+    }
+}
+
+void Log::init_local_sinks(const Mode mode) {
+    // make two sinks; messages are escaped for the terminal unless disabled
+    spdlog::sink_ptr console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    if (options_.safe_console) {
+        console_sink = std::make_shared<TerminalSafeSink>(std::move(console_sink));
+    }
+
+    // rotating file sink plus a sidecar time/level index, read by project_template_logquery;
+    // optionally with a length + CRC-32C frame per record
+    auto file_sink = std::make_shared<IndexedRotatingFileSink>("logs/project_template.log", 1024 * 1024 * 5, 3,
+                                                               IndexedRotatingFileSink::default_index_interval,
+                                                               options_.framed_file);
+
+    // one registry sink, so sinks can be attached and detached while other threads log
+    sinks_ = std::make_shared<SinkRegistry>(std::vector<spdlog::sink_ptr>{console_sink, file_sink});
+
+    // with a memory budget, rings take at most half of it; the rest is left for records in flight
+    const auto ring_bytes = options_.memory_budget / 2;
+
+    // pick sync vs async (spin-then-park worker, batched sink writes) vs per-CPU buffers
+    if (mode == Mode::Async) {
+        spd_logger_ = std::make_shared<BatchAsyncLogger>(
+            "project_template", std::vector<spdlog::sink_ptr>{sinks_},
+            ring_bytes > 0 ? BatchAsyncLogger::capacity_for(ring_bytes) : BatchAsyncLogger::default_capacity);
+    } else if (mode == Mode::PerCpu) {
+        spd_logger_ = std::make_shared<PerCpuLogger>(
+            "project_template", std::vector<spdlog::sink_ptr>{sinks_},
+            ring_bytes > 0 ? PerCpuRing::capacity_for(ring_bytes) : PerCpuRing::default_capacity);
+    } else {
+        spd_logger_ = std::make_shared<spdlog::logger>("project_template", sinks_);
+        spdlog::register_logger(spd_logger_);
+    }
 }
 
 std::shared_ptr<spdlog::logger>& Log::instance() {
     if (!spd_logger_) {
         init(); // Info, Async, default‑pattern
     }
-    // **re‑apply** the last init() pattern on every sink,
-    // so sinks added later (like your oss_sink_) pick it up:
-    for (const auto& s : spd_logger_->sinks()) {
-        s->set_pattern(pattern_);
-    }
     return spd_logger_;
 }
 
+void Log::add_sink(spdlog::sink_ptr sink) {
+    instance();
+    sinks_->add(std::move(sink));
+}
+
+bool Log::remove_sink(const spdlog::sink_ptr& sink) {
+    return sinks_ && sinks_->remove(sink);
+}
+
+std::vector<spdlog::sink_ptr> Log::sinks() {
+    return sinks_ ? sinks_->snapshot() : std::vector<spdlog::sink_ptr>{};
+}
+
 void Log::reset_logger() {
     spdlog::shutdown();
     spd_logger_.reset();
+    sinks_.reset();
     pattern_.clear();
-    mode_ = Mode::Sync;
+    mode_    = Mode::Sync;
+    options_ = {};
+    LogMemoryBudget::global().configure(0, BudgetPolicy::DropLowSeverity);
 }
 
 spdlog::level::level_enum Log::to_spdlog_level(const Level level) {
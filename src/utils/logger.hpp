@@ -1,12 +1,23 @@
 #pragma once
 
+#include "log_context.hpp"
+#include "log_memory.hpp"
+#include "sink_registry.hpp"
+
 #include <spdlog/async.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/spdlog.h>
+#if !defined(SPDLOG_USE_STD_FORMAT)
+#include <spdlog/fmt/compile.h>
+#endif
 
+#include <cstddef>
 #include <cstring>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace project_template::utils::log {
 /**
@@ -42,7 +53,9 @@ enum class Level : std::uint8_t { Trace, Debug, Info, Warn, Error, Critical, Off
  *
  * - **Async**
  *   Logging calls enqueue the record on a lock-free queue and return
- *   immediately. A background worker thread performs the actual I/O.
+ *   immediately. A background worker thread performs the actual I/O in
+ *   batches; it spins briefly when idle and then parks on a futex, so
+ *   producers rarely pay for a wakeup (see `BatchAsyncLogger`).
  *   This reduces latency and improves throughput, especially in applications
  *   that produce many logs or perform frequent I/O.
  *
@@ -54,11 +67,59 @@ enum class Level : std::uint8_t { Trace, Debug, Info, Warn, Error, Critical, Off
  *   Because writes are deferred, applications should flush or shut down the
  *   logger cleanly to avoid losing queued messages at shutdown.
  *
+ * - **PerCpu**
+ *   Like Async, but records are appended to one buffer per CPU instead of a
+ *   shared queue, lock-free via Linux restartable sequences (rseq) where
+ *   available and behind a per-CPU spinlock otherwise (see `PerCpuLogger`).
+ *   Memory scales with the core count rather than the thread count, and
+ *   threads keep no per-thread logging state, which suits workloads with
+ *   many short-lived threads. The worker polls the buffers, so records
+ *   become visible within a few milliseconds unless flushed.
+ *
+ * - **Shared**
+ *   Records are encoded and pushed into a shared-memory ring
+ *   (`ShmLogRing::default_name`) that a single collector process
+ *   (`project_template_logcollector`) drains into the console and file sinks.
+ *   Meant for hosts running several worker processes: they no longer contend
+ *   on (or interleave within) one file, and logging never blocks on I/O;
+ *   when the ring is full records are dropped and counted instead.
+ *
+ *   If no collector is running, `init()` falls back to local synchronous
+ *   sinks and logs a warning.
+ *
  * Ordering notes:
  *  - Per-thread message order is preserved
  *  - Cross-thread interleaving may differ in async mode
+ *  - In per-CPU mode, records are written in timestamp order per drain round
+ *  - In shared mode, records of all processes are ordered by ring position
+ */
+enum class Mode : std::uint8_t { Sync, Async, PerCpu, Shared };
+
+/**
+ * @brief Further `Log::init` settings.
+ *
+ * `memory_budget` bounds what the logging subsystem keeps in memory: the
+ * async queue or per-CPU rings (sized to at most half the budget when the
+ * logger is built) plus records in flight whose text does not fit the
+ * preallocated slots. Usage is reported by `Log::memory_usage()`, also
+ * without a budget. Sync and Shared mode buffer nothing.
+ *
+ * `framed_file` writes each record of the rotating log file with a length
+ * and CRC-32C header, so `project_template_logquery` can skip damaged
+ * records instead of passing on garbage (see `IndexedRotatingFileSink`).
+ *
+ * `safe_console` escapes control characters and ill-formed UTF-8 in messages
+ * before they reach the console, so logged input cannot emit terminal escape
+ * sequences (see `TerminalSafeSink`). The file keeps the text verbatim.
  */
-enum class Mode : std::uint8_t { Sync, Async };
+struct LogOptions {
+    std::size_t memory_budget  = 0; ///< bytes, 0 = unlimited
+    BudgetPolicy budget_policy = BudgetPolicy::DropLowSeverity;
+    bool framed_file           = false;
+    bool safe_console          = true;
+
+    bool operator==(const LogOptions&) const = default;
+};
 
 /**
  * @brief Centralized logging facility for the project.
@@ -76,8 +137,10 @@ enum class Mode : std::uint8_t { Sync, Async };
  *
  * Behavior:
  *  - Calling `init()` multiple times reconfigures the existing logger.
- *  - The logger pattern and level are reapplied for all sinks via `instance()`.
- *  - In async mode, `reset_logger()` shuts down the async thread pool.
+ *  - The logger's sinks sit in a `SinkRegistry`: `add_sink()` / `remove_sink()`
+ *    attach and detach sinks while other threads log, and attached sinks take
+ *    the `init()` pattern.
+ *  - In async mode, `reset_logger()` writes all queued records and stops the worker.
  *
  * Recommended use:
  *  - Call `Log::init()` once at program startup.
@@ -100,70 +163,127 @@ class Log {
      * @param mode
      *        - Mode::Sync: log on the caller thread
      *        - Mode::Async: enqueue and return immediately
+     *        - Mode::PerCpu: append to the current CPU's buffer and return immediately
+     *        - Mode::Shared: hand records to the collector process
      *
      * @param pattern
      *        spdlog-compatible formatting pattern shared by all sinks.
      *        The default includes timestamp, colored level, and the message.
      *
+     * @param options
+     *        Memory budget and the policy applied when it is exhausted,
+     *        checksummed file records. Changing them rebuilds the logger.
+     *
      * Notes:
-     *  - In async mode, call `Log::reset_logger()` or `spdlog::shutdown()` at
-     *    shutdown to ensure all queued messages are flushed.
+     *  - In async mode, call `Log::reset_logger()` (or `Log::flush()`) at
+     *    shutdown to ensure all queued messages are written.
      *  - High severity logs (`error`, `critical`) automatically trigger flushes.
+     *  - Records dropped by the memory budget are counted in `memory_usage()`.
      */
     static void init(Level level = Level::Info, Mode mode = Mode::Async,
-                     const std::string& pattern = "[%T.%f] [%^%l%$] %v");
+                     const std::string& pattern = "[%T.%f] [%^%l%$] %v", const LogOptions& options = {});
 
     /// @brief Retrieve (and lazily initialize) the shared logger.
     static std::shared_ptr<spdlog::logger>& instance();
 
-    /// @brief Shutdown and reset the logger (including async thread pool).
+    /// @brief Shutdown and reset the logger (including the async worker).
     static void reset_logger();
 
+    /**
+     * @name Sinks
+     * Safe while other threads log (see `SinkRegistry`), not concurrently with
+     * `init()` or `reset_logger()`. A rebuild by `init()` (mode or options
+     * changed) starts again from the console and file sinks.
+     * @{
+     */
+    /// @brief Attach `sink`, formatted with the `init()` pattern; e.g. a temporary capture sink.
+    static void add_sink(spdlog::sink_ptr sink);
+
+    /// @brief Detach `sink`; once this returns it receives no further records. False if it was not attached.
+    static bool remove_sink(const spdlog::sink_ptr& sink);
+
+    /// @brief The currently attached sinks.
+    static std::vector<spdlog::sink_ptr> sinks();
+    /// @}
+
+    /// @brief Memory charged by logging buffers, against the `LogOptions::memory_budget`.
+    static LogMemoryBudget::Stats memory_usage() {
+        return LogMemoryBudget::global().stats();
+    }
+
     /// @brief Flush all sinks immediately.
     static void flush() {
         if (spd_logger_) spd_logger_->flush();
     }
 
     /// @name Logging convenience functions
-    /// These forward directly to the shared spdlog logger.
+    /// These log through the shared spdlog logger, after the thread's `LogContext` prefix.
     /// @{
     template <typename... Args> static void trace(spdlog::fmt_lib::format_string<Args...> fmt_str, Args&&... args) {
-        instance()->trace(fmt_str, std::forward<Args>(args)...);
+        log_compiled(spdlog::level::trace, fmt_str, std::forward<Args>(args)...);
     }
 
     template <typename... Args> static void debug(spdlog::fmt_lib::format_string<Args...> fmt_str, Args&&... args) {
-        instance()->debug(fmt_str, std::forward<Args>(args)...);
+        log_compiled(spdlog::level::debug, fmt_str, std::forward<Args>(args)...);
     }
 
     template <typename... Args> static void info(spdlog::fmt_lib::format_string<Args...> fmt_str, Args&&... args) {
-        instance()->info(fmt_str, std::forward<Args>(args)...);
+        log_compiled(spdlog::level::info, fmt_str, std::forward<Args>(args)...);
     }
 
     template <typename... Args> static void warn(spdlog::fmt_lib::format_string<Args...> fmt_str, Args&&... args) {
-        instance()->warn(fmt_str, std::forward<Args>(args)...);
+        log_compiled(spdlog::level::warn, fmt_str, std::forward<Args>(args)...);
     }
 
     template <typename... Args> static void error(spdlog::fmt_lib::format_string<Args...> fmt_str, Args&&... args) {
-        instance()->error(fmt_str, std::forward<Args>(args)...);
-        instance()->flush();
+        log_compiled(spdlog::level::err, fmt_str, std::forward<Args>(args)...);
     }
 
     template <typename... Args> static void critical(spdlog::fmt_lib::format_string<Args...> fmt_str, Args&&... args) {
-        instance()->critical(fmt_str, std::forward<Args>(args)...);
-        instance()->flush();
+        log_compiled(spdlog::level::critical, fmt_str, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Log with a format compiled at the call site (`FMT_COMPILE`), as the `LOG_*` macros do.
+     *
+     * The message is formatted here, only if `level` is enabled, and handed
+     * to spdlog as finished text, so fmt never parses the format at run time.
+     * The text starts with the thread's `LogContext` prefix, copied rather
+     * than formatted again. Error and critical records are flushed at once.
+     */
+    template <typename CompiledFormat, typename... Args>
+    static void log_compiled(const spdlog::level::level_enum level, const CompiledFormat& format, Args&&... args) {
+        const auto& logger = instance();
+        if (!logger->should_log(level)) return;
+        spdlog::memory_buf_t buf;
+        append_log_context(buf);
+        spdlog::fmt_lib::format_to(std::back_inserter(buf), format, std::forward<Args>(args)...);
+        logger->log(level, spdlog::string_view_t{buf.data(), buf.size()});
+        if (level >= spdlog::level::err) logger->flush();
     }
 
     /// @}
 
   private:
     static std::shared_ptr<spdlog::logger> spd_logger_;
-    static std::string pattern_; ///< last applied pattern
-    static Mode mode_;           ///< last selected mode
+    static std::shared_ptr<SinkRegistry> sinks_; ///< the logger's only sink, fanning out to the attached ones
+    static std::string pattern_;                 ///< last applied pattern
+    static Mode mode_;                           ///< last selected mode
+    static LogOptions options_;                  ///< last applied options
+
+    /// @brief Build the console + file logger for Sync / Async / PerCpu mode.
+    static void init_local_sinks(Mode mode);
 
     /// @brief Convert Log::Level to spdlog's native level enum.
     static spdlog::level::level_enum to_spdlog_level(Level level);
 };
 
+/// @brief File name without directories, computed at compile time (e.g. for `__FILE__`).
+consteval std::string_view source_file_name(const std::string_view path) {
+    const auto slash = path.find_last_of('/');
+    return slash == std::string_view::npos ? path : path.substr(slash + 1);
+}
+
 /**
  * @name File-and-line aware logging macros
  *
@@ -178,38 +298,52 @@ class Log {
  *   [config.cpp@line:42] Loaded configuration '/etc/app/config.yaml'
  *
  * This format makes it easier to trace log origins across large codebases.
+ *
+ * The line number is pasted into the format literal, the file name is a
+ * compile-time constant, and the whole format is compiled with `FMT_COMPILE`
+ * (see `Log::log_compiled()`): each call site formats with straight-line
+ * code instead of parsing its format string on every call, and format
+ * errors are compile errors. With `SPDLOG_USE_STD_FORMAT` the macros fall
+ * back to the run-time formatted `Log::info()` etc.
  */
 /// @{
 
 #define PROJECT_FILENAME (strrchr(__FILE__, '/') ? strrchr(__FILE__, '/') + 1 : __FILE__)
 
-#define LOG_TRACE(fmt, ...)                                                                                            \
-    ::project_template::utils::log::Log::trace("[{}@line:{}] " fmt, PROJECT_FILENAME,                                  \
-                                               __LINE__ __VA_OPT__(, __VA_ARGS__))
+#define PROJECT_LOG_STRINGIFY_(x) #x
+#define PROJECT_LOG_STRINGIFY(x) PROJECT_LOG_STRINGIFY_(x)
+
+// The class the macros log through: `Log`, unless a target routes them to a `StaticLogger` (see `StaticLogFrontend`).
+#if !defined(PROJECT_LOG_FRONTEND)
+#define PROJECT_LOG_FRONTEND ::project_template::utils::log::Log
+#endif
+
+#if defined(SPDLOG_USE_STD_FORMAT)
+#define PROJECT_LOG_AT(function, level, fmt, ...)                                                                      \
+    PROJECT_LOG_FRONTEND::function("[{}@line:{}] " fmt, PROJECT_FILENAME, __LINE__ __VA_OPT__(, __VA_ARGS__))
+#else
+#define PROJECT_LOG_AT(function, level, fmt, ...)                                                                      \
+    PROJECT_LOG_FRONTEND::log_compiled(level, FMT_COMPILE("[{}@line:" PROJECT_LOG_STRINGIFY(__LINE__) "] " fmt),       \
+                                       ::project_template::utils::log::source_file_name(__FILE__)                      \
+                                           __VA_OPT__(, __VA_ARGS__))
+#endif
+
+#define LOG_TRACE(fmt, ...) PROJECT_LOG_AT(trace, ::spdlog::level::trace, fmt __VA_OPT__(, __VA_ARGS__))
 
-#define LOG_DEBUG(fmt, ...)                                                                                            \
-    ::project_template::utils::log::Log::debug("[{}@line:{}] " fmt, PROJECT_FILENAME,                                  \
-                                               __LINE__ __VA_OPT__(, __VA_ARGS__))
+#define LOG_DEBUG(fmt, ...) PROJECT_LOG_AT(debug, ::spdlog::level::debug, fmt __VA_OPT__(, __VA_ARGS__))
 
-#define LOG_INFO(fmt, ...)                                                                                             \
-    ::project_template::utils::log::Log::info("[{}@line:{}] " fmt, PROJECT_FILENAME, __LINE__ __VA_OPT__(, __VA_ARGS__))
+#define LOG_INFO(fmt, ...) PROJECT_LOG_AT(info, ::spdlog::level::info, fmt __VA_OPT__(, __VA_ARGS__))
 
-#define LOG_WARN(fmt, ...)                                                                                             \
-    ::project_template::utils::log::Log::warn("[{}@line:{}] " fmt, PROJECT_FILENAME, __LINE__ __VA_OPT__(, __VA_ARGS__))
+#define LOG_WARN(fmt, ...) PROJECT_LOG_AT(warn, ::spdlog::level::warn, fmt __VA_OPT__(, __VA_ARGS__))
 
-#define LOG_ERROR(fmt, ...)                                                                                            \
-    ::project_template::utils::log::Log::error("[{}@line:{}] " fmt, PROJECT_FILENAME,                                  \
-                                               __LINE__ __VA_OPT__(, __VA_ARGS__))
+#define LOG_ERROR(fmt, ...) PROJECT_LOG_AT(error, ::spdlog::level::err, fmt __VA_OPT__(, __VA_ARGS__))
 
-#define LOG_CRITICAL(fmt, ...)                                                                                         \
-    ::project_template::utils::log::Log::critical("[{}@line:{}] " fmt, PROJECT_FILENAME,                               \
-                                                  __LINE__ __VA_OPT__(, __VA_ARGS__))
+#define LOG_CRITICAL(fmt, ...) PROJECT_LOG_AT(critical, ::spdlog::level::critical, fmt __VA_OPT__(, __VA_ARGS__))
 
 #define LOG_WARN_IF(cond, fmt, ...)                                                                                    \
     do {                                                                                                               \
         if (cond) {                                                                                                    \
-            ::project_template::utils::log::Log::warn("[{}@line:{}] " fmt, PROJECT_FILENAME,                           \
-                                                      __LINE__ __VA_OPT__(, __VA_ARGS__));                             \
+            LOG_WARN(fmt __VA_OPT__(, __VA_ARGS__));                                                                   \
         }                                                                                                              \
     } while (0)
 
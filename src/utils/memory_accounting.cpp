@@ -0,0 +1,116 @@
+#include "memory_accounting.hpp"
+
+#include "text_escape.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <iterator>
+#include <utility>
+
+namespace project_template::utils::metrics {
+
+MemoryAccount::MemoryAccount(std::string name) : MemoryAccount(std::move(name), MemoryRegistry::global()) {}
+
+MemoryAccount::MemoryAccount(std::string name, MemoryRegistry& registry) : name_(std::move(name)), registry_(registry) {
+    const std::lock_guard lock{registry_.mutex_};
+    registry_.accounts_.push_back(this);
+}
+
+MemoryAccount::~MemoryAccount() {
+    const std::lock_guard lock{registry_.mutex_};
+    std::erase(registry_.accounts_, this);
+}
+
+// ---------------------------------------------------------------------------
+// MemoryRegistry
+// ---------------------------------------------------------------------------
+
+MemoryRegistry& MemoryRegistry::global() {
+    static MemoryRegistry registry;
+    return registry;
+}
+
+std::vector<MemoryRegistry::Entry> MemoryRegistry::snapshot() const {
+    std::vector<Entry> entries;
+    {
+        const std::lock_guard lock{mutex_};
+        for (const auto* account : accounts_) {
+            auto it = std::find_if(entries.begin(), entries.end(),
+                                   [account](const Entry& entry) { return entry.name == account->name(); });
+            if (it == entries.end()) it = entries.insert(entries.end(), Entry{account->name()});
+            it->current += account->current();
+            it->peak += account->peak();
+            ++it->count;
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.name < b.name; });
+    return entries;
+}
+
+std::size_t MemoryRegistry::total() const {
+    const std::lock_guard lock{mutex_};
+    std::size_t total = 0;
+    for (const auto* account : accounts_) {
+        total += account->current();
+    }
+    return total;
+}
+
+void MemoryRegistry::reset_peaks() {
+    const std::lock_guard lock{mutex_};
+    for (auto* account : accounts_) {
+        account->reset_peak();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Sampling
+// ---------------------------------------------------------------------------
+
+MemorySample sample_memory(const MemoryRegistry& registry) {
+    return {process_memory(), peak_rss_bytes(), registry.snapshot()};
+}
+
+std::string memory_sample_json(const MemorySample& sample) {
+    const auto& process = sample.process;
+    spdlog::memory_buf_t out;
+    fmt::format_to(std::back_inserter(out),
+                   "{{\"rss_bytes\": {}, \"peak_rss_bytes\": {}, \"virtual_bytes\": {}, \"shared_bytes\": {}",
+                   process.rss_bytes, sample.peak_rss_bytes, process.size_bytes, process.shared_bytes);
+    if (process.rollup) {
+        fmt::format_to(std::back_inserter(out),
+                       ", \"pss_bytes\": {}, \"anonymous_bytes\": {}, \"private_dirty_bytes\": {}, "
+                       "\"shared_dirty_bytes\": {}, \"swap_bytes\": {}",
+                       process.pss_bytes, process.anonymous_bytes, process.private_dirty_bytes,
+                       process.shared_dirty_bytes, process.swap_bytes);
+    }
+    out.append(std::string_view{", \"accounts\": {"});
+    for (const auto& entry : sample.accounts) {
+        if (&entry != sample.accounts.data()) out.append(std::string_view{", "});
+        out.push_back('"');
+        text::append_json_escaped(out, entry.name);
+        fmt::format_to(std::back_inserter(out), "\": {{\"current\": {}, \"peak\": {}}}", entry.current, entry.peak);
+    }
+    out.append(std::string_view{"}}"});
+    return fmt::to_string(out);
+}
+
+MemorySampler::MemorySampler(const std::chrono::nanoseconds interval, Callback callback,
+                             const MemoryRegistry& registry)
+  : thread_([interval, callback = std::move(callback), &registry](const std::stop_token& stop) {
+        std::mutex mutex;
+        std::condition_variable_any wakeup;
+        std::unique_lock lock{mutex};
+        while (!wakeup.wait_for(lock, stop, interval, [&stop] { return stop.stop_requested(); })) {
+            callback(sample_memory(registry));
+        }
+    }) {}
+
+void MemorySampler::stop() {
+    thread_.request_stop();
+    if (thread_.joinable()) thread_.join();
+}
+
+} // namespace project_template::utils::metrics
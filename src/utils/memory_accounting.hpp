@@ -0,0 +1,156 @@
+#pragma once
+
+#include "process_usage.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace project_template::utils::metrics {
+
+class MemoryRegistry;
+
+/**
+ * @brief Bytes one subsystem currently holds, and the most it has held.
+ *
+ * The owner reports its allocations with `add()` / `sub()`, typically
+ * buffers, queues or caches it sizes itself. Both are a relaxed atomic
+ * add; `add()` additionally raises the peak when it is exceeded. While it
+ * exists, the account is listed in its registry under `name`; accounts
+ * with the same name (e.g. one per pool instance) are summed there.
+ *
+ *   class Cache {
+ *       metrics::MemoryAccount memory_{"cache.entries"};
+ *       void insert(...) { memory_.add(entry_size); ... }
+ *   };
+ */
+class MemoryAccount {
+  public:
+    explicit MemoryAccount(std::string name);
+    MemoryAccount(std::string name, MemoryRegistry& registry);
+    ~MemoryAccount();
+
+    MemoryAccount(const MemoryAccount&)            = delete;
+    MemoryAccount& operator=(const MemoryAccount&) = delete;
+
+    void add(std::size_t bytes) noexcept {
+        const auto current = current_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        auto peak          = peak_.load(std::memory_order_relaxed);
+        while (peak < current && !peak_.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+    }
+
+    void sub(std::size_t bytes) noexcept {
+        current_.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] const std::string& name() const noexcept {
+        return name_;
+    }
+
+    [[nodiscard]] std::size_t current() const noexcept {
+        return current_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t peak() const noexcept {
+        return peak_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Restart the peak at the current value, e.g. at the start of a measurement.
+    void reset_peak() noexcept {
+        peak_.store(current(), std::memory_order_relaxed);
+    }
+
+  private:
+    std::string name_;
+    MemoryRegistry& registry_;
+    std::atomic<std::size_t> current_{0};
+    std::atomic<std::size_t> peak_{0};
+};
+
+/**
+ * @brief The memory accounts of a process, by name.
+ *
+ * Accounts register themselves on construction and leave on destruction.
+ * Registering takes a mutex, reading the accounts does too; updating an
+ * account does not involve the registry at all.
+ */
+class MemoryRegistry {
+  public:
+    struct Entry {
+        std::string name;
+        std::size_t current = 0; ///< sum over the live accounts with this name
+        std::size_t peak    = 0; ///< sum of their peaks (an upper bound of the joint peak)
+        std::size_t count   = 0; ///< live accounts with this name
+    };
+
+    MemoryRegistry() = default;
+
+    MemoryRegistry(const MemoryRegistry&)            = delete;
+    MemoryRegistry& operator=(const MemoryRegistry&) = delete;
+
+    /// @brief Registry used by `MemoryAccount`s constructed without one.
+    static MemoryRegistry& global();
+
+    /// @brief One entry per name, sorted by name.
+    [[nodiscard]] std::vector<Entry> snapshot() const;
+
+    /// @brief Current bytes over all accounts.
+    [[nodiscard]] std::size_t total() const;
+
+    /// @brief `MemoryAccount::reset_peak()` on every account.
+    void reset_peaks();
+
+  private:
+    friend class MemoryAccount;
+
+    mutable std::mutex mutex_;
+    std::vector<MemoryAccount*> accounts_;
+};
+
+/// @brief Process memory and the registry's accounts at one point in time.
+struct MemorySample {
+    ProcessMemory process;
+    std::uint64_t peak_rss_bytes = 0; ///< `VmHWM`: highest RSS so far
+    std::vector<MemoryRegistry::Entry> accounts;
+};
+
+/// @brief Take a sample: statm, smaps_rollup, the RSS high-water mark and `registry`.
+MemorySample sample_memory(const MemoryRegistry& registry = MemoryRegistry::global());
+
+/// @brief One-line JSON object with the process figures and an `accounts` object (`{"name": {"current", "peak"}}`).
+std::string memory_sample_json(const MemorySample& sample);
+
+/**
+ * @brief Background thread calling `callback` with a fresh `MemorySample` every `interval`.
+ *
+ * Reading `smaps_rollup` costs the kernel a walk over all mappings, which
+ * is why it is sampled here instead of with every metrics update. The
+ * callback publishes the sample, e.g. logs `memory_sample_json()` or adds
+ * it to a metrics record; it runs on the sampler thread. The first sample
+ * is taken after one interval. Destruction stops the thread.
+ */
+class MemorySampler {
+  public:
+    using Callback = std::function<void(const MemorySample&)>;
+
+    MemorySampler(std::chrono::nanoseconds interval, Callback callback,
+                  const MemoryRegistry& registry = MemoryRegistry::global());
+
+    MemorySampler(const MemorySampler&)            = delete;
+    MemorySampler& operator=(const MemorySampler&) = delete;
+
+    /// @brief Stop the thread; a callback in progress completes first. Idempotent.
+    void stop();
+
+  private:
+    std::jthread thread_;
+};
+
+} // namespace project_template::utils::metrics
@@ -0,0 +1,417 @@
+#include "per_cpu_logger.hpp"
+
+#include "binary_log.hpp"
+#include "sink_group.hpp"
+#include "sink_registry.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <utility>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/sysinfo.h>
+#endif
+
+// rseq appends need the registration glibc ≥ 2.35 performs for every thread
+// (__rseq_offset / __rseq_size) and an architecture-specific critical section.
+#if defined(__linux__) && defined(__x86_64__) && defined(__GLIBC__) &&                                                 \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 35)) && __has_include(<sys/rseq.h>)
+#include <sys/rseq.h>
+#define PROJECT_TEMPLATE_HAS_RSEQ 1
+#else
+#define PROJECT_TEMPLATE_HAS_RSEQ 0
+#endif
+
+namespace project_template::utils::log {
+
+struct PerCpuRing::CpuBuffer {
+    alignas(64) std::atomic<std::uint64_t> head{0}; ///< bytes appended (producers on this CPU)
+    std::atomic<bool> locked{false};                ///< fallback path only
+    std::atomic<std::uint64_t> dropped{0};
+    std::unique_ptr<std::uint64_t[]> words;         ///< capacity + one max-size frame of slack
+
+    alignas(64) std::atomic<std::uint64_t> tail{0}; ///< bytes released (consumer)
+};
+
+namespace {
+
+constexpr std::size_t max_frame_words = (PerCpuRing::max_record + 8) / 8;
+constexpr std::size_t min_capacity    = 4096; ///< smallest ring per CPU, in bytes
+
+constexpr std::size_t frame_bytes(const std::size_t size) {
+    return (size + 8 + 7) & ~std::size_t{7};
+}
+
+std::size_t configured_cpus() {
+#if defined(__linux__)
+    // every id the kernel may report in rseq / sched_getcpu(), including offline CPUs
+    return static_cast<std::size_t>(std::max(::get_nprocs_conf(), 1));
+#else
+    return std::max(std::thread::hardware_concurrency(), 1u);
+#endif
+}
+
+std::size_t current_cpu() {
+#if defined(__linux__)
+    if (const int cpu = ::sched_getcpu(); cpu >= 0) return static_cast<std::size_t>(cpu);
+#endif
+    return std::hash<std::thread::id>{}(std::this_thread::get_id());
+}
+
+#if PROJECT_TEMPLATE_HAS_RSEQ
+
+constexpr std::uint32_t rseq_signature = 0x53053053; ///< glibc's RSEQ_SIG on x86
+
+rseq* rseq_area() {
+    return reinterpret_cast<rseq*>(static_cast<char*>(__builtin_thread_pointer()) + __rseq_offset);
+}
+
+/**
+ * Restartable sequence: if the thread still runs on `cpu` and `*head == expected`,
+ * copy `count` words from `src` to `dst` and commit by storing `desired` to `*head`.
+ * Returns 0 on commit, 1 if `*head` changed, -1 if the kernel aborted the sequence
+ * (preemption, migration or signal). Modeled on librseq's rseq_cmpeqv_trymemcpy_storev.
+ */
+int rseq_copy_commit(rseq* area, const std::uint32_t cpu, std::atomic<std::uint64_t>& head,
+                     const std::uint64_t expected, std::uint64_t* dst, const std::uint64_t* src,
+                     const std::size_t count, const std::uint64_t desired) {
+    static_assert(sizeof(std::atomic<std::uint64_t>) == sizeof(std::uint64_t));
+    auto* const head_word = reinterpret_cast<std::uint64_t*>(&head);
+    std::uint64_t scratch[3];
+    // asm goto has no outputs: the loop registers are saved to scratch and restored on every exit
+    __asm__ __volatile__ goto(
+        // critical section descriptor {version, flags, start_ip, post_commit_offset, abort_ip}
+        ".pushsection __rseq_cs, \"aw\"\n\t"
+        ".balign 32\n\t"
+        "3:\n\t"
+        ".long 0, 0\n\t"
+        ".quad 1f, (2f - 1f), 4f\n\t"
+        ".popsection\n\t"
+        "movq %[src], %[scratch0]\n\t"
+        "movq %[dst], %[scratch1]\n\t"
+        "movq %[count], %[scratch2]\n\t"
+        "leaq 3b(%%rip), %%rax\n\t"
+        "movq %%rax, 8(%[area])\n\t" // rseq->rseq_cs = &descriptor
+        "1:\n\t"
+        "cmpl %[cpu], 4(%[area])\n\t" // rseq->cpu_id
+        "jnz 4f\n\t"
+        "cmpq %[head], %[expected]\n\t"
+        "jnz 5f\n\t"
+        "test %[count], %[count]\n\t"
+        "jz 7f\n\t"
+        "6:\n\t"
+        "movq (%[src]), %%rax\n\t"
+        "movq %%rax, (%[dst])\n\t"
+        "addq $8, %[src]\n\t"
+        "addq $8, %[dst]\n\t"
+        "decq %[count]\n\t"
+        "jnz 6b\n\t"
+        "7:\n\t"
+        "movq %[desired], %[head]\n\t" // commit
+        "2:\n\t"
+        "movq %[scratch2], %[count]\n\t"
+        "movq %[scratch1], %[dst]\n\t"
+        "movq %[scratch0], %[src]\n\t"
+        ".pushsection __rseq_failure, \"ax\"\n\t"
+        ".byte 0x0f, 0xb9, 0x3d\n\t" // ud1 <sig>(%rip), %edi: signature the kernel checks before aborting
+        ".long %c[signature]\n\t"
+        "4:\n\t"
+        "movq %[scratch2], %[count]\n\t"
+        "movq %[scratch1], %[dst]\n\t"
+        "movq %[scratch0], %[src]\n\t"
+        "jmp %l[aborted]\n\t"
+        "5:\n\t"
+        "movq %[scratch2], %[count]\n\t"
+        "movq %[scratch1], %[dst]\n\t"
+        "movq %[scratch0], %[src]\n\t"
+        "jmp %l[changed]\n\t"
+        ".popsection\n\t"
+        :
+        : [cpu] "r"(cpu), [area] "r"(area), [head] "m"(*head_word), [expected] "r"(expected),
+          [desired] "r"(desired), [dst] "r"(dst), [src] "r"(src), [count] "r"(count), [scratch0] "m"(scratch[0]),
+          [scratch1] "m"(scratch[1]), [scratch2] "m"(scratch[2]), [signature] "i"(rseq_signature)
+        : "memory", "cc", "rax"
+        : aborted, changed);
+    return 0;
+aborted:
+    return -1;
+changed:
+    return 1;
+}
+
+#endif
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// PerCpuRing
+// ---------------------------------------------------------------------------
+
+PerCpuRing::PerCpuRing(const std::size_t capacity_per_cpu, const bool allow_rseq)
+    : capacity_(std::bit_ceil(std::max(capacity_per_cpu, min_capacity))), cpu_count_(configured_cpus()),
+      use_rseq_(allow_rseq && rseq_available()), buffers_(std::make_unique<CpuBuffer[]>(cpu_count_)),
+      drained_to_(cpu_count_, 0) {
+    for (std::size_t cpu = 0; cpu < cpu_count_; ++cpu) {
+        buffers_[cpu].words = std::make_unique<std::uint64_t[]>(capacity_ / 8 + max_frame_words);
+    }
+}
+
+PerCpuRing::~PerCpuRing() = default;
+
+bool PerCpuRing::rseq_available() {
+#if PROJECT_TEMPLATE_HAS_RSEQ
+    // __rseq_size is 0 if glibc did not register (kernel < 4.18, or disabled via glibc.pthread.rseq=0)
+    return __rseq_size > 0 && static_cast<std::int32_t>(rseq_area()->cpu_id) >= 0;
+#else
+    return false;
+#endif
+}
+
+bool PerCpuRing::try_append(const std::span<const std::byte> record) {
+    if (record.size() > max_record) return false;
+
+    // frame on the stack: appends keep no per-thread state
+    std::array<std::uint64_t, max_frame_words> frame;
+    const auto words = frame_bytes(record.size()) / 8;
+    frame[words - 1] = 0; // padding
+    frame[0]         = record.size();
+    std::memcpy(&frame[1], record.data(), record.size());
+
+    const std::span<const std::uint64_t> view{frame.data(), words};
+    return use_rseq_ ? append_rseq_(view) : append_locked_(view);
+}
+
+bool PerCpuRing::append_rseq_(const std::span<const std::uint64_t> frame) {
+#if PROJECT_TEMPLATE_HAS_RSEQ
+    const auto bytes = frame.size() * 8;
+    auto* const area = rseq_area();
+    for (;;) {
+        const auto cpu = __atomic_load_n(&area->cpu_id_start, __ATOMIC_RELAXED);
+        if (cpu >= cpu_count_) return false; // cannot happen with get_nprocs_conf() CPUs; never share a ring
+
+        CpuBuffer& buffer = buffers_[cpu];
+        const auto head   = buffer.head.load(std::memory_order_relaxed);
+        if (head + bytes - buffer.tail.load(std::memory_order_acquire) > capacity_) {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        auto* const dst = buffer.words.get() + (head & (capacity_ - 1)) / 8;
+        if (rseq_copy_commit(area, cpu, buffer.head, head, dst, frame.data(), frame.size(), head + bytes) == 0) {
+            return true;
+        }
+        // preempted, migrated or signalled, or another thread on this CPU appended first: retry
+    }
+#else
+    return append_locked_(frame);
+#endif
+}
+
+bool PerCpuRing::append_locked_(const std::span<const std::uint64_t> frame) {
+    const auto bytes  = frame.size() * 8;
+    CpuBuffer& buffer = buffers_[current_cpu() % cpu_count_];
+
+    // the holder may be preempted on this very CPU, so yield rather than spin
+    while (buffer.locked.exchange(true, std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    const auto head = buffer.head.load(std::memory_order_relaxed);
+    const bool fits = head + bytes - buffer.tail.load(std::memory_order_acquire) <= capacity_;
+    if (fits) {
+        std::memcpy(buffer.words.get() + (head & (capacity_ - 1)) / 8, frame.data(), bytes);
+        buffer.head.store(head + bytes, std::memory_order_release);
+    }
+    buffer.locked.store(false, std::memory_order_release);
+
+    if (!fits) buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+    return fits;
+}
+
+std::size_t PerCpuRing::drain(const std::function<void(std::span<const std::span<const std::byte>>)>& consume) {
+    batch_.clear();
+    for (std::size_t cpu = 0; cpu < cpu_count_; ++cpu) {
+        const CpuBuffer& buffer = buffers_[cpu];
+        const auto head         = buffer.head.load(std::memory_order_acquire);
+        // a frame that runs past the end continues in the slack words, so every record is contiguous
+        for (auto pos = buffer.tail.load(std::memory_order_relaxed); pos < head;) {
+            const auto* const frame = buffer.words.get() + (pos & (capacity_ - 1)) / 8;
+            const auto size         = static_cast<std::size_t>(frame[0]);
+            batch_.emplace_back(reinterpret_cast<const std::byte*>(frame + 1), size);
+            pos += frame_bytes(size);
+        }
+        drained_to_[cpu] = head;
+    }
+    if (batch_.empty()) return 0;
+
+    consume(batch_);
+
+    // release exactly what was handed out: heads may have moved meanwhile
+    for (std::size_t cpu = 0; cpu < cpu_count_; ++cpu) {
+        buffers_[cpu].tail.store(drained_to_[cpu], std::memory_order_release);
+    }
+    return batch_.size();
+}
+
+std::size_t PerCpuRing::capacity_for(const std::size_t bytes) {
+    return capacity_for(bytes, configured_cpus());
+}
+
+std::size_t PerCpuRing::capacity_for(const std::size_t bytes, const std::size_t cpus) {
+    // the slack frame and the header are charged per CPU whatever the capacity
+    const auto per_cpu  = bytes / std::max(cpus, std::size_t{1});
+    const auto overhead = max_frame_words * 8 + sizeof(CpuBuffer);
+    const auto ring     = per_cpu > overhead ? per_cpu - overhead : 0;
+    return std::min(std::bit_floor(std::max(ring, min_capacity)), default_capacity);
+}
+
+std::size_t PerCpuRing::memory_bytes_for(const std::size_t capacity_per_cpu, const std::size_t cpus) {
+    const auto capacity = std::bit_ceil(std::max(capacity_per_cpu, min_capacity));
+    return cpus * ((capacity / 8 + max_frame_words) * 8 + sizeof(CpuBuffer));
+}
+
+std::size_t PerCpuRing::memory_bytes() const {
+    return memory_bytes_for(capacity_, cpu_count_);
+}
+
+std::uint64_t PerCpuRing::dropped() const {
+    std::uint64_t total = 0;
+    for (std::size_t cpu = 0; cpu < cpu_count_; ++cpu) {
+        total += buffers_[cpu].dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// ---------------------------------------------------------------------------
+// PerCpuLogger
+// ---------------------------------------------------------------------------
+
+PerCpuLogger::PerCpuLogger(std::string name, std::vector<spdlog::sink_ptr> sinks, const std::size_t capacity_per_cpu,
+                           const bool allow_rseq, LogMemoryBudget& budget)
+    : spdlog::logger(std::move(name), sinks.begin(), sinks.end()), ring_(capacity_per_cpu, allow_rseq),
+      capacity_per_cpu_(capacity_per_cpu), allow_rseq_(allow_rseq), budget_(&budget) {
+    budget_->charge(ring_.memory_bytes());
+    worker_ = std::thread([this] { run_(); });
+}
+
+PerCpuLogger::~PerCpuLogger() {
+    {
+        const std::scoped_lock lock{mutex_};
+        stop_ = true;
+    }
+    wake_.notify_one();
+    worker_.join();
+    budget_->release(ring_.memory_bytes());
+}
+
+std::shared_ptr<spdlog::logger> PerCpuLogger::clone(std::string logger_name) {
+    auto cloned =
+        std::make_shared<PerCpuLogger>(std::move(logger_name), sinks_, capacity_per_cpu_, allow_rseq_, *budget_);
+    cloned->set_level(level());
+    cloned->flush_on(flush_level());
+    return cloned;
+}
+
+void PerCpuLogger::sink_it_(const spdlog::details::log_msg& msg) {
+    if (!budget_->try_charge(0, msg.level)) return;
+
+    // stack buffer (inline for typical records): short-lived threads pay no per-thread setup
+    spdlog::memory_buf_t buffer;
+    encode_record(msg, buffer);
+    if (buffer.size() > PerCpuRing::max_record) {
+        // keep the record, cut the payload
+        auto truncated      = msg;
+        const auto overflow = buffer.size() - PerCpuRing::max_record;
+        const auto keep     = msg.payload.size() > overflow ? msg.payload.size() - overflow : 0;
+        truncated.payload   = spdlog::string_view_t{msg.payload.data(), keep};
+        buffer.clear();
+        encode_record(truncated, buffer);
+    }
+    ring_.try_append({reinterpret_cast<const std::byte*>(buffer.data()), buffer.size()});
+}
+
+void PerCpuLogger::flush_() {
+    std::unique_lock lock{mutex_};
+    const auto ticket = ++flush_requests_;
+    wake_.notify_one();
+    flushed_.wait(lock, [&] { return flush_done_ >= ticket; });
+}
+
+void PerCpuLogger::run_() {
+    constexpr std::chrono::microseconds min_poll_interval{50};
+    std::chrono::microseconds interval{0};
+    for (;;) {
+        std::uint64_t requested = 0;
+        bool stopping           = false;
+        {
+            std::unique_lock lock{mutex_};
+            if (interval.count() > 0) {
+                wake_.wait_for(lock, interval, [&] { return stop_ || flush_requests_ != flush_done_; });
+            }
+            requested = flush_requests_ != flush_done_ ? flush_requests_ : 0;
+            stopping  = stop_;
+        }
+
+        // everything appended before the flush request / stop is visible to this round
+        const auto written = write_round_();
+        if (requested != 0) {
+            flush_sinks_();
+            {
+                const std::scoped_lock lock{mutex_};
+                flush_done_ = requested;
+            }
+            flushed_.notify_all();
+        }
+        if (stopping && written == 0) {
+            flush_sinks_();
+            return;
+        }
+        // busy: go straight on; idle: back off
+        interval = written > 0 ? std::chrono::microseconds{0}
+                               : std::clamp(interval * 2, min_poll_interval, max_poll_interval);
+    }
+}
+
+std::size_t PerCpuLogger::write_round_() {
+    return ring_.drain([this](const std::span<const std::span<const std::byte>> records) {
+        batch_.clear();
+        for (const auto record_bytes : records) {
+            BinaryRecordReader reader{record_bytes};
+            BinaryRecord record;
+            if (reader.next(record)) batch_.push_back(record.to_log_msg());
+        }
+        // rings are drained CPU by CPU; restore time order (stable: equal stamps keep CPU order)
+        std::stable_sort(batch_.begin(), batch_.end(), [](const auto& a, const auto& b) { return a.time < b.time; });
+
+        const SinkGroupScope scope{std::span<const spdlog::details::log_msg>{batch_}};
+        for_each_sink(sinks_, [this](const spdlog::sink_ptr& sink) {
+            for (const auto& msg : batch_) {
+                if (!sink->should_log(msg.level)) continue;
+                try {
+                    sink->log(msg);
+                } catch (const std::exception& e) {
+                    err_handler_(e.what());
+                }
+            }
+        });
+        if (std::any_of(batch_.begin(), batch_.end(), [this](const auto& msg) { return should_flush_(msg); })) {
+            flush_sinks_();
+        }
+    });
+}
+
+void PerCpuLogger::flush_sinks_() {
+    for_each_sink(sinks_, [this](const spdlog::sink_ptr& sink) {
+        try {
+            sink->flush();
+        } catch (const std::exception& e) {
+            err_handler_(e.what());
+        }
+    });
+}
+
+} // namespace project_template::utils::log
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "log_memory.hpp"
+
+#include <spdlog/logger.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace project_template::utils::log {
+
+/**
+ * @brief One byte ring per CPU; producers append to the ring of the CPU they run on.
+ *
+ * Memory is `cpu_count() * capacity` regardless of how many threads log,
+ * and a producer never touches a cache line shared with producers on other
+ * CPUs. A single consumer drains all rings.
+ *
+ * Appends are lock-free restartable sequences (Linux rseq, registered by
+ * glibc ≥ 2.35, x86-64): the record is copied to the free space behind the
+ * ring's head and the head is bumped by a single store that commits the
+ * sequence. If the thread is preempted, migrated or signalled anywhere in
+ * between, the kernel restarts it at an abort handler and the append is
+ * simply retried, so no atomic read-modify-write is needed.
+ *
+ * Without rseq (older kernel or glibc, other architectures, or
+ * `allow_rseq = false`) each ring is guarded by a spinlock instead, selected
+ * by `sched_getcpu()`; contention stays limited to threads on the same CPU.
+ *
+ * Records are framed as `[u64 size][data]` padded to 8 bytes; a full ring
+ * drops the record and counts it in `dropped()`.
+ */
+class PerCpuRing {
+  public:
+    static constexpr std::size_t default_capacity = std::size_t{128} << 10; ///< bytes per CPU (rounded to 2^n)
+    static constexpr std::size_t max_record       = 4096 - 8;               ///< largest `try_append()` payload
+
+    explicit PerCpuRing(std::size_t capacity_per_cpu = default_capacity, bool allow_rseq = true);
+    ~PerCpuRing();
+
+    PerCpuRing(const PerCpuRing&)            = delete;
+    PerCpuRing& operator=(const PerCpuRing&) = delete;
+
+    /// @brief True if this process can use rseq appends (kernel + glibc registration, x86-64).
+    [[nodiscard]] static bool rseq_available();
+
+    /**
+     * @brief Largest capacity per CPU (2^n, at most `default_capacity`) whose rings fit into `bytes`.
+     *
+     * Counts everything `memory_bytes()` charges: besides the ring, each CPU
+     * has one max-size frame of slack and its buffer header. The capacity is
+     * at least 4 KiB, so below about 8.3 KiB per CPU the rings exceed `bytes`.
+     */
+    [[nodiscard]] static std::size_t capacity_for(std::size_t bytes);
+    [[nodiscard]] static std::size_t capacity_for(std::size_t bytes, std::size_t cpus);
+
+    /// @brief What `memory_bytes()` is for rings of `capacity_per_cpu` (as passed to the constructor) on `cpus`.
+    [[nodiscard]] static std::size_t memory_bytes_for(std::size_t capacity_per_cpu, std::size_t cpus);
+
+    /// @brief Append `record` to the calling CPU's ring; false if dropped (ring full or record too large).
+    bool try_append(std::span<const std::byte> record);
+
+    /**
+     * @brief Consumer side: hand every record currently in any ring to `consume` in one call.
+     *
+     * Records of one CPU keep their append order; records of different CPUs
+     * are concatenated CPU by CPU. The spans stay valid until `consume`
+     * returns, after which the space is released. Single consumer only.
+     *
+     * @return Number of records consumed.
+     */
+    std::size_t drain(const std::function<void(std::span<const std::span<const std::byte>>)>& consume);
+
+    [[nodiscard]] bool uses_rseq() const {
+        return use_rseq_;
+    }
+
+    [[nodiscard]] std::size_t cpu_count() const {
+        return cpu_count_;
+    }
+
+    /// @brief Bytes reserved for all rings.
+    [[nodiscard]] std::size_t memory_bytes() const;
+
+    /// @brief Records dropped because their CPU's ring was full.
+    [[nodiscard]] std::uint64_t dropped() const;
+
+  private:
+    struct CpuBuffer;
+
+    bool append_rseq_(std::span<const std::uint64_t> frame);
+    bool append_locked_(std::span<const std::uint64_t> frame);
+
+    std::size_t capacity_;
+    std::size_t cpu_count_;
+    bool use_rseq_;
+    std::unique_ptr<CpuBuffer[]> buffers_;
+    std::vector<std::span<const std::byte>> batch_; ///< consumer-only scratch
+    std::vector<std::uint64_t> drained_to_;         ///< consumer-only: per-CPU head of the last drain
+};
+
+/**
+ * @brief Asynchronous logger backed by a `PerCpuRing` (`Mode::PerCpu`).
+ *
+ * Producers encode records in the binary log format (no formatting on the
+ * caller thread, no per-thread state) and append them to their CPU's ring;
+ * a worker thread drains all rings, restores timestamp order across CPUs
+ * and writes each round to the sinks in one pass.
+ *
+ * The hot path touches no shared counter, so the worker is not signalled:
+ * it polls, backing off from 50 µs up to `max_poll_interval` while idle.
+ * `flush()` (and therefore `error`/`critical` through `Log`) wakes it and
+ * waits until everything appended before the call has been written.
+ * Payloads longer than a ring record are truncated; a full ring drops.
+ *
+ * The rings are charged to a `LogMemoryBudget` as a fixed allocation;
+ * records need no further memory, so of the budget policies only the early
+ * drop of low-severity records under `BudgetPolicy::DropLowSeverity` applies.
+ */
+class PerCpuLogger final : public spdlog::logger {
+  public:
+    static constexpr std::chrono::microseconds max_poll_interval{5000};
+
+    PerCpuLogger(std::string name, std::vector<spdlog::sink_ptr> sinks,
+                 std::size_t capacity_per_cpu = PerCpuRing::default_capacity, bool allow_rseq = true,
+                 LogMemoryBudget& budget = LogMemoryBudget::global());
+
+    /// @brief Write everything still buffered, then stop the worker.
+    ~PerCpuLogger() override;
+
+    PerCpuLogger(const PerCpuLogger&)            = delete;
+    PerCpuLogger& operator=(const PerCpuLogger&) = delete;
+
+    [[nodiscard]] std::shared_ptr<spdlog::logger> clone(std::string logger_name) override;
+
+    [[nodiscard]] const PerCpuRing& ring() const {
+        return ring_;
+    }
+
+  protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override;
+
+  private:
+    void run_();
+    /// @brief Drain one round from all CPUs and write it; returns the number of records.
+    std::size_t write_round_();
+    void flush_sinks_();
+
+    PerCpuRing ring_;
+    std::size_t capacity_per_cpu_;
+    bool allow_rseq_;
+    LogMemoryBudget* budget_;
+    std::vector<spdlog::details::log_msg> batch_; ///< worker-only scratch
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable flushed_;
+    bool stop_                    = false;
+    std::uint64_t flush_requests_ = 0;
+    std::uint64_t flush_done_     = 0;
+
+    std::thread worker_;
+};
+
+} // namespace project_template::utils::log
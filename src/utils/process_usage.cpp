@@ -0,0 +1,107 @@
+#include "process_usage.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace project_template::utils::metrics {
+
+ProcessUsage process_usage() {
+    ProcessUsage usage;
+#if defined(__unix__) || defined(__APPLE__)
+    rusage ru{};
+    if (::getrusage(RUSAGE_SELF, &ru) == 0) {
+        const auto to_ns = [](const timeval& tv) {
+            return static_cast<std::uint64_t>(tv.tv_sec) * 1'000'000'000 +
+                   static_cast<std::uint64_t>(tv.tv_usec) * 1000;
+        };
+        usage.user_cpu_ns   = to_ns(ru.ru_utime);
+        usage.system_cpu_ns = to_ns(ru.ru_stime);
+#if defined(__APPLE__)
+        usage.peak_rss_bytes = static_cast<std::uint64_t>(ru.ru_maxrss); // bytes on macOS
+#else
+        usage.peak_rss_bytes = static_cast<std::uint64_t>(ru.ru_maxrss) * 1024; // KiB on Linux
+#endif
+    }
+#endif
+#if defined(__linux__)
+    // statm: size resident shared text lib data dt, in pages
+    std::ifstream statm{"/proc/self/statm"};
+    std::uint64_t size_pages     = 0;
+    std::uint64_t resident_pages = 0;
+    if (statm >> size_pages >> resident_pages) {
+        usage.rss_bytes = resident_pages * static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+    }
+    // the kernel updates the high-water mark lazily, so it can trail the current RSS
+    usage.peak_rss_bytes = std::max(usage.peak_rss_bytes, usage.rss_bytes);
+#endif
+    return usage;
+}
+
+#if defined(__linux__)
+namespace {
+
+/// Value of a `Name:   1234 kB` line, in bytes.
+std::uint64_t kib_field(const std::string& line, const std::string_view name) {
+    if (!line.starts_with(name) || line.size() <= name.size() || line[name.size()] != ':') return 0;
+    return std::stoull(line.substr(name.size() + 1)) * 1024;
+}
+
+} // namespace
+#endif
+
+ProcessMemory process_memory([[maybe_unused]] const bool rollup) {
+    ProcessMemory memory;
+#if defined(__linux__)
+    const auto page = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+    std::ifstream statm{"/proc/self/statm"};
+    std::uint64_t size = 0, resident = 0, shared = 0, text = 0, lib = 0, data = 0;
+    if (statm >> size >> resident >> shared >> text >> lib >> data) {
+        memory.size_bytes   = size * page;
+        memory.rss_bytes    = resident * page;
+        memory.shared_bytes = shared * page;
+        memory.text_bytes   = text * page;
+        memory.data_bytes   = data * page;
+    }
+    if (!rollup) return memory;
+
+    std::ifstream smaps{"/proc/self/smaps_rollup"};
+    for (std::string line; std::getline(smaps, line);) {
+        memory.rollup = true;
+        memory.pss_bytes += kib_field(line, "Pss");
+        memory.anonymous_bytes += kib_field(line, "Anonymous");
+        memory.private_dirty_bytes += kib_field(line, "Private_Dirty");
+        memory.shared_dirty_bytes += kib_field(line, "Shared_Dirty");
+        memory.swap_bytes += kib_field(line, "Swap");
+    }
+#endif
+    return memory;
+}
+
+std::uint64_t peak_rss_bytes() {
+#if defined(__linux__)
+    std::ifstream status{"/proc/self/status"};
+    for (std::string line; std::getline(status, line);) {
+        if (line.starts_with("VmHWM:")) return kib_field(line, "VmHWM");
+    }
+#endif
+    return 0;
+}
+
+bool reset_peak_rss() {
+#if defined(__linux__)
+    std::ofstream clear_refs{"/proc/self/clear_refs"};
+    clear_refs << "5" << std::flush; // 5: reset the peak RSS to the current RSS
+    return static_cast<bool>(clear_refs);
+#else
+    return false;
+#endif
+}
+
+} // namespace project_template::utils::metrics
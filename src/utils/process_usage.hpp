@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+namespace project_template::utils::metrics {
+
+/**
+ * @brief CPU time and resident memory of the calling process.
+ *
+ * CPU times are summed over all threads since the process started; take
+ * two samples and subtract them to measure a run. On Linux RSS comes from
+ * `/proc/self/statm` and the peak from `getrusage()`. Elsewhere the fields
+ * that cannot be read are 0.
+ */
+struct ProcessUsage {
+    std::uint64_t user_cpu_ns    = 0;
+    std::uint64_t system_cpu_ns  = 0;
+    std::uint64_t rss_bytes      = 0; ///< resident set size now
+    std::uint64_t peak_rss_bytes = 0; ///< highest resident set size so far
+
+    [[nodiscard]] std::uint64_t cpu_ns() const noexcept {
+        return user_cpu_ns + system_cpu_ns;
+    }
+};
+
+/// @brief Sample the calling process.
+ProcessUsage process_usage();
+
+/**
+ * @brief Memory map summary of the calling process (Linux; all 0 elsewhere).
+ *
+ * The first group comes from `/proc/self/statm`, which is cheap to read.
+ * The second comes from `/proc/self/smaps_rollup` (Linux 4.14+), which the
+ * kernel computes by walking every mapping: sample it periodically, not
+ * per operation. `rollup` is false if it could not be read.
+ */
+struct ProcessMemory {
+    std::uint64_t size_bytes   = 0; ///< virtual size
+    std::uint64_t rss_bytes    = 0; ///< resident set size
+    std::uint64_t shared_bytes = 0; ///< resident file-backed pages (shared libraries, mapped files)
+    std::uint64_t text_bytes   = 0;
+    std::uint64_t data_bytes   = 0; ///< data + stack (virtual)
+
+    bool rollup                       = false;
+    std::uint64_t pss_bytes           = 0; ///< RSS with shared pages divided among the processes mapping them
+    std::uint64_t anonymous_bytes     = 0; ///< resident heap, stacks and anonymous mappings
+    std::uint64_t private_dirty_bytes = 0;
+    std::uint64_t shared_dirty_bytes  = 0;
+    std::uint64_t swap_bytes          = 0;
+};
+
+/// @brief Read `/proc/self/statm` and, if `rollup` is set, `/proc/self/smaps_rollup`.
+ProcessMemory process_memory(bool rollup = true);
+
+/**
+ * @name Resident-set high-water mark
+ * `VmHWM` from `/proc/self/status`. Unlike `ProcessUsage::peak_rss_bytes`
+ * it can be reset (`/proc/self/clear_refs`), so the peak of one phase,
+ * e.g. one benchmark, can be measured.
+ * @{
+ */
+/// @brief Highest resident set size since the start or the last `reset_peak_rss()`; 0 if unknown.
+std::uint64_t peak_rss_bytes();
+
+/// @brief Restart the high-water mark at the current RSS. Returns false where that is not supported.
+bool reset_peak_rss();
+/// @}
+
+} // namespace project_template::utils::metrics
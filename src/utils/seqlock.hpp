@@ -0,0 +1,129 @@
+#pragma once
+
+#include "strided_slots.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace project_template::utils::concurrency {
+
+/**
+ * @brief Snapshot of a small, trivially copyable value, read without writing shared memory.
+ *
+ * A sequence counter guards the payload: `store()` makes it odd, writes the
+ * payload and makes it even again. `load()` reads the counter, copies the
+ * payload and re-reads the counter, retrying if a store was in progress or
+ * completed in between. Readers only load, so any number of them read the
+ * same cache lines in parallel without bouncing them between cores. In
+ * contrast, `std::shared_mutex` makes every reader write its reader count.
+ * The price is that readers retry while a store is in progress, so this
+ * suits data that is read far more often than written: statistics,
+ * configuration, calibration results.
+ *
+ *   SeqLock<Limits> limits{{.max_bytes = 1 << 20}};
+ *   const auto current = limits.load();            // any thread, lock-free
+ *   limits.update([](Limits& l) { l.max_bytes *= 2; });
+ *
+ * The payload is stored in relaxed atomic words rather than as a plain `T`,
+ * so a reader racing a writer copies torn words (and discards them) instead
+ * of causing a data race. Writers are serialized by a mutex. Keep `T`
+ * small: every `load()` copies all of it, and a retry copies it again.
+ */
+template <class T> class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock<T> copies T bytewise; use Versioned<T> otherwise");
+
+  public:
+    SeqLock() : SeqLock(T{}) {}
+
+    explicit SeqLock(const T& value) noexcept {
+        write_words_(value);
+    }
+
+    SeqLock(const SeqLock&)            = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    /// @brief Consistent copy of the last stored value. Spins (then yields) while a store is in progress.
+    [[nodiscard]] T load() const noexcept {
+        for (unsigned attempt = 0;; ++attempt) {
+            const auto before = sequence_.load(std::memory_order_acquire);
+            if ((before & 1) == 0) {
+                std::array<std::uint64_t, word_count> copy;
+                for (std::size_t i = 0; i < word_count; ++i) {
+                    copy[i] = words_[i].load(std::memory_order_relaxed);
+                }
+                // orders the payload loads before the re-check (a load-load barrier; free on x86)
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence_.load(std::memory_order_relaxed) == before) return from_words_(copy);
+            }
+            if (attempt >= 64) std::this_thread::yield(); // the writer may have been preempted
+        }
+    }
+
+    void store(const T& value) {
+        const std::lock_guard lock{writer_};
+        write_locked_(value);
+    }
+
+    /// @brief Read-modify-write: `f(T&)` is applied to a copy of the current value, which is then stored.
+    template <class F> void update(F&& f) {
+        const std::lock_guard lock{writer_};
+        T value = read_words_();
+        std::forward<F>(f)(value);
+        write_locked_(value);
+    }
+
+    /// @brief Completed stores so far (the counter halved); changes whenever the value may have.
+    [[nodiscard]] std::uint64_t version() const noexcept {
+        return sequence_.load(std::memory_order_acquire) / 2;
+    }
+
+  private:
+    static constexpr std::size_t word_count = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    void write_locked_(const T& value) noexcept {
+        const auto sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        // the odd counter must be visible before any payload word changes
+        std::atomic_thread_fence(std::memory_order_release);
+        write_words_(value);
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    void write_words_(const T& value) noexcept {
+        std::array<std::uint64_t, word_count> copy{};
+        std::memcpy(copy.data(), &value, sizeof(T));
+        for (std::size_t i = 0; i < word_count; ++i) {
+            words_[i].store(copy[i], std::memory_order_relaxed);
+        }
+    }
+
+    /// Only under `writer_`: no store can be in progress.
+    [[nodiscard]] T read_words_() const noexcept {
+        std::array<std::uint64_t, word_count> copy;
+        for (std::size_t i = 0; i < word_count; ++i) {
+            copy[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        return from_words_(copy);
+    }
+
+    [[nodiscard]] static T from_words_(const std::array<std::uint64_t, word_count>& words) noexcept {
+        std::array<std::byte, sizeof(T)> bytes;
+        std::memcpy(bytes.data(), words.data(), sizeof(T));
+        return std::bit_cast<T>(bytes);
+    }
+
+    // counter and payload share the first line; the mutex, which only writers touch, is kept off it
+    alignas(container::cache_line_size) std::atomic<std::uint64_t> sequence_{0};
+    std::array<std::atomic<std::uint64_t>, word_count> words_;
+    alignas(container::cache_line_size) std::mutex writer_;
+};
+
+} // namespace project_template::utils::concurrency
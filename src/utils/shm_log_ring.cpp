@@ -0,0 +1,342 @@
+#include "shm_log_ring.hpp"
+
+#include "binary_log.hpp"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+namespace project_template::utils::log {
+
+// ---------------------------------------------------------------------------
+// Shared layout
+// ---------------------------------------------------------------------------
+
+struct ShmLogRing::Header {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t slot_size;
+    std::uint64_t slot_count;
+
+    alignas(64) std::atomic<std::uint64_t> head; ///< next position producers claim
+    alignas(64) std::atomic<std::uint64_t> tail; ///< next position the collector retires
+    alignas(64) std::atomic<std::uint64_t> dropped;
+    std::atomic<std::uint64_t> lost;
+    std::atomic<std::uint32_t> ready; ///< set last by create(), checked by attach()
+};
+
+struct alignas(64) ShmLogRing::Slot {
+    std::atomic<std::uint64_t> seq;  ///< (position << 2) | state
+    std::atomic<std::int32_t> owner; ///< pid of the writing producer
+    std::uint32_t size;
+    std::byte data[slot_payload];
+};
+
+namespace {
+
+constexpr std::array<char, 8> ring_magic = {'P', 'T', 'L', 'O', 'G', 'S', 'H', 'M'};
+constexpr std::uint32_t ring_version     = 1;
+constexpr std::uint64_t state_free       = 0;
+constexpr std::uint64_t state_writing    = 1;
+constexpr std::uint64_t state_ready      = 2;
+constexpr std::chrono::milliseconds dead_owner_check{10};
+
+constexpr std::uint64_t seq_of(const std::uint64_t position, const std::uint64_t state) {
+    return (position << 2) | state;
+}
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "the ring relies on address-free atomics");
+static_assert(std::atomic<std::int32_t>::is_always_lock_free, "the ring relies on address-free atomics");
+
+/// getpid() without a syscall per record; refreshed in fork children.
+std::atomic<std::int32_t> cached_pid{0};
+
+std::int32_t current_pid() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        cached_pid.store(static_cast<std::int32_t>(::getpid()), std::memory_order_relaxed);
+        ::pthread_atfork(nullptr, nullptr,
+                         [] { cached_pid.store(static_cast<std::int32_t>(::getpid()), std::memory_order_relaxed); });
+    });
+    return cached_pid.load(std::memory_order_relaxed);
+}
+
+bool process_is_gone(const std::int32_t pid) {
+    return pid > 0 && ::kill(pid, 0) != 0 && errno == ESRCH;
+}
+
+[[noreturn]] void throw_errno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Setup / teardown
+// ---------------------------------------------------------------------------
+
+ShmLogRing ShmLogRing::create(const std::string& name, const std::size_t slot_count) {
+    if (slot_count == 0 || (slot_count & (slot_count - 1)) != 0) {
+        throw std::invalid_argument("ShmLogRing: slot_count must be a power of two");
+    }
+    const auto bytes = sizeof(Header) + slot_count * sizeof(Slot);
+
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0660);
+    if (fd < 0) throw_errno("shm_open " + name);
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || (st.st_size == 0 && ::ftruncate(fd, static_cast<off_t>(bytes)) != 0)) {
+        const int err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), "sizing " + name);
+    }
+    const auto size = st.st_size == 0 ? bytes : static_cast<std::size_t>(st.st_size);
+    void* mapping   = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) throw_errno("mmap " + name);
+
+    auto* header = static_cast<Header*>(mapping);
+    if (header->ready.load(std::memory_order_acquire) != 0) {
+        // a previous collector's ring: keep its records, but it has to match
+        if (header->magic != ring_magic || header->version != ring_version || header->slot_size != sizeof(Slot) ||
+            size != sizeof(Header) + header->slot_count * sizeof(Slot)) {
+            ::munmap(mapping, size);
+            throw std::runtime_error("ShmLogRing: incompatible existing ring " + name);
+        }
+        return {mapping, size};
+    }
+    if (size != bytes) {
+        ::munmap(mapping, size);
+        throw std::runtime_error("ShmLogRing: half-initialized ring of a different size " + name);
+    }
+
+    // fresh (zero-filled) region: every slot starts free for its first lap
+    header->magic      = ring_magic;
+    header->version    = ring_version;
+    header->slot_size  = sizeof(Slot);
+    header->slot_count = slot_count;
+    auto* slots        = reinterpret_cast<Slot*>(static_cast<std::byte*>(mapping) + sizeof(Header));
+    for (std::uint64_t i = 0; i < slot_count; ++i) {
+        slots[i].seq.store(seq_of(i, state_free), std::memory_order_relaxed);
+    }
+    header->ready.store(1, std::memory_order_release);
+    return {mapping, size};
+}
+
+ShmLogRing ShmLogRing::attach(const std::string& name) {
+    const int fd = ::shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+    if (fd < 0) throw_errno("shm_open " + name);
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        const int err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), "fstat " + name);
+    }
+    const auto size = static_cast<std::size_t>(st.st_size);
+    if (size < sizeof(Header)) {
+        ::close(fd);
+        throw std::runtime_error("ShmLogRing: ring " + name + " is not initialized");
+    }
+    void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) throw_errno("mmap " + name);
+
+    const auto* header = static_cast<const Header*>(mapping);
+    if (header->ready.load(std::memory_order_acquire) == 0 || header->magic != ring_magic ||
+        header->version != ring_version || header->slot_size != sizeof(Slot) ||
+        size != sizeof(Header) + header->slot_count * sizeof(Slot)) {
+        ::munmap(mapping, size);
+        throw std::runtime_error("ShmLogRing: ring " + name + " is not initialized or incompatible");
+    }
+    return {mapping, size};
+}
+
+void ShmLogRing::unlink(const std::string& name) {
+    ::shm_unlink(name.c_str());
+}
+
+ShmLogRing::ShmLogRing(void* mapping, const std::size_t size)
+    : mapping_(mapping), size_(size), header_(static_cast<Header*>(mapping)),
+      slots_(static_cast<std::byte*>(mapping) + sizeof(Header)) {}
+
+ShmLogRing::ShmLogRing(ShmLogRing&& other) noexcept
+    : mapping_(std::exchange(other.mapping_, nullptr)), size_(std::exchange(other.size_, 0)),
+      header_(std::exchange(other.header_, nullptr)), slots_(std::exchange(other.slots_, nullptr)),
+      stall_position_(other.stall_position_), stall_since_(other.stall_since_) {}
+
+ShmLogRing& ShmLogRing::operator=(ShmLogRing&& other) noexcept {
+    if (this != &other) {
+        std::swap(mapping_, other.mapping_);
+        std::swap(size_, other.size_);
+        std::swap(header_, other.header_);
+        std::swap(slots_, other.slots_);
+        std::swap(stall_position_, other.stall_position_);
+        std::swap(stall_since_, other.stall_since_);
+    }
+    return *this;
+}
+
+ShmLogRing::~ShmLogRing() {
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, size_);
+    }
+}
+
+ShmLogRing::Slot& ShmLogRing::slot(const std::uint64_t position) const {
+    const auto index = position & (header_->slot_count - 1);
+    return *std::launder(reinterpret_cast<Slot*>(slots_ + index * sizeof(Slot)));
+}
+
+// ---------------------------------------------------------------------------
+// Producer side
+// ---------------------------------------------------------------------------
+
+ShmLogRing::Reservation ShmLogRing::try_reserve() {
+    auto position = header_->head.load(std::memory_order_relaxed);
+    for (;;) {
+        const auto seq = slot(position).seq.load(std::memory_order_acquire);
+        if (seq == seq_of(position, state_free)) {
+            if (header_->head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        } else if (seq < seq_of(position, state_free)) {
+            // still holds the record from one lap ago: full
+            header_->dropped.fetch_add(1, std::memory_order_relaxed);
+            return {};
+        } else {
+            position = header_->head.load(std::memory_order_relaxed); // someone else took it
+        }
+    }
+
+    auto& s = slot(position);
+    s.owner.store(current_pid(), std::memory_order_relaxed);
+    auto expected = seq_of(position, state_free);
+    if (!s.seq.compare_exchange_strong(expected, seq_of(position, state_writing), std::memory_order_acq_rel)) {
+        // we stalled so long that the collector gave up on this position
+        header_->dropped.fetch_add(1, std::memory_order_relaxed);
+        return {};
+    }
+    return {.data = {s.data, slot_payload}, .position = position, .valid = true};
+}
+
+bool ShmLogRing::commit(const Reservation& reservation, const std::size_t size) {
+    auto& s       = slot(reservation.position);
+    s.size        = static_cast<std::uint32_t>(std::min(size, slot_payload));
+    auto expected = seq_of(reservation.position, state_writing);
+    if (!s.seq.compare_exchange_strong(expected, seq_of(reservation.position, state_ready),
+                                       std::memory_order_release, std::memory_order_relaxed)) {
+        header_->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool ShmLogRing::try_push(const std::span<const std::byte> record) {
+    if (record.size() > slot_payload) {
+        header_->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    const auto reservation = try_reserve();
+    if (!reservation) return false;
+    std::memcpy(reservation.data.data(), record.data(), record.size());
+    return commit(reservation, record.size());
+}
+
+// ---------------------------------------------------------------------------
+// Collector side
+// ---------------------------------------------------------------------------
+
+std::size_t ShmLogRing::drain(const std::function<void(std::span<const std::byte>)>& consume,
+                              const std::size_t max_records) {
+    auto tail           = header_->tail.load(std::memory_order_relaxed);
+    std::size_t retired = 0;
+
+    while (retired < max_records) {
+        auto& s             = slot(tail);
+        const auto seq      = s.seq.load(std::memory_order_acquire);
+        const auto next_lap = seq_of(tail + header_->slot_count, state_free);
+
+        if (seq == seq_of(tail, state_ready)) {
+            consume({s.data, std::min<std::size_t>(s.size, slot_payload)});
+            s.seq.store(next_lap, std::memory_order_release);
+        } else if (header_->head.load(std::memory_order_acquire) <= tail) {
+            break; // empty
+        } else if (should_skip_stalled(s, tail, seq)) {
+            auto expected = seq;
+            if (!s.seq.compare_exchange_strong(expected, next_lap, std::memory_order_acq_rel)) {
+                continue; // the producer made progress after all; look again
+            }
+            header_->lost.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            break; // a producer is still writing
+        }
+        ++tail;
+        ++retired;
+        header_->tail.store(tail, std::memory_order_release);
+    }
+    return retired;
+}
+
+bool ShmLogRing::should_skip_stalled(const Slot& slot, const std::uint64_t tail, const std::uint64_t seq) {
+    const auto now = std::chrono::steady_clock::now();
+    if (stall_position_ != tail) {
+        stall_position_ = tail;
+        stall_since_    = now;
+        return false;
+    }
+    const auto stalled = now - stall_since_;
+    if (seq == seq_of(tail, state_writing)) {
+        return stalled >= dead_owner_check && process_is_gone(slot.owner.load(std::memory_order_relaxed));
+    }
+    // claimed through `head` but never marked: the producer died between the two CASes, or is descheduled
+    return seq == seq_of(tail, state_free) && stalled >= claim_timeout;
+}
+
+std::size_t ShmLogRing::slot_count() const {
+    return header_->slot_count;
+}
+
+std::uint64_t ShmLogRing::backlog() const {
+    return header_->head.load(std::memory_order_relaxed) - header_->tail.load(std::memory_order_relaxed);
+}
+
+std::uint64_t ShmLogRing::dropped() const {
+    return header_->dropped.load(std::memory_order_relaxed);
+}
+
+std::uint64_t ShmLogRing::lost() const {
+    return header_->lost.load(std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// ShmRingSink
+// ---------------------------------------------------------------------------
+
+void ShmRingSink::sink_it_(const spdlog::details::log_msg& msg) {
+    thread_local spdlog::memory_buf_t buffer;
+    buffer.clear();
+    encode_record(msg, buffer);
+    if (buffer.size() > ShmLogRing::slot_payload) {
+        // keep the record, cut the payload
+        auto truncated      = msg;
+        const auto overflow = buffer.size() - ShmLogRing::slot_payload;
+        const auto keep     = msg.payload.size() > overflow ? msg.payload.size() - overflow : 0;
+        truncated.payload   = spdlog::string_view_t{msg.payload.data(), keep};
+        buffer.clear();
+        encode_record(truncated, buffer);
+    }
+    ring_.try_push({reinterpret_cast<const std::byte*>(buffer.data()), buffer.size()});
+}
+
+} // namespace project_template::utils::log
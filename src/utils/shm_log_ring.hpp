@@ -0,0 +1,145 @@
+#pragma once
+
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <utility>
+
+namespace project_template::utils::log {
+
+/**
+ * @brief Multi-process, multi-producer / single-consumer ring of log records in shared memory.
+ *
+ * One collector process `create()`s the ring (POSIX `shm_open` + `mmap`) and
+ * drains it into the real sinks; any number of producer processes `attach()`
+ * and push encoded records (see `binary_log.hpp`). Producers never block and
+ * never make a syscall on the hot path: when the ring is full the record is
+ * dropped and counted in `dropped()`.
+ *
+ * The ring is an array of fixed-size slots, each guarded by a sequence word
+ * `(position << 2) | state` with state free → writing → ready. A producer
+ * claims a position with a CAS on `head`, marks its slot `writing` (storing
+ * its pid in the slot first), copies the record and marks it `ready`.
+ *
+ * Producer crashes: a slot stuck in `writing` whose owner pid no longer
+ * exists, or a position claimed but never marked (crash between the two
+ * CASes) that stays stuck for `claim_timeout`, is skipped by the collector
+ * and counted in `lost()`. Both transitions are CASes on the slot's sequence
+ * word, so a producer that was merely slow notices it lost its slot and
+ * drops its record instead of overwriting a newer one.
+ *
+ * Records larger than `slot_payload` must be truncated by the caller.
+ */
+class ShmLogRing {
+  public:
+    static constexpr std::size_t slot_size          = 512;
+    static constexpr std::size_t slot_payload       = slot_size - 16;
+    static constexpr std::size_t default_slot_count = 1 << 14; ///< 8 MiB ring
+
+    /// Ring used by `Log::init(..., Mode::Shared)` and `project_template_logcollector`.
+    static constexpr const char* default_name = "/project_template_log";
+
+    /// How long a claimed-but-unmarked position may block the collector before it is skipped.
+    static constexpr std::chrono::milliseconds claim_timeout{1000};
+
+    /// A claimed slot; write up to `slot_payload` bytes into `data`, then `commit()`.
+    struct Reservation {
+        std::span<std::byte> data;
+        std::uint64_t position = 0;
+        bool valid             = false;
+
+        explicit operator bool() const {
+            return valid;
+        }
+    };
+
+    /// @brief Create the ring (or reopen the one a previous collector left behind).
+    static ShmLogRing create(const std::string& name, std::size_t slot_count = default_slot_count);
+
+    /// @brief Attach to an existing ring; throws `std::system_error` / `std::runtime_error` if unavailable.
+    static ShmLogRing attach(const std::string& name);
+
+    /// @brief Remove the ring's name (existing mappings stay valid).
+    static void unlink(const std::string& name);
+
+    ShmLogRing(ShmLogRing&& other) noexcept;
+    ShmLogRing& operator=(ShmLogRing&& other) noexcept;
+    ShmLogRing(const ShmLogRing&)            = delete;
+    ShmLogRing& operator=(const ShmLogRing&) = delete;
+    ~ShmLogRing();
+
+    /// @name Producer side (any thread of any process)
+    /// @{
+    [[nodiscard]] Reservation try_reserve();
+    /// @brief Publish `size` bytes of a reservation; false if the collector reclaimed the slot meanwhile.
+    bool commit(const Reservation& reservation, std::size_t size);
+    /// @brief Copy `record` into the ring; false if it was dropped (ring full or record too large).
+    bool try_push(std::span<const std::byte> record);
+    /// @}
+
+    /**
+     * @brief Collector side: hand up to `max_records` ready records to `consume`, in ring order.
+     *
+     * Returns the number of slots retired (consumed or skipped after a
+     * producer crash). Must only be called from one thread.
+     */
+    std::size_t drain(const std::function<void(std::span<const std::byte>)>& consume, std::size_t max_records);
+
+    [[nodiscard]] std::size_t slot_count() const;
+    /// @brief Records not yet retired by the collector.
+    [[nodiscard]] std::uint64_t backlog() const;
+    /// @brief Records producers dropped because the ring was full or they lost their slot.
+    [[nodiscard]] std::uint64_t dropped() const;
+    /// @brief Slots the collector skipped because their producer died mid-write.
+    [[nodiscard]] std::uint64_t lost() const;
+
+  private:
+    struct Header;
+    struct Slot;
+
+    ShmLogRing(void* mapping, std::size_t size);
+
+    Slot& slot(std::uint64_t position) const;
+    /// @brief Decide whether the unpublished slot at the tail belongs to a dead producer.
+    bool should_skip_stalled(const Slot& slot, std::uint64_t tail, std::uint64_t seq);
+
+    void* mapping_    = nullptr;
+    std::size_t size_ = 0;
+    Header* header_   = nullptr;
+    std::byte* slots_ = nullptr;
+
+    std::uint64_t stall_position_ = ~std::uint64_t{0};
+    std::chrono::steady_clock::time_point stall_since_{};
+};
+
+/**
+ * @brief Producer-side sink: encodes each record and pushes it into a `ShmLogRing`.
+ *
+ * Lock-free (`null_mutex`): concurrent `log()` calls from several threads only
+ * contend on the ring's head counter. Payloads that do not fit into a slot
+ * are truncated. `flush()` is a no-op; the collector owns all I/O.
+ */
+class ShmRingSink final : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+  public:
+    explicit ShmRingSink(ShmLogRing ring) : ring_(std::move(ring)) {}
+
+    [[nodiscard]] const ShmLogRing& ring() const {
+        return ring_;
+    }
+
+  protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override {}
+
+  private:
+    ShmLogRing ring_;
+};
+
+} // namespace project_template::utils::log
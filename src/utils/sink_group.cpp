@@ -0,0 +1,162 @@
+#include "sink_group.hpp"
+
+#include <spdlog/pattern_formatter.h>
+
+#include <array>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace project_template::utils::log {
+
+struct SinkGroupFormatter::Group {
+    std::uint64_t id;
+    std::unique_ptr<spdlog::formatter> prototype; ///< only cloned, never used to format
+};
+
+namespace {
+
+std::uint64_t next_group_id() {
+    static std::atomic<std::uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// Where a covered record's text lies in its group's buffer.
+struct Formatted {
+    std::uint64_t scope     = 0; ///< scope the text belongs to; stale otherwise
+    std::size_t offset      = 0;
+    std::size_t size        = 0;
+    std::size_t color_start = 0; ///< relative to `offset`
+    std::size_t color_end   = 0;
+};
+
+/// One group's state on one thread.
+struct GroupCache {
+    std::uint64_t group = 0;
+    std::unique_ptr<spdlog::formatter> formatter; ///< this thread's clone of the prototype
+    std::uint64_t scope = 0;                      ///< scope `text` was filled in
+    spdlog::memory_buf_t text;
+    std::vector<Formatted> records; ///< by position in the scope
+};
+
+/// Larger text buffers are released when their scope closes, so one burst of long records does not pin memory.
+constexpr std::size_t max_retained_text = 1 << 20;
+
+struct ThreadState {
+    const std::byte* first = nullptr; ///< first record of the open scope; null if none
+    std::size_t stride     = 0;
+    std::size_t count      = 0;
+    std::uint64_t scope    = 0; ///< serial of the open (or last) scope
+    std::array<GroupCache, 4> groups;
+    std::size_t next_victim = 0;
+
+    /// Position of `msg` in the open scope, or `count` if it is not covered.
+    [[nodiscard]] std::size_t position(const spdlog::details::log_msg& msg) const noexcept {
+        const auto* address = reinterpret_cast<const std::byte*>(&msg);
+        if (first == nullptr || address < first) return count;
+        const auto distance = static_cast<std::size_t>(address - first);
+        const auto index    = distance / stride;
+        return index < count && distance % stride == 0 ? index : count;
+    }
+
+    GroupCache& cache_for(const std::uint64_t id, const spdlog::formatter& prototype) {
+        for (auto& cache : groups) {
+            if (cache.group == id) return cache;
+        }
+        // least recently added group gives way; more than four patterns just format more often
+        auto& cache     = groups[next_victim++ % groups.size()];
+        cache.group     = id;
+        cache.formatter = prototype.clone();
+        cache.scope     = 0;
+        cache.records.clear();
+        return cache;
+    }
+};
+
+thread_local ThreadState thread_state;
+
+void append_formatted(const GroupCache& cache, const Formatted& record, const spdlog::details::log_msg& msg,
+                      spdlog::memory_buf_t& dest) {
+    const auto base = dest.size();
+    dest.append(cache.text.data() + record.offset, cache.text.data() + record.offset + record.size);
+    msg.color_range_start = base + record.color_start;
+    msg.color_range_end   = base + record.color_end;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// SinkGroupFormatter
+// ---------------------------------------------------------------------------
+
+SinkGroupFormatter::SinkGroupFormatter(const std::string& pattern)
+    : SinkGroupFormatter(std::make_unique<spdlog::pattern_formatter>(pattern)) {}
+
+SinkGroupFormatter::SinkGroupFormatter(std::unique_ptr<spdlog::formatter> prototype)
+    : group_(std::make_shared<const Group>(Group{next_group_id(), std::move(prototype)})) {}
+
+SinkGroupFormatter::SinkGroupFormatter(std::shared_ptr<const Group> group) noexcept : group_(std::move(group)) {}
+
+std::unique_ptr<spdlog::formatter> SinkGroupFormatter::clone() const {
+    return std::unique_ptr<spdlog::formatter>(new SinkGroupFormatter(group_));
+}
+
+std::uint64_t SinkGroupFormatter::group() const noexcept {
+    return group_->id;
+}
+
+void SinkGroupFormatter::format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) {
+    auto& state = thread_state;
+    auto& cache = state.cache_for(group_->id, *group_->prototype);
+
+    const auto position = state.position(msg);
+    if (position == state.count) {
+        cache.formatter->format(msg, dest);
+        return;
+    }
+
+    if (cache.scope != state.scope) {
+        cache.scope = state.scope;
+        cache.text.clear();
+        if (cache.records.size() < state.count) cache.records.resize(state.count);
+    }
+    auto& record = cache.records[position];
+    if (record.scope != state.scope) {
+        // first sink of the group to see this record: format it for all of them
+        const auto offset     = cache.text.size();
+        msg.color_range_start = 0;
+        msg.color_range_end   = 0;
+        cache.formatter->format(msg, cache.text);
+        const bool colored = msg.color_range_end > msg.color_range_start;
+        record = {state.scope, offset, cache.text.size() - offset, colored ? msg.color_range_start - offset : 0,
+                  colored ? msg.color_range_end - offset : 0};
+    }
+    append_formatted(cache, record, msg, dest);
+}
+
+// ---------------------------------------------------------------------------
+// SinkGroupScope
+// ---------------------------------------------------------------------------
+
+SinkGroupScope::SinkGroupScope(const spdlog::details::log_msg* first, const std::size_t stride,
+                               const std::size_t count) noexcept
+    : active_(thread_state.first == nullptr && count > 0) {
+    if (!active_) return;
+    auto& state  = thread_state;
+    state.first  = reinterpret_cast<const std::byte*>(first);
+    state.stride = stride;
+    state.count  = count;
+    ++state.scope;
+}
+
+SinkGroupScope::~SinkGroupScope() {
+    if (!active_) return;
+    auto& state = thread_state;
+    state.first = nullptr;
+    state.count = 0;
+    for (auto& cache : state.groups) {
+        if (cache.text.capacity() > max_retained_text) cache.text = spdlog::memory_buf_t{};
+    }
+}
+
+} // namespace project_template::utils::log
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <spdlog/details/log_msg.h>
+#include <spdlog/formatter.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace project_template::utils::log {
+
+/**
+ * @brief Formatter shared by a group of sinks: each record is formatted once per group, not once per sink.
+ *
+ * spdlog gives every sink its own formatter, so a record written to a
+ * console and a file sink with the same pattern is formatted twice. Give
+ * those sinks clones of one `SinkGroupFormatter` instead (`SinkRegistry`
+ * does so for the pattern set on it) and, while a `SinkGroupScope` marks
+ * the records being written, the first sink of the group formats a record
+ * and the others copy the text, including the color range of `%^...%$`.
+ * Sinks with other patterns or formatters form their own groups or format
+ * as usual, so formatting runs once per distinct pattern.
+ *
+ * Outside a scope, or for a record the scope does not cover (e.g. a copy
+ * a decorator made to rewrite the payload, as `TerminalSafeSink` does),
+ * the formatter simply formats. Each thread formats with its own clone of
+ * the prototype, so one formatter may be used from several threads.
+ */
+class SinkGroupFormatter final : public spdlog::formatter {
+  public:
+    /// @brief A new group formatting with `spdlog::pattern_formatter{pattern}`.
+    explicit SinkGroupFormatter(const std::string& pattern);
+
+    /// @brief A new group formatting with clones of `prototype` (e.g. a pattern with custom flags).
+    explicit SinkGroupFormatter(std::unique_ptr<spdlog::formatter> prototype);
+
+    void format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) override;
+
+    /// @brief A formatter of the same group: sinks given clones share the formatted records.
+    [[nodiscard]] std::unique_ptr<spdlog::formatter> clone() const override;
+
+    /// @brief Identifies the group; unique for the lifetime of the process.
+    [[nodiscard]] std::uint64_t group() const noexcept;
+
+  private:
+    struct Group;
+    explicit SinkGroupFormatter(std::shared_ptr<const Group> group) noexcept;
+
+    std::shared_ptr<const Group> group_;
+};
+
+/**
+ * @brief Marks the records one thread is about to write to several sinks, so groups format each of them once.
+ *
+ * Opened around a fan-out: one record (`SinkRegistry::log`) or a batch
+ * written sink by sink (`BatchAsyncLogger`, `PerCpuLogger`). Records are
+ * recognized by address, so the covered `log_msg`s must stay alive and
+ * unchanged while the scope is open. A batch is described by its first
+ * record, the distance between records in bytes and their count, so
+ * records inside larger ring cells can be covered without copying.
+ *
+ * Formatted text is kept per thread and group until the scope closes.
+ * Scopes nest; an inner scope leaves the outer one in charge.
+ */
+class SinkGroupScope {
+  public:
+    explicit SinkGroupScope(const spdlog::details::log_msg& msg) noexcept : SinkGroupScope(&msg, sizeof(msg), 1) {}
+
+    explicit SinkGroupScope(std::span<const spdlog::details::log_msg> records) noexcept
+      : SinkGroupScope(records.data(), sizeof(spdlog::details::log_msg), records.size()) {}
+
+    SinkGroupScope(const spdlog::details::log_msg& first, const std::size_t stride, const std::size_t count) noexcept
+      : SinkGroupScope(&first, stride, count) {}
+
+    ~SinkGroupScope();
+
+    SinkGroupScope(const SinkGroupScope&)            = delete;
+    SinkGroupScope& operator=(const SinkGroupScope&) = delete;
+
+  private:
+    SinkGroupScope(const spdlog::details::log_msg* first, std::size_t stride, std::size_t count) noexcept;
+
+    bool active_; ///< false for a nested or empty scope
+};
+
+} // namespace project_template::utils::log
@@ -0,0 +1,142 @@
+#include "sink_registry.hpp"
+
+#include "sink_group.hpp"
+
+#include <spdlog/details/log_msg.h>
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <utility>
+
+namespace project_template::utils::log {
+
+namespace {
+
+/// Reader counter of the calling thread: handed out round-robin, so concurrent threads rarely share a line.
+std::size_t reader_slot() {
+    static std::atomic<std::size_t> next_slot{0};
+    thread_local const std::size_t slot =
+        next_slot.fetch_add(1, std::memory_order_relaxed) % SinkRegistry::reader_slots;
+    return slot;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// readers
+// ---------------------------------------------------------------------------
+
+SinkRegistry::Pinned::Pinned(std::atomic<std::uint64_t>& readers, const std::vector<spdlog::sink_ptr>& sinks)
+    : readers_(&readers), sinks_(&sinks) {}
+
+SinkRegistry::Pinned::~Pinned() {
+    // release: our reads of the array happen before the writer that waits for this counter frees it
+    readers_->fetch_sub(1, std::memory_order_release);
+}
+
+SinkRegistry::Pinned SinkRegistry::pin() const {
+    auto& slot = readers_[reader_slot()];
+    for (;;) {
+        // count ourselves in the current generation, then confirm it did not flip meanwhile: a writer flipping
+        // after the check waits for this counter, one flipping before it would be missed (seq_cst throughout)
+        const auto generation = generation_.load();
+        auto& active          = slot.active[generation & 1U];
+        active.fetch_add(1);
+        if (generation_.load() == generation) {
+            return Pinned{active, *current_.load()};
+        }
+        active.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+std::vector<spdlog::sink_ptr> SinkRegistry::snapshot() const {
+    const auto sinks = pin();
+    return {sinks.begin(), sinks.end()};
+}
+
+void SinkRegistry::log(const spdlog::details::log_msg& msg) {
+    // a throwing sink must not keep the record from the others; the first error goes to the logger
+    std::exception_ptr error;
+    const SinkGroupScope scope{msg}; // sinks sharing the registry's pattern format the record once
+    for (const auto& sink : pin()) {
+        if (!sink->should_log(msg.level)) continue;
+        try {
+            sink->log(msg);
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void SinkRegistry::flush() {
+    std::exception_ptr error;
+    for (const auto& sink : pin()) {
+        try {
+            sink->flush();
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+// ---------------------------------------------------------------------------
+// writers
+// ---------------------------------------------------------------------------
+
+SinkRegistry::SinkRegistry(std::vector<spdlog::sink_ptr> sinks) : current_(new List(std::move(sinks))) {}
+
+SinkRegistry::~SinkRegistry() {
+    delete current_.load();
+}
+
+void SinkRegistry::add(spdlog::sink_ptr sink) {
+    const std::lock_guard lock{write_mutex_};
+    const auto& current = *current_.load();
+    if (std::find(current.begin(), current.end(), sink) != current.end()) return;
+
+    if (formatter_) sink->set_formatter(formatter_->clone());
+    auto next = current;
+    next.push_back(std::move(sink));
+    publish_(std::move(next));
+}
+
+bool SinkRegistry::remove(const spdlog::sink_ptr& sink) {
+    const std::lock_guard lock{write_mutex_};
+    auto next = *current_.load();
+    const auto it = std::find(next.begin(), next.end(), sink);
+    if (it == next.end()) return false;
+
+    next.erase(it);
+    publish_(std::move(next));
+    return true;
+}
+
+void SinkRegistry::publish_(List next) {
+    const auto* const old = current_.exchange(new List(std::move(next)));
+
+    // readers arriving from now on count in the other generation and see the new array; wait out the rest
+    const auto generation = generation_.fetch_add(1) & 1U;
+    for (std::size_t i = 0; i < readers_.size(); ++i) {
+        while (readers_[i].active[generation].load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+    delete old;
+}
+
+void SinkRegistry::set_pattern(const std::string& pattern) {
+    set_formatter(std::make_unique<SinkGroupFormatter>(pattern));
+}
+
+void SinkRegistry::set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) {
+    // writers are serialized, so the current array cannot be freed underneath us
+    const std::lock_guard lock{write_mutex_};
+    for (const auto& sink : *current_.load()) {
+        sink->set_formatter(sink_formatter->clone());
+    }
+    formatter_ = std::move(sink_formatter);
+}
+
+} // namespace project_template::utils::log
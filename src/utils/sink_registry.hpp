@@ -0,0 +1,145 @@
+#pragma once
+
+#include "strided_slots.hpp"
+
+#include <spdlog/sinks/sink.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace project_template::utils::log {
+
+/**
+ * @brief Sink that fans records out to a set of sinks which may change while logging.
+ *
+ * `spdlog::logger::sinks()` is a plain vector: changing it while another
+ * thread logs is a data race. The registry is installed as the logger's only
+ * sink instead and holds the real sinks in an immutable array; `add()` and
+ * `remove()` copy the array, change the copy and publish it with one atomic
+ * pointer store (copy-on-write).
+ *
+ * Logging threads take no lock to read the array. They announce themselves
+ * in one of `reader_slots` counters on their own cache lines (picked per
+ * thread, so threads rarely share one; see `StridedSlots` for packing them
+ * to reproduce false sharing) and then load the current array. A writer
+ * publishes the new array, flips the counter generation and waits until the
+ * readers counted in the old generation have left, then frees the old array
+ * (a grace period, as in sleepable RCU). New readers never delay the writer.
+ *
+ * Guarantees:
+ *  - a record goes to the sinks of one published array, never a mix;
+ *  - when `remove()` returns, the sink receives no further records and the
+ *    registry holds no reference to it, so a capture sink can be inspected
+ *    or destroyed right away;
+ *  - the formatter last set on the registry is applied to sinks added later.
+ *
+ * `set_pattern()` gives the sinks clones of one `SinkGroupFormatter`, so a
+ * record is formatted once for all of them rather than once per sink; the
+ * fan-out in `log()` (and in the batch writers, per batch) opens the
+ * `SinkGroupScope` that makes them share the text. A sink given its own
+ * pattern afterwards formats for itself.
+ *
+ * `add()` and `remove()` wait for writes in progress, so they must not be
+ * called from within a sink of the same registry.
+ */
+class SinkRegistry final : public spdlog::sinks::sink {
+  public:
+    /// Reader counters; more slots mean fewer threads sharing a cache line.
+    static constexpr std::size_t reader_slots = 16;
+
+    /**
+     * @brief The sinks published when `pin()` was called.
+     *
+     * While it lives, the array (and every sink in it) stays valid and a
+     * concurrent `remove()` waits. Keep it short-lived: one record or batch.
+     */
+    class Pinned {
+      public:
+        ~Pinned();
+        Pinned(const Pinned&)            = delete;
+        Pinned& operator=(const Pinned&) = delete;
+
+        [[nodiscard]] auto begin() const {
+            return sinks_->begin();
+        }
+        [[nodiscard]] auto end() const {
+            return sinks_->end();
+        }
+        [[nodiscard]] std::size_t size() const {
+            return sinks_->size();
+        }
+
+      private:
+        friend class SinkRegistry;
+        Pinned(std::atomic<std::uint64_t>& readers, const std::vector<spdlog::sink_ptr>& sinks);
+
+        std::atomic<std::uint64_t>* readers_;
+        const std::vector<spdlog::sink_ptr>* sinks_;
+    };
+
+    explicit SinkRegistry(std::vector<spdlog::sink_ptr> sinks = {});
+    ~SinkRegistry() override;
+
+    SinkRegistry(const SinkRegistry&)            = delete;
+    SinkRegistry& operator=(const SinkRegistry&) = delete;
+
+    /// @brief Attach `sink` (formatted like the registry, if a pattern was set). Adding it twice is a no-op.
+    void add(spdlog::sink_ptr sink);
+
+    /// @brief Detach `sink`; returns false if it was not attached. Returns once no thread writes to it.
+    bool remove(const spdlog::sink_ptr& sink);
+
+    /// @brief Pin the current sinks for iteration without locks.
+    [[nodiscard]] Pinned pin() const;
+
+    /// @brief Copy of the current sinks.
+    [[nodiscard]] std::vector<spdlog::sink_ptr> snapshot() const;
+
+    /// @brief Writes each record to every attached sink whose level admits it.
+    void log(const spdlog::details::log_msg& msg) override;
+    void flush() override;
+    /// @brief Applied to the attached sinks, as one formatting group, and remembered for sinks added later.
+    void set_pattern(const std::string& pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override;
+
+  private:
+    using List = std::vector<spdlog::sink_ptr>;
+
+    struct ReaderSlot {
+        std::atomic<std::uint64_t> active[2] = {}; ///< readers per generation
+    };
+
+    void publish_(List next); ///< caller holds write_mutex_
+
+    mutable container::StridedSlots<ReaderSlot> readers_{reader_slots};
+    alignas(64) std::atomic<const List*> current_;
+    std::atomic<std::uint32_t> generation_{0}; ///< low bit selects the counter new readers use
+
+    std::mutex write_mutex_;                       ///< serializes add / remove / set_formatter
+    std::unique_ptr<spdlog::formatter> formatter_; ///< applied to added sinks; guarded by write_mutex_
+};
+
+/**
+ * @brief Call `f(sink)` for each sink in `sinks`, expanding a `SinkRegistry` into its pinned sinks.
+ *
+ * Lets batch writers keep their sink-major loop (each sink takes a whole
+ * batch while its state is hot) when the logger's sinks are a registry.
+ */
+template <class F> void for_each_sink(const std::vector<spdlog::sink_ptr>& sinks, F&& f) {
+    for (const auto& sink : sinks) {
+        if (const auto* registry = dynamic_cast<const SinkRegistry*>(sink.get())) {
+            for (const auto& attached : registry->pin()) {
+                f(attached);
+            }
+        } else {
+            f(sink);
+        }
+    }
+}
+
+} // namespace project_template::utils::log
@@ -0,0 +1,23 @@
+#include "static_logger.hpp"
+
+#include <spdlog/common.h>
+
+#include <cerrno>
+#include <filesystem>
+
+namespace project_template::utils::log {
+
+StaticFileSink::StaticFileSink(const std::string& path, const bool truncate) : path_(path) {
+    if (const auto directory = std::filesystem::path{path}.parent_path(); !directory.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec); // fopen reports what matters
+    }
+    file_.reset(std::fopen(path.c_str(), truncate ? "wb" : "ab"));
+    if (!file_) fail_("open");
+}
+
+void StaticFileSink::fail_(const char* operation) const {
+    spdlog::throw_spdlog_ex(std::string{"static file sink: failed to "} + operation + " " + path_, errno);
+}
+
+} // namespace project_template::utils::log
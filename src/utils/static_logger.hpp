@@ -0,0 +1,292 @@
+#pragma once
+
+#include "logger.hpp"
+
+#include <spdlog/details/log_msg.h>
+#include <spdlog/pattern_formatter.h>
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace project_template::utils::log {
+
+/**
+ * @brief What `StaticLogger` requires of a sink: write a formatted record, flush.
+ *
+ * Called with the logger's lock held, so a sink needs no synchronization of
+ * its own. `text` is the record formatted with the logger's pattern; `msg`
+ * carries level, time and payload for sinks that look at the fields.
+ */
+template <class S>
+concept StaticSink = requires(S& sink, const spdlog::details::log_msg& msg, std::string_view text) {
+    sink.write(msg, text);
+    sink.flush();
+};
+
+/**
+ * @brief Appends records to a file through stdio's buffer; the file of a `StaticLogger` deployment.
+ *
+ * No rotation and no index: for those, use `Log` and its
+ * `IndexedRotatingFileSink`. Writing is one `fwrite_unlocked()` into the
+ * stdio buffer, since the logger already serializes its sinks.
+ */
+class StaticFileSink {
+  public:
+    /// @brief Open `path` for appending (truncated with `truncate`); creates missing directories. Throws on failure.
+    explicit StaticFileSink(const std::string& path, bool truncate = false);
+
+    void write(const spdlog::details::log_msg& /*msg*/, const std::string_view text) {
+        if (fwrite_unlocked(text.data(), 1, text.size(), file_.get()) != text.size()) fail_("write");
+    }
+
+    void flush() {
+        if (std::fflush(file_.get()) != 0) fail_("flush");
+    }
+
+    [[nodiscard]] const std::string& path() const noexcept {
+        return path_;
+    }
+
+  private:
+    struct Close {
+        void operator()(std::FILE* file) const noexcept {
+            std::fclose(file);
+        }
+    };
+
+    [[noreturn]] void fail_(const char* operation) const;
+
+    std::string path_;
+    std::unique_ptr<std::FILE, Close> file_;
+};
+
+/**
+ * @brief Metrics tap: counts records and bytes per level, readable from any thread while logging.
+ */
+class StaticCountingSink {
+  public:
+    StaticCountingSink() = default;
+
+    /// Copies take a snapshot of the counts (so a sink can be passed to the `StaticLogger` constructor).
+    StaticCountingSink(const StaticCountingSink& other) noexcept : bytes_(other.bytes()) {
+        for (std::size_t i = 0; i < records_.size(); ++i) {
+            records_[i].store(other.records_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    StaticCountingSink& operator=(const StaticCountingSink&) = delete;
+
+    void write(const spdlog::details::log_msg& msg, const std::string_view text) noexcept {
+        records_[static_cast<std::size_t>(msg.level)].fetch_add(1, std::memory_order_relaxed);
+        bytes_.fetch_add(text.size(), std::memory_order_relaxed);
+    }
+
+    void flush() noexcept {}
+
+    [[nodiscard]] std::uint64_t records(const spdlog::level::level_enum level) const noexcept {
+        return records_[static_cast<std::size_t>(level)].load(std::memory_order_relaxed);
+    }
+
+    /// @brief Records over all levels.
+    [[nodiscard]] std::uint64_t records() const noexcept {
+        std::uint64_t total = 0;
+        for (const auto& count : records_) {
+            total += count.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /// @brief Formatted bytes seen, i.e. what a file sink next to it has written.
+    [[nodiscard]] std::uint64_t bytes() const noexcept {
+        return bytes_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::array<std::atomic<std::uint64_t>, spdlog::level::n_levels> records_{};
+    std::atomic<std::uint64_t> bytes_{0};
+};
+
+/**
+ * @brief Logger front-end over a sink list fixed at compile time: no virtual calls, one lock, one format.
+ *
+ * `Log` composes its sinks at run time: `spdlog::logger` walks a vector of
+ * `sink_ptr`, calling the virtual `log()` of each sink, which takes its own
+ * mutex and formats the record with its own formatter. For a deployment
+ * whose sinks never change, `StaticLogger<StaticFileSink, StaticCountingSink>`
+ * keeps the sinks in a tuple instead: a record is formatted once with the
+ * logger's pattern, under one lock, and handed to each sink by a direct,
+ * inlinable call.
+ *
+ *   StaticLogger<StaticFileSink, StaticCountingSink> logger{
+ *       "[%T.%f] [%^%l%$] %v", StaticFileSink{"logs/service.log"}, StaticCountingSink{}};
+ *   logger.info("listening on port {}", port);
+ *   const auto errors = logger.sink<StaticCountingSink>().records(spdlog::level::err);
+ *
+ * It offers the members the `LOG_*` macros use, so a target can route them
+ * here at compile time (see `StaticLogFrontend`). Messages start with the
+ * thread's `LogContext` prefix, as with `Log`. Records are written on the
+ * calling thread; error and critical records flush all sinks. Sink
+ * exceptions are reported on stderr, as spdlog does, and do not reach the
+ * caller.
+ */
+template <StaticSink... Sinks> class StaticLogger {
+  public:
+    explicit StaticLogger(Sinks... sinks) : StaticLogger("[%T.%f] [%^%l%$] %v", std::move(sinks)...) {}
+
+    StaticLogger(const std::string& pattern, Sinks... sinks)
+      : formatter_(pattern), sinks_(std::move(sinks)...) {}
+
+    StaticLogger(const StaticLogger&)            = delete;
+    StaticLogger& operator=(const StaticLogger&) = delete;
+
+    [[nodiscard]] bool should_log(const spdlog::level::level_enum level) const noexcept {
+        return level >= level_.load(std::memory_order_relaxed);
+    }
+
+    void set_level(const spdlog::level::level_enum level) noexcept {
+        level_.store(level, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] spdlog::level::level_enum level() const noexcept {
+        return level_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief The sink of type `S` (e.g. to read a counting sink). Access is not synchronized with logging.
+    template <class S> [[nodiscard]] S& sink() noexcept {
+        return std::get<S>(sinks_);
+    }
+
+    template <typename... Args>
+    void log(const spdlog::level::level_enum level, spdlog::fmt_lib::format_string<Args...> format, Args&&... args) {
+        if (!should_log(level)) return;
+        spdlog::memory_buf_t payload;
+        append_log_context(payload);
+        spdlog::fmt_lib::format_to(std::back_inserter(payload), format, std::forward<Args>(args)...);
+        write_(level, std::string_view{payload.data(), payload.size()});
+    }
+
+    /// @brief As `Log::log_compiled()`: the format was compiled at the call site.
+    template <typename CompiledFormat, typename... Args>
+    void log_compiled(const spdlog::level::level_enum level, const CompiledFormat& format, Args&&... args) {
+        if (!should_log(level)) return;
+        spdlog::memory_buf_t payload;
+        append_log_context(payload);
+        spdlog::fmt_lib::format_to(std::back_inserter(payload), format, std::forward<Args>(args)...);
+        write_(level, std::string_view{payload.data(), payload.size()});
+    }
+
+    /// @name Convenience functions, as on `Log`
+    /// @{
+    template <typename... Args> void trace(spdlog::fmt_lib::format_string<Args...> format, Args&&... args) {
+        log(spdlog::level::trace, format, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> void debug(spdlog::fmt_lib::format_string<Args...> format, Args&&... args) {
+        log(spdlog::level::debug, format, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> void info(spdlog::fmt_lib::format_string<Args...> format, Args&&... args) {
+        log(spdlog::level::info, format, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> void warn(spdlog::fmt_lib::format_string<Args...> format, Args&&... args) {
+        log(spdlog::level::warn, format, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> void error(spdlog::fmt_lib::format_string<Args...> format, Args&&... args) {
+        log(spdlog::level::err, format, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> void critical(spdlog::fmt_lib::format_string<Args...> format, Args&&... args) {
+        log(spdlog::level::critical, format, std::forward<Args>(args)...);
+    }
+    /// @}
+
+    void flush() {
+        const std::lock_guard lock{mutex_};
+        flush_locked_();
+    }
+
+  private:
+    void write_(const spdlog::level::level_enum level, const std::string_view message) {
+        const spdlog::details::log_msg msg{"project_template", level, message};
+        const std::lock_guard lock{mutex_};
+        try {
+            // the formatter caches the current second, so it is used under the lock as well
+            text_.clear();
+            formatter_.format(msg, text_);
+            const std::string_view text{text_.data(), text_.size()};
+            std::apply([&](auto&... sinks) { (sinks.write(msg, text), ...); }, sinks_);
+            if (level >= spdlog::level::err) flush_locked_();
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "[*** LOG ERROR ***] [project_template] %s\n", e.what());
+        }
+    }
+
+    void flush_locked_() {
+        std::apply([](auto&... sinks) { (sinks.flush(), ...); }, sinks_);
+    }
+
+    std::atomic<spdlog::level::level_enum> level_{spdlog::level::info};
+    std::mutex mutex_;
+    spdlog::pattern_formatter formatter_; ///< guarded by mutex_
+    spdlog::memory_buf_t text_;           ///< formatted record; guarded by mutex_
+    std::tuple<Sinks...> sinks_;
+};
+
+/**
+ * @brief Routes the `LOG_*` macros to a `StaticLogger` with static storage duration.
+ *
+ * The macros log through `PROJECT_LOG_FRONTEND` (by default `Log`). Define
+ * it for a target, before `logger.hpp` is included, to a frontend of the
+ * deployment's logger, and every `LOG_*` call compiles into direct calls
+ * into its sinks:
+ *
+ *   // app_log.hpp
+ *   inline StaticLogger<StaticFileSink, StaticCountingSink> app_logger{...};
+ *   // CMake: target_compile_definitions(app PRIVATE
+ *   //     "PROJECT_LOG_FRONTEND=::project_template::utils::log::StaticLogFrontend<app_logger>")
+ */
+template <auto& Logger> struct StaticLogFrontend {
+    template <typename CompiledFormat, typename... Args>
+    static void log_compiled(const spdlog::level::level_enum level, const CompiledFormat& format, Args&&... args) {
+        Logger.log_compiled(level, format, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> static void trace(spdlog::fmt_lib::format_string<Args...> format, Args&&... args) {
+        Logger.trace(format, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> static void debug(spdlog::fmt_lib::format_string<Args...> format, Args&&... args) {
+        Logger.debug(format, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> static void info(spdlog::fmt_lib::format_string<Args...> format, Args&&... args) {
+        Logger.info(format, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> static void warn(spdlog::fmt_lib::format_string<Args...> format, Args&&... args) {
+        Logger.warn(format, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> static void error(spdlog::fmt_lib::format_string<Args...> format, Args&&... args) {
+        Logger.error(format, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> static void critical(spdlog::fmt_lib::format_string<Args...> format, Args&&... args) {
+        Logger.critical(format, std::forward<Args>(args)...);
+    }
+};
+
+} // namespace project_template::utils::log
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace project_template::utils::container {
+
+/// Cache line size assumed for padding (x86-64 and most AArch64 cores).
+inline constexpr std::size_t cache_line_size = 64;
+
+/**
+ * @brief Process-wide stride override for `StridedSlots` built without an explicit stride.
+ *
+ * A debugging aid for false sharing: set to 8 or 16 to pack the per-thread
+ * slots of every utility into shared cache lines (and confirm that a slowdown
+ * goes away with padding), or to 128 to keep them off adjacent-line prefetch
+ * pairs. 0 (the default) pads each slot to whole cache lines. Initialized from
+ * the environment variable `PROJECT_TEMPLATE_SLOT_STRIDE`; changing it affects
+ * only slots constructed afterwards.
+ */
+inline std::atomic<std::size_t>& slot_stride_override() {
+    static std::atomic<std::size_t> stride{[] {
+        const char* env = std::getenv("PROJECT_TEMPLATE_SLOT_STRIDE");
+        return env != nullptr ? static_cast<std::size_t>(std::strtoull(env, nullptr, 10)) : std::size_t{0};
+    }()};
+    return stride;
+}
+
+/**
+ * @brief Fixed number of per-thread (or per-CPU) slots of `T`, `stride()` bytes apart.
+ *
+ * Per-thread counters and buffers are only free of false sharing if no two
+ * of them share a cache line, which `alignas` on the element type hard-codes.
+ * Here the placement is a run-time choice: by default every slot starts on
+ * its own cache line, and a debug build, test or benchmark can pass (or set
+ * `slot_stride_override()` to) a smaller stride to provoke false sharing, or
+ * a larger one to rule out adjacent-line prefetch effects.
+ *
+ * The slots are default-constructed in a cache-line-aligned block and are
+ * not movable; `T` is typically an atomic or a small struct of atomics.
+ */
+template <class T> class StridedSlots {
+  public:
+    /// @brief Stride used when none is given: `slot_stride_override()` if set, else `sizeof(T)` padded to lines.
+    [[nodiscard]] static std::size_t default_stride() {
+        if (const auto stride = slot_stride_override().load(std::memory_order_relaxed); stride > 0) {
+            return std::max(round_up(stride, alignof(T)), round_up(sizeof(T), alignof(T)));
+        }
+        return round_up(sizeof(T), cache_line_size);
+    }
+
+    /// @throws std::invalid_argument if `stride` is smaller than `T` or not a multiple of its alignment.
+    explicit StridedSlots(const std::size_t count, const std::size_t stride = default_stride())
+        : count_(count), stride_(stride) {
+        if (stride_ < sizeof(T) || stride_ % alignof(T) != 0) {
+            throw std::invalid_argument("StridedSlots: stride " + std::to_string(stride_) +
+                                        " does not fit the element type");
+        }
+        storage_ = static_cast<std::byte*>(::operator new(bytes_(), std::align_val_t{align_()}));
+        for (std::size_t i = 0; i < count_; ++i) {
+            ::new (storage_ + i * stride_) T();
+        }
+    }
+
+    ~StridedSlots() {
+        for (std::size_t i = 0; i < count_; ++i) {
+            (*this)[i].~T();
+        }
+        ::operator delete(storage_, bytes_(), std::align_val_t{align_()});
+    }
+
+    StridedSlots(const StridedSlots&)            = delete;
+    StridedSlots& operator=(const StridedSlots&) = delete;
+
+    [[nodiscard]] T& operator[](const std::size_t i) noexcept {
+        return *std::launder(reinterpret_cast<T*>(storage_ + i * stride_));
+    }
+
+    [[nodiscard]] const T& operator[](const std::size_t i) const noexcept {
+        return *std::launder(reinterpret_cast<const T*>(storage_ + i * stride_));
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return count_;
+    }
+
+    [[nodiscard]] std::size_t stride() const noexcept {
+        return stride_;
+    }
+
+    /// @brief True if slots `i` and `j` (i != j) have bytes in a common cache line: writers to them false-share.
+    [[nodiscard]] bool shares_line(std::size_t i, std::size_t j) const noexcept {
+        if (i > j) std::swap(i, j);
+        const auto last_line_of_i  = (i * stride_ + sizeof(T) - 1) / cache_line_size;
+        const auto first_line_of_j = (j * stride_) / cache_line_size;
+        return i != j && last_line_of_i >= first_line_of_j;
+    }
+
+  private:
+    static constexpr std::size_t round_up(const std::size_t n, const std::size_t to) {
+        return (n + to - 1) / to * to;
+    }
+
+    [[nodiscard]] std::size_t bytes_() const noexcept {
+        return std::max<std::size_t>(count_ * stride_, 1);
+    }
+
+    [[nodiscard]] static constexpr std::size_t align_() noexcept {
+        return std::max(alignof(T), cache_line_size);
+    }
+
+    std::size_t count_;
+    std::size_t stride_;
+    std::byte* storage_ = nullptr;
+};
+
+} // namespace project_template::utils::container
@@ -0,0 +1,39 @@
+#include "terminal_safe_sink.hpp"
+
+#include "text_escape.hpp"
+
+#include <spdlog/details/log_msg.h>
+
+#include <string_view>
+#include <utility>
+
+namespace project_template::utils::log {
+
+TerminalSafeSink::TerminalSafeSink(spdlog::sink_ptr inner) : inner_(std::move(inner)) {}
+
+void TerminalSafeSink::log(const spdlog::details::log_msg& msg) {
+    const std::string_view payload{msg.payload.data(), msg.payload.size()};
+    if (!text::needs_terminal_escaping(payload)) {
+        inner_->log(msg);
+        return;
+    }
+    spdlog::memory_buf_t escaped;
+    text::append_terminal_safe(escaped, payload);
+    auto copy    = msg;
+    copy.payload = spdlog::string_view_t{escaped.data(), escaped.size()};
+    inner_->log(copy);
+}
+
+void TerminalSafeSink::flush() {
+    inner_->flush();
+}
+
+void TerminalSafeSink::set_pattern(const std::string& pattern) {
+    inner_->set_pattern(pattern);
+}
+
+void TerminalSafeSink::set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) {
+    inner_->set_formatter(std::move(sink_formatter));
+}
+
+} // namespace project_template::utils::log
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <spdlog/sinks/sink.h>
+
+#include <memory>
+#include <string>
+
+namespace project_template::utils::log {
+
+/**
+ * @brief Sink decorator that makes message text safe to print on a terminal.
+ *
+ * Forwards every record to `inner`. A payload containing control characters
+ * other than newline and tab, DEL, or ill-formed UTF-8 is forwarded as a copy
+ * passed through `text::append_terminal_safe()`, so a logged string cannot
+ * move the cursor, recolor or retitle the terminal. Clean payloads, the
+ * common case, cost one SIMD scan and are forwarded without copying.
+ *
+ * Only the payload is rewritten; the pattern (including the inner sink's
+ * own color codes) is applied by `inner` as usual. Thread safety is that of
+ * `inner`.
+ */
+class TerminalSafeSink final : public spdlog::sinks::sink {
+  public:
+    explicit TerminalSafeSink(spdlog::sink_ptr inner);
+
+    void log(const spdlog::details::log_msg& msg) override;
+    void flush() override;
+    void set_pattern(const std::string& pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override;
+
+    [[nodiscard]] const spdlog::sink_ptr& inner() const {
+        return inner_;
+    }
+
+  private:
+    spdlog::sink_ptr inner_;
+};
+
+} // namespace project_template::utils::log
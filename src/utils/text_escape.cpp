@@ -0,0 +1,491 @@
+#include "text_escape.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define PROJECT_TEMPLATE_ESCAPE_X86 1
+#endif
+
+namespace project_template::utils::text {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// scans: find the next byte that needs attention
+// ---------------------------------------------------------------------------
+
+/// Which ASCII bytes a scan stops at.
+enum class Scan {
+    Json,     ///< control characters, `"`, `\`
+    Terminal, ///< control characters except `\n` and `\t`, DEL
+    NonAscii, ///< none (only useful together with `Utf8`)
+};
+
+/// `Utf8` scans also stop at every byte >= 0x80 so it can be validated; the others assume valid UTF-8.
+template <Scan S, bool Utf8> constexpr bool stops_at(const unsigned char c) {
+    if (c >= 0x80) return Utf8;
+    switch (S) {
+        case Scan::Json:
+            return c < 0x20 || c == '"' || c == '\\';
+        case Scan::Terminal:
+            return (c < 0x20 && c != '\n' && c != '\t') || c == 0x7F;
+        case Scan::NonAscii:
+            return false;
+    }
+    return false;
+}
+
+template <Scan S, bool Utf8> constexpr auto stop_table = [] {
+    std::array<bool, 256> t{};
+    for (std::size_t c = 0; c < t.size(); ++c) {
+        t[c] = stops_at<S, Utf8>(static_cast<unsigned char>(c));
+    }
+    return t;
+}();
+
+/// First byte in `[p, end)` the scan stops at, or `end`.
+using Find = const char* (*)(const char* p, const char* end);
+
+template <Scan S, bool Utf8> const char* find_portable(const char* p, const char* const end) {
+    while (p != end && !stop_table<S, Utf8>[static_cast<unsigned char>(*p)]) {
+        ++p;
+    }
+    return p;
+}
+
+#if defined(PROJECT_TEMPLATE_ESCAPE_X86)
+// `cmplt_epi8(v, 0x20)` compares signed, so it also holds for every byte >= 0x80 (what Utf8 scans need);
+// `min_epu8(v, 0x1F) == v` is the unsigned `v < 0x20` for the others.
+
+template <Scan S, bool Utf8> const char* find_sse2(const char* p, const char* const end) {
+    const auto space = _mm_set1_epi8(0x20);
+    for (; end - p >= 16; p += 16) {
+        const auto v     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const auto below = Utf8 ? _mm_cmplt_epi8(v, space) : _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1F)), v);
+        __m128i stop;
+        if constexpr (S == Scan::Json) {
+            const auto quote = _mm_cmpeq_epi8(v, _mm_set1_epi8('"'));
+            const auto slash = _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'));
+            stop             = _mm_or_si128(below, _mm_or_si128(quote, slash));
+        } else if constexpr (S == Scan::Terminal) {
+            const auto newline = _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'));
+            const auto tab     = _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'));
+            const auto del     = _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7F));
+            const auto kept    = _mm_or_si128(newline, tab);
+            stop               = _mm_or_si128(_mm_andnot_si128(kept, below), del);
+        } else {
+            stop = v; // the sign bit is all movemask looks at
+        }
+        if (const auto mask = static_cast<unsigned>(_mm_movemask_epi8(stop)); mask != 0) {
+            return p + std::countr_zero(mask);
+        }
+    }
+    return find_portable<S, Utf8>(p, end);
+}
+
+template <Scan S, bool Utf8>
+__attribute__((target("avx2"))) const char* find_avx2(const char* p, const char* const end) {
+    const auto space = _mm256_set1_epi8(0x20);
+    for (; end - p >= 32; p += 32) {
+        const auto v     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const auto below = Utf8 ? _mm256_cmpgt_epi8(space, v)
+                                : _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(0x1F)), v);
+        __m256i stop;
+        if constexpr (S == Scan::Json) {
+            const auto quote = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'));
+            const auto slash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'));
+            stop             = _mm256_or_si256(below, _mm256_or_si256(quote, slash));
+        } else if constexpr (S == Scan::Terminal) {
+            const auto newline = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'));
+            const auto tab     = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'));
+            const auto del     = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7F));
+            const auto kept    = _mm256_or_si256(newline, tab);
+            stop               = _mm256_or_si256(_mm256_andnot_si256(kept, below), del);
+        } else {
+            stop = v;
+        }
+        if (const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(stop)); mask != 0) {
+            return p + std::countr_zero(mask);
+        }
+    }
+    return find_sse2<S, Utf8>(p, end);
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// UTF-8 validation
+// ---------------------------------------------------------------------------
+
+constexpr std::string_view replacement_character = "\xEF\xBF\xBD"; // U+FFFD
+
+struct Utf8Sequence {
+    std::size_t length; ///< bytes of the sequence, or of its maximal ill-formed subpart (at least 1)
+    bool valid;
+};
+
+/// Classify the multi-byte sequence starting at `p` (`*p >= 0x80`), following Unicode table 3-7.
+Utf8Sequence utf8_sequence_at(const char* const p, const char* const end) {
+    const auto lead    = static_cast<unsigned char>(*p);
+    unsigned char low  = 0x80; // allowed range of the second byte; later bytes are always 80..BF
+    unsigned char high = 0xBF;
+    std::size_t length = 0;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (lead == 0xE0) low = 0xA0;  // overlong
+        if (lead == 0xED) high = 0x9F; // surrogates
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (lead == 0xF0) low = 0x90;  // overlong
+        if (lead == 0xF4) high = 0x8F; // above U+10FFFF
+    } else {
+        return {1, false}; // continuation byte, overlong lead C0/C1, or F5..FF
+    }
+    for (std::size_t i = 1; i < length; ++i) {
+        if (p + i == end) return {i, false};
+        const auto c = static_cast<unsigned char>(p[i]);
+        if (c < low || c > high) return {i, false};
+        low  = 0x80;
+        high = 0xBF;
+    }
+    return {length, true};
+}
+
+/// True if `[p, end)` is well-formed UTF-8.
+using Validate = bool (*)(const char* p, const char* end);
+
+/// Skip ASCII with `FindNonAscii`, decode everything else one sequence at a time.
+template <Find FindNonAscii> bool validate_sequences(const char* p, const char* const end) {
+    while ((p = FindNonAscii(p, end)) != end) {
+        const auto sequence = utf8_sequence_at(p, end);
+        if (!sequence.valid) return false;
+        p += sequence.length;
+    }
+    return true;
+}
+
+#if defined(PROJECT_TEMPLATE_ESCAPE_X86)
+// Block validation after Keiser & Lemire, "Validating UTF-8 in less than one instruction per byte" (2021):
+// every byte is classified together with its predecessor by three 16-entry nibble lookups whose AND is
+// non-zero exactly for an invalid pair; a separate check requires continuation bytes 2 and 3 positions
+// after 3- and 4-byte leads.
+
+constexpr std::uint8_t too_short      = 1U << 0; // lead not followed by a continuation
+constexpr std::uint8_t too_long       = 1U << 1; // ASCII followed by a continuation
+constexpr std::uint8_t overlong_3     = 1U << 2; // E0 80..9F
+constexpr std::uint8_t too_large      = 1U << 3; // F4 90..BF, F5..FF
+constexpr std::uint8_t surrogate      = 1U << 4; // ED A0..BF
+constexpr std::uint8_t overlong_2     = 1U << 5; // C0, C1
+constexpr std::uint8_t too_large_1000 = 1U << 6; // F5..FF 80..8F
+constexpr std::uint8_t overlong_4     = 1U << 6; // F0 80..8F
+constexpr std::uint8_t two_conts      = 1U << 7; // continuation after continuation (checked separately)
+constexpr std::uint8_t carry          = too_short | too_long | two_conts;
+
+using NibbleTable = std::array<std::uint8_t, 16>;
+
+/// By the high nibble of the previous byte.
+constexpr NibbleTable prev_high = {
+    too_long,                                            // 0
+    too_long,                                            // 1
+    too_long,                                            // 2
+    too_long,                                            // 3
+    too_long,                                            // 4
+    too_long,                                            // 5
+    too_long,                                            // 6
+    too_long,                                            // 7
+    two_conts,                                           // 8
+    two_conts,                                           // 9
+    two_conts,                                           // A
+    two_conts,                                           // B
+    too_short | overlong_2,                              // C
+    too_short,                                           // D
+    too_short | overlong_3 | surrogate,                  // E
+    too_short | too_large | too_large_1000 | overlong_4, // F
+};
+
+/// By the low nibble of the previous byte.
+constexpr NibbleTable prev_low = {
+    carry | overlong_3 | overlong_2 | overlong_4,   // 0
+    carry | overlong_2,                             // 1
+    carry,                                          // 2
+    carry,                                          // 3
+    carry | too_large,                              // 4
+    carry | too_large | too_large_1000,             // 5
+    carry | too_large | too_large_1000,             // 6
+    carry | too_large | too_large_1000,             // 7
+    carry | too_large | too_large_1000,             // 8
+    carry | too_large | too_large_1000,             // 9
+    carry | too_large | too_large_1000,             // A
+    carry | too_large | too_large_1000,             // B
+    carry | too_large | too_large_1000,             // C
+    carry | too_large | too_large_1000 | surrogate, // D
+    carry | too_large | too_large_1000,             // E
+    carry | too_large | too_large_1000,             // F
+};
+
+/// By the high nibble of the current byte.
+constexpr NibbleTable current_high = {
+    too_short,                                                                    // 0
+    too_short,                                                                    // 1
+    too_short,                                                                    // 2
+    too_short,                                                                    // 3
+    too_short,                                                                    // 4
+    too_short,                                                                    // 5
+    too_short,                                                                    // 6
+    too_short,                                                                    // 7
+    too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4, // 8
+    too_long | overlong_2 | two_conts | overlong_3 | too_large,                   // 9
+    too_long | overlong_2 | two_conts | surrogate | too_large,                    // A
+    too_long | overlong_2 | two_conts | surrogate | too_large,                    // B
+    too_short,                                                                    // C
+    too_short,                                                                    // D
+    too_short,                                                                    // E
+    too_short,                                                                    // F
+};
+
+/// A lead byte in the last three positions of a block needs bytes from the next block.
+constexpr auto incomplete_limit = [] {
+    std::array<std::uint8_t, 32> limit{};
+    limit.fill(0xFF);
+    limit[29] = 0xF0 - 1;
+    limit[30] = 0xE0 - 1;
+    limit[31] = 0xC0 - 1;
+    return limit;
+}();
+
+__attribute__((target("avx2"))) __m256i lookup_avx2(const NibbleTable& table, const __m256i nibbles) {
+    const auto entries = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.data()));
+    return _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(entries), nibbles);
+}
+
+/// `input` moved up by `N` bytes, the gap filled with the end of `previous`.
+template <int N> __attribute__((target("avx2"))) __m256i prev_avx2(const __m256i input, const __m256i previous) {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+}
+
+__attribute__((target("avx2"))) bool validate_avx2(const char* p, const char* const end) {
+    const auto nibble = _mm256_set1_epi8(0x0F);
+    const auto limit  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(incomplete_limit.data()));
+    auto previous     = _mm256_setzero_si256();
+    auto error        = _mm256_setzero_si256();
+    auto incomplete   = _mm256_setzero_si256();
+    std::array<char, 32> tail{};
+
+    while (p != end) {
+        __m256i input;
+        if (end - p >= 32) {
+            input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            p += 32;
+        } else {
+            tail = {}; // padding with ASCII makes a truncated final sequence fail the pair check
+            std::memcpy(tail.data(), p, static_cast<std::size_t>(end - p));
+            input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tail.data()));
+            p     = end;
+        }
+
+        if (_mm256_movemask_epi8(input) == 0) {
+            error = _mm256_or_si256(error, incomplete); // ASCII cannot continue the previous block
+        } else {
+            const auto prev1 = prev_avx2<1>(input, previous);
+            const auto high1 = lookup_avx2(prev_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+            const auto low1  = lookup_avx2(prev_low, _mm256_and_si256(prev1, nibble));
+            const auto high2 = lookup_avx2(current_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+            const auto pairs = _mm256_and_si256(_mm256_and_si256(high1, low1), high2);
+
+            // bytes 2 and 3 after a 3- or 4-byte lead must be continuations (saturating: only leads stay >= 0x80)
+            const auto third  = _mm256_subs_epu8(prev_avx2<2>(input, previous), _mm256_set1_epi8(0xE0 - 0x80));
+            const auto fourth = _mm256_subs_epu8(prev_avx2<3>(input, previous), _mm256_set1_epi8(0xF0 - 0x80));
+            const auto must_continue =
+                _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+
+            error      = _mm256_or_si256(error, _mm256_xor_si256(must_continue, pairs));
+            incomplete = _mm256_subs_epu8(input, limit);
+        }
+        previous = input;
+    }
+    error = _mm256_or_si256(error, incomplete);
+    return _mm256_testz_si256(error, error) != 0;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// implementation selection
+// ---------------------------------------------------------------------------
+
+/// A scan that stops at non-ASCII to validate it, and one for text already known to be valid UTF-8.
+struct Scans {
+    Find utf8;
+    Find ascii;
+};
+
+struct Implementation {
+    Scans json;
+    Scans terminal;
+    Validate validate;
+    std::string_view name;
+};
+
+constexpr Implementation portable{{find_portable<Scan::Json, true>, find_portable<Scan::Json, false>},
+                                  {find_portable<Scan::Terminal, true>, find_portable<Scan::Terminal, false>},
+                                  validate_sequences<find_portable<Scan::NonAscii, true>>,
+                                  "portable"};
+
+Implementation select_implementation() {
+#if defined(PROJECT_TEMPLATE_ESCAPE_X86)
+    if (__builtin_cpu_supports("avx2")) {
+        return {{find_avx2<Scan::Json, true>, find_avx2<Scan::Json, false>},
+                {find_avx2<Scan::Terminal, true>, find_avx2<Scan::Terminal, false>},
+                validate_avx2,
+                "avx2"};
+    }
+    return {{find_sse2<Scan::Json, true>, find_sse2<Scan::Json, false>},
+            {find_sse2<Scan::Terminal, true>, find_sse2<Scan::Terminal, false>},
+            validate_sequences<find_sse2<Scan::NonAscii, true>>,
+            "sse2"};
+#else
+    return portable;
+#endif
+}
+
+const Implementation& implementation() {
+    static const Implementation selected = select_implementation();
+    return selected;
+}
+
+// ---------------------------------------------------------------------------
+// escaping
+// ---------------------------------------------------------------------------
+
+void append(spdlog::memory_buf_t& out, const std::string_view text) {
+    out.append(text.data(), text.data() + text.size());
+}
+
+constexpr char hex_digits[] = "0123456789abcdef";
+
+void escape_json(spdlog::memory_buf_t& out, const unsigned char c) {
+    switch (c) {
+        case '"':
+            append(out, "\\\"");
+            break;
+        case '\\':
+            append(out, "\\\\");
+            break;
+        case '\n':
+            append(out, "\\n");
+            break;
+        case '\r':
+            append(out, "\\r");
+            break;
+        case '\t':
+            append(out, "\\t");
+            break;
+        default: {
+            const char escaped[] = {'\\', 'u', '0', '0', hex_digits[c >> 4], hex_digits[c & 0xF]};
+            out.append(escaped, escaped + sizeof(escaped));
+            break;
+        }
+    }
+}
+
+void escape_terminal(spdlog::memory_buf_t& out, const unsigned char c) {
+    const char escaped[] = {'\\', 'x', hex_digits[c >> 4], hex_digits[c & 0xF]};
+    out.append(escaped, escaped + sizeof(escaped));
+}
+
+/**
+ * Copy `text`, handing ASCII stop bytes to `escape` and replacing ill-formed UTF-8.
+ *
+ * At the first non-ASCII byte the rest of the text is validated once; if it is well-formed, the
+ * scan switches to the ASCII-only variant and non-ASCII text is copied in bulk like ASCII.
+ * Otherwise non-ASCII bytes are decoded one sequence at a time.
+ */
+template <class Escape>
+void append_escaped(spdlog::memory_buf_t& out, const std::string_view text, const Scans& scans,
+                    const Validate validate, const Escape escape) {
+    const char* p         = text.data();
+    const char* const end = p + text.size();
+    auto find             = scans.utf8;
+    bool rest_validated   = false;
+    while (true) {
+        const char* stop = find(p, end);
+        out.append(p, stop);
+        if (stop == end) return;
+        p = stop;
+
+        if (static_cast<unsigned char>(*p) < 0x80) {
+            escape(out, static_cast<unsigned char>(*p));
+            ++p;
+            continue;
+        }
+        if (!rest_validated) {
+            rest_validated = true;
+            if (validate(p, end)) {
+                find = scans.ascii;
+                continue;
+            }
+        }
+        // a run of non-ASCII text (e.g. a word in another script) is handled here rather than rescanned
+        while (p != end && static_cast<unsigned char>(*p) >= 0x80) {
+            const auto sequence = utf8_sequence_at(p, end);
+            if (sequence.valid) {
+                out.append(p, p + sequence.length);
+            } else {
+                append(out, replacement_character);
+            }
+            p += sequence.length;
+        }
+    }
+}
+
+bool needs_escaping(const std::string_view text, const Scans& scans, const Validate validate) {
+    const char* const end = text.data() + text.size();
+    const char* stop      = scans.utf8(text.data(), end);
+    if (stop == end) return false;
+    if (static_cast<unsigned char>(*stop) < 0x80 || !validate(stop, end)) return true;
+    return scans.ascii(stop, end) != end;
+}
+
+} // namespace
+
+void append_json_escaped(spdlog::memory_buf_t& out, const std::string_view text) {
+    const auto& impl = implementation();
+    append_escaped(out, text, impl.json, impl.validate, escape_json);
+}
+
+void append_terminal_safe(spdlog::memory_buf_t& out, const std::string_view text) {
+    const auto& impl = implementation();
+    append_escaped(out, text, impl.terminal, impl.validate, escape_terminal);
+}
+
+bool needs_terminal_escaping(const std::string_view text) {
+    const auto& impl = implementation();
+    return needs_escaping(text, impl.terminal, impl.validate);
+}
+
+bool is_valid_utf8(const std::string_view text) {
+    return implementation().validate(text.data(), text.data() + text.size());
+}
+
+void append_json_escaped_portable(spdlog::memory_buf_t& out, const std::string_view text) {
+    append_escaped(out, text, portable.json, portable.validate, escape_json);
+}
+
+void append_terminal_safe_portable(spdlog::memory_buf_t& out, const std::string_view text) {
+    append_escaped(out, text, portable.terminal, portable.validate, escape_terminal);
+}
+
+bool is_valid_utf8_portable(const std::string_view text) {
+    return portable.validate(text.data(), text.data() + text.size());
+}
+
+std::string_view escape_implementation() {
+    return implementation().name;
+}
+
+} // namespace project_template::utils::text
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <spdlog/common.h>
+
+#include <string_view>
+
+namespace project_template::utils::text {
+
+/**
+ * @name Escaping untrusted text for structured and console output
+ *
+ * Messages passed to `LOG_*` may contain quotes, control characters or bytes
+ * that are not UTF-8. These routines make such text safe for the output
+ * format while copying clean text verbatim:
+ *
+ *  - `append_json_escaped()` produces the body of a JSON string: `"`, `\` and
+ *    control characters are escaped (`\n`, `\u0001`, ...).
+ *  - `append_terminal_safe()` keeps newlines and tabs but writes other control
+ *    characters and DEL as `\xNN`, so a message cannot emit terminal escape
+ *    sequences (cursor movement, window titles, ...).
+ *
+ * Both replace ill-formed UTF-8 with U+FFFD, one per maximal ill-formed
+ * subsequence (Unicode 3.9), so the output is always valid UTF-8.
+ *
+ * The scan for bytes needing attention runs 32 (AVX2) or 16 (SSE2) bytes per
+ * step, selected once at run time; runs of clean text are copied in one
+ * piece. At the first non-ASCII byte the rest of the text is validated in
+ * one pass (AVX2: nibble-lookup validation after Keiser & Lemire; otherwise
+ * sequence by sequence), so well-formed non-ASCII text stays on the fast
+ * path and only ill-formed text is decoded one sequence at a time.
+ */
+/// @{
+
+/// @brief Append `text` as the body of a JSON string (without the enclosing quotes).
+void append_json_escaped(spdlog::memory_buf_t& out, std::string_view text);
+
+/// @brief Append `text` with control characters (except `\n` and `\t`) escaped for a terminal.
+void append_terminal_safe(spdlog::memory_buf_t& out, std::string_view text);
+
+/// @brief True if `append_terminal_safe()` would change `text` (lets callers skip the copy).
+bool needs_terminal_escaping(std::string_view text);
+
+/// @brief True if `text` is well-formed UTF-8 (no overlongs, surrogates or code points above U+10FFFF).
+bool is_valid_utf8(std::string_view text);
+
+/// @}
+
+/// @name Byte-at-a-time versions, regardless of the CPU (reference for tests and benchmarks)
+/// @{
+void append_json_escaped_portable(spdlog::memory_buf_t& out, std::string_view text);
+void append_terminal_safe_portable(spdlog::memory_buf_t& out, std::string_view text);
+bool is_valid_utf8_portable(std::string_view text);
+/// @}
+
+/// @brief Implementation used for scanning: "avx2", "sse2" or "portable".
+std::string_view escape_implementation();
+
+} // namespace project_template::utils::text
@@ -0,0 +1,303 @@
+#include "timing_wheel.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace project_template::utils::timer {
+
+namespace {
+// marks a periodic node whose callback is currently running (unlinked, but still owned)
+constexpr std::uint32_t firing_slot = UINT32_MAX - 1;
+} // namespace
+
+TimingWheel::TimingWheel(const std::chrono::nanoseconds tick, const Clock::time_point start)
+  : tick_(tick.count() > 0 ? tick : std::chrono::nanoseconds{1}), origin_(start) {
+    heads_.fill(nil);
+}
+
+TimingWheel::TimerId TimingWheel::schedule_after(const std::chrono::nanoseconds delay, Callback callback) {
+    return schedule_ticks(to_ticks(delay), 0, std::move(callback));
+}
+
+TimingWheel::TimerId TimingWheel::schedule_every(const std::chrono::nanoseconds period, Callback callback) {
+    const auto ticks = to_ticks(period);
+    return schedule_ticks(ticks, ticks, std::move(callback));
+}
+
+bool TimingWheel::cancel(const TimerId id) {
+    const auto index      = static_cast<std::uint32_t>(id & 0xFFFFFFFFU);
+    const auto generation = static_cast<std::uint32_t>(id >> 32);
+    if (index >= nodes_.size()) return false;
+
+    const Node& node = nodes_[index];
+    if (node.generation != generation || node.slot == nil) return false;
+
+    if (node.slot != firing_slot) unlink(index);
+    release(index);
+    return true;
+}
+
+std::size_t TimingWheel::advance(const std::uint64_t ticks) {
+    const auto target = now_ + ticks;
+    std::size_t fired = 0;
+    while (now_ < target) {
+        // skip straight over ticks in which nothing fires or cascades
+        const auto next = next_event_tick();
+        if (next > target) {
+            now_ = target;
+            break;
+        }
+        now_ = next - 1;
+        fired += tick_once();
+    }
+    return fired;
+}
+
+std::size_t TimingWheel::advance_to(const Clock::time_point now) {
+    if (now <= origin_) return 0;
+    const auto target = static_cast<std::uint64_t>((now - origin_) / tick_);
+    return target > now_ ? advance(target - now_) : 0;
+}
+
+TimingWheel::TimerId TimingWheel::schedule_ticks(const std::uint64_t delay_ticks, const std::uint64_t period_ticks,
+                                                 Callback callback) {
+    const auto index = allocate();
+    Node& node       = nodes_[index];
+    node.expiry      = now_ + delay_ticks;
+    node.period      = period_ticks;
+    node.callback    = std::move(callback);
+    link(index);
+    return make_id(index, node.generation);
+}
+
+std::uint64_t TimingWheel::to_ticks(const std::chrono::nanoseconds d) const {
+    if (d.count() <= 0) return 1;
+    // round up, and never schedule into the tick that has already been processed
+    const auto ticks = static_cast<std::uint64_t>((d.count() + tick_.count() - 1) / tick_.count());
+    return ticks == 0 ? 1 : ticks;
+}
+
+std::uint32_t TimingWheel::allocate() {
+    ++pending_;
+    if (free_head_ != nil) {
+        const auto index   = free_head_;
+        free_head_         = nodes_[index].next;
+        nodes_[index].next = nil;
+        return index;
+    }
+    nodes_.emplace_back();
+    return static_cast<std::uint32_t>(nodes_.size() - 1);
+}
+
+void TimingWheel::release(const std::uint32_t index) {
+    Node& node    = nodes_[index];
+    node.callback = nullptr;
+    node.slot     = nil;
+    node.prev     = nil;
+    node.next     = free_head_;
+    // bump the generation so stale ids no longer match; 0 is reserved for invalid_timer
+    if (++node.generation == 0) node.generation = 1;
+    free_head_ = index;
+    --pending_;
+}
+
+void TimingWheel::link(const std::uint32_t index) {
+    Node& node = nodes_[index];
+
+    // pick the lowest wheel whose higher-order bits agree with the current tick
+    const std::uint64_t diff = node.expiry ^ now_;
+    std::size_t slot         = overflow;
+    for (std::size_t wheel = 0; wheel < wheel_count; ++wheel) {
+        if ((diff >> (wheel_bits * (wheel + 1))) == 0) {
+            slot = wheel * wheel_size + ((node.expiry >> (wheel_bits * wheel)) & wheel_mask);
+            break;
+        }
+    }
+
+    node.slot = static_cast<std::uint32_t>(slot);
+    node.prev = nil;
+    node.next = heads_[slot];
+    if (node.next != nil) nodes_[node.next].prev = index;
+    heads_[slot] = index;
+    mark(slot, true);
+}
+
+void TimingWheel::unlink(const std::uint32_t index) {
+    Node& node = nodes_[index];
+    if (node.prev != nil) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        heads_[node.slot] = node.next;
+        if (node.next == nil) mark(node.slot, false);
+    }
+    if (node.next != nil) nodes_[node.next].prev = node.prev;
+    node.prev = nil;
+    node.next = nil;
+}
+
+void TimingWheel::cascade(const std::size_t slot) {
+    auto index   = heads_[slot];
+    heads_[slot] = nil;
+    mark(slot, false);
+    while (index != nil) {
+        const auto next = nodes_[index].next;
+        link(index);
+        index = next;
+    }
+}
+
+std::size_t TimingWheel::tick_once() {
+    ++now_;
+
+    // re-distribute timers whose wheel boundary was just crossed, highest wheel first
+    if ((now_ & 0xFFFFFFFFULL) == 0) cascade(overflow);
+    for (std::size_t wheel = wheel_count - 1; wheel > 0; --wheel) {
+        const auto shift = wheel_bits * wheel;
+        if ((now_ & ((std::uint64_t{1} << shift) - 1)) == 0) {
+            cascade(wheel * wheel_size + ((now_ >> shift) & wheel_mask));
+        }
+    }
+
+    std::size_t fired = 0;
+    const auto slot   = static_cast<std::size_t>(now_ & wheel_mask);
+    while (heads_[slot] != nil) {
+        const auto index = heads_[slot];
+        unlink(index);
+        ++fired;
+
+        Node& node            = nodes_[index];
+        Callback callback     = std::move(node.callback);
+        const auto generation = node.generation;
+        const auto period     = node.period;
+
+        if (period == 0) {
+            release(index);
+            callback();
+            continue;
+        }
+
+        // periodic: keep the slab entry reserved while the callback runs so it can cancel itself
+        node.slot = firing_slot;
+        callback();
+
+        Node& again = nodes_[index]; // the callback may have grown nodes_
+        if (again.generation != generation) continue; // cancelled from inside the callback
+        again.callback = std::move(callback);
+        again.expiry   = now_ + period;
+        link(index);
+    }
+    return fired;
+}
+
+std::uint64_t TimingWheel::next_event_tick() const {
+    std::uint64_t next = UINT64_MAX;
+
+    // per wheel: the first occupied slot after the current position within the current block
+    for (std::size_t wheel = 0; wheel < wheel_count; ++wheel) {
+        const auto shift   = wheel_bits * wheel;
+        const auto current = static_cast<std::size_t>((now_ >> shift) & wheel_mask);
+        for (std::size_t bit = current + 1; bit < wheel_size;) {
+            const auto word = occupied_[(wheel * wheel_size + bit) / 64] >> (bit % 64);
+            if (word == 0) {
+                bit = (bit / 64 + 1) * 64;
+                continue;
+            }
+            const auto slot  = bit + static_cast<std::size_t>(std::countr_zero(word));
+            const auto block = (now_ >> (shift + wheel_bits)) << (shift + wheel_bits);
+            next             = std::min(next, block | (static_cast<std::uint64_t>(slot) << shift));
+            break;
+        }
+    }
+
+    if (heads_[overflow] != nil) {
+        const auto span = wheel_bits * wheel_count;
+        next            = std::min(next, ((now_ >> span) + 1) << span);
+    }
+    return next;
+}
+
+void TimingWheel::mark(const std::size_t slot, const bool occupied) {
+    if (slot == overflow) return;
+    const auto bit = std::uint64_t{1} << (slot % 64);
+    if (occupied) {
+        occupied_[slot / 64] |= bit;
+    } else {
+        occupied_[slot / 64] &= ~bit;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// TimerThread
+// ---------------------------------------------------------------------------
+
+TimerThread::TimerThread(const std::chrono::nanoseconds tick)
+  : wheel_(tick), thread_([this](const std::stop_token& stop) { run(stop); }) {}
+
+TimerThread::~TimerThread() {
+    stop();
+}
+
+TimingWheel::TimerId TimerThread::schedule_after(const std::chrono::nanoseconds delay,
+                                                 TimingWheel::Callback callback) {
+    const std::lock_guard lock(mutex_);
+    catch_up();
+    const auto id = wheel_.schedule_after(delay, std::move(callback));
+    wakeup_.notify_one();
+    return id;
+}
+
+TimingWheel::TimerId TimerThread::schedule_every(const std::chrono::nanoseconds period,
+                                                 TimingWheel::Callback callback) {
+    const std::lock_guard lock(mutex_);
+    catch_up();
+    const auto id = wheel_.schedule_every(period, std::move(callback));
+    wakeup_.notify_one();
+    return id;
+}
+
+bool TimerThread::cancel(const TimingWheel::TimerId id) {
+    const std::lock_guard lock(mutex_);
+    return wheel_.cancel(id);
+}
+
+std::size_t TimerThread::size() const {
+    const std::lock_guard lock(mutex_);
+    return wheel_.size();
+}
+
+void TimerThread::stop() {
+    if (!thread_.joinable()) return;
+    thread_.request_stop();
+    thread_.join();
+}
+
+void TimerThread::run(const std::stop_token& stop) {
+    std::unique_lock lock(mutex_);
+    while (!stop.stop_requested()) {
+        if (wheel_.empty()) {
+            // sleep until something is scheduled (or we are asked to stop)
+            wakeup_.wait(lock, stop, [this] { return !wheel_.empty(); });
+            continue;
+        }
+        // sleep until something is due; an earlier timer scheduled meanwhile moves the deadline up
+        const auto next = wheel_.next_event_tick();
+        wakeup_.wait_until(lock, stop, wheel_.time_of_tick(next),
+                           [this, next] { return wheel_.next_event_tick() < next; });
+        if (stop.stop_requested()) break;
+        wheel_.advance_to(TimingWheel::Clock::now());
+    }
+}
+
+void TimerThread::catch_up() {
+    // the wheel is only advanced when something is due; move it to now so a new delay is measured from
+    // here, but stop short of the next event so its callbacks still run on the timer thread
+    const auto now = TimingWheel::Clock::now();
+    if (wheel_.empty()) {
+        wheel_.advance_to(now);
+        return;
+    }
+    wheel_.advance_to(std::min(now, wheel_.time_of_tick(wheel_.next_event_tick() - 1)));
+}
+
+} // namespace project_template::utils::timer
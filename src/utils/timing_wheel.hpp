@@ -0,0 +1,202 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace project_template::utils::timer {
+
+/**
+ * @brief Hierarchical timing wheel with O(1) schedule and cancel.
+ *
+ * Time is quantized into ticks of a fixed resolution. Timers are kept in
+ * four wheels of 256 slots each (8 bits of the expiry tick per wheel), so a
+ * single wheel instance covers 2^32 ticks (~49 days at 1 ms resolution);
+ * timers beyond that horizon are parked in an overflow list and re-inserted
+ * whenever the top wheel wraps.
+ *
+ * Each timer lives in a slab slot and is linked into exactly one wheel slot
+ * through an intrusive doubly-linked list, which makes both `schedule_*()`
+ * and `cancel()` constant time. Advancing the wheel fires the current slot
+ * and cascades timers from higher wheels down as their boundaries are crossed.
+ *
+ * Typical usage (periodic maintenance work such as grouped flushes, metrics
+ * snapshots or rate-limit windows):
+ *
+ *   TimingWheel wheel{std::chrono::milliseconds{1}};
+ *   const auto id = wheel.schedule_every(std::chrono::seconds{1}, [] { Log::flush(); });
+ *   ...
+ *   wheel.advance_to(TimingWheel::Clock::now()); // fires everything that is due
+ *   wheel.cancel(id);
+ *
+ * The wheel itself is not thread-safe; see `TimerThread` for a driven,
+ * synchronized wrapper.
+ *
+ * Callbacks are invoked from within `advance()`/`advance_to()` and may
+ * schedule or cancel timers (including themselves) on the same wheel.
+ */
+class TimingWheel {
+  public:
+    using Clock    = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    /// Opaque handle returned by `schedule_*()`; `0` is never a valid id.
+    using TimerId = std::uint64_t;
+
+    static constexpr TimerId invalid_timer = 0;
+
+    /**
+     * @brief Create an empty wheel.
+     *
+     * @param tick  Resolution of the wheel. Delays are rounded up to whole ticks.
+     * @param start Time point corresponding to tick 0.
+     */
+    explicit TimingWheel(std::chrono::nanoseconds tick = std::chrono::milliseconds{1},
+                         Clock::time_point start      = Clock::now());
+
+    /// @brief Schedule a one-shot timer firing after (at least) `delay`.
+    TimerId schedule_after(std::chrono::nanoseconds delay, Callback callback);
+
+    /// @brief Schedule a periodic timer firing every `period`, starting one period from now.
+    TimerId schedule_every(std::chrono::nanoseconds period, Callback callback);
+
+    /**
+     * @brief Cancel a pending timer.
+     * @return true if the timer was pending and is now removed, false for
+     *         unknown, already-fired or already-cancelled ids.
+     */
+    bool cancel(TimerId id);
+
+    /// @brief Advance the wheel by `ticks` ticks, firing due timers. Returns the number fired.
+    std::size_t advance(std::uint64_t ticks);
+
+    /// @brief Advance the wheel up to the tick containing `now`, firing due timers.
+    std::size_t advance_to(Clock::time_point now);
+
+    /// @brief Number of pending timers.
+    [[nodiscard]] std::size_t size() const {
+        return pending_;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return pending_ == 0;
+    }
+
+    /// @brief Current wheel position in ticks since construction.
+    [[nodiscard]] std::uint64_t current_tick() const {
+        return now_;
+    }
+
+    /**
+     * @brief First tick after the current one in which a timer may fire or a wheel cascades.
+     *
+     * `UINT64_MAX` if nothing is pending. Nothing happens before that tick, so
+     * a driver can sleep until `time_of_tick(next_event_tick())`.
+     */
+    [[nodiscard]] std::uint64_t next_event_tick() const;
+
+    /// @brief Configured tick resolution.
+    [[nodiscard]] std::chrono::nanoseconds tick() const {
+        return tick_;
+    }
+
+    /// @brief Wall-clock (steady) time point at which tick `t` begins.
+    [[nodiscard]] Clock::time_point time_of_tick(std::uint64_t t) const {
+        return origin_ + tick_ * static_cast<std::int64_t>(t);
+    }
+
+  private:
+    static constexpr std::size_t wheel_bits  = 8;
+    static constexpr std::size_t wheel_size  = std::size_t{1} << wheel_bits;
+    static constexpr std::size_t wheel_mask  = wheel_size - 1;
+    static constexpr std::size_t wheel_count = 4;
+    static constexpr std::size_t slot_count  = wheel_count * wheel_size + 1; ///< +1: overflow list
+    static constexpr std::size_t overflow    = slot_count - 1;
+    static constexpr std::uint32_t nil       = UINT32_MAX;
+
+    struct Node {
+        std::uint64_t expiry     = 0; ///< absolute tick
+        std::uint64_t period     = 0; ///< ticks; 0 for one-shot timers
+        Callback callback;
+        std::uint32_t prev       = nil;
+        std::uint32_t next       = nil;
+        std::uint32_t generation = 1;
+        std::uint32_t slot       = nil; ///< nil while free
+    };
+
+    std::chrono::nanoseconds tick_;
+    Clock::time_point origin_;
+    std::uint64_t now_   = 0;
+    std::size_t pending_ = 0;
+
+    std::vector<Node> nodes_;
+    std::uint32_t free_head_ = nil;
+    std::array<std::uint32_t, slot_count> heads_{};
+
+    /// One bit per wheel slot (overflow excluded), set while the slot is non-empty.
+    std::array<std::uint64_t, wheel_count * wheel_size / 64> occupied_{};
+
+    TimerId schedule_ticks(std::uint64_t delay_ticks, std::uint64_t period_ticks, Callback callback);
+    std::uint64_t to_ticks(std::chrono::nanoseconds d) const;
+
+    std::uint32_t allocate();
+    void release(std::uint32_t index);
+    void link(std::uint32_t index);
+    void unlink(std::uint32_t index);
+    void cascade(std::size_t slot);
+    std::size_t tick_once();
+
+    void mark(std::size_t slot, bool occupied);
+
+    static TimerId make_id(std::uint32_t index, std::uint32_t generation) {
+        return (static_cast<TimerId>(generation) << 32) | index;
+    }
+};
+
+/**
+ * @brief A `TimingWheel` driven by a dedicated background thread.
+ *
+ * All methods are thread-safe. Callbacks run on the timer thread; they should
+ * be short (hand real work off to a queue) since they delay every other timer
+ * on the wheel. Callbacks may call back into the `TimerThread` to schedule or
+ * cancel timers.
+ *
+ * The thread sleeps until the next tick in which something is due (see
+ * `TimingWheel::next_event_tick()`) rather than waking every tick, and waits
+ * without a deadline while no timer is pending.
+ */
+class TimerThread {
+  public:
+    explicit TimerThread(std::chrono::nanoseconds tick = std::chrono::milliseconds{1});
+    ~TimerThread();
+
+    TimerThread(const TimerThread&)            = delete;
+    TimerThread& operator=(const TimerThread&) = delete;
+
+    TimingWheel::TimerId schedule_after(std::chrono::nanoseconds delay, TimingWheel::Callback callback);
+    TimingWheel::TimerId schedule_every(std::chrono::nanoseconds period, TimingWheel::Callback callback);
+    bool cancel(TimingWheel::TimerId id);
+
+    /// @brief Number of pending timers.
+    [[nodiscard]] std::size_t size() const;
+
+    /// @brief Stop the thread; pending timers are discarded. Idempotent.
+    void stop();
+
+  private:
+    mutable std::recursive_mutex mutex_;
+    std::condition_variable_any wakeup_;
+    TimingWheel wheel_;
+    std::jthread thread_;
+
+    void run(const std::stop_token& stop);
+    void catch_up();
+};
+
+} // namespace project_template::utils::timer
@@ -0,0 +1,125 @@
+#include "versioned.hpp"
+
+#include "strided_slots.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace project_template::utils::concurrency {
+
+/// One per reading thread, on its own cache line: only the owner writes `epoch`.
+struct alignas(container::cache_line_size) EpochDomain::Slot {
+    std::atomic<std::uint64_t> epoch{0}; ///< global epoch when the owner pinned; 0 = not pinned
+    std::atomic<bool> in_use{false};
+    Slot* next = nullptr;
+};
+
+namespace {
+
+/// The calling thread's slot in the global domain; releases it for reuse when the thread exits.
+struct ThreadRecord {
+    std::atomic<std::uint64_t>* epoch = nullptr;
+    std::atomic<bool>* in_use         = nullptr;
+    unsigned nesting                  = 0;
+
+    ~ThreadRecord() {
+        if (in_use != nullptr) in_use->store(false, std::memory_order_release);
+    }
+};
+
+thread_local ThreadRecord thread_record;
+
+} // namespace
+
+EpochDomain& EpochDomain::global() {
+    // never destroyed: threads may read a Versioned<T> during static destruction
+    static auto* domain = new EpochDomain;
+    return *domain;
+}
+
+EpochDomain::Slot* EpochDomain::acquire_slot_() {
+    for (auto* slot = slots_.load(std::memory_order_acquire); slot != nullptr; slot = slot->next) {
+        bool expected = false;
+        if (!slot->in_use.load(std::memory_order_relaxed) &&
+            slot->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return slot;
+        }
+    }
+    auto* slot = new Slot;
+    slot->in_use.store(true, std::memory_order_relaxed);
+    slot->next = slots_.load(std::memory_order_relaxed);
+    while (!slots_.compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed)) {}
+    return slot;
+}
+
+EpochDomain::Guard EpochDomain::pin() {
+    auto& record = thread_record;
+    if (record.epoch == nullptr) {
+        auto* slot    = acquire_slot_();
+        record.epoch  = &slot->epoch;
+        record.in_use = &slot->in_use;
+    }
+    if (record.nesting++ == 0) {
+        // acquire: a reader that sees an advanced epoch also sees the pointer swap that preceded it
+        record.epoch->store(epoch_.load(std::memory_order_acquire), std::memory_order_relaxed);
+        // store-load barrier: either a reclaiming writer sees this pin, or the loads below see its swap
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    return Guard{&record};
+}
+
+EpochDomain::Guard::~Guard() {
+    if (record_ == nullptr) return;
+    auto& record = *static_cast<ThreadRecord*>(record_);
+    if (--record.nesting == 0) record.epoch->store(0, std::memory_order_release);
+}
+
+void EpochDomain::retire(void* object, void (*deleter)(void*)) {
+    std::vector<Retired> freed;
+    {
+        const std::lock_guard lock{mutex_};
+        retired_.push_back({object, deleter, epoch_.load(std::memory_order_relaxed)});
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        freed = collect_();
+    }
+    // outside the lock: destructors may be expensive or retire objects themselves
+    for (const auto& retired : freed) {
+        retired.deleter(retired.object);
+    }
+}
+
+std::size_t EpochDomain::reclaim() {
+    std::vector<Retired> freed;
+    std::size_t remaining = 0;
+    {
+        const std::lock_guard lock{mutex_};
+        freed     = collect_();
+        remaining = retired_.size();
+    }
+    for (const auto& retired : freed) {
+        retired.deleter(retired.object);
+    }
+    return remaining;
+}
+
+std::size_t EpochDomain::pending() const {
+    const std::lock_guard lock{mutex_};
+    return retired_.size();
+}
+
+std::vector<EpochDomain::Retired> EpochDomain::collect_() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto oldest = std::numeric_limits<std::uint64_t>::max();
+    for (const auto* slot = slots_.load(std::memory_order_acquire); slot != nullptr; slot = slot->next) {
+        const auto epoch = slot->epoch.load(std::memory_order_acquire);
+        if (epoch != 0) oldest = std::min(oldest, epoch);
+    }
+    // a reader pinned at epoch E may hold anything retired at E or later
+    const auto held = std::stable_partition(retired_.begin(), retired_.end(),
+                                            [oldest](const Retired& retired) { return retired.epoch >= oldest; });
+    std::vector<Retired> freed{held, retired_.end()};
+    retired_.erase(held, retired_.end());
+    return freed;
+}
+
+} // namespace project_template::utils::concurrency
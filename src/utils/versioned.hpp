@@ -0,0 +1,188 @@
+#pragma once
+
+#include "strided_slots.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace project_template::utils::concurrency {
+
+/**
+ * @brief Epoch-based reclamation: frees retired objects once no reader can still hold them.
+ *
+ * Every thread that reads gets its own epoch slot, a cache line that only
+ * that thread writes (slots are reused after a thread exits). `pin()`
+ * copies the global epoch into the slot for the lifetime of the returned
+ * guard. A writer unlinks an object and hands it to `retire()`, which tags
+ * it with the current epoch and advances the global one. The object is
+ * freed once every pinned slot shows a later epoch, i.e. each reader that
+ * could have seen it has left its critical section. Readers therefore
+ * never write a cache line another thread reads or writes; the shared
+ * epoch is only read.
+ *
+ * Reclamation runs in `retire()` and `reclaim()`. A reader that stays
+ * pinned delays it but does not block writers: retired objects wait in a
+ * list. Guards nest and must end on the thread that created them.
+ */
+class EpochDomain {
+  public:
+    class Guard {
+      public:
+        ~Guard();
+        Guard(Guard&& other) noexcept : record_(std::exchange(other.record_, nullptr)) {}
+        Guard(const Guard&)            = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard& operator=(Guard&&)      = delete;
+
+      private:
+        friend class EpochDomain;
+        explicit Guard(void* record) noexcept : record_(record) {}
+        void* record_; ///< the pinning thread's record; null once moved from
+    };
+
+    /// @brief The domain shared by all `Versioned<T>`.
+    static EpochDomain& global();
+
+    EpochDomain(const EpochDomain&)            = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    /// @brief Enter a read-side critical section: objects retired from now on stay valid until the guard ends.
+    [[nodiscard]] Guard pin();
+
+    /// @brief Free `object` with `deleter` once no pinned reader can hold it; may free earlier retirements.
+    void retire(void* object, void (*deleter)(void*));
+
+    /// @brief Free what can be freed now; returns the number of objects still waiting.
+    std::size_t reclaim();
+
+    /// @brief Retired objects not freed yet.
+    [[nodiscard]] std::size_t pending() const;
+
+  private:
+    struct Slot;
+    struct Retired {
+        void* object;
+        void (*deleter)(void*);
+        std::uint64_t epoch;
+    };
+
+    EpochDomain()  = default;
+    ~EpochDomain() = default; // never runs: `global()` outlives static destruction
+
+    Slot* acquire_slot_();
+    /// Under `mutex_`: moves the objects no reader can hold out of `retired_`.
+    std::vector<Retired> collect_();
+
+    alignas(container::cache_line_size) std::atomic<std::uint64_t> epoch_{1}; ///< read by every reader, written by writers
+    std::atomic<Slot*> slots_{nullptr}; ///< grows only; slots are reused
+    mutable std::mutex mutex_;
+    std::vector<Retired> retired_;
+};
+
+/**
+ * @brief RCU-style versioned value: lock-free snapshot reads of a `T` that is replaced as a whole.
+ *
+ * For payloads `SeqLock` cannot copy bytewise, or that are too large to
+ * copy on every read: configuration with strings and vectors, lookup
+ * tables. `read()` pins the epoch and returns a guard pointing at the
+ * current version. Writers never modify a published version. `store()`
+ * and `update()` publish a new one with a single pointer swap and retire
+ * the old one to `EpochDomain::global()`, which frees it once the readers
+ * that may hold it are done.
+ *
+ *   Versioned<Config> config{load_config()};
+ *   if (const auto current = config.read(); current->verbose) ...   // any thread
+ *   config.update([](Config& c) { c.sinks.push_back("file"); });   // copy, modify, publish
+ *
+ * A read costs one store to the reader's own slot and a full fence (a
+ * store-load barrier, so writers see the pin before freeing). It never
+ * writes a shared cache line. Writers are serialized, allocate a new `T`
+ * and copy it for `update()`. Read guards must not outlive the
+ * `Versioned`, and should be short-lived: they delay reclamation.
+ */
+template <class T> class Versioned {
+  public:
+    /// Pins one version for reading; valid until the guard is destroyed.
+    class ReadGuard {
+      public:
+        [[nodiscard]] const T& operator*() const noexcept {
+            return *value_;
+        }
+        [[nodiscard]] const T* operator->() const noexcept {
+            return value_;
+        }
+        [[nodiscard]] const T* get() const noexcept {
+            return value_;
+        }
+
+      private:
+        friend class Versioned;
+        ReadGuard(EpochDomain::Guard&& guard, const T* value) noexcept : guard_(std::move(guard)), value_(value) {}
+
+        EpochDomain::Guard guard_;
+        const T* value_;
+    };
+
+    Versioned() : Versioned(T{}) {}
+    explicit Versioned(T value) : current_(new T(std::move(value))) {}
+
+    /// No `ReadGuard` may be alive. Versions retired earlier are freed by the domain.
+    ~Versioned() {
+        delete current_.load(std::memory_order_relaxed);
+    }
+
+    Versioned(const Versioned&)            = delete;
+    Versioned& operator=(const Versioned&) = delete;
+
+    [[nodiscard]] ReadGuard read() const {
+        auto guard = EpochDomain::global().pin();
+        return ReadGuard{std::move(guard), current_.load(std::memory_order_acquire)};
+    }
+
+    /// @brief Copy of the current version (for callers that need to keep it).
+    [[nodiscard]] T load() const {
+        return *read();
+    }
+
+    void store(T value) {
+        auto* next = new T(std::move(value));
+        const std::lock_guard lock{writer_};
+        publish_(next);
+    }
+
+    /// @brief `f(T&)` is applied to a copy of the current version, which is then published.
+    template <class F> void update(F&& f) {
+        const std::lock_guard lock{writer_};
+        auto* next = new T(*current_.load(std::memory_order_relaxed));
+        try {
+            std::forward<F>(f)(*next);
+        } catch (...) {
+            delete next;
+            throw;
+        }
+        publish_(next);
+    }
+
+    /// @brief Versions published so far, including the initial one.
+    [[nodiscard]] std::uint64_t version() const noexcept {
+        return version_.load(std::memory_order_acquire);
+    }
+
+  private:
+    /// Under `writer_`.
+    void publish_(T* next) {
+        T* previous = current_.exchange(next, std::memory_order_seq_cst);
+        version_.fetch_add(1, std::memory_order_release);
+        EpochDomain::global().retire(previous, [](void* object) { delete static_cast<T*>(object); });
+    }
+
+    std::atomic<T*> current_;
+    std::atomic<std::uint64_t> version_{1};
+    std::mutex writer_;
+};
+
+} // namespace project_template::utils::concurrency
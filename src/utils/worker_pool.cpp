@@ -0,0 +1,85 @@
+#include "worker_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace project_template::utils::concurrency {
+
+namespace {
+thread_local std::size_t current_worker = WorkerPool::not_a_worker;
+} // namespace
+
+WorkerPool::WorkerPool(const std::size_t threads, const std::size_t capacity)
+  : capacity_(std::max<std::size_t>(capacity, 1)) {
+    const auto count = std::max<std::size_t>(threads, 1);
+    workers_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        workers_.emplace_back([this, i] { run_(i); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    drain(Clock::now());
+}
+
+bool WorkerPool::try_submit(Task task) {
+    {
+        const std::lock_guard lock{mutex_};
+        if (!accepting_ || queue_.size() >= capacity_) return false;
+        queue_.push_back(std::move(task));
+        queue_memory_.add(sizeof(Task));
+    }
+    ready_.notify_one();
+    return true;
+}
+
+std::size_t WorkerPool::drain(const Clock::time_point deadline) {
+    std::deque<Task> abandoned;
+    {
+        std::unique_lock lock{mutex_};
+        if (stopping_) return 0;
+        accepting_ = false;
+        idle_.wait_until(lock, deadline, [this] { return queue_.empty(); });
+        abandoned.swap(queue_);
+        queue_memory_.sub(abandoned.size() * sizeof(Task));
+        stopping_ = true;
+    }
+    ready_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+    return abandoned.size(); // destroyed here, outside the lock
+}
+
+std::size_t WorkerPool::worker_index() noexcept {
+    return current_worker;
+}
+
+std::size_t WorkerPool::queued() const {
+    const std::lock_guard lock{mutex_};
+    return queue_.size();
+}
+
+void WorkerPool::run_(const std::size_t index) {
+    current_worker = index;
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock lock{mutex_};
+            ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return; // stopping and nothing left
+            task = std::move(queue_.front());
+            queue_.pop_front();
+            queue_memory_.sub(sizeof(Task));
+            if (queue_.empty()) idle_.notify_all();
+        }
+        try {
+            task();
+        } catch (...) {
+            failed_.fetch_add(1, std::memory_order_relaxed);
+        }
+        completed_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace project_template::utils::concurrency
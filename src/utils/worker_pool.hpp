@@ -0,0 +1,103 @@
+#pragma once
+
+#include "memory_accounting.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace project_template::utils::concurrency {
+
+/**
+ * @brief Fixed set of worker threads serving a bounded FIFO queue of tasks, with a deadline-bound drain.
+ *
+ * `try_submit()` never blocks. When the queue is full or the pool is
+ * draining, the task is refused, so the caller decides how to shed load.
+ *
+ *   WorkerPool pool{4, 1024};
+ *   if (!pool.try_submit([request] { handle(request); })) ++rejected;
+ *   ...
+ *   const auto abandoned = pool.drain(WorkerPool::Clock::now() + std::chrono::seconds{5});
+ *
+ * `drain()` stops accepting tasks and lets the workers finish the queue
+ * until the deadline. At the deadline the tasks still queued are discarded
+ * unstarted. Tasks already running are never interrupted, so `drain()`
+ * returns once they finish.
+ *
+ * An exception escaping a task is swallowed and counted in `failed()`;
+ * the worker carries on with the next task.
+ *
+ * Queued tasks are reported in the memory account `worker_pool.queue`
+ * (`sizeof(Task)` each; captures too large for the small-buffer storage
+ * of `std::function` are not included).
+ */
+class WorkerPool {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Task  = std::function<void()>;
+
+    /// Value of `worker_index()` on threads that are not workers of a pool.
+    static constexpr std::size_t not_a_worker = SIZE_MAX;
+
+    /// @brief Start `threads` workers (at least one); at most `capacity` tasks wait in the queue.
+    WorkerPool(std::size_t threads, std::size_t capacity);
+
+    /// @brief Same as `drain(Clock::now())`: queued tasks are discarded, running ones finish.
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&)            = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /// @brief Queue `task`; false (and `task` dropped) if the queue is full or the pool is draining.
+    bool try_submit(Task task);
+
+    /**
+     * @brief Stop accepting tasks, run the queued ones until `deadline`, discard the rest and join the workers.
+     * @return Number of queued tasks discarded at the deadline. Later calls return 0.
+     */
+    std::size_t drain(Clock::time_point deadline);
+
+    /// @brief Index in [0, threads) of the calling worker thread, or `not_a_worker`.
+    static std::size_t worker_index() noexcept;
+
+    [[nodiscard]] std::size_t threads() const noexcept {
+        return workers_.size();
+    }
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return capacity_;
+    }
+    /// @brief Tasks waiting for a worker.
+    [[nodiscard]] std::size_t queued() const;
+    /// @brief Tasks run to completion (including those that threw).
+    [[nodiscard]] std::uint64_t completed() const noexcept {
+        return completed_.load(std::memory_order_relaxed);
+    }
+    /// @brief Tasks that ended with an exception.
+    [[nodiscard]] std::uint64_t failed() const noexcept {
+        return failed_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    void run_(std::size_t index);
+
+    const std::size_t capacity_;
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;  ///< a task was queued, or the pool is draining
+    std::condition_variable idle_;   ///< the queue became empty
+    std::deque<Task> queue_;
+    metrics::MemoryAccount queue_memory_{"worker_pool.queue"};
+    bool accepting_ = true;
+    bool stopping_  = false; ///< workers exit once they see it
+    std::atomic<std::uint64_t> completed_{0};
+    std::atomic<std::uint64_t> failed_{0};
+    std::vector<std::thread> workers_;
+};
+
+} // namespace project_template::utils::concurrency
@@ -0,0 +1,164 @@
+#include "batch_async_logger.hpp"
+#include "peak_rss.hpp"
+
+#include <benchmark/benchmark.h>
+#include <spdlog/async.h>
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/sinks/base_sink.h>
+#include <sys/resource.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using project_template::utils::log::BatchAsyncLogger;
+
+namespace {
+
+/// Formats every record (like a file sink would) and counts it; no I/O.
+class CountingSink final : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+  public:
+    std::atomic<std::uint64_t> count{0};
+
+  protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        buffer_.clear();
+        formatter_->format(msg, buffer_);
+        benchmark::DoNotOptimize(buffer_.data());
+        count.fetch_add(1, std::memory_order_release);
+    }
+
+    void flush_() override {}
+
+  private:
+    spdlog::memory_buf_t buffer_;
+};
+
+/// spdlog's async_logger: mutex + condition variable queue, one record per wakeup.
+struct SpdlogBackend {
+    std::shared_ptr<spdlog::details::thread_pool> pool = std::make_shared<spdlog::details::thread_pool>(8192, 1);
+    std::shared_ptr<spdlog::logger> logger;
+
+    explicit SpdlogBackend(const std::shared_ptr<CountingSink>& sink)
+        : logger(std::make_shared<spdlog::async_logger>("bench", sink, pool, spdlog::async_overflow_policy::block)) {}
+
+    [[nodiscard]] std::uint64_t wakeups() const {
+        return 0; // not observable; see the context-switch counter
+    }
+};
+
+/// BatchAsyncLogger: lock-free ring, spin-then-futex worker, batched writes.
+struct BatchBackend {
+    std::shared_ptr<spdlog::logger> logger;
+
+    explicit BatchBackend(const std::shared_ptr<CountingSink>& sink)
+        : logger(std::make_shared<BatchAsyncLogger>("bench", std::vector<spdlog::sink_ptr>{sink})) {}
+
+    [[nodiscard]] std::uint64_t wakeups() const {
+        return static_cast<const BatchAsyncLogger&>(*logger).stats().wakeups;
+    }
+};
+
+/// Voluntary context switches of the whole process (every blocking futex wait is one).
+std::int64_t voluntary_context_switches() {
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw;
+}
+
+void wait_for(const CountingSink& sink, const std::uint64_t expected) {
+    while (sink.count.load(std::memory_order_acquire) < expected) {
+        std::this_thread::yield();
+    }
+}
+
+void set_counters(benchmark::State& state, const std::uint64_t messages, const std::int64_t switches,
+                  const std::uint64_t wakeups) {
+    const auto per_message = [&](const double value) {
+        return benchmark::Counter(value / static_cast<double>(messages));
+    };
+    state.SetItemsProcessed(static_cast<int64_t>(messages));
+    state.counters["ctx_switches/msg"] = per_message(static_cast<double>(switches));
+    state.counters["wake_calls/msg"]   = per_message(static_cast<double>(wakeups));
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// saturated: N producer threads log as fast as they can, until all records are written
+// ---------------------------------------------------------------------------
+
+template <class Backend> static void bm_async_throughput(benchmark::State& state) {
+    constexpr std::uint64_t per_thread = 20'000;
+    const auto producers               = static_cast<std::uint64_t>(state.range(0));
+    const auto sink                    = std::make_shared<CountingSink>();
+    Backend backend{sink};
+
+    std::uint64_t expected    = 0;
+    const auto switches_start = voluntary_context_switches();
+    for (auto _ : state) {
+        std::vector<std::jthread> threads;
+        for (std::uint64_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&logger = *backend.logger, p] {
+                for (std::uint64_t i = 0; i < per_thread; ++i) {
+                    logger.info("[worker.cpp@line:{}] processed request id={} status=ok", p, i);
+                }
+            });
+        }
+        threads.clear();
+        expected += producers * per_thread;
+        wait_for(*sink, expected);
+    }
+    set_counters(state, expected, voluntary_context_switches() - switches_start, backend.wakeups());
+}
+
+// ---------------------------------------------------------------------------
+// paced: one producer logs every `interval` µs (busy between records), so the worker
+// keeps going idle; this is where per-record wakeups cost the most
+// ---------------------------------------------------------------------------
+
+template <class Backend> static void bm_async_paced(benchmark::State& state) {
+    constexpr std::uint64_t messages = 2'000;
+    const auto interval              = std::chrono::microseconds{state.range(0)};
+    const auto sink                  = std::make_shared<CountingSink>();
+    Backend backend{sink};
+
+    std::uint64_t expected    = 0;
+    const auto switches_start = voluntary_context_switches();
+    for (auto _ : state) {
+        auto next = std::chrono::steady_clock::now();
+        for (std::uint64_t i = 0; i < messages; ++i) {
+            backend.logger->info("[worker.cpp@line:42] processed request id={} status=ok", i);
+            next += interval;
+            while (std::chrono::steady_clock::now() < next) {
+                // simulated application work
+            }
+        }
+        expected += messages;
+        wait_for(*sink, expected);
+    }
+    set_counters(state, expected, voluntary_context_switches() - switches_start, backend.wakeups());
+}
+
+// producers and the worker do the work on other threads: report wall-clock time
+BENCHMARK_TEMPLATE(bm_async_throughput, SpdlogBackend)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(bm_async_throughput, BatchBackend)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(bm_async_paced, SpdlogBackend)->Arg(5)->Arg(50)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_async_paced, BatchBackend)->Arg(5)->Arg(50)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+PEAK_RSS_BENCHMARK_MAIN();
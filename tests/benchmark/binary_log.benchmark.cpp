@@ -0,0 +1,149 @@
+#include "binary_log.hpp"
+#include "peak_rss.hpp"
+
+#include <benchmark/benchmark.h>
+#include <spdlog/pattern_formatter.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+using project_template::utils::log::BinaryRecord;
+using project_template::utils::log::BinaryRecordReader;
+using project_template::utils::log::encode_record;
+using project_template::utils::log::JsonRenderer;
+using project_template::utils::log::render_parallel;
+using project_template::utils::log::split_records;
+
+namespace {
+
+/// ~64 MiB of records shaped like LOG_* output, 1 µs apart, mixed levels.
+const spdlog::memory_buf_t& segment() {
+    static const auto buffer = [] {
+        auto buf             = std::make_unique<spdlog::memory_buf_t>();
+        const auto start     = spdlog::log_clock::now();
+        constexpr auto bytes = std::size_t{64} << 20;
+        for (int i = 0; buf->size() < bytes; ++i) {
+            const auto payload = "[worker.cpp@line:" + std::to_string(100 + i % 50) + "] processed request id=" +
+                                 std::to_string(i) + " status=ok latency_us=" + std::to_string(i % 997);
+            spdlog::details::log_msg msg{start + std::chrono::microseconds{i},
+                                         spdlog::source_loc{},
+                                         "project_template",
+                                         static_cast<spdlog::level::level_enum>(i % 5),
+                                         spdlog::string_view_t{payload.data(), payload.size()}};
+            encode_record(msg, *buf);
+        }
+        return buf;
+    }();
+    return *buffer;
+}
+
+std::span<const std::byte> records() {
+    return {reinterpret_cast<const std::byte*>(segment().data()), segment().size()};
+}
+
+void set_throughput(benchmark::State& state) {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(records().size()));
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// framing only: the boundary pass used to hand chunks to threads
+// ---------------------------------------------------------------------------
+
+static void bm_binary_log_split(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(split_records(records(), std::size_t{4} << 20));
+    }
+    set_throughput(state);
+}
+
+// ---------------------------------------------------------------------------
+// decode: every field of every record, no rendering
+// ---------------------------------------------------------------------------
+
+static void bm_binary_log_decode(benchmark::State& state) {
+    for (auto _ : state) {
+        BinaryRecordReader reader{records()};
+        BinaryRecord record;
+        std::size_t payload_bytes = 0;
+        while (reader.next(record)) {
+            payload_bytes += record.payload.size();
+        }
+        benchmark::DoNotOptimize(payload_bytes);
+    }
+    set_throughput(state);
+}
+
+// ---------------------------------------------------------------------------
+// decode + render, single thread
+// ---------------------------------------------------------------------------
+
+static void bm_binary_log_render_text(benchmark::State& state) {
+    spdlog::pattern_formatter formatter{"[%T.%f] [%^%l%$] %v"};
+    spdlog::memory_buf_t out;
+    for (auto _ : state) {
+        BinaryRecordReader reader{records()};
+        BinaryRecord record;
+        while (reader.next(record)) {
+            out.clear();
+            formatter.format(record.to_log_msg(), out);
+            benchmark::DoNotOptimize(out.data());
+        }
+    }
+    set_throughput(state);
+}
+
+static void bm_binary_log_render_json(benchmark::State& state) {
+    JsonRenderer render;
+    spdlog::memory_buf_t out;
+    for (auto _ : state) {
+        BinaryRecordReader reader{records()};
+        BinaryRecord record;
+        while (reader.next(record)) {
+            out.clear();
+            render(record, out);
+            benchmark::DoNotOptimize(out.data());
+        }
+    }
+    set_throughput(state);
+}
+
+// ---------------------------------------------------------------------------
+// decode + render on N threads, as project_template_logcat does
+// ---------------------------------------------------------------------------
+
+static void bm_binary_log_render_text_parallel(benchmark::State& state) {
+    const auto threads = static_cast<unsigned>(state.range(0));
+    const auto make    = [] {
+        return [formatter = std::make_unique<spdlog::pattern_formatter>("[%T.%f] [%^%l%$] %v")](
+                   const BinaryRecord& record, spdlog::memory_buf_t& out) {
+            formatter->format(record.to_log_msg(), out);
+        };
+    };
+    for (auto _ : state) {
+        std::size_t written = 0;
+        render_parallel(records(), threads, std::size_t{4} << 20, make,
+                        [&written](const std::string_view text) { written += text.size(); });
+        benchmark::DoNotOptimize(written);
+    }
+    set_throughput(state);
+}
+
+BENCHMARK(bm_binary_log_split)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_binary_log_decode)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_binary_log_render_text)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_binary_log_render_json)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_binary_log_render_text_parallel)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+PEAK_RSS_BENCHMARK_MAIN();
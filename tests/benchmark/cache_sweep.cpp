@@ -0,0 +1,123 @@
+#include "cache_sweep.hpp"
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+namespace benchmark_cache {
+
+namespace {
+
+std::string read_line(const std::filesystem::path& file) {
+    std::ifstream in{file};
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+std::size_t parse_number(const std::string_view text, std::size_t& pos) {
+    std::size_t value = 0;
+    const auto [end, ec] = std::from_chars(text.data() + pos, text.data() + text.size(), value);
+    pos                  = static_cast<std::size_t>(end - text.data());
+    return ec == std::errc{} ? value : 0;
+}
+
+/// "48K", "2048K", "32M" → bytes.
+std::size_t parse_size(const std::string_view text) {
+    std::size_t pos   = 0;
+    const auto number = parse_number(text, pos);
+    if (pos < text.size() && text[pos] == 'K') return number << 10;
+    if (pos < text.size() && text[pos] == 'M') return number << 20;
+    if (pos < text.size() && text[pos] == 'G') return number << 30;
+    return number;
+}
+
+/// "0-3,8-11" → 8.
+std::size_t count_cpus(const std::string_view list) {
+    std::size_t count = 0;
+    std::size_t pos   = 0;
+    while (pos < list.size()) {
+        const auto first = parse_number(list, pos);
+        auto last        = first;
+        if (pos < list.size() && list[pos] == '-') {
+            ++pos;
+            last = parse_number(list, pos);
+        }
+        count += last >= first ? last - first + 1 : 0;
+        if (pos < list.size() && list[pos] != ',') break; // malformed
+        ++pos;
+    }
+    return count;
+}
+
+std::vector<CacheLevel> from_sysfs() {
+    std::vector<CacheLevel> caches;
+    const std::filesystem::path root{"/sys/devices/system/cpu/cpu0/cache"};
+    for (int index = 0;; ++index) {
+        const auto dir = root / ("index" + std::to_string(index));
+        std::error_code ec;
+        if (!std::filesystem::is_directory(dir, ec)) break;
+        if (read_line(dir / "type") == "Instruction") continue;
+
+        CacheLevel cache;
+        std::size_t pos      = 0;
+        cache.level          = static_cast<int>(parse_number(read_line(dir / "level"), pos));
+        cache.capacity       = parse_size(read_line(dir / "size"));
+        pos                  = 0;
+        cache.line_size      = parse_number(read_line(dir / "coherency_line_size"), pos);
+        cache.shared_by_cpus = count_cpus(read_line(dir / "shared_cpu_list"));
+        if (cache.level > 0 && cache.capacity > 0) caches.push_back(cache);
+    }
+    return caches;
+}
+
+std::vector<CacheLevel> from_sysconf() {
+    std::vector<CacheLevel> caches;
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+    const int sizes[] = {_SC_LEVEL1_DCACHE_SIZE, _SC_LEVEL2_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE, _SC_LEVEL4_CACHE_SIZE};
+    const int lines[] = {_SC_LEVEL1_DCACHE_LINESIZE, _SC_LEVEL2_CACHE_LINESIZE, _SC_LEVEL3_CACHE_LINESIZE,
+                         _SC_LEVEL4_CACHE_LINESIZE};
+    for (int level = 1; level <= 4; ++level) {
+        const long capacity = sysconf(sizes[level - 1]);
+        const long line     = sysconf(lines[level - 1]);
+        if (capacity > 0) {
+            caches.push_back({level, static_cast<std::size_t>(capacity), line > 0 ? static_cast<std::size_t>(line) : 0,
+                              0});
+        }
+    }
+#endif
+    return caches;
+}
+
+std::vector<CacheLevel> detect() {
+    auto caches = from_sysfs();
+    if (caches.empty()) caches = from_sysconf();
+    if (caches.empty()) caches = {{1, std::size_t{32} << 10, 64, 1}, {2, std::size_t{1} << 20, 64, 1},
+                                  {3, std::size_t{32} << 20, 64, 0}};
+    std::sort(caches.begin(), caches.end(), [](const auto& a, const auto& b) { return a.level < b.level; });
+    return caches;
+}
+
+} // namespace
+
+const std::vector<CacheLevel>& data_caches() {
+    static const std::vector<CacheLevel> caches = detect();
+    return caches;
+}
+
+std::vector<std::size_t> working_set_sweep(const int max_level) {
+    std::vector<std::size_t> sizes;
+    for (const auto& cache : data_caches()) {
+        if (max_level > 0 && cache.level > max_level) break;
+        sizes.insert(sizes.end(), {cache.capacity / 2, cache.capacity, 2 * cache.capacity});
+    }
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+    return sizes;
+}
+
+} // namespace benchmark_cache
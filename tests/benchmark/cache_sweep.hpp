@@ -0,0 +1,56 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace benchmark_cache {
+
+/**
+ * @brief A data (or unified) cache level of the CPU the benchmarks run on.
+ */
+struct CacheLevel {
+    int level                  = 0; ///< 1, 2, 3, ...
+    std::size_t capacity       = 0; ///< bytes
+    std::size_t line_size      = 0; ///< bytes
+    std::size_t shared_by_cpus = 0; ///< logical CPUs sharing this cache (1 = private, 0 = unknown)
+};
+
+/**
+ * @brief The data cache hierarchy of CPU 0, innermost level first.
+ *
+ * Read from `/sys/devices/system/cpu/cpu0/cache/index<N>/` (instruction
+ * caches skipped); where sysfs is unavailable, from `sysconf()`; failing
+ * both, a typical 32 KiB / 1 MiB / 32 MiB hierarchy, so a sweep can always be
+ * generated. Read once per process.
+ */
+const std::vector<CacheLevel>& data_caches();
+
+/**
+ * @brief Working-set sizes in bytes around each cache capacity C: C/2, C and 2C.
+ *
+ * Half the capacity fits comfortably, the full capacity is at the edge and
+ * twice the capacity spills into the next level, so plotting a benchmark
+ * over the sweep shows one cliff per level on any machine. Sorted,
+ * without duplicates. `max_level` > 0 stops after that cache level (for
+ * benchmarks too slow or too memory-hungry for DRAM-sized inputs).
+ */
+std::vector<std::size_t> working_set_sweep(int max_level = 0);
+
+/**
+ * @brief Register `working_set_sweep()` as element counts: `->Apply(cache_sweep<sizeof(T)>)`.
+ *
+ * `BytesPerElement` is the footprint of one element including per-element
+ * overhead (nodes, control bytes), so `state.range(0)` elements occupy about
+ * the swept working set.
+ */
+template <std::size_t BytesPerElement, int MaxLevel = 0> void cache_sweep(benchmark::internal::Benchmark* bench) {
+    for (const auto bytes : working_set_sweep(MaxLevel)) {
+        bench->Arg(static_cast<std::int64_t>(std::max<std::size_t>(1, bytes / BytesPerElement)));
+    }
+}
+
+} // namespace benchmark_cache
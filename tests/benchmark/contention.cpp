@@ -0,0 +1,123 @@
+#include "contention.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace benchmark_contention {
+
+namespace {
+
+/// Uncontended ns per operation of the running benchmark, set by thread 0 before the loop.
+std::atomic<double> solo_ns{0};
+
+#if defined(__linux__)
+struct Event {
+    std::uint32_t type;
+    std::uint64_t config;
+    const char* counter;
+    const char* name;
+};
+
+Event pick_event() {
+#if defined(__x86_64__)
+    if (__builtin_cpu_is("intel")) {
+        return {PERF_TYPE_RAW, 0x04d2, "hitm_per_op", "MEM_LOAD_L3_HIT_RETIRED.XSNP_HITM (raw 0x04d2)"};
+    }
+#endif
+    return {PERF_TYPE_HW_CACHE,
+            PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+            "l1d_miss_per_op", "L1D read misses (no HITM event for this CPU)"};
+}
+
+/// Counter for the calling thread, user space only (allowed up to perf_event_paranoid 2), disabled.
+int open_event(const Event& event) {
+    perf_event_attr attr{};
+    attr.size           = sizeof(attr);
+    attr.type           = event.type;
+    attr.config         = event.config;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+CounterInfo probe() {
+    const auto event = pick_event();
+    const int fd     = open_event(event);
+    if (fd < 0) {
+        return {"", std::string{"unavailable: perf_event_open: "} + std::strerror(errno)};
+    }
+    ::close(fd);
+    return {event.counter, event.name};
+}
+#endif
+
+} // namespace
+
+const CounterInfo& contention_counter() {
+#if defined(__linux__)
+    static const CounterInfo info = probe();
+#else
+    static const CounterInfo info{"", "unavailable: no perf events on this platform"};
+#endif
+    return info;
+}
+
+std::int64_t ContentionMeter::thread_cpu_ns_() {
+#if defined(__linux__)
+    timespec ts{};
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<std::int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+void ContentionMeter::set_solo_ns_(const double ns) {
+    solo_ns.store(ns, std::memory_order_relaxed); // published to the other threads by the loop's start barrier
+}
+
+void ContentionMeter::start_() {
+#if defined(__linux__)
+    if (!contention_counter().counter.empty()) {
+        fd_ = open_event(pick_event());
+        if (fd_ >= 0) ::ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+    start_ns_ = thread_cpu_ns_();
+}
+
+ContentionMeter::~ContentionMeter() {
+#if defined(__linux__)
+    if (fd_ >= 0) ::close(fd_);
+#endif
+}
+
+void ContentionMeter::report(benchmark::State& state) const {
+    const auto iterations = static_cast<double>(std::max<benchmark::IterationCount>(state.iterations(), 1));
+    const auto ns_per_op  = static_cast<double>(thread_cpu_ns_() - start_ns_) / iterations;
+    if (const auto solo = solo_ns.load(std::memory_order_relaxed); solo > 0) {
+        state.counters["slowdown"] = benchmark::Counter(ns_per_op / solo, benchmark::Counter::kAvgThreads);
+    }
+#if defined(__linux__)
+    std::uint64_t events = 0;
+    if (fd_ >= 0 && ::read(fd_, &events, sizeof(events)) == static_cast<ssize_t>(sizeof(events))) {
+        state.counters[contention_counter().counter] =
+            benchmark::Counter(static_cast<double>(events), benchmark::Counter::kAvgIterations);
+    }
+#endif
+}
+
+} // namespace benchmark_contention
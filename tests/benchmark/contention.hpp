@@ -0,0 +1,83 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace benchmark_contention {
+
+/**
+ * @brief The hardware event `ContentionMeter` counts on this machine, if any.
+ *
+ * On Intel CPUs this is `MEM_LOAD_L3_HIT_RETIRED.XSNP_HITM` (`XSNP_FWD` on
+ * Ice Lake and later): loads that found their line modified in another
+ * core's cache, the signature of true and false sharing (what `perf c2c`
+ * reports as HITM). Elsewhere L1D read misses stand in as a proxy. Counting
+ * needs `perf_event_open()` for the calling thread; in VMs without a virtual
+ * PMU, or with `perf_event_paranoid` > 2, nothing is counted.
+ */
+struct CounterInfo {
+    std::string counter; ///< benchmark counter name: "hitm_per_op" or "l1d_miss_per_op" (empty if unavailable)
+    std::string detail;  ///< event name, or why no event could be opened
+};
+
+const CounterInfo& contention_counter();
+
+/**
+ * @brief Reports how much a multi-threaded benchmark suffers from cache-line contention.
+ *
+ * Construct it on every benchmark thread right before the timed loop, with
+ * the operation the loop repeats, and call `report()` after it:
+ *
+ *     ContentionMeter meter{state, [&] { slots[state.thread_index()].fetch_add(1); }};
+ *     for (auto _ : state) { ... }
+ *     meter.report(state);
+ *
+ * Thread 0 first runs `op` alone (the other threads wait at the start of the
+ * loop) to measure its uncontended cost. `report()` then adds `slowdown`: the
+ * thread CPU time per iteration, averaged over the threads, relative to that
+ * uncontended cost. CPU time rather than wall time keeps time-sliced threads
+ * on a machine with fewer cores than threads from counting as contention;
+ * cycles stalled on a contended line do count. Where the hardware event of
+ * `contention_counter()` is available, it also adds that counter per
+ * iteration.
+ */
+class ContentionMeter {
+  public:
+    template <class Op> ContentionMeter(const benchmark::State& state, Op&& op) {
+        if (state.thread_index() == 0) calibrate_(op);
+        start_();
+    }
+
+    ~ContentionMeter();
+    ContentionMeter(const ContentionMeter&)            = delete;
+    ContentionMeter& operator=(const ContentionMeter&) = delete;
+
+    void report(benchmark::State& state) const;
+
+  private:
+    template <class Op> static void calibrate_(Op& op) {
+        constexpr int calls = 1 << 14;
+        double best         = 0;
+        for (int run = 0; run < 3; ++run) {
+            const auto start = thread_cpu_ns_();
+            for (int i = 0; i < calls; ++i) {
+                op();
+            }
+            const auto ns = static_cast<double>(thread_cpu_ns_() - start) / calls;
+            best          = run == 0 ? ns : std::min(best, ns);
+        }
+        set_solo_ns_(best);
+    }
+
+    static std::int64_t thread_cpu_ns_();
+    static void set_solo_ns_(double ns);
+    void start_();
+
+    std::int64_t start_ns_ = 0;
+    int fd_                = -1; ///< perf event of the calling thread
+};
+
+} // namespace benchmark_contention
@@ -1,15 +1,20 @@
+#include "cache_sweep.hpp"
 #include "example.hpp"
+#include "roofline.hpp"
 
 #include <benchmark/benchmark.h>
 
+using benchmark_cache::cache_sweep;
 using benchmark_example::make_test_vector;
 using benchmark_example::sum_accumulate;
 using benchmark_example::sum_naive;
+using benchmark_roofline::RooflineMeter;
 
 static void bm_sum_naive(benchmark::State& state) {
     const auto size = static_cast<std::size_t>(state.range(0));
     const auto data = make_test_vector(size);
 
+    RooflineMeter meter;
     for (auto _ : state) {
         auto result = sum_naive(data);
         benchmark::DoNotOptimize(result);
@@ -17,12 +22,14 @@ static void bm_sum_naive(benchmark::State& state) {
     }
 
     state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+    meter.report(state, size * sizeof(int), size * sizeof(int), size);
 }
 
 static void bm_sum_accumulate(benchmark::State& state) {
     const auto size = static_cast<std::size_t>(state.range(0));
     const auto data = make_test_vector(size);
 
+    RooflineMeter meter;
     for (auto _ : state) {
         auto result = sum_accumulate(data);
         benchmark::DoNotOptimize(result);
@@ -30,10 +37,11 @@ static void bm_sum_accumulate(benchmark::State& state) {
     }
 
     state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+    meter.report(state, size * sizeof(int), size * sizeof(int), size);
 }
 
-BENCHMARK(bm_sum_naive)->Arg(1 << 10)->Arg(1 << 15)->Arg(1 << 20);
+BENCHMARK(bm_sum_naive)->Apply(cache_sweep<sizeof(int)>);
 
-BENCHMARK(bm_sum_accumulate)->Arg(1 << 10)->Arg(1 << 15)->Arg(1 << 20);
+BENCHMARK(bm_sum_accumulate)->Apply(cache_sweep<sizeof(int)>);
 
-BENCHMARK_MAIN();
+ROOFLINE_BENCHMARK_MAIN();
@@ -0,0 +1,166 @@
+#include "batch_async_logger.hpp"
+#include "contention.hpp"
+#include "peak_rss.hpp"
+#include "per_cpu_logger.hpp"
+#include "sink_registry.hpp"
+#include "strided_slots.hpp"
+
+#include <benchmark/benchmark.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+using benchmark_contention::ContentionMeter;
+using project_template::utils::container::slot_stride_override;
+using project_template::utils::container::StridedSlots;
+using project_template::utils::log::BatchAsyncLogger;
+using project_template::utils::log::PerCpuRing;
+using project_template::utils::log::SinkRegistry;
+
+namespace {
+
+constexpr int max_threads = 8;
+
+/// Sets the process-wide slot stride for the utilities constructed while it lives (0 = their default padding).
+class StrideScope {
+  public:
+    explicit StrideScope(const std::size_t stride) : previous_(slot_stride_override().exchange(stride)) {}
+    ~StrideScope() {
+        slot_stride_override().store(previous_);
+    }
+    StrideScope(const StrideScope&)            = delete;
+    StrideScope& operator=(const StrideScope&) = delete;
+
+  private:
+    std::size_t previous_;
+};
+
+void stride_args(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("stride");
+    for (const std::int64_t stride : {8, 16, 32, 64, 128}) {
+        bench->Arg(stride);
+    }
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// per-thread counters placed `stride` bytes apart: false sharing below 64
+// ---------------------------------------------------------------------------
+
+static void bm_private_counters(benchmark::State& state) {
+    using Slots = StridedSlots<std::atomic<std::uint64_t>>;
+    static Slots* slots = nullptr;
+    if (state.thread_index() == 0) slots = new Slots(max_threads, static_cast<std::size_t>(state.range(0)));
+    // other threads may only touch `slots` once the loop has started (thread 0 creates it before the barrier)
+    const auto index     = static_cast<std::size_t>(state.thread_index());
+    const auto increment = [index] { (*slots)[index].fetch_add(1, std::memory_order_relaxed); };
+
+    ContentionMeter meter{state, increment};
+    for (auto _ : state) {
+        increment();
+    }
+    meter.report(state);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    if (state.thread_index() == 0) {
+        delete slots;
+        slots = nullptr;
+    }
+}
+
+/// Reference point: every thread increments the same counter (true sharing).
+static void bm_shared_counter(benchmark::State& state) {
+    static std::atomic<std::uint64_t> counter{0};
+    ContentionMeter meter{state, [] { counter.fetch_add(1, std::memory_order_relaxed); }};
+    for (auto _ : state) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+    meter.report(state);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK(bm_private_counters)->Apply(stride_args)->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(bm_shared_counter)->ThreadRange(1, max_threads)->UseRealTime();
+
+// ---------------------------------------------------------------------------
+// concurrent utilities of utils_lib, from 1-8 threads
+// ---------------------------------------------------------------------------
+
+/// SinkRegistry readers: stride 16 packs the per-thread reader counters four to a line, 0 keeps the default.
+static void bm_sink_registry_log(benchmark::State& state) {
+    static SinkRegistry* registry = nullptr;
+    if (state.thread_index() == 0) {
+        const StrideScope stride{static_cast<std::size_t>(state.range(0))};
+        registry = new SinkRegistry{std::vector<spdlog::sink_ptr>{std::make_shared<spdlog::sinks::null_sink_st>()}};
+    }
+    const spdlog::details::log_msg msg{"bench", spdlog::level::info, "request finished"};
+
+    ContentionMeter meter{state, [&] { registry->log(msg); }};
+    for (auto _ : state) {
+        registry->log(msg);
+    }
+    meter.report(state);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    if (state.thread_index() == 0) {
+        delete registry;
+        registry = nullptr;
+    }
+}
+
+/// PerCpuRing appends of a 64-byte record; thread 0 also drains, as the logger's worker would.
+static void bm_per_cpu_ring_append(benchmark::State& state) {
+    static PerCpuRing* ring = nullptr;
+    if (state.thread_index() == 0) ring = new PerCpuRing;
+    const std::array<std::byte, 64> record{};
+    const bool drains   = state.thread_index() == 0;
+    std::size_t appends = 0;
+    const auto append   = [&] {
+        benchmark::DoNotOptimize(ring->try_append(std::span<const std::byte>{record}));
+        if (drains && ++appends % 256 == 0) ring->drain([](auto records) { benchmark::DoNotOptimize(records); });
+    };
+
+    ContentionMeter meter{state, append};
+    for (auto _ : state) {
+        append();
+    }
+    meter.report(state);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    if (state.thread_index() == 0) {
+        delete ring;
+        ring = nullptr;
+    }
+}
+
+/// BatchAsyncLogger producers: they share the ring's claim counter by design, so this is true contention.
+static void bm_batch_async_log(benchmark::State& state) {
+    static std::shared_ptr<BatchAsyncLogger> logger;
+    if (state.thread_index() == 0) {
+        logger = std::make_shared<BatchAsyncLogger>(
+            "bench", std::vector<spdlog::sink_ptr>{std::make_shared<spdlog::sinks::null_sink_mt>()});
+    }
+
+    ContentionMeter meter{state, [&] { logger->info("request {} finished", 42); }};
+    for (auto _ : state) {
+        logger->info("request {} finished", 42);
+    }
+    meter.report(state);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    if (state.thread_index() == 0) logger.reset();
+}
+
+BENCHMARK(bm_sink_registry_log)->ArgName("stride")->Arg(16)->Arg(0)->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(bm_per_cpu_ring_append)->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(bm_batch_async_log)->ThreadRange(1, max_threads)->UseRealTime();
+
+int main(int argc, char** argv) {
+    return benchmark_peak_rss::run_benchmarks(argc, argv, [] {
+        benchmark::AddCustomContext("contention_counter", benchmark_contention::contention_counter().detail);
+    });
+}
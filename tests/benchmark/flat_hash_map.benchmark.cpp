@@ -0,0 +1,172 @@
+#include "cache_sweep.hpp"
+#include "flat_hash_map.hpp"
+#include "peak_rss.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using benchmark_cache::cache_sweep;
+using project_template::utils::container::FlatHashMap;
+
+namespace {
+
+/// Distinct, scattered 64-bit keys `first .. first + count - 1` (deterministic across runs).
+std::vector<std::uint64_t> make_int_keys(const std::size_t count, const std::size_t first = 0) {
+    std::vector<std::uint64_t> keys(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        // odd multiplier keeps the mapping a bijection, so keys stay unique
+        keys[i] = static_cast<std::uint64_t>(first + i) * 0x9E3779B97F4A7C15ULL;
+    }
+    return keys;
+}
+
+/// Keys shaped like logger / call-site names, e.g. "component.subsystem.123".
+std::vector<std::string> make_string_keys(const std::size_t count) {
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        keys.push_back("project_template.module." + std::to_string(i));
+    }
+    return keys;
+}
+
+template <class Map, class Keys> Map make_filled(const Keys& keys) {
+    Map map;
+    map.reserve(keys.size());
+    for (const auto& k : keys) {
+        map.emplace(k, 1);
+    }
+    return map;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// insert: build a map of N elements from scratch (no reserve, includes growth)
+// ---------------------------------------------------------------------------
+
+template <class Map> static void bm_insert_int(benchmark::State& state) {
+    const auto keys = make_int_keys(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        Map map;
+        for (const auto k : keys) {
+            map.emplace(k, k);
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// ---------------------------------------------------------------------------
+// find: successful lookups in random order, plus a miss-heavy variant
+// ---------------------------------------------------------------------------
+
+template <class Map> static void bm_find_hit_int(benchmark::State& state) {
+    const auto keys = make_int_keys(static_cast<std::size_t>(state.range(0)));
+    const auto map  = make_filled<Map>(keys);
+    auto probes     = keys;
+    std::shuffle(probes.begin(), probes.end(), std::mt19937_64{3});
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(probes[i]));
+        if (++i == probes.size()) i = 0;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+template <class Map> static void bm_find_miss_int(benchmark::State& state) {
+    const auto keys   = make_int_keys(static_cast<std::size_t>(state.range(0)));
+    const auto map    = make_filled<Map>(keys);
+    const auto probes = make_int_keys(keys.size(), keys.size()); // disjoint from the inserted keys
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(probes[i]));
+        if (++i == probes.size()) i = 0;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// ---------------------------------------------------------------------------
+// erase + re-insert: steady-state churn at constant size
+// ---------------------------------------------------------------------------
+
+template <class Map> static void bm_erase_insert_int(benchmark::State& state) {
+    const auto keys = make_int_keys(static_cast<std::size_t>(state.range(0)));
+    auto map        = make_filled<Map>(keys);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        map.erase(keys[i]);
+        map.emplace(keys[i], 1);
+        if (++i == keys.size()) i = 0;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// ---------------------------------------------------------------------------
+// string keys: lookups as a named-logger registry would do them
+// ---------------------------------------------------------------------------
+
+template <class Map> static void bm_find_hit_string(benchmark::State& state) {
+    const auto keys = make_string_keys(static_cast<std::size_t>(state.range(0)));
+    const auto map  = make_filled<Map>(keys);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(keys[i]));
+        if (++i == keys.size()) i = 0;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+/// Flat map only: lookup by std::string_view without materializing a std::string.
+static void bm_flat_find_hit_string_view(benchmark::State& state) {
+    const auto keys = make_string_keys(static_cast<std::size_t>(state.range(0)));
+    const auto map  = make_filled<FlatHashMap<std::string, int>>(keys);
+    std::vector<std::string_view> views(keys.begin(), keys.end());
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(views[i]));
+        if (++i == views.size()) i = 0;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+using FlatIntMap    = FlatHashMap<std::uint64_t, std::uint64_t>;
+using StdIntMap     = std::unordered_map<std::uint64_t, std::uint64_t>;
+using FlatStringMap = FlatHashMap<std::string, int>;
+using StdStringMap  = std::unordered_map<std::string, int>;
+
+/// Approximate bytes per element, so the sweep's element counts land around the cache sizes: a 16-byte slot plus
+/// control byte at 7/8 load for the flat map, a heap node and bucket pointer for std::unordered_map; string keys add
+/// a heap-allocated 32-byte key.
+constexpr std::size_t int_entry_bytes    = 32;
+constexpr std::size_t string_entry_bytes = 72;
+
+BENCHMARK_TEMPLATE(bm_insert_int, FlatIntMap)->Apply(cache_sweep<int_entry_bytes>)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(bm_insert_int, StdIntMap)->Apply(cache_sweep<int_entry_bytes>)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(bm_find_hit_int, FlatIntMap)->Apply(cache_sweep<int_entry_bytes>);
+BENCHMARK_TEMPLATE(bm_find_hit_int, StdIntMap)->Apply(cache_sweep<int_entry_bytes>);
+
+BENCHMARK_TEMPLATE(bm_find_miss_int, FlatIntMap)->Apply(cache_sweep<int_entry_bytes>);
+BENCHMARK_TEMPLATE(bm_find_miss_int, StdIntMap)->Apply(cache_sweep<int_entry_bytes>);
+
+BENCHMARK_TEMPLATE(bm_erase_insert_int, FlatIntMap)->Apply(cache_sweep<int_entry_bytes>);
+BENCHMARK_TEMPLATE(bm_erase_insert_int, StdIntMap)->Apply(cache_sweep<int_entry_bytes>);
+
+BENCHMARK_TEMPLATE(bm_find_hit_string, FlatStringMap)->Apply(cache_sweep<string_entry_bytes>);
+BENCHMARK_TEMPLATE(bm_find_hit_string, StdStringMap)->Apply(cache_sweep<string_entry_bytes>);
+BENCHMARK(bm_flat_find_hit_string_view)->Apply(cache_sweep<string_entry_bytes>);
+
+PEAK_RSS_BENCHMARK_MAIN();
@@ -0,0 +1,70 @@
+#include "log_capture.hpp"
+#include "log_context.hpp"
+#include "logger.hpp"
+#include "peak_rss.hpp"
+
+#include <benchmark/benchmark.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using project_template::utils::log::Log;
+using project_template::utils::log::LogContext;
+
+namespace {
+
+/// The ids a request handler attaches to its lines.
+struct Request {
+    std::uint64_t id   = 8'315'004'127;
+    std::string tenant = "acme-industries";
+    std::string trace  = "4bf92f3577b34da6a3ce929d0e0e4736";
+};
+
+/// Sync mode into a null sink, so a call costs formatting and dispatch only.
+void use_null_sink() {
+    test_support::log_only_to({std::make_shared<spdlog::sinks::null_sink_mt>()},
+                              "[%T.%f] [%^%l%$] %v"); // Log::init's default
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// `state.range(0)` lines per request, each carrying three ids: as format arguments vs. a LogContext
+// ---------------------------------------------------------------------------
+
+static void bm_ids_as_arguments(benchmark::State& state) {
+    use_null_sink();
+    const Request request;
+    const auto lines = state.range(0);
+    int rows         = 0;
+    for (auto _ : state) {
+        for (int64_t i = 0; i < lines; ++i) {
+            LOG_INFO("[req={} tenant={} trace={}] loaded {} rows", request.id, request.tenant, request.trace, ++rows);
+        }
+    }
+    Log::reset_logger();
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * lines);
+}
+
+/// Includes entering and leaving the scope, once per request.
+static void bm_ids_in_context(benchmark::State& state) {
+    use_null_sink();
+    const Request request;
+    const auto lines = state.range(0);
+    int rows         = 0;
+    for (auto _ : state) {
+        const LogContext context{{"req", request.id}, {"tenant", request.tenant}, {"trace", request.trace}};
+        for (int64_t i = 0; i < lines; ++i) {
+            LOG_INFO("loaded {} rows", ++rows);
+        }
+    }
+    Log::reset_logger();
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * lines);
+}
+
+BENCHMARK(bm_ids_as_arguments)->Arg(1)->Arg(8)->Arg(64);
+BENCHMARK(bm_ids_in_context)->Arg(1)->Arg(8)->Arg(64);
+
+PEAK_RSS_BENCHMARK_MAIN();
@@ -0,0 +1,152 @@
+#include "log_capture.hpp"
+#include "logger.hpp"
+#include "peak_rss.hpp"
+
+#include <benchmark/benchmark.h>
+#include <spdlog/fmt/compile.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string_view>
+
+using project_template::utils::log::Log;
+
+/// What `LOG_INFO` expanded to before formats were compiled: fmt parses the format on every call.
+#define RUNTIME_LOG_INFO(fmt, ...)                                                                                     \
+    Log::info("[{}@line:{}] " fmt, PROJECT_FILENAME, __LINE__ __VA_OPT__(, __VA_ARGS__))
+
+namespace {
+
+/// Typical argument mix; read through DoNotOptimize so the compiler cannot fold the values into the format.
+struct Fields {
+    int id                = 123456;
+    std::string_view user = "alice";
+    double latency_ms     = 4.17;
+    std::uint64_t bytes   = 51234;
+};
+
+struct Runtime {
+    template <int Args> static void log(const Fields& f) {
+        if constexpr (Args == 0) {
+            RUNTIME_LOG_INFO("request finished");
+        } else if constexpr (Args == 1) {
+            RUNTIME_LOG_INFO("request {} finished", f.id);
+        } else if constexpr (Args == 2) {
+            RUNTIME_LOG_INFO("request {} for {} finished", f.id, f.user);
+        } else if constexpr (Args == 3) {
+            RUNTIME_LOG_INFO("request {} for {} finished in {:.2f} ms", f.id, f.user, f.latency_ms);
+        } else {
+            RUNTIME_LOG_INFO("request {} for {} finished in {:.2f} ms, {} bytes", f.id, f.user, f.latency_ms, f.bytes);
+        }
+    }
+};
+
+struct Compiled {
+    template <int Args> static void log(const Fields& f) {
+        if constexpr (Args == 0) {
+            LOG_INFO("request finished");
+        } else if constexpr (Args == 1) {
+            LOG_INFO("request {} finished", f.id);
+        } else if constexpr (Args == 2) {
+            LOG_INFO("request {} for {} finished", f.id, f.user);
+        } else if constexpr (Args == 3) {
+            LOG_INFO("request {} for {} finished in {:.2f} ms", f.id, f.user, f.latency_ms);
+        } else {
+            LOG_INFO("request {} for {} finished in {:.2f} ms, {} bytes", f.id, f.user, f.latency_ms, f.bytes);
+        }
+    }
+};
+
+/// Route the shared logger into a null sink: the benchmark sees the call and message formatting, not I/O.
+void use_null_sink() {
+    test_support::log_only_to({std::make_shared<spdlog::sinks::null_sink_mt>()});
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// message formatting alone: run-time parsed vs. compiled format
+// ---------------------------------------------------------------------------
+
+template <bool IsCompiled, int Args> static void bm_format(benchmark::State& state) {
+    Fields fields;
+    spdlog::memory_buf_t buf;
+    const auto out = std::back_inserter(buf);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fields);
+        buf.clear();
+        if constexpr (IsCompiled) {
+            if constexpr (Args == 0) {
+                fmt::format_to(out, FMT_COMPILE("[{}@line:42] request finished"), "main.cpp");
+            } else if constexpr (Args == 1) {
+                fmt::format_to(out, FMT_COMPILE("[{}@line:42] request {} finished"), "main.cpp", fields.id);
+            } else if constexpr (Args == 2) {
+                fmt::format_to(out, FMT_COMPILE("[{}@line:42] request {} for {} finished"), "main.cpp", fields.id,
+                               fields.user);
+            } else if constexpr (Args == 3) {
+                fmt::format_to(out, FMT_COMPILE("[{}@line:42] request {} for {} finished in {:.2f} ms"), "main.cpp",
+                               fields.id, fields.user, fields.latency_ms);
+            } else {
+                fmt::format_to(out, FMT_COMPILE("[{}@line:42] request {} for {} finished in {:.2f} ms, {} bytes"),
+                               "main.cpp", fields.id, fields.user, fields.latency_ms, fields.bytes);
+            }
+        } else {
+            if constexpr (Args == 0) {
+                fmt::format_to(out, "[{}@line:{}] request finished", "main.cpp", 42);
+            } else if constexpr (Args == 1) {
+                fmt::format_to(out, "[{}@line:{}] request {} finished", "main.cpp", 42, fields.id);
+            } else if constexpr (Args == 2) {
+                fmt::format_to(out, "[{}@line:{}] request {} for {} finished", "main.cpp", 42, fields.id, fields.user);
+            } else if constexpr (Args == 3) {
+                fmt::format_to(out, "[{}@line:{}] request {} for {} finished in {:.2f} ms", "main.cpp", 42, fields.id,
+                               fields.user, fields.latency_ms);
+            } else {
+                fmt::format_to(out, "[{}@line:{}] request {} for {} finished in {:.2f} ms, {} bytes", "main.cpp", 42,
+                               fields.id, fields.user, fields.latency_ms, fields.bytes);
+            }
+        }
+        benchmark::DoNotOptimize(buf.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// ---------------------------------------------------------------------------
+// whole LOG_INFO call through Log to a null sink: old macro expansion vs. LOG_INFO
+// ---------------------------------------------------------------------------
+
+template <class Impl, int Args> static void bm_log_call(benchmark::State& state) {
+    use_null_sink();
+    Fields fields;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fields);
+        Impl::template log<Args>(fields);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    Log::reset_logger();
+}
+
+BENCHMARK_TEMPLATE(bm_format, false, 0);
+BENCHMARK_TEMPLATE(bm_format, true, 0);
+BENCHMARK_TEMPLATE(bm_format, false, 1);
+BENCHMARK_TEMPLATE(bm_format, true, 1);
+BENCHMARK_TEMPLATE(bm_format, false, 2);
+BENCHMARK_TEMPLATE(bm_format, true, 2);
+BENCHMARK_TEMPLATE(bm_format, false, 3);
+BENCHMARK_TEMPLATE(bm_format, true, 3);
+BENCHMARK_TEMPLATE(bm_format, false, 4);
+BENCHMARK_TEMPLATE(bm_format, true, 4);
+
+BENCHMARK_TEMPLATE(bm_log_call, Runtime, 0);
+BENCHMARK_TEMPLATE(bm_log_call, Compiled, 0);
+BENCHMARK_TEMPLATE(bm_log_call, Runtime, 1);
+BENCHMARK_TEMPLATE(bm_log_call, Compiled, 1);
+BENCHMARK_TEMPLATE(bm_log_call, Runtime, 2);
+BENCHMARK_TEMPLATE(bm_log_call, Compiled, 2);
+BENCHMARK_TEMPLATE(bm_log_call, Runtime, 3);
+BENCHMARK_TEMPLATE(bm_log_call, Compiled, 3);
+BENCHMARK_TEMPLATE(bm_log_call, Runtime, 4);
+BENCHMARK_TEMPLATE(bm_log_call, Compiled, 4);
+
+PEAK_RSS_BENCHMARK_MAIN();
@@ -0,0 +1,141 @@
+#include "cache_sweep.hpp"
+#include "crc32c.hpp"
+#include "log_frame.hpp"
+#include "roofline.hpp"
+
+#include <benchmark/benchmark.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/pattern_formatter.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+using benchmark_cache::cache_sweep;
+using benchmark_roofline::RooflineMeter;
+using project_template::utils::checksum::crc32c;
+using project_template::utils::checksum::crc32c_implementation;
+using project_template::utils::checksum::crc32c_portable;
+using project_template::utils::log::LogFrameHeader;
+using project_template::utils::log::LogFrameReader;
+using project_template::utils::log::seal_frame;
+
+namespace {
+
+struct Dispatched {
+    static std::uint32_t crc(const std::span<const std::byte> data) {
+        return crc32c(data);
+    }
+};
+
+struct Portable {
+    static std::uint32_t crc(const std::span<const std::byte> data) {
+        return crc32c_portable(data);
+    }
+};
+
+std::vector<std::byte> random_bytes(const std::size_t size) {
+    std::mt19937 rng{1};
+    std::vector<std::byte> data(size);
+    for (auto& b : data) {
+        b = static_cast<std::byte>(rng());
+    }
+    return data;
+}
+
+/// A record shaped like LOG_* output (~90 bytes once formatted).
+const std::string payload = "[worker.cpp@line:142] processed request id=123456 status=ok latency_us=417";
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// CRC-32C throughput: dispatched (hardware where available) vs. table-driven
+// ---------------------------------------------------------------------------
+
+template <class Impl> static void bm_crc32c(benchmark::State& state) {
+    const auto data = random_bytes(static_cast<std::size_t>(state.range(0)));
+    RooflineMeter meter;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Impl::crc(data));
+    }
+    meter.report(state, data.size(), data.size());
+    state.SetLabel(std::is_same_v<Impl, Dispatched> ? std::string(crc32c_implementation()) : "portable");
+}
+
+// ---------------------------------------------------------------------------
+// per-record cost in the file sink: pattern formatting with and without framing
+// ---------------------------------------------------------------------------
+
+template <bool Framed> static void bm_format_record(benchmark::State& state) {
+    spdlog::pattern_formatter formatter{"[%Y-%m-%d %H:%M:%S.%f] [%l] %v"};
+    const spdlog::details::log_msg msg{"project_template", spdlog::level::info, payload};
+    spdlog::memory_buf_t buf;
+    for (auto _ : state) {
+        buf.clear();
+        if constexpr (Framed) {
+            buf.resize(sizeof(LogFrameHeader));
+            formatter.format(msg, buf);
+            seal_frame(buf, 0);
+        } else {
+            formatter.format(msg, buf);
+        }
+        benchmark::DoNotOptimize(buf.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+/// Framing alone: header and CRC over an already formatted record.
+static void bm_seal_frame(benchmark::State& state) {
+    spdlog::pattern_formatter formatter{"[%Y-%m-%d %H:%M:%S.%f] [%l] %v"};
+    const spdlog::details::log_msg msg{"project_template", spdlog::level::info, payload};
+    spdlog::memory_buf_t buf;
+    buf.resize(sizeof(LogFrameHeader));
+    formatter.format(msg, buf);
+    for (auto _ : state) {
+        seal_frame(buf, 0);
+        benchmark::DoNotOptimize(buf.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// ---------------------------------------------------------------------------
+// reader: verify and unframe a segment of records
+// ---------------------------------------------------------------------------
+
+static void bm_frame_read(benchmark::State& state) {
+    spdlog::memory_buf_t segment;
+    constexpr int records = 10'000;
+    for (int i = 0; i < records; ++i) {
+        const auto start = segment.size();
+        segment.resize(start + sizeof(LogFrameHeader));
+        segment.append(payload.data(), payload.data() + payload.size());
+        seal_frame(segment, start);
+    }
+    RooflineMeter meter;
+    for (auto _ : state) {
+        LogFrameReader reader{{segment.data(), segment.size()}};
+        std::string_view record;
+        std::size_t bytes = 0;
+        while (reader.next(record)) {
+            bytes += record.size();
+        }
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * records);
+    meter.report(state, segment.size(), segment.size());
+}
+
+// record-sized buffers, then whole segments around each cache level
+BENCHMARK_TEMPLATE(bm_crc32c, Dispatched)->RangeMultiplier(4)->Range(16, 4 << 10)->Apply(cache_sweep<1>);
+BENCHMARK_TEMPLATE(bm_crc32c, Portable)->RangeMultiplier(4)->Range(16, 4 << 10)->Apply(cache_sweep<1>);
+BENCHMARK_TEMPLATE(bm_format_record, false);
+BENCHMARK_TEMPLATE(bm_format_record, true);
+BENCHMARK(bm_seal_frame);
+BENCHMARK(bm_frame_read);
+
+ROOFLINE_BENCHMARK_MAIN();
@@ -0,0 +1,96 @@
+#include "peak_rss.hpp"
+
+#include "process_usage.hpp"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace benchmark_peak_rss {
+
+namespace {
+
+/// Peak RSS per benchmark: the first reporter asking about a benchmark reads and resets the mark.
+class PeakRss {
+  public:
+    double of(const std::string& benchmark) {
+        if (benchmark != benchmark_) {
+            benchmark_ = benchmark;
+            bytes_     = static_cast<double>(project_template::utils::metrics::peak_rss_bytes());
+            project_template::utils::metrics::reset_peak_rss();
+        }
+        return bytes_;
+    }
+
+  private:
+    std::string benchmark_;
+    double bytes_ = 0;
+};
+
+/// Adds the `peak_rss` counter to every run and forwards to the reporter doing the formatting.
+class PeakRssReporter final : public benchmark::BenchmarkReporter {
+  public:
+    PeakRssReporter(benchmark::BenchmarkReporter& inner, PeakRss& peak) : inner_(inner), peak_(peak) {}
+
+    bool ReportContext(const Context& context) override {
+        // the library sets the streams (e.g. the --benchmark_out file) on this reporter
+        inner_.SetOutputStream(&GetOutputStream());
+        inner_.SetErrorStream(&GetErrorStream());
+        return inner_.ReportContext(context);
+    }
+
+    void ReportRuns(const std::vector<Run>& reports) override {
+        auto runs = reports;
+        for (auto& run : runs) {
+            run.counters["peak_rss"] = benchmark::Counter(peak_.of(run.run_name.str()), benchmark::Counter::kDefaults,
+                                                          benchmark::Counter::kIs1024);
+        }
+        inner_.ReportRuns(runs);
+    }
+
+    void Finalize() override {
+        inner_.Finalize();
+    }
+
+  private:
+    benchmark::BenchmarkReporter& inner_;
+    PeakRss& peak_;
+};
+
+/// Reporter for the --benchmark_out file; none for the deprecated CSV format, which the library then writes itself.
+std::unique_ptr<benchmark::BenchmarkReporter> file_reporter(const std::string_view format) {
+    if (format == "console") return std::make_unique<benchmark::ConsoleReporter>(benchmark::ConsoleReporter::OO_None);
+    if (format == "json") return std::make_unique<benchmark::JSONReporter>();
+    return nullptr;
+}
+
+} // namespace
+
+int run_benchmarks(int argc, char** argv, const std::function<void()>& prepare) {
+    // Initialize() consumes the flags: look for the output file first. The library refuses a file reporter
+    // without --benchmark_out and does not expose --benchmark_out_format.
+    bool out_file               = false;
+    std::string_view out_format = "json";
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+        if (arg.starts_with("--benchmark_out=")) out_file = true;
+        if (arg.starts_with("--benchmark_out_format=")) out_format = arg.substr(arg.find('=') + 1);
+    }
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    if (prepare) prepare();
+
+    PeakRss peak;
+    PeakRssReporter display{*benchmark::CreateDefaultDisplayReporter(), peak};
+    const auto file_format = file_reporter(out_format);
+    std::unique_ptr<PeakRssReporter> file;
+    if (out_file && file_format) file = std::make_unique<PeakRssReporter>(*file_format, peak);
+
+    project_template::utils::metrics::reset_peak_rss();
+    benchmark::RunSpecifiedBenchmarks(&display, file.get());
+    benchmark::Shutdown();
+    return 0;
+}
+
+} // namespace benchmark_peak_rss
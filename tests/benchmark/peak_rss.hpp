@@ -0,0 +1,34 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+
+namespace benchmark_peak_rss {
+
+/**
+ * @brief Run the benchmarks like `BENCHMARK_MAIN()`, with a `peak_rss` counter on every benchmark.
+ *
+ * `prepare` runs after the flags are parsed, before the first benchmark
+ * (e.g. to add custom context). The resident-set high-water mark
+ * (`metrics::peak_rss_bytes()`) is reset before the first benchmark, and
+ * read and reset again when a benchmark's results are reported, which
+ * happens right after it ran. So `peak_rss` is the highest RSS of the
+ * process while that benchmark ran, repetitions included. It includes
+ * memory kept from earlier benchmarks of the executable: compare it
+ * between runs of the same benchmark, not between benchmarks. Where the
+ * mark cannot be reset (not Linux), it is the peak of the process so far.
+ *
+ * The counter is in the console output and in the `--benchmark_out` file,
+ * which `benchmark_runner.py compare-json --time-key peak_rss` compares.
+ */
+int run_benchmarks(int argc, char** argv, const std::function<void()>& prepare = {});
+
+} // namespace benchmark_peak_rss
+
+/// Like `BENCHMARK_MAIN()`, with the peak RSS of every benchmark as the `peak_rss` counter.
+#define PEAK_RSS_BENCHMARK_MAIN()                                                                                      \
+    int main(int argc, char** argv) {                                                                                  \
+        return benchmark_peak_rss::run_benchmarks(argc, argv);                                                         \
+    }                                                                                                                  \
+    int main(int, char**)
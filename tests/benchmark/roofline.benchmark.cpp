@@ -0,0 +1,68 @@
+#include "cache_sweep.hpp"
+#include "roofline.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+using benchmark_cache::cache_sweep;
+using benchmark_roofline::RooflineMeter;
+
+namespace {
+
+/// The four STREAM kernels; `arrays` counts the arrays touched per element, `ops` the arithmetic per element.
+struct Copy {
+    static constexpr std::size_t arrays = 2, ops = 0;
+    static void run(double* a, const double* b, const double*, const double, const std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) a[i] = b[i];
+    }
+};
+
+struct Scale {
+    static constexpr std::size_t arrays = 2, ops = 1;
+    static void run(double* a, const double* b, const double*, const double s, const std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) a[i] = s * b[i];
+    }
+};
+
+struct Add {
+    static constexpr std::size_t arrays = 3, ops = 1;
+    static void run(double* a, const double* b, const double* c, const double, const std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) a[i] = b[i] + c[i];
+    }
+};
+
+struct Triad {
+    static constexpr std::size_t arrays = 3, ops = 2;
+    static void run(double* a, const double* b, const double* c, const double s, const std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) a[i] = b[i] + s * c[i];
+    }
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// STREAM kernels over working sets around each cache level
+// ---------------------------------------------------------------------------
+
+template <class Kernel> static void bm_stream(benchmark::State& state) {
+    const auto working_set = static_cast<std::size_t>(state.range(0));
+    const auto n           = working_set / (Kernel::arrays * sizeof(double));
+    std::vector<double> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+
+    RooflineMeter meter;
+    for (auto _ : state) {
+        Kernel::run(a.data(), b.data(), c.data(), 3.0, n);
+        benchmark::DoNotOptimize(a.data());
+        benchmark::ClobberMemory();
+    }
+    meter.report(state, Kernel::arrays * n * sizeof(double), working_set, Kernel::ops * n);
+}
+
+BENCHMARK_TEMPLATE(bm_stream, Copy)->Apply(cache_sweep<1>);
+BENCHMARK_TEMPLATE(bm_stream, Scale)->Apply(cache_sweep<1>);
+BENCHMARK_TEMPLATE(bm_stream, Add)->Apply(cache_sweep<1>);
+BENCHMARK_TEMPLATE(bm_stream, Triad)->Apply(cache_sweep<1>);
+
+ROOFLINE_BENCHMARK_MAIN();
@@ -0,0 +1,238 @@
+#include "roofline.hpp"
+
+#include "cache_sweep.hpp"
+#include "peak_rss.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace benchmark_roofline {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Best time of one `kernel()` call over several runs, each repeating the kernel for at least 10 ms.
+template <class Kernel> double seconds_per_call(Kernel&& kernel) {
+    constexpr int runs     = 5;
+    constexpr auto min_run = std::chrono::milliseconds(10);
+    double best            = std::numeric_limits<double>::infinity();
+    for (int run = 0; run < runs; ++run) {
+        std::size_t calls = 0;
+        const auto start  = Clock::now();
+        Clock::duration elapsed{};
+        do {
+            kernel();
+            ++calls;
+            elapsed = Clock::now() - start;
+        } while (elapsed < min_run);
+        best = std::min(best, std::chrono::duration<double>(elapsed).count() / static_cast<double>(calls));
+    }
+    return best;
+}
+
+// ---------------------------------------------------------------------------
+// kernels: streaming read and in-register multiply-add
+// ---------------------------------------------------------------------------
+
+/// Four independent sums, vectorized by the compiler for the baseline target.
+std::uint64_t read_portable(const std::vector<std::uint64_t>& data) {
+    std::uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (std::size_t i = 0; i + 4 <= data.size(); i += 4) {
+        s0 += data[i];
+        s1 += data[i + 1];
+        s2 += data[i + 2];
+        s3 += data[i + 3];
+    }
+    return s0 + s1 + s2 + s3;
+}
+
+/// STREAM triad: two read streams and one write stream, which DRAM serves faster than a single read stream.
+void triad_portable(double* a, const double* b, const double* c, const std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        a[i] = b[i] + 3.0 * c[i];
+    }
+}
+
+constexpr std::size_t portable_lanes = 16; ///< enough independent chains to hide SSE2 mul + add latency
+constexpr std::size_t avx2_lanes     = 32; ///< 8 ymm chains: FMA latency (4) x 2 ports
+constexpr int madd_steps             = 256;
+
+void madd_portable(std::array<double, avx2_lanes>& x) {
+    for (int step = 0; step < madd_steps; ++step) {
+        for (std::size_t lane = 0; lane < portable_lanes; ++lane) {
+            x[lane] = x[lane] * 0.999999 + 1e-6;
+        }
+    }
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) std::uint64_t read_avx2(const std::vector<std::uint64_t>& data) {
+    const auto* p = reinterpret_cast<const __m256i*>(data.data());
+    __m256i s0 = _mm256_setzero_si256(), s1 = s0, s2 = s0, s3 = s0;
+    for (std::size_t i = 0; i + 4 <= data.size() / 4; i += 4) {
+        s0 = _mm256_add_epi64(s0, _mm256_loadu_si256(p + i));
+        s1 = _mm256_add_epi64(s1, _mm256_loadu_si256(p + i + 1));
+        s2 = _mm256_add_epi64(s2, _mm256_loadu_si256(p + i + 2));
+        s3 = _mm256_add_epi64(s3, _mm256_loadu_si256(p + i + 3));
+    }
+    const auto sum = _mm256_add_epi64(_mm256_add_epi64(s0, s1), _mm256_add_epi64(s2, s3));
+    return static_cast<std::uint64_t>(_mm256_extract_epi64(sum, 0) + _mm256_extract_epi64(sum, 1) +
+                                      _mm256_extract_epi64(sum, 2) + _mm256_extract_epi64(sum, 3));
+}
+
+__attribute__((target("avx2"))) void triad_avx2(double* a, const double* b, const double* c, const std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        a[i] = b[i] + 3.0 * c[i];
+    }
+}
+
+__attribute__((target("avx2,fma"))) void madd_avx2(std::array<double, avx2_lanes>& x) {
+    for (int step = 0; step < madd_steps; ++step) {
+        for (std::size_t lane = 0; lane < avx2_lanes; ++lane) {
+            x[lane] = std::fma(x[lane], 0.999999, 1e-6);
+        }
+    }
+}
+
+bool has_avx2() {
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+#else
+bool has_avx2() {
+    return false;
+}
+#endif
+
+/// Bytes per second over a working set of `bytes`: the better of a pure read stream and STREAM triad.
+double bandwidth(const std::size_t bytes) {
+    const bool avx2 = has_avx2();
+
+    const std::vector<std::uint64_t> data(bytes / sizeof(std::uint64_t), 1);
+    const double read_seconds = seconds_per_call([&] {
+#if defined(__x86_64__)
+        benchmark::DoNotOptimize(avx2 ? read_avx2(data) : read_portable(data));
+#else
+        benchmark::DoNotOptimize(read_portable(data));
+#endif
+    });
+
+    const auto n = bytes / (3 * sizeof(double));
+    std::vector<double> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+    const double triad_seconds = seconds_per_call([&] {
+#if defined(__x86_64__)
+        if (avx2) {
+            triad_avx2(a.data(), b.data(), c.data(), n);
+        } else {
+            triad_portable(a.data(), b.data(), c.data(), n);
+        }
+#else
+        triad_portable(a.data(), b.data(), c.data(), n);
+#endif
+        benchmark::DoNotOptimize(a.data());
+        benchmark::ClobberMemory();
+    });
+
+    return std::max(static_cast<double>(data.size() * sizeof(std::uint64_t)) / read_seconds,
+                    static_cast<double>(3 * n * sizeof(double)) / triad_seconds);
+}
+
+double peak_ops() {
+    std::array<double, avx2_lanes> x{};
+    x.fill(1.0);
+    const bool avx2      = has_avx2();
+    const double seconds = seconds_per_call([&] {
+#if defined(__x86_64__)
+        if (avx2) {
+            madd_avx2(x);
+        } else {
+            madd_portable(x);
+        }
+#else
+        madd_portable(x);
+#endif
+        benchmark::DoNotOptimize(x.data());
+        benchmark::ClobberMemory();
+    });
+    const auto lanes = avx2 ? avx2_lanes : portable_lanes;
+    return 2.0 * static_cast<double>(lanes) * madd_steps / seconds;
+}
+
+Roofline calibrate() {
+    Roofline limits;
+    std::size_t largest = 0;
+    for (const auto& cache : benchmark_cache::data_caches()) {
+        limits.levels.push_back({"L" + std::to_string(cache.level), cache.capacity, bandwidth(cache.capacity / 4)});
+        largest = cache.capacity;
+    }
+    limits.levels.push_back({"DRAM", 0, bandwidth(std::max<std::size_t>(2 * largest, std::size_t{64} << 20))});
+    limits.ops_per_second = peak_ops();
+    return limits;
+}
+
+std::string format_level(const MemoryLevel& level) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    if (level.capacity >= (1U << 20)) {
+        out << static_cast<double>(level.capacity) / (1U << 20) << " MiB, ";
+    } else if (level.capacity > 0) {
+        out << static_cast<double>(level.capacity) / (1U << 10) << " KiB, ";
+    }
+    out << level.bytes_per_second / 1e9 << " GB/s";
+    return out.str();
+}
+
+} // namespace
+
+const MemoryLevel& Roofline::level_for(const std::size_t working_set) const {
+    const auto it = std::find_if(levels.begin(), levels.end(),
+                                 [&](const MemoryLevel& level) { return working_set <= level.capacity; });
+    return it != levels.end() ? *it : levels.back();
+}
+
+const Roofline& roofline() {
+    static const Roofline limits = calibrate();
+    return limits;
+}
+
+void RooflineMeter::report(benchmark::State& state, const std::size_t bytes_per_iteration,
+                           const std::size_t working_set, const std::size_t ops_per_iteration) const {
+    const auto iterations = static_cast<double>(state.iterations());
+    const auto seconds    = std::chrono::duration<double>(Clock::now() - start_).count();
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(bytes_per_iteration));
+
+    const auto& limits          = roofline();
+    const auto& level           = limits.level_for(working_set);
+    const auto bytes_per_second = iterations * static_cast<double>(bytes_per_iteration) / seconds;
+
+    state.counters[level.name + "_bw_pct"] = 100.0 * bytes_per_second / level.bytes_per_second;
+    if (ops_per_iteration > 0) {
+        const auto ops_per_second      = iterations * static_cast<double>(ops_per_iteration) / seconds;
+        state.counters["peak_ops_pct"] = 100.0 * ops_per_second / limits.ops_per_second;
+    }
+}
+
+int run_benchmarks(int argc, char** argv) {
+    return benchmark_peak_rss::run_benchmarks(argc, argv, [] {
+        const auto& limits = roofline();
+        for (const auto& level : limits.levels) {
+            benchmark::AddCustomContext("roofline_" + level.name, format_level(level));
+        }
+        std::ostringstream peak;
+        peak << std::fixed << std::setprecision(1) << limits.ops_per_second / 1e9 << " Gop/s";
+        benchmark::AddCustomContext("roofline_peak_ops", peak.str());
+    });
+}
+
+} // namespace benchmark_roofline
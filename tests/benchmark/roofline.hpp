@@ -0,0 +1,80 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace benchmark_roofline {
+
+/**
+ * @brief One level of the memory hierarchy with its measured read bandwidth.
+ */
+struct MemoryLevel {
+    std::string name;            ///< "L1", "L2", "L3" or "DRAM"
+    std::size_t capacity    = 0; ///< data cache size in bytes (0 for DRAM)
+    double bytes_per_second = 0; ///< single-thread streaming bandwidth
+};
+
+/**
+ * @brief Hardware limits of one core, measured once per benchmark process.
+ *
+ * Bandwidth is measured STREAM-style over a quarter of the level's capacity
+ * (twice the last-level cache, at least 64 MiB, for DRAM): the better of a
+ * vectorized sum and STREAM triad, best of several runs. Peak compute is the
+ * rate of independent double-precision multiply-adds held in registers,
+ * counted per vector lane and operation. Both use AVX2 / FMA where the CPU
+ * has them, so kernels with their own SIMD paths are compared against the
+ * hardware rather than against the baseline target the rest of the code is
+ * compiled for.
+ */
+struct Roofline {
+    std::vector<MemoryLevel> levels; ///< innermost first, DRAM last
+    double ops_per_second = 0;       ///< peak arithmetic operations
+
+    /// @brief Innermost level that holds `working_set` bytes (DRAM if none does).
+    [[nodiscard]] const MemoryLevel& level_for(std::size_t working_set) const;
+};
+
+/// @brief The calibration of this machine; measured on first use (well under a second).
+const Roofline& roofline();
+
+/**
+ * @brief Reports a kernel benchmark against the roofline.
+ *
+ * Construct it right before the timed loop and call `report()` after it:
+ *
+ *     RooflineMeter meter;
+ *     for (auto _ : state) { ... }
+ *     meter.report(state, bytes_per_iteration, working_set);
+ *
+ * `report()` sets bytes/s and a counter `<level>_bw_pct`: the achieved bytes/s
+ * as a percentage of the bandwidth of the level holding `working_set`. With
+ * `ops_per_iteration` it also adds `peak_ops_pct`. A kernel near 100 % on
+ * either has no headroom left on that side of the roofline. (Google Benchmark
+ * rate counters would print percentages as "/s", hence the own stopwatch.)
+ */
+class RooflineMeter {
+  public:
+    RooflineMeter() : start_(std::chrono::steady_clock::now()) {}
+
+    void report(benchmark::State& state, std::size_t bytes_per_iteration, std::size_t working_set,
+                std::size_t ops_per_iteration = 0) const;
+
+  private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+/// @brief Run the benchmarks with the calibration recorded in the output context (and a `peak_rss` counter).
+int run_benchmarks(int argc, char** argv);
+
+} // namespace benchmark_roofline
+
+/// Like `BENCHMARK_MAIN()`, with the roofline calibration in the context (console header and JSON).
+#define ROOFLINE_BENCHMARK_MAIN()                                                                                      \
+    int main(int argc, char** argv) {                                                                                  \
+        return benchmark_roofline::run_benchmarks(argc, argv);                                                         \
+    }                                                                                                                  \
+    int main(int, char**)
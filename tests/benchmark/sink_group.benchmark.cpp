@@ -0,0 +1,72 @@
+#include "peak_rss.hpp"
+#include "sink_registry.hpp"
+
+#include <benchmark/benchmark.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/pattern_formatter.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using project_template::utils::log::SinkRegistry;
+
+namespace {
+
+constexpr auto pattern = "[%T.%f] [%^%l%$] %v"; // Log::init's default
+
+/// Formats every record, as a console or file sink does, and discards the text.
+class FormattingSink final : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+  protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        spdlog::memory_buf_t formatted;
+        formatter_->format(msg, formatted);
+        benchmark::DoNotOptimize(formatted.data());
+    }
+    void flush_() override {}
+};
+
+std::vector<spdlog::sink_ptr> formatting_sinks(const std::int64_t count) {
+    std::vector<spdlog::sink_ptr> sinks;
+    for (std::int64_t i = 0; i < count; ++i) {
+        sinks.push_back(std::make_shared<FormattingSink>());
+    }
+    return sinks;
+}
+
+void log_records(benchmark::State& state, SinkRegistry& registry) {
+    const spdlog::details::log_msg msg{"bench", spdlog::level::info, "request 42 finished in 1.25 ms"};
+    for (auto _ : state) {
+        registry.log(msg);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// per-record cost of fanning out to 1, 2 and 4 sinks with the same pattern
+// ---------------------------------------------------------------------------
+
+/// spdlog's default: every sink has its own formatter and formats the record again.
+static void bm_format_per_sink(benchmark::State& state) {
+    SinkRegistry registry{formatting_sinks(state.range(0))};
+    registry.set_formatter(std::make_unique<spdlog::pattern_formatter>(pattern));
+    log_records(state, registry);
+}
+
+/// SinkRegistry::set_pattern: the sinks form one SinkGroupFormatter group, the first formats and the rest copy.
+static void bm_format_per_group(benchmark::State& state) {
+    SinkRegistry registry{formatting_sinks(state.range(0))};
+    registry.set_pattern(pattern);
+    log_records(state, registry);
+}
+
+BENCHMARK(bm_format_per_sink)->ArgName("sinks")->Arg(1)->Arg(2)->Arg(4);
+BENCHMARK(bm_format_per_group)->ArgName("sinks")->Arg(1)->Arg(2)->Arg(4);
+
+PEAK_RSS_BENCHMARK_MAIN();
@@ -0,0 +1,127 @@
+#include "peak_rss.hpp"
+#include "sink_registry.hpp"
+
+#include <benchmark/benchmark.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/sinks/sink.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+using project_template::utils::log::SinkRegistry;
+
+namespace {
+
+/// Accepts a record without doing anything: the benchmark measures getting to the sinks, not writing.
+class NullSink final : public spdlog::sinks::sink {
+  public:
+    void log(const spdlog::details::log_msg& msg) override {
+        benchmark::DoNotOptimize(&msg);
+    }
+    void flush() override {}
+    void set_pattern(const std::string&) override {}
+    void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+};
+
+std::vector<spdlog::sink_ptr> null_sinks(const std::size_t count) {
+    std::vector<spdlog::sink_ptr> sinks;
+    for (std::size_t i = 0; i < count; ++i) {
+        sinks.push_back(std::make_shared<NullSink>());
+    }
+    return sinks;
+}
+
+void write_all(const std::vector<spdlog::sink_ptr>& sinks, const spdlog::details::log_msg& msg) {
+    for (const auto& sink : sinks) {
+        if (sink->should_log(msg.level)) sink->log(msg);
+    }
+}
+
+/// spdlog's own vector: no synchronization at all, so changing it while logging is a data race (baseline).
+struct Unsynchronized {
+    std::vector<spdlog::sink_ptr> sinks = null_sinks(2);
+
+    void log(const spdlog::details::log_msg& msg) {
+        write_all(sinks, msg);
+    }
+};
+
+/// Readers share a lock; every record still writes the lock's cache line.
+struct SharedMutex {
+    std::vector<spdlog::sink_ptr> sinks = null_sinks(2);
+    std::shared_mutex mutex;
+
+    void log(const spdlog::details::log_msg& msg) {
+        const std::shared_lock lock{mutex};
+        write_all(sinks, msg);
+    }
+};
+
+/// Copy-on-write through std::atomic<std::shared_ptr>: the load takes a lock bit and bumps the shared count.
+struct AtomicSharedPtr {
+    std::atomic<std::shared_ptr<const std::vector<spdlog::sink_ptr>>> sinks{
+        std::make_shared<const std::vector<spdlog::sink_ptr>>(null_sinks(2))};
+
+    void log(const spdlog::details::log_msg& msg) {
+        const auto current = sinks.load();
+        write_all(*current, msg);
+    }
+};
+
+/// SinkRegistry: per-thread reader counter, plain pointer load.
+struct Registry {
+    SinkRegistry registry{null_sinks(2)};
+
+    void log(const spdlog::details::log_msg& msg) {
+        registry.log(msg);
+    }
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// one record to two sinks, from 1-8 threads sharing the sink list
+// ---------------------------------------------------------------------------
+
+template <class Sinks> static void bm_fan_out(benchmark::State& state) {
+    static Sinks* sinks = nullptr;
+    if (state.thread_index() == 0) sinks = new Sinks;
+    const spdlog::details::log_msg msg{"bench", spdlog::level::info, "request finished"};
+    for (auto _ : state) {
+        sinks->log(msg);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    if (state.thread_index() == 0) {
+        delete sinks;
+        sinks = nullptr;
+    }
+}
+
+BENCHMARK_TEMPLATE(bm_fan_out, Unsynchronized)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_fan_out, SharedMutex)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_fan_out, AtomicSharedPtr)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_fan_out, Registry)->ThreadRange(1, 8)->UseRealTime();
+
+// ---------------------------------------------------------------------------
+// attaching and detaching a sink (copy, publish, grace period)
+// ---------------------------------------------------------------------------
+
+static void bm_add_remove(benchmark::State& state) {
+    SinkRegistry registry{null_sinks(2)};
+    const auto capture = std::make_shared<NullSink>();
+    for (auto _ : state) {
+        registry.add(capture);
+        registry.remove(capture);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK(bm_add_remove);
+
+PEAK_RSS_BENCHMARK_MAIN();
@@ -0,0 +1,114 @@
+#include "contention.hpp"
+#include "peak_rss.hpp"
+#include "seqlock.hpp"
+#include "versioned.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+using benchmark_contention::ContentionMeter;
+using project_template::utils::concurrency::SeqLock;
+using project_template::utils::concurrency::Versioned;
+
+namespace {
+
+constexpr int max_threads = 64;
+
+/// One cache line of statistics, written with all fields equal.
+struct Stats {
+    std::array<std::uint64_t, 8> values{};
+};
+
+Stats uniform(const std::uint64_t value) {
+    Stats stats;
+    stats.values.fill(value);
+    return stats;
+}
+
+/// Reference point: every reader takes the lock in shared mode, i.e. writes the lock's reader count.
+class SharedMutexSnapshot {
+  public:
+    [[nodiscard]] Stats load() const {
+        const std::shared_lock lock{mutex_};
+        return stats_;
+    }
+
+    void store(const Stats& stats) {
+        const std::unique_lock lock{mutex_};
+        stats_ = stats;
+    }
+
+  private:
+    mutable std::shared_mutex mutex_;
+    Stats stats_;
+};
+
+/// Stores into `snapshot` at `rate` per second until destroyed (0 = never).
+template <class Snapshot> std::jthread start_writer(Snapshot& snapshot, const std::int64_t rate) {
+    if (rate == 0) return {};
+    const auto interval = std::chrono::nanoseconds{std::chrono::seconds{1}} / rate;
+    return std::jthread{[&snapshot, interval](const std::stop_token& stop) {
+        for (std::uint64_t value = 1; !stop.stop_requested(); ++value) {
+            snapshot.store(uniform(value));
+            std::this_thread::sleep_for(interval);
+        }
+    }};
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// 64-byte snapshot reads from 1-64 threads, without and with a background writer
+// ---------------------------------------------------------------------------
+
+template <class Snapshot> static void bm_snapshot_read(benchmark::State& state) {
+    static Snapshot* snapshot = nullptr;
+    if (state.thread_index() == 0) snapshot = new Snapshot;
+    const auto read = [] { benchmark::DoNotOptimize(snapshot->load()); };
+
+    ContentionMeter meter{state, read};
+    // started after thread 0's uncontended calibration; stopped before `snapshot` is deleted
+    std::jthread writer;
+    if (state.thread_index() == 0) writer = start_writer(*snapshot, state.range(0));
+    for (auto _ : state) {
+        read();
+    }
+    meter.report(state);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    if (state.thread_index() == 0) {
+        writer = {};
+        delete snapshot;
+        snapshot = nullptr;
+    }
+}
+
+BENCHMARK_TEMPLATE(bm_snapshot_read, SeqLock<Stats>)
+    ->ArgName("writes_per_s")
+    ->Arg(0)
+    ->Arg(10000)
+    ->ThreadRange(1, max_threads)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(bm_snapshot_read, Versioned<Stats>)
+    ->ArgName("writes_per_s")
+    ->Arg(0)
+    ->Arg(10000)
+    ->ThreadRange(1, max_threads)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(bm_snapshot_read, SharedMutexSnapshot)
+    ->ArgName("writes_per_s")
+    ->Arg(0)
+    ->Arg(10000)
+    ->ThreadRange(1, max_threads)
+    ->UseRealTime();
+
+int main(int argc, char** argv) {
+    return benchmark_peak_rss::run_benchmarks(argc, argv, [] {
+        benchmark::AddCustomContext("contention_counter", benchmark_contention::contention_counter().detail);
+    });
+}
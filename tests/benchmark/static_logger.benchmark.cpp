@@ -0,0 +1,100 @@
+#include "log_capture.hpp"
+#include "logger.hpp"
+#include "peak_rss.hpp"
+#include "static_logger.hpp"
+
+#include <benchmark/benchmark.h>
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/basic_file_sink.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+using project_template::utils::log::Log;
+using project_template::utils::log::StaticCountingSink;
+using project_template::utils::log::StaticFileSink;
+using project_template::utils::log::StaticLogger;
+
+namespace {
+
+constexpr auto pattern = "[%T.%f] [%^%l%$] %v"; // Log::init's default
+
+/// The runtime counterpart of StaticCountingSink: a virtual sink with its own mutex.
+class CountingSink final : public spdlog::sinks::base_sink<std::mutex> {
+  protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        records_[static_cast<std::size_t>(msg.level)].fetch_add(1, std::memory_order_relaxed);
+    }
+    void flush_() override {}
+
+  private:
+    std::array<std::atomic<std::uint64_t>, spdlog::level::n_levels> records_{};
+};
+
+/// One file sink plus a metrics tap, composed at run time behind `Log` (sync mode, so the sinks run inline).
+void use_runtime_pipeline() {
+    test_support::log_only_to(
+        {std::make_shared<spdlog::sinks::basic_file_sink_mt>("/dev/null"), std::make_shared<CountingSink>()}, pattern);
+}
+
+/// The same pipeline composed at compile time.
+StaticLogger<StaticFileSink, StaticCountingSink> static_logger{pattern, StaticFileSink{"/dev/null"},
+                                                               StaticCountingSink{}};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// one LOG_INFO into a file sink and a counting tap: runtime-composed Log vs. StaticLogger
+// ---------------------------------------------------------------------------
+
+static void bm_log_runtime(benchmark::State& state) {
+    use_runtime_pipeline();
+    int id = 0;
+    for (auto _ : state) {
+        LOG_INFO("request {} finished in {} us", ++id, 1250);
+    }
+    Log::reset_logger();
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+/// Filtered out by level: the cost of a disabled call site.
+static void bm_log_runtime_disabled(benchmark::State& state) {
+    use_runtime_pipeline();
+    int id = 0;
+    for (auto _ : state) {
+        LOG_DEBUG("request {} finished in {} us", ++id, 1250);
+    }
+    Log::reset_logger();
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// the same macros, routed to the static pipeline from here on
+#undef PROJECT_LOG_FRONTEND
+#define PROJECT_LOG_FRONTEND ::project_template::utils::log::StaticLogFrontend<static_logger>
+
+static void bm_log_static(benchmark::State& state) {
+    int id = 0;
+    for (auto _ : state) {
+        LOG_INFO("request {} finished in {} us", ++id, 1250);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void bm_log_static_disabled(benchmark::State& state) {
+    int id = 0;
+    for (auto _ : state) {
+        LOG_DEBUG("request {} finished in {} us", ++id, 1250);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK(bm_log_runtime);
+BENCHMARK(bm_log_static);
+BENCHMARK(bm_log_runtime_disabled);
+BENCHMARK(bm_log_static_disabled);
+
+PEAK_RSS_BENCHMARK_MAIN();
@@ -0,0 +1,139 @@
+#include "roofline.hpp"
+#include "text_escape.hpp"
+
+#include <benchmark/benchmark.h>
+#include <spdlog/common.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace text = project_template::utils::text;
+using benchmark_roofline::RooflineMeter;
+
+namespace {
+
+struct Dispatched {
+    static void json(spdlog::memory_buf_t& out, const std::string_view s) {
+        text::append_json_escaped(out, s);
+    }
+    static void terminal(spdlog::memory_buf_t& out, const std::string_view s) {
+        text::append_terminal_safe(out, s);
+    }
+    static bool valid(const std::string_view s) {
+        return text::is_valid_utf8(s);
+    }
+};
+
+struct Portable {
+    static void json(spdlog::memory_buf_t& out, const std::string_view s) {
+        text::append_json_escaped_portable(out, s);
+    }
+    static void terminal(spdlog::memory_buf_t& out, const std::string_view s) {
+        text::append_terminal_safe_portable(out, s);
+    }
+    static bool valid(const std::string_view s) {
+        return text::is_valid_utf8_portable(s);
+    }
+};
+
+struct Payload {
+    std::string_view name;
+    std::string text;
+};
+
+std::string stack_trace() {
+    std::string s = "unhandled exception: std::runtime_error: \"connection reset by peer\"\n";
+    for (int frame = 0; frame < 12; ++frame) {
+        s += "\t#" + std::to_string(frame) + " 0x00007f3a1c2b4d5e in project_template::net::Session::on_read(";
+        s += "std::span<const std::byte>) at src/net/session.cpp:" + std::to_string(100 + frame) + "\n";
+    }
+    return s;
+}
+
+constexpr int64_t payload_count = 5;
+
+/// Shapes of `LOG_*` payloads: clean ASCII dominates, quotes and newlines are occasional, some text is not English.
+const std::array<Payload, payload_count> payloads = {{
+    {"short", "processed request id=123456 status=ok latency_us=417"},
+    {"line", "GET /api/v1/orders?id=42 status=200 bytes=5123 latency_us=417 peer=10.0.3.17:51544 "
+             "user_agent=Mozilla/5.0 (X11; Linux x86_64) trace=4bf92f3577b34da6a3ce929d0e0e4736"},
+    {"quoted", R"(config reloaded: {"retries": 3, "backoff_ms": [10, 50, 250], "endpoint": "https://example.org/"})"},
+    {"utf8", "Benutzer „Jürgen Groß“ hat die Datei Übersicht.pdf geöffnet — ユーザーがファイルを開きました"},
+    {"stack", stack_trace()},
+}};
+
+template <class Impl> void report(benchmark::State& state, const Payload& payload, const RooflineMeter& meter) {
+    const auto impl = std::is_same_v<Impl, Dispatched> ? text::escape_implementation() : "portable";
+    state.SetLabel(std::string(payload.name) + "/" + std::string(impl));
+    meter.report(state, payload.text.size(), payload.text.size());
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// JSON string escaping (logcat --json, JsonRenderer)
+// ---------------------------------------------------------------------------
+
+template <class Impl> static void bm_json_escape(benchmark::State& state) {
+    const auto& payload = payloads[static_cast<std::size_t>(state.range(0))];
+    spdlog::memory_buf_t out;
+    RooflineMeter meter;
+    for (auto _ : state) {
+        out.clear();
+        Impl::json(out, payload.text);
+        benchmark::DoNotOptimize(out.data());
+    }
+    report<Impl>(state, payload, meter);
+}
+
+// ---------------------------------------------------------------------------
+// terminal escaping (console sink); clean payloads normally skip the copy
+// ---------------------------------------------------------------------------
+
+template <class Impl> static void bm_terminal_safe(benchmark::State& state) {
+    const auto& payload = payloads[static_cast<std::size_t>(state.range(0))];
+    spdlog::memory_buf_t out;
+    RooflineMeter meter;
+    for (auto _ : state) {
+        out.clear();
+        Impl::terminal(out, payload.text);
+        benchmark::DoNotOptimize(out.data());
+    }
+    report<Impl>(state, payload, meter);
+}
+
+static void bm_needs_terminal_escaping(benchmark::State& state) {
+    const auto& payload = payloads[static_cast<std::size_t>(state.range(0))];
+    RooflineMeter meter;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(text::needs_terminal_escaping(payload.text));
+    }
+    report<Dispatched>(state, payload, meter);
+}
+
+// ---------------------------------------------------------------------------
+// UTF-8 validation
+// ---------------------------------------------------------------------------
+
+template <class Impl> static void bm_validate_utf8(benchmark::State& state) {
+    const auto& payload = payloads[static_cast<std::size_t>(state.range(0))];
+    RooflineMeter meter;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Impl::valid(payload.text));
+    }
+    report<Impl>(state, payload, meter);
+}
+
+BENCHMARK_TEMPLATE(bm_json_escape, Dispatched)->DenseRange(0, payload_count - 1);
+BENCHMARK_TEMPLATE(bm_json_escape, Portable)->DenseRange(0, payload_count - 1);
+BENCHMARK_TEMPLATE(bm_terminal_safe, Dispatched)->DenseRange(0, payload_count - 1);
+BENCHMARK_TEMPLATE(bm_terminal_safe, Portable)->DenseRange(0, payload_count - 1);
+BENCHMARK(bm_needs_terminal_escaping)->DenseRange(0, payload_count - 1);
+BENCHMARK_TEMPLATE(bm_validate_utf8, Dispatched)->DenseRange(0, payload_count - 1);
+BENCHMARK_TEMPLATE(bm_validate_utf8, Portable)->DenseRange(0, payload_count - 1);
+
+ROOFLINE_BENCHMARK_MAIN();
@@ -0,0 +1,179 @@
+#include "cache_sweep.hpp"
+#include "peak_rss.hpp"
+#include "timing_wheel.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+using benchmark_cache::cache_sweep;
+using project_template::utils::timer::TimingWheel;
+
+namespace {
+
+/**
+ * @brief Baseline timer set: a binary heap ordered by expiry with lazy cancellation.
+ *
+ * This is the usual `std::priority_queue` approach: O(log n) insert and pop,
+ * and cancellation by tombstoning the id (the heap entry is skipped on pop).
+ */
+class HeapTimerSet {
+  public:
+    using Callback = std::function<void()>;
+
+    std::uint64_t schedule_after(const std::uint64_t delay_ticks, Callback callback) {
+        const auto id = callbacks_.size();
+        callbacks_.push_back(std::move(callback));
+        cancelled_.push_back(false);
+        heap_.push(Entry{.expiry = now_ + (delay_ticks == 0 ? 1 : delay_ticks), .id = id});
+        return id;
+    }
+
+    bool cancel(const std::uint64_t id) {
+        if (id >= cancelled_.size() || cancelled_[id]) return false;
+        cancelled_[id] = true;
+        return true;
+    }
+
+    std::size_t advance(const std::uint64_t ticks) {
+        now_ += ticks;
+        std::size_t fired = 0;
+        while (!heap_.empty() && heap_.top().expiry <= now_) {
+            const auto id = heap_.top().id;
+            heap_.pop();
+            if (cancelled_[id]) continue;
+            cancelled_[id] = true;
+            callbacks_[id]();
+            ++fired;
+        }
+        return fired;
+    }
+
+  private:
+    struct Entry {
+        std::uint64_t expiry;
+        std::uint64_t id;
+
+        bool operator>(const Entry& other) const {
+            return expiry > other.expiry;
+        }
+    };
+
+    std::uint64_t now_ = 0;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heap_;
+    std::vector<Callback> callbacks_;
+    std::vector<bool> cancelled_;
+};
+
+/// Deterministic delays spread over one minute of 1 ms ticks.
+std::vector<std::uint64_t> make_delays(const std::size_t count) {
+    std::mt19937_64 rng{42};
+    std::uniform_int_distribution<std::uint64_t> dist{1, 60'000};
+    std::vector<std::uint64_t> delays(count);
+    for (auto& d : delays) {
+        d = dist(rng);
+    }
+    return delays;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// schedule + cancel with N timers already pending (the common case for timeouts)
+// ---------------------------------------------------------------------------
+
+static void bm_timing_wheel_schedule_cancel(benchmark::State& state) {
+    const auto pending = static_cast<std::size_t>(state.range(0));
+    const auto delays  = make_delays(pending);
+
+    TimingWheel wheel{std::chrono::milliseconds{1}};
+    for (const auto d : delays) {
+        wheel.schedule_after(std::chrono::milliseconds{d}, [] {});
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto id = wheel.schedule_after(std::chrono::milliseconds{delays[i++ % pending]}, [] {});
+        benchmark::DoNotOptimize(wheel.cancel(id));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void bm_priority_queue_schedule_cancel(benchmark::State& state) {
+    const auto pending = static_cast<std::size_t>(state.range(0));
+    const auto delays  = make_delays(pending);
+
+    HeapTimerSet timers;
+    for (const auto d : delays) {
+        timers.schedule_after(d, [] {});
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto id = timers.schedule_after(delays[i++ % pending], [] {});
+        benchmark::DoNotOptimize(timers.cancel(id));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// ---------------------------------------------------------------------------
+// fill N timers, then run the clock until all of them have fired
+// ---------------------------------------------------------------------------
+
+static void bm_timing_wheel_fill_and_expire(benchmark::State& state) {
+    const auto pending        = static_cast<std::size_t>(state.range(0));
+    const auto delays         = make_delays(pending);
+    std::uint64_t fired_total = 0;
+
+    for (auto _ : state) {
+        TimingWheel wheel{std::chrono::milliseconds{1}};
+        for (const auto d : delays) {
+            wheel.schedule_after(std::chrono::milliseconds{d}, [&fired_total] { ++fired_total; });
+        }
+        // tick the same way a timer thread would
+        for (int t = 0; t < 60'000; ++t) {
+            benchmark::DoNotOptimize(wheel.advance(1));
+        }
+    }
+
+    benchmark::DoNotOptimize(fired_total);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(pending));
+}
+
+static void bm_priority_queue_fill_and_expire(benchmark::State& state) {
+    const auto pending        = static_cast<std::size_t>(state.range(0));
+    const auto delays         = make_delays(pending);
+    std::uint64_t fired_total = 0;
+
+    for (auto _ : state) {
+        HeapTimerSet timers;
+        for (const auto d : delays) {
+            timers.schedule_after(d, [&fired_total] { ++fired_total; });
+        }
+        // tick the same way a timer thread would
+        for (int t = 0; t < 60'000; ++t) {
+            benchmark::DoNotOptimize(timers.advance(1));
+        }
+    }
+
+    benchmark::DoNotOptimize(fired_total);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(pending));
+}
+
+/// Approximate bytes per pending timer (wheel node or heap entry plus its std::function), for the cache sweep.
+constexpr std::size_t timer_bytes = 64;
+
+BENCHMARK(bm_timing_wheel_schedule_cancel)->Apply(cache_sweep<timer_bytes>);
+BENCHMARK(bm_priority_queue_schedule_cancel)->Apply(cache_sweep<timer_bytes>);
+
+BENCHMARK(bm_timing_wheel_fill_and_expire)->Apply(cache_sweep<timer_bytes>)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_priority_queue_fill_and_expire)->Apply(cache_sweep<timer_bytes>)->Unit(benchmark::kMillisecond);
+
+PEAK_RSS_BENCHMARK_MAIN();
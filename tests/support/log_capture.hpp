@@ -0,0 +1,41 @@
+#pragma once
+
+#include "logger.hpp"
+
+#include <spdlog/common.h>
+
+#include <initializer_list>
+#include <string>
+
+namespace test_support {
+
+/**
+ * @brief Detach every sink `Log` writes to (console, file, ...) and attach `sinks` instead.
+ *
+ * The logger itself, with its mode, level and pattern, stays as it is.
+ */
+inline void capture_only(const std::initializer_list<spdlog::sink_ptr> sinks) {
+    using project_template::utils::log::Log;
+    for (const auto& attached : Log::sinks()) {
+        Log::remove_sink(attached);
+    }
+    for (const auto& sink : sinks) {
+        Log::add_sink(sink);
+    }
+}
+
+/**
+ * @brief Restart `Log` in sync mode, so sinks run on the logging thread, writing to `sinks` only.
+ *
+ * Tests use it to capture what a call logs; benchmarks to measure a call
+ * against a known set of sinks without console or file output.
+ */
+inline void log_only_to(const std::initializer_list<spdlog::sink_ptr> sinks, const std::string& pattern = "%v",
+                        const project_template::utils::log::Level level = project_template::utils::log::Level::Info) {
+    using project_template::utils::log::Log;
+    Log::reset_logger();
+    Log::init(level, project_template::utils::log::Mode::Sync, pattern);
+    capture_only(sinks);
+}
+
+} // namespace test_support
@@ -0,0 +1,143 @@
+/**
+ * @file batch_async_logger.unit.cpp
+ * @brief Unit tests for project_template::utils::log::BatchAsyncLogger.
+ */
+
+#include "batch_async_logger.hpp"
+
+#include <gtest/gtest.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace project_template::utils::log;
+using namespace std::chrono_literals;
+
+/** @defgroup BatchAsyncLoggerTests Batch async logger tests
+ *  @brief Tests for the spin-then-park async backend used by Mode::Async.
+ *  @{
+ */
+
+namespace {
+
+/// Records payloads and counts flushes.
+class CaptureSink final : public spdlog::sinks::base_sink<std::mutex> {
+  public:
+    std::vector<std::string> payloads;
+    std::atomic<std::size_t> count{0};
+    std::atomic<std::size_t> flushes{0};
+
+  protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        payloads.emplace_back(msg.payload.data(), msg.payload.size());
+        count.fetch_add(1, std::memory_order_release);
+    }
+
+    void flush_() override {
+        flushes.fetch_add(1, std::memory_order_release);
+    }
+};
+
+/// Poll `done` for up to a few seconds.
+template <typename Pred> bool eventually(Pred done) {
+    for (int i = 0; i < 5000 && !done(); ++i) {
+        std::this_thread::sleep_for(1ms);
+    }
+    return done();
+}
+
+} // namespace
+
+/**
+ * @brief flush() returns only after every earlier record is written and the sinks are flushed.
+ */
+TEST(BatchAsyncLoggerTest, FlushWaitsForQueuedRecords) {
+    const auto sink = std::make_shared<CaptureSink>();
+    BatchAsyncLogger logger{"test", {sink}};
+
+    for (int i = 0; i < 1000; ++i) {
+        logger.info("record {}", i);
+    }
+    logger.flush();
+
+    ASSERT_EQ(sink->payloads.size(), 1000u);
+    EXPECT_EQ(sink->payloads.front(), "record 0");
+    EXPECT_EQ(sink->payloads.back(), "record 999");
+    EXPECT_GE(sink->flushes.load(), 1u);
+    EXPECT_EQ(logger.stats().messages, 1000u);
+}
+
+/**
+ * @brief Records from several producers all arrive, each producer's in order,
+ *        also when the ring is much smaller than the burst (producers block).
+ */
+TEST(BatchAsyncLoggerTest, ConcurrentProducersKeepPerThreadOrder) {
+    constexpr int producers  = 4;
+    constexpr int per_thread = 5000;
+    const auto sink          = std::make_shared<CaptureSink>();
+    {
+        BatchAsyncLogger logger{"test", {sink}, 64, 16};
+        std::vector<std::jthread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&logger, p] {
+                for (int i = 0; i < per_thread; ++i) {
+                    logger.info("{}:{}", p, i);
+                }
+            });
+        }
+    } // joins the producers, then the destructor writes the rest
+
+    ASSERT_EQ(sink->payloads.size(), static_cast<std::size_t>(producers * per_thread));
+    std::vector<int> next(producers, 0);
+    for (const auto& payload : sink->payloads) {
+        const auto colon = payload.find(':');
+        const auto p     = static_cast<std::size_t>(std::stoi(payload.substr(0, colon)));
+        EXPECT_EQ(std::stoi(payload.substr(colon + 1)), next[p]++);
+    }
+}
+
+/**
+ * @brief An idle worker parks, and the next record wakes it with a single wake call.
+ */
+TEST(BatchAsyncLoggerTest, ParkedWorkerIsWokenOnce) {
+    const auto sink = std::make_shared<CaptureSink>();
+    BatchAsyncLogger logger{"test", {sink}};
+
+    ASSERT_TRUE(eventually([&] { return logger.stats().parks >= 1; }));
+    EXPECT_EQ(logger.stats().wakeups, 0u);
+
+    logger.info("wake up");
+    ASSERT_TRUE(eventually([&] { return sink->count.load(std::memory_order_acquire) == 1; }));
+    EXPECT_EQ(logger.stats().wakeups, 1u);
+}
+
+/**
+ * @brief flush_on() levels are flushed by the worker; the destructor writes what is still queued.
+ */
+TEST(BatchAsyncLoggerTest, FlushOnLevelAndDrainOnDestruction) {
+    const auto sink = std::make_shared<CaptureSink>();
+    {
+        BatchAsyncLogger logger{"test", {sink}};
+        logger.flush_on(spdlog::level::err);
+        logger.error("boom");
+        ASSERT_TRUE(eventually([&] { return sink->flushes.load(std::memory_order_acquire) >= 1; }));
+        for (int i = 0; i < 100; ++i) {
+            logger.debug("tail {}", i);
+        }
+        logger.set_level(spdlog::level::trace);
+        for (int i = 0; i < 100; ++i) {
+            logger.trace("tail {}", i);
+        }
+    }
+    ASSERT_EQ(sink->payloads.size(), 101u) << "debug records below the default level are filtered";
+    EXPECT_EQ(sink->payloads.back(), "tail 99");
+}
+
+/** @} */
@@ -0,0 +1,198 @@
+/**
+ * @file binary_log.unit.cpp
+ * @brief Unit tests for the binary log format, BinaryFileSink and the decoders.
+ */
+
+#include "binary_log.hpp"
+#include "log_index.hpp"
+
+#include <gtest/gtest.h>
+#include <spdlog/pattern_formatter.h>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+
+using namespace project_template::utils::log;
+
+namespace {
+
+spdlog::details::log_msg make_msg(const std::string_view payload, const std::int64_t seconds = 1'700'000'000,
+                                  const spdlog::level::level_enum level = spdlog::level::warn) {
+    const spdlog::log_clock::time_point time{std::chrono::seconds{seconds} + std::chrono::microseconds{42}};
+    spdlog::details::log_msg msg{time, spdlog::source_loc{"main.cpp", 17, "main"}, "project_template", level,
+                                 spdlog::string_view_t{payload.data(), payload.size()}};
+    msg.thread_id = 1234;
+    return msg;
+}
+
+std::span<const std::byte> as_bytes(const spdlog::memory_buf_t& buf) {
+    return {reinterpret_cast<const std::byte*>(buf.data()), buf.size()};
+}
+
+std::string to_string(const spdlog::memory_buf_t& buf) {
+    return {buf.data(), buf.size()};
+}
+
+} // namespace
+
+/** @defgroup BinaryLogTests Binary log tests
+ *  @brief Tests for binary record encoding, decoding and rendering.
+ *  @{
+ */
+
+/**
+ * @brief A record decodes to the same fields, and the pattern formatter renders it like the original.
+ */
+TEST(BinaryLogTest, RoundTripMatchesPatternFormatter) {
+    const auto original = make_msg("hello 42");
+    spdlog::memory_buf_t encoded;
+    encode_record(original, encoded);
+
+    BinaryRecordReader reader{as_bytes(encoded)};
+    BinaryRecord record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.payload, "hello 42");
+    EXPECT_EQ(record.logger, "project_template");
+    EXPECT_STREQ(record.file, "main.cpp");
+    EXPECT_STREQ(record.func, "main");
+    EXPECT_EQ(record.line, 17u);
+    EXPECT_EQ(record.thread_id, 1234u);
+    EXPECT_EQ(record.level, spdlog::level::warn);
+    EXPECT_FALSE(reader.next(record));
+    EXPECT_FALSE(reader.truncated());
+
+    spdlog::pattern_formatter formatter{"[%Y-%m-%d %T.%f] [%n] [%l] [%t] [%s:%#] %v"};
+    spdlog::memory_buf_t expected;
+    spdlog::memory_buf_t actual;
+    formatter.format(original, expected);
+    formatter.format(record.to_log_msg(), actual);
+    EXPECT_EQ(to_string(actual), to_string(expected));
+}
+
+/**
+ * @brief A torn record at the end stops decoding without reading past the data.
+ */
+TEST(BinaryLogTest, ReaderStopsAtTornTail) {
+    spdlog::memory_buf_t encoded;
+    encode_record(make_msg("first"), encoded);
+    encode_record(make_msg("second"), encoded);
+    const auto full = encoded.size();
+    encoded.resize(full - 3);
+
+    BinaryRecordReader reader{as_bytes(encoded)};
+    BinaryRecord record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.payload, "first");
+    EXPECT_FALSE(reader.next(record));
+    EXPECT_TRUE(reader.truncated());
+    EXPECT_EQ(split_records(as_bytes(encoded), 1).back(), reader.offset());
+}
+
+/**
+ * @brief Parallel rendering produces exactly the sequential output, in order.
+ */
+TEST(BinaryLogTest, ParallelRenderKeepsOrder) {
+    spdlog::memory_buf_t encoded;
+    for (int i = 0; i < 1000; ++i) {
+        const auto text = "record " + std::to_string(i);
+        encode_record(make_msg(text, 1'700'000'000 + i), encoded);
+    }
+
+    const auto records = as_bytes(encoded);
+    const auto bounds  = split_records(records, 512);
+    EXPECT_GT(bounds.size(), 10u);
+    EXPECT_EQ(bounds.back(), records.size());
+
+    std::string sequential;
+    render_parallel(records, 1, records.size(), [] { return JsonRenderer{}; },
+                    [&](const std::string_view text) { sequential += text; });
+    std::string parallel;
+    const auto result = render_parallel(records, 4, 512, [] { return JsonRenderer{}; },
+                                        [&](const std::string_view text) { parallel += text; });
+    EXPECT_EQ(result.decoded_bytes, records.size());
+    EXPECT_TRUE(result.corrupt.empty());
+    EXPECT_EQ(parallel, sequential);
+    EXPECT_NE(parallel.find(R"("msg":"record 999")"), std::string::npos);
+}
+
+/**
+ * @brief A malformed record costs only itself: it is reported, not counted as decoded, and the chunk goes on.
+ */
+TEST(BinaryLogTest, ParallelRenderSkipsAndReportsMalformedRecords) {
+    spdlog::memory_buf_t encoded;
+    std::size_t bad_offset = 0;
+    std::size_t bad_size   = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (i == 42) bad_offset = encoded.size();
+        encode_record(make_msg("record " + std::to_string(i)), encoded);
+        if (i == 42) bad_size = encoded.size() - bad_offset;
+    }
+    encoded.data()[bad_offset + offsetof(BinaryRecordHeader, level)] = static_cast<char>(spdlog::level::n_levels);
+    const auto torn = encoded.size();
+    encode_record(make_msg("torn"), encoded);
+    encoded.resize(encoded.size() - 2);
+
+    const auto records = as_bytes(encoded);
+    std::string output;
+    const auto result = render_parallel(records, 3, 256, [] { return JsonRenderer{}; },
+                                        [&](const std::string_view text) { output += text; });
+
+    ASSERT_EQ(result.corrupt.size(), 1u);
+    EXPECT_EQ(result.corrupt[0].offset, bad_offset);
+    EXPECT_EQ(result.corrupt[0].length, bad_size);
+    EXPECT_EQ(result.end, torn);
+    EXPECT_EQ(result.decoded_bytes, torn - bad_size);
+    EXPECT_EQ(output.find(R"("msg":"record 42")"), std::string::npos);
+    EXPECT_NE(output.find(R"("msg":"record 41")"), std::string::npos);
+    EXPECT_NE(output.find(R"("msg":"record 43")"), std::string::npos);
+    EXPECT_NE(output.find(R"("msg":"record 99")"), std::string::npos);
+}
+
+/**
+ * @brief JSON output escapes quotes, backslashes and control characters.
+ */
+TEST(BinaryLogTest, JsonRendererEscapes) {
+    spdlog::memory_buf_t encoded;
+    encode_record(make_msg("say \"hi\"\\\n\x01", 0, spdlog::level::err), encoded);
+
+    BinaryRecordReader reader{as_bytes(encoded)};
+    BinaryRecord record;
+    ASSERT_TRUE(reader.next(record));
+    spdlog::memory_buf_t out;
+    JsonRenderer{}(record, out);
+    EXPECT_EQ(to_string(out), R"({"time":"1970-01-01T00:00:00.000042000Z","level":"error","logger":"project_template",)"
+                              R"("thread":1234,"file":"main.cpp","line":17,"func":"main",)"
+                              R"("msg":"say \"hi\"\\\n\u0001"})"
+                              "\n");
+}
+
+/**
+ * @brief BinaryFileSink writes a segment that the mapped-file decoder reads back.
+ */
+TEST(BinaryLogTest, FileSinkWritesReadableSegment) {
+    const auto path = std::filesystem::temp_directory_path() / "project_template_binary_log.bin";
+    {
+        BinaryFileSink sink{path.string(), true};
+        sink.log(make_msg("one"));
+        sink.log(make_msg("two"));
+    }
+
+    const MappedFile mapped{path};
+    BinaryRecordReader reader{binary_log_records({mapped.data(), mapped.size()})};
+    BinaryRecord record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.payload, "one");
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.payload, "two");
+    EXPECT_FALSE(reader.next(record));
+    std::filesystem::remove(path);
+
+    const std::byte garbage[32]{};
+    EXPECT_THROW(binary_log_records(garbage), std::runtime_error);
+}
+
+/** @} */
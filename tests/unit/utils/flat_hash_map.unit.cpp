@@ -0,0 +1,163 @@
+/**
+ * @file flat_hash_map.unit.cpp
+ * @brief Unit tests for project_template::utils::container::FlatHashMap and FlatHashSet.
+ */
+
+#include "flat_hash_map.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using namespace project_template::utils::container;
+
+/** @defgroup FlatHashMapTests Flat hash map tests
+ *  @brief Tests for the open-addressing map/set containers.
+ *  @{
+ */
+
+/**
+ * @brief Basic insert / find / overwrite semantics.
+ */
+TEST(FlatHashMapTest, InsertFindAndOverwrite) {
+    FlatHashMap<int, std::string> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(1), map.end());
+
+    EXPECT_TRUE(map.insert({1, "one"}).second);
+    EXPECT_FALSE(map.insert({1, "uno"}).second) << "insert must not overwrite";
+    EXPECT_EQ(map.at(1), "one");
+
+    map[2] = "two";
+    map.insert_or_assign(1, std::string{"uno"});
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map[1], "uno");
+    EXPECT_EQ(map.find(2)->second, "two");
+    EXPECT_THROW(map.at(3), std::out_of_range);
+}
+
+/**
+ * @brief String-keyed maps accept string_view and literals without building a std::string.
+ */
+TEST(FlatHashMapTest, HeterogeneousStringLookup) {
+    FlatHashMap<std::string, int> map;
+    map["alpha"] = 1;
+    map.try_emplace(std::string_view{"beta"}, 2);
+
+    constexpr std::string_view key = "alpha";
+    ASSERT_NE(map.find(key), map.end());
+    EXPECT_EQ(map.find(key)->second, 1);
+    EXPECT_TRUE(map.contains("beta"));
+    EXPECT_EQ(map.count(std::string_view{"gamma"}), 0u);
+
+    EXPECT_EQ(map.erase(std::string_view{"alpha"}), 1u);
+    EXPECT_FALSE(map.contains(key));
+}
+
+/**
+ * @brief Randomized differential test against std::unordered_map across growth,
+ *        erasure (tombstones) and re-insertion.
+ */
+TEST(FlatHashMapTest, MatchesUnorderedMapUnderRandomOps) {
+    FlatHashMap<std::uint64_t, std::uint64_t> flat;
+    std::unordered_map<std::uint64_t, std::uint64_t> reference;
+
+    std::mt19937_64 rng{7};
+    std::uniform_int_distribution<std::uint64_t> keys{0, 5000};
+    for (int i = 0; i < 100'000; ++i) {
+        const auto k = keys(rng);
+        switch (rng() % 3) {
+            case 0:
+                flat[k]      = static_cast<std::uint64_t>(i);
+                reference[k] = static_cast<std::uint64_t>(i);
+                break;
+            case 1:
+                EXPECT_EQ(flat.erase(k), reference.erase(k));
+                break;
+            default:
+                EXPECT_EQ(flat.contains(k), reference.contains(k));
+                break;
+        }
+    }
+
+    ASSERT_EQ(flat.size(), reference.size());
+    std::size_t visited = 0;
+    for (const auto& [k, v] : flat) {
+        ASSERT_TRUE(reference.contains(k));
+        EXPECT_EQ(reference.at(k), v);
+        ++visited;
+    }
+    EXPECT_EQ(visited, reference.size());
+}
+
+/**
+ * @brief erase(iterator) returns the next element, allowing erase-while-iterating.
+ */
+TEST(FlatHashMapTest, EraseWhileIterating) {
+    FlatHashMap<int, int> map;
+    for (int i = 0; i < 1000; ++i) {
+        map[i] = i;
+    }
+    for (auto it = map.begin(); it != map.end();) {
+        it = (it->first % 2 == 0) ? map.erase(it) : std::next(it);
+    }
+    EXPECT_EQ(map.size(), 500u);
+    for (const auto& [k, v] : map) {
+        EXPECT_EQ(k % 2, 1);
+    }
+}
+
+/**
+ * @brief Copies are deep, moves leave the source empty, and reserve() avoids rehashing.
+ */
+TEST(FlatHashMapTest, CopyMoveAndReserve) {
+    FlatHashMap<std::string, int> a;
+    a.reserve(100);
+    const auto capacity = a.capacity();
+    for (int i = 0; i < 100; ++i) {
+        a[std::to_string(i)] = i;
+    }
+    EXPECT_EQ(a.capacity(), capacity);
+
+    FlatHashMap<std::string, int> b = a;
+    b["0"] = -1;
+    EXPECT_EQ(a["0"], 0);
+
+    FlatHashMap<std::string, int> c = std::move(a);
+    EXPECT_EQ(c.size(), 100u);
+    EXPECT_TRUE(a.empty()); // NOLINT(bugprone-use-after-move)
+}
+
+/**
+ * @brief Non-copyable mapped types are supported via try_emplace.
+ */
+TEST(FlatHashMapTest, MoveOnlyValues) {
+    FlatHashMap<int, std::unique_ptr<int>> map;
+    for (int i = 0; i < 64; ++i) {
+        map.try_emplace(i, std::make_unique<int>(i));
+    }
+    EXPECT_EQ(*map.at(42), 42);
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(42));
+}
+
+/**
+ * @brief FlatHashSet basic semantics including heterogeneous insert.
+ */
+TEST(FlatHashSetTest, InsertContainsErase) {
+    FlatHashSet<std::string> set{"a", "b"};
+    EXPECT_TRUE(set.insert(std::string_view{"c"}).second);
+    EXPECT_FALSE(set.insert("a").second);
+    EXPECT_EQ(set.size(), 3u);
+    EXPECT_TRUE(set.contains(std::string_view{"b"}));
+    EXPECT_EQ(set.erase(std::string{"b"}), 1u);
+    EXPECT_FALSE(set.contains("b"));
+}
+
+/** @} */
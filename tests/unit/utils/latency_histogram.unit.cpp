@@ -0,0 +1,84 @@
+/**
+ * @file latency_histogram.unit.cpp
+ * @brief Unit tests for project_template::utils::metrics::LatencyHistogram.
+ */
+
+#include "latency_histogram.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+using namespace project_template::utils::metrics;
+
+/** @defgroup LatencyHistogramTests Latency histogram tests
+ *  @brief Tests for bucketing, percentile accuracy and merging.
+ *  @{
+ */
+
+/**
+ * @brief Buckets are contiguous and monotonic, exact below 64, and cover the whole 64-bit range.
+ */
+TEST(LatencyHistogramTest, BucketsCoverTheRange) {
+    for (std::uint64_t v = 0; v < 64; ++v) {
+        EXPECT_EQ(LatencyHistogram::bucket_of(v), v);
+        EXPECT_EQ(LatencyHistogram::bucket_upper_bound(v), v);
+    }
+    for (std::size_t i = 64; i < LatencyHistogram::bucket_count; ++i) {
+        const auto upper = LatencyHistogram::bucket_upper_bound(i);
+        EXPECT_EQ(LatencyHistogram::bucket_of(upper), i);
+        if (i + 1 < LatencyHistogram::bucket_count) EXPECT_EQ(LatencyHistogram::bucket_of(upper + 1), i + 1);
+    }
+    EXPECT_EQ(LatencyHistogram::bucket_of(UINT64_MAX), LatencyHistogram::bucket_count - 1);
+}
+
+/**
+ * @brief Percentiles of a uniform distribution are within the 1/32 relative error bound.
+ */
+TEST(LatencyHistogramTest, PercentilesWithinRelativeError) {
+    LatencyHistogram histogram;
+    for (std::uint64_t v = 1; v <= 100'000; ++v) {
+        histogram.record(v);
+    }
+    EXPECT_EQ(histogram.count(), 100'000u);
+    EXPECT_EQ(histogram.min(), 1u);
+    EXPECT_EQ(histogram.max(), 100'000u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 50'000.5);
+
+    for (const double p : {50.0, 90.0, 99.0, 99.9}) {
+        const auto exact = p * 1000.0;
+        const auto value = static_cast<double>(histogram.percentile(p));
+        EXPECT_GE(value, exact) << "p" << p;
+        EXPECT_LE(value, exact * (1.0 + 1.0 / 32)) << "p" << p;
+    }
+    EXPECT_EQ(histogram.percentile(0), 1u);
+    EXPECT_EQ(histogram.percentile(100), 100'000u);
+}
+
+/**
+ * @brief Merging per-thread histograms equals recording everything into one; reset empties it.
+ */
+TEST(LatencyHistogramTest, MergeAndReset) {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    LatencyHistogram all;
+    for (std::uint64_t v = 0; v < 5000; ++v) {
+        (v % 3 == 0 ? a : b).record(v * 37);
+        all.record(v * 37);
+    }
+    a.merge(b);
+    EXPECT_EQ(a.count(), all.count());
+    EXPECT_EQ(a.min(), all.min());
+    EXPECT_EQ(a.max(), all.max());
+    EXPECT_DOUBLE_EQ(a.mean(), all.mean());
+    for (const double p : {1.0, 25.0, 50.0, 75.0, 99.0}) {
+        EXPECT_EQ(a.percentile(p), all.percentile(p));
+    }
+
+    a.reset();
+    EXPECT_EQ(a.count(), 0u);
+    EXPECT_EQ(a.percentile(50), 0u);
+    EXPECT_EQ(a.min(), 0u);
+}
+
+/** @} */
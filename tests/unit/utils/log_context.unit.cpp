@@ -0,0 +1,120 @@
+/**
+ * @file log_context.unit.cpp
+ * @brief Unit tests for LogContext: scoped thread-local fields rendered once and prefixed to each record.
+ */
+
+#include "log_capture.hpp"
+#include "log_context.hpp"
+#include "logger.hpp"
+
+#include <gtest/gtest.h>
+#include <spdlog/sinks/ostream_sink.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using namespace project_template::utils::log;
+
+/** @defgroup LogContextTests Log context tests
+ *  @brief Tests for rendering, nesting, per-thread scoping and the records that carry the prefix.
+ *  @{
+ */
+
+/**
+ * @brief Fields are rendered as `key=value` when the scope opens; outside any scope the prefix is empty.
+ */
+TEST(LogContextTest, RendersFieldsOnce) {
+    EXPECT_TRUE(LogContext::prefix().empty());
+    {
+        std::string tenant = "acme";
+        const LogContext context{{"req", 42}, {"tenant", tenant}, {"ratio", 0.5}};
+        tenant = "changed later";
+
+        EXPECT_EQ(context.fields(), "req=42 tenant=acme ratio=0.5");
+        EXPECT_EQ(LogContext::prefix(), "[req=42 tenant=acme ratio=0.5] ");
+    }
+    EXPECT_TRUE(LogContext::prefix().empty());
+}
+
+/**
+ * @brief A context without fields, also nested in another one without fields, adds no prefix.
+ */
+TEST(LogContextTest, EmptyContextAddsNothing) {
+    const LogContext outer{};
+    EXPECT_TRUE(LogContext::prefix().empty());
+    EXPECT_TRUE(outer.fields().empty());
+    {
+        const LogContext inner{};
+        EXPECT_TRUE(LogContext::prefix().empty());
+        const LogContext request{{"req", 3}};
+        EXPECT_EQ(LogContext::prefix(), "[req=3] ");
+    }
+    EXPECT_TRUE(LogContext::prefix().empty());
+}
+
+/**
+ * @brief A nested scope adds its fields after the outer ones; leaving it restores the outer prefix.
+ */
+TEST(LogContextTest, NestedScopesInheritAndRestore) {
+    const LogContext request{{"req", 7}};
+    {
+        const LogContext step{{"step", "parse"}};
+        EXPECT_EQ(LogContext::prefix(), "[req=7 step=parse] ");
+        {
+            const LogContext empty{};
+            EXPECT_EQ(LogContext::prefix(), "[req=7 step=parse] ");
+        }
+    }
+    EXPECT_EQ(LogContext::prefix(), "[req=7] ");
+}
+
+/**
+ * @brief Records from the LOG_* macros and Log's functions start with the context prefix.
+ */
+TEST(LogContextTest, RecordsCarryPrefix) {
+    std::ostringstream out;
+    test_support::log_only_to({std::make_shared<spdlog::sinks::ostream_sink_mt>(out)});
+    Log::info("before");
+    {
+        const LogContext context{{"req", 42}, {"tenant", "acme"}};
+        LOG_INFO("loaded {} rows", 12);
+        Log::warn("slow query");
+    }
+    Log::info("after");
+    Log::reset_logger();
+
+    std::istringstream lines(out.str());
+    std::string line;
+    std::getline(lines, line);
+    EXPECT_EQ(line, "before");
+    std::getline(lines, line);
+    EXPECT_EQ(line.rfind("[req=42 tenant=acme] [log_context.unit.cpp@line:", 0), 0u) << line;
+    EXPECT_NE(line.find("] loaded 12 rows"), std::string::npos);
+    std::getline(lines, line);
+    EXPECT_EQ(line, "[req=42 tenant=acme] slow query");
+    std::getline(lines, line);
+    EXPECT_EQ(line, "after");
+}
+
+/**
+ * @brief Each thread has its own context: a scope on one thread does not show on another.
+ */
+TEST(LogContextTest, ContextIsPerThread) {
+    const LogContext context{{"req", 1}};
+    std::string other_prefix = "unset";
+    std::string other_nested;
+    std::thread([&] {
+        other_prefix = std::string{LogContext::prefix()};
+        const LogContext own{{"req", 2}};
+        other_nested = std::string{LogContext::prefix()};
+    }).join();
+
+    EXPECT_EQ(other_prefix, "");
+    EXPECT_EQ(other_nested, "[req=2] ");
+    EXPECT_EQ(LogContext::prefix(), "[req=1] ");
+}
+
+/** @} */
@@ -0,0 +1,168 @@
+/**
+ * @file log_frame.unit.cpp
+ * @brief Unit tests for checksummed record framing, LogFrameReader and framed IndexedRotatingFileSink files.
+ */
+
+#include "indexed_file_sink.hpp"
+#include "log_frame.hpp"
+#include "log_index.hpp"
+
+#include <gtest/gtest.h>
+#include <spdlog/details/log_msg.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace project_template::utils::log;
+
+/** @defgroup LogFrameTests Log frame tests
+ *  @brief Tests for CRC-32C record frames, resynchronization after damage, and the framed file sink.
+ *  @{
+ */
+
+namespace {
+
+std::string frame(const std::string_view payload) {
+    spdlog::memory_buf_t buf;
+    buf.resize(sizeof(LogFrameHeader));
+    buf.append(payload.data(), payload.data() + payload.size());
+    seal_frame(buf, 0);
+    return {buf.data(), buf.size()};
+}
+
+struct ReadResult {
+    std::vector<std::string> payloads;
+    std::size_t skipped = 0;
+    std::size_t regions = 0;
+};
+
+ReadResult read_all(const std::string_view data) {
+    ReadResult result;
+    LogFrameReader reader{data};
+    std::string_view payload;
+    while (reader.next(payload)) {
+        result.payloads.emplace_back(payload);
+    }
+    result.skipped = reader.skipped_bytes();
+    result.regions = reader.corrupt_regions();
+    return result;
+}
+
+std::string records(const int first, const int count) {
+    std::string out;
+    for (int i = first; i < first + count; ++i) {
+        out += frame("record " + std::to_string(i) + "\n");
+    }
+    return out;
+}
+
+} // namespace
+
+/**
+ * @brief Frames round-trip, including empty payloads and payloads containing the magic byte.
+ */
+TEST(LogFrameTest, RoundTrip) {
+    const std::string tricky = std::string("a\xFF") + "PTF b";
+    const auto data          = frame("first\n") + frame("") + frame(tricky);
+
+    EXPECT_TRUE(starts_with_frame(data));
+    EXPECT_FALSE(starts_with_frame("plain text\n"));
+    EXPECT_EQ(data.size(), 3 * sizeof(LogFrameHeader) + 6 + tricky.size());
+
+    const auto result = read_all(data);
+    EXPECT_EQ(result.payloads, (std::vector<std::string>{"first\n", "", tricky}));
+    EXPECT_EQ(result.skipped, 0u);
+    EXPECT_EQ(result.regions, 0u);
+}
+
+/**
+ * @brief A flipped bit, overwritten bytes or a torn tail cost only the frames they hit.
+ */
+TEST(LogFrameTest, ResynchronizesAfterDamage) {
+    auto data             = records(0, 10);
+    const auto frame_size = data.size() / 10; // all records have the same length
+
+    auto& flipped = data[3 * frame_size + sizeof(LogFrameHeader) + 2];
+    flipped       = static_cast<char>(flipped ^ 0x04);                  // payload bit flip in record 3
+    data.replace(6 * frame_size + 5, 4, "\xFF\xFF\xFF\xFF");             // header garbage in record 6
+    data += frame("torn record that never completed\n").substr(0, 20); // torn tail
+
+    const auto result = read_all(data);
+    std::vector<std::string> expected;
+    for (const int i : {0, 1, 2, 4, 5, 7, 8, 9}) {
+        expected.push_back("record " + std::to_string(i) + "\n");
+    }
+    EXPECT_EQ(result.payloads, expected);
+    EXPECT_EQ(result.regions, 3u);
+    EXPECT_EQ(result.skipped, 2 * frame_size + 20);
+}
+
+/**
+ * @brief Garbage spliced between frames (e.g. a foreign write) is skipped as one region.
+ */
+TEST(LogFrameTest, SkipsInsertedGarbage) {
+    const auto data   = records(0, 3) + std::string(100, '\xFF') + "some text" + records(3, 3);
+    const auto result = read_all(data);
+    ASSERT_EQ(result.payloads.size(), 6u);
+    EXPECT_EQ(result.payloads[3], "record 3\n");
+    EXPECT_EQ(result.regions, 1u);
+    EXPECT_EQ(result.skipped, 109u);
+}
+
+/**
+ * @brief The framed sink writes frames on index block boundaries and a LogSegment reads them back;
+ *        reopening with the other setting starts a new file.
+ */
+TEST(LogFrameTest, FramedSinkWritesReadableSegments) {
+    const auto dir = std::filesystem::temp_directory_path() / "project_template_log_frame_sink";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto base = (dir / "app.log").string();
+
+    const auto write = [&](const bool framed, const int first, const int count) {
+        IndexedRotatingFileSink sink{base, 1 << 20, 3, 4, framed};
+        sink.set_pattern("%v");
+        for (int i = first; i < first + count; ++i) {
+            const std::string text = "line " + std::to_string(i);
+            sink.log(spdlog::details::log_msg{"test", spdlog::level::info, text});
+        }
+    };
+
+    write(true, 0, 10);
+    {
+        const LogSegment segment{base};
+        EXPECT_TRUE(segment.framed());
+        ASSERT_EQ(segment.entries().size(), 3u); // 4 + 4 + 2 records
+        const auto second = segment.entries()[1];
+        const auto result = read_all(segment.bytes({second.offset, second.length}));
+        EXPECT_EQ(result.payloads, (std::vector<std::string>{"line 4\n", "line 5\n", "line 6\n", "line 7\n"}));
+    }
+
+    // damage the middle of the file; the records around it survive
+    {
+        std::fstream file{base, std::ios::in | std::ios::out | std::ios::binary};
+        file.seekp(static_cast<std::streamoff>(3 * (sizeof(LogFrameHeader) + 7) + 2));
+        file.write("XX", 2);
+    }
+    write(true, 10, 2);
+    {
+        const LogSegment segment{base};
+        const auto result = read_all(segment.bytes({0, segment.data_size()}));
+        EXPECT_EQ(result.payloads.size(), 11u);
+        EXPECT_EQ(result.payloads.back(), "line 11\n");
+        EXPECT_EQ(result.regions, 1u);
+    }
+
+    // plain records go to a fresh file; the framed one is rotated to app.1.log
+    write(false, 12, 1);
+    EXPECT_FALSE(LogSegment{base}.framed());
+    EXPECT_TRUE(LogSegment{(dir / "app.1.log").string()}.framed());
+
+    std::filesystem::remove_all(dir);
+}
+
+/** @} */
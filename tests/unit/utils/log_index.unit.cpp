@@ -0,0 +1,238 @@
+/**
+ * @file log_index.unit.cpp
+ * @brief Unit tests for IndexedRotatingFileSink and the LogSegment reader.
+ */
+
+#include "indexed_file_sink.hpp"
+#include "log_index.hpp"
+
+#include <gtest/gtest.h>
+#include <spdlog/details/log_msg.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace project_template::utils::log;
+
+namespace {
+
+constexpr std::int64_t second_ns = 1'000'000'000;
+
+/// Fresh, empty directory per test.
+class LogIndexTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        const auto* test = ::testing::UnitTest::GetInstance()->current_test_info();
+
+        dir_ = std::filesystem::temp_directory_path() / (std::string("project_template_log_index_") + test->name());
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+
+    [[nodiscard]] std::string base() const {
+        return (dir_ / "app.log").string();
+    }
+
+    /// Log one record with the timestamp `t` seconds after the epoch; the line reads "<t>\n".
+    static void write(IndexedRotatingFileSink& sink, const std::int64_t t,
+                      const spdlog::level::level_enum level = spdlog::level::info) {
+        const std::string text = std::to_string(t);
+        const spdlog::log_clock::time_point time{std::chrono::seconds{t}};
+        const spdlog::details::log_msg msg{time, spdlog::source_loc{}, "test", level, text};
+        sink.log(msg);
+    }
+
+    static std::string collect(const LogSegment& segment, const LogQuery& query) {
+        std::string out;
+        for (const auto& range : segment.query(query)) {
+            out += segment.bytes(range);
+        }
+        return out;
+    }
+
+    static std::unique_ptr<IndexedRotatingFileSink> make_sink(const std::string& base,
+                                                              const std::size_t max_size = 1 << 20) {
+        auto sink = std::make_unique<IndexedRotatingFileSink>(base, max_size, 3, 4);
+        sink->set_pattern("%v");
+        return sink;
+    }
+
+    std::filesystem::path dir_;
+};
+
+} // namespace
+
+/** @defgroup LogIndexTests Log index tests
+ *  @brief Tests for the sidecar time/level index and its reader.
+ *  @{
+ */
+
+/**
+ * @brief One entry per `interval` records, with contiguous offsets and per-block bounds.
+ */
+TEST_F(LogIndexTest, SealsOneEntryPerBlock) {
+    {
+        const auto sink = make_sink(base());
+        for (std::int64_t t = 100; t < 110; ++t) {
+            write(*sink, t);
+        }
+    } // destructor seals the partial third block
+
+    const LogSegment segment{base()};
+    ASSERT_EQ(segment.interval(), 4u);
+    const auto entries = segment.entries();
+    ASSERT_EQ(entries.size(), 3u);
+
+    EXPECT_EQ(entries[0].offset, 0u);
+    EXPECT_EQ(entries[0].length, 16u); // "100\n".."103\n"
+    EXPECT_EQ(entries[1].offset, 16u);
+    EXPECT_EQ(entries[2].records, 2u);
+    EXPECT_EQ(entries[0].min_ts_ns, 100 * second_ns);
+    EXPECT_EQ(entries[1].max_ts_ns, 107 * second_ns);
+    EXPECT_EQ(entries[2].offset + entries[2].length, segment.data_size());
+}
+
+/**
+ * @brief A time window returns the blocks overlapping it and nothing else.
+ */
+TEST_F(LogIndexTest, QueriesTimeWindowByBlock) {
+    {
+        const auto sink = make_sink(base());
+        for (std::int64_t t = 0; t < 16; ++t) {
+            write(*sink, t);
+        }
+    }
+
+    const LogSegment segment{base()};
+    // 5..6 lies in the second block (4..7)
+    EXPECT_EQ(collect(segment, {.from_ns = 5 * second_ns, .to_ns = 6 * second_ns}), "4\n5\n6\n7\n");
+    // 7..8 spans the second and third blocks, returned as one coalesced range
+    const auto ranges = segment.query({.from_ns = 7 * second_ns, .to_ns = 8 * second_ns});
+    ASSERT_EQ(ranges.size(), 1u);
+    EXPECT_EQ(segment.bytes(ranges[0]), "4\n5\n6\n7\n8\n9\n10\n11\n");
+    // outside the file
+    EXPECT_TRUE(segment.query({.from_ns = 100 * second_ns}).empty());
+}
+
+/**
+ * @brief Blocks written after the clock stepped back are still found, behind a block that starts later.
+ */
+TEST_F(LogIndexTest, FindsBlocksAfterClockStepsBack) {
+    {
+        const auto sink = make_sink(base());
+        for (const std::int64_t t : {0, 1, 2, 3, 100, 101, 102, 103, 8, 9, 10, 11, 12, 13, 14, 15}) {
+            write(*sink, t);
+        }
+    }
+
+    const LogSegment segment{base()};
+    ASSERT_EQ(segment.entries().size(), 4u);
+    // the block 100..103 starts after the window, but the blocks behind it do not
+    EXPECT_EQ(collect(segment, {.from_ns = 9 * second_ns, .to_ns = 10 * second_ns}), "8\n9\n10\n11\n");
+    EXPECT_EQ(collect(segment, {.from_ns = 2 * second_ns, .to_ns = 13 * second_ns}),
+              "0\n1\n2\n3\n8\n9\n10\n11\n12\n13\n14\n15\n");
+    // later blocks only know the running max (103), so they may hold 101 as well and are returned too
+    EXPECT_EQ(collect(segment, {.from_ns = 101 * second_ns, .to_ns = 101 * second_ns}).rfind("100\n101\n", 0), 0u);
+}
+
+/**
+ * @brief Blocks without a record at a requested level are skipped.
+ */
+TEST_F(LogIndexTest, FiltersByLevelMask) {
+    {
+        const auto sink = make_sink(base());
+        for (std::int64_t t = 0; t < 12; ++t) {
+            write(*sink, t, t == 9 ? spdlog::level::err : spdlog::level::info);
+        }
+    }
+
+    const LogSegment segment{base()};
+    const auto errors = 1U << spdlog::level::err;
+    EXPECT_EQ(collect(segment, {.level_mask = errors}), "8\n9\n10\n11\n");
+}
+
+/**
+ * @brief Records not yet sealed are served as the newest part of the file.
+ */
+TEST_F(LogIndexTest, UnsealedTailIsReturnedForRecentWindows) {
+    const auto sink = make_sink(base());
+    for (std::int64_t t = 0; t < 6; ++t) {
+        write(*sink, t);
+    }
+    sink->flush();
+
+    const LogSegment segment{base()};
+    ASSERT_EQ(segment.entries().size(), 1u);
+    EXPECT_EQ(collect(segment, {.from_ns = 5 * second_ns}), "4\n5\n");
+    EXPECT_EQ(collect(segment, {.to_ns = 2 * second_ns}), "0\n1\n2\n3\n");
+}
+
+/**
+ * @brief Reopening after an unclean shutdown indexes the leftover tail as one coarse block.
+ */
+TEST_F(LogIndexTest, ReopenIndexesLeftoverTail) {
+    {
+        const auto sink = make_sink(base());
+        for (std::int64_t t = 0; t < 6; ++t) {
+            write(*sink, t);
+        }
+        sink->flush();
+        // simulate a crash: keep the index as it was before the destructor sealed the tail
+        std::filesystem::copy_file(index_path_for(base()), dir_ / "crash.idx");
+    }
+    std::filesystem::copy_file(dir_ / "crash.idx", index_path_for(base()),
+                               std::filesystem::copy_options::overwrite_existing);
+
+    {
+        const auto sink = make_sink(base());
+        for (std::int64_t t = 6; t < 10; ++t) {
+            write(*sink, t);
+        }
+    }
+
+    const LogSegment segment{base()};
+    const auto entries = segment.entries();
+    ASSERT_EQ(entries.size(), 3u);
+    EXPECT_EQ(entries[1].records, 0u) << "coarse block for the unindexed records";
+    EXPECT_EQ(entries[1].offset, 8u);
+    EXPECT_EQ(entries[1].length, 4u);
+    EXPECT_EQ(entries[2].offset, 12u);
+    // the coarse block is bounded by the file's mtime, so it matches any window after its first record
+    EXPECT_EQ(collect(segment, {.from_ns = 6 * second_ns, .to_ns = 9 * second_ns}), "4\n5\n6\n7\n8\n9\n");
+}
+
+/**
+ * @brief Rotation moves each index with its data file; segments are listed oldest first.
+ */
+TEST_F(LogIndexTest, RotationKeepsIndexWithItsFile) {
+    {
+        const auto sink = make_sink(base(), 32); // "NN\n" records → 10 per file
+        for (std::int64_t t = 10; t < 40; ++t) {
+            write(*sink, t);
+        }
+    }
+
+    const auto files = rotated_segments(base());
+    ASSERT_EQ(files.size(), 3u); // app.2.log, app.1.log, app.log
+    EXPECT_EQ(files.back(), std::filesystem::path{base()});
+
+    std::int64_t previous_max = 0;
+    for (const auto& file : files) {
+        const LogSegment segment{file};
+        ASSERT_FALSE(segment.entries().empty()) << file;
+        EXPECT_GT(segment.entries().front().min_ts_ns, previous_max) << file;
+        EXPECT_EQ(segment.entries().back().offset + segment.entries().back().length, segment.data_size());
+        previous_max = segment.entries().back().max_ts_ns;
+    }
+    EXPECT_EQ(previous_max, 39 * second_ns);
+}
+
+/** @} */
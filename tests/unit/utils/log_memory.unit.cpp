@@ -0,0 +1,225 @@
+/**
+ * @file log_memory.unit.cpp
+ * @brief Unit tests for project_template::utils::log::LogMemoryBudget and its use by the loggers.
+ */
+
+#include "batch_async_logger.hpp"
+#include "log_memory.hpp"
+#include "logger.hpp"
+
+#include <gtest/gtest.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace project_template::utils::log;
+using namespace std::chrono_literals;
+
+/** @defgroup LogMemoryTests Logging memory budget tests
+ *  @brief Tests for the budget policies and the accounting done by the async logger and `Log`.
+ *  @{
+ */
+
+namespace {
+
+/// Holds the worker in the first write until opened, so records stay queued.
+class GateSink final : public spdlog::sinks::base_sink<std::mutex> {
+  public:
+    std::atomic<bool> open{false};
+    std::size_t written = 0;
+
+  protected:
+    void sink_it_(const spdlog::details::log_msg&) override {
+        while (!open.load()) {
+            std::this_thread::yield();
+        }
+        ++written;
+    }
+
+    void flush_() override {}
+};
+
+} // namespace
+
+/**
+ * @brief Without a limit everything is admitted, but usage and peak are still tracked.
+ */
+TEST(LogMemoryBudgetTest, TracksUsageWithoutLimit) {
+    LogMemoryBudget budget;
+    budget.charge(1000);
+    EXPECT_TRUE(budget.try_charge(500, spdlog::level::trace));
+    budget.release(1200);
+
+    const auto stats = budget.stats();
+    EXPECT_EQ(stats.usage, 300u);
+    EXPECT_EQ(stats.peak, 1500u);
+    EXPECT_EQ(stats.limit, 0u);
+    EXPECT_EQ(stats.dropped, 0u);
+}
+
+/**
+ * @brief Low-severity records stop at 75% of the budget; warnings may use the rest, nothing exceeds it.
+ */
+TEST(LogMemoryBudgetTest, DropLowSeverityKeepsHeadroomForWarnings) {
+    LogMemoryBudget budget{1000, BudgetPolicy::DropLowSeverity};
+    budget.charge(700);
+    EXPECT_TRUE(budget.try_charge(10, spdlog::level::info));
+    budget.charge(50);
+
+    EXPECT_FALSE(budget.try_charge(0, spdlog::level::info)) << "above 75%, even records without extra memory";
+    EXPECT_FALSE(budget.try_charge(0, spdlog::level::debug));
+    EXPECT_TRUE(budget.try_charge(200, spdlog::level::warn));
+    EXPECT_FALSE(budget.try_charge(100, spdlog::level::err)) << "would exceed the budget";
+    EXPECT_TRUE(budget.try_charge(40, spdlog::level::critical));
+
+    EXPECT_EQ(budget.usage(), 1000u);
+    EXPECT_EQ(budget.stats().dropped, 3u);
+}
+
+/**
+ * @brief Under Block a record waits for a release instead of being dropped; impossible records are dropped.
+ */
+TEST(LogMemoryBudgetTest, BlockWaitsForRelease) {
+    LogMemoryBudget budget{1000, BudgetPolicy::Block};
+    budget.charge(900);
+
+    std::atomic<bool> admitted{false};
+    std::jthread producer([&] { admitted = budget.try_charge(200, spdlog::level::info); });
+    std::this_thread::sleep_for(20ms);
+    EXPECT_FALSE(admitted.load());
+
+    budget.release(50); // not enough yet
+    std::this_thread::sleep_for(20ms);
+    EXPECT_FALSE(admitted.load());
+
+    budget.release(400);
+    producer.join();
+    EXPECT_TRUE(admitted.load());
+    EXPECT_EQ(budget.usage(), 650u);
+
+    EXPECT_FALSE(budget.try_charge(2000, spdlog::level::err));
+    EXPECT_EQ(budget.stats().dropped, 1u);
+}
+
+/**
+ * @brief Raising the limit releases blocked producers too.
+ */
+TEST(LogMemoryBudgetTest, ConfigureWakesBlockedProducers) {
+    LogMemoryBudget budget{1000, BudgetPolicy::Block};
+    budget.charge(1000);
+
+    std::atomic<bool> admitted{false};
+    std::jthread producer([&] { admitted = budget.try_charge(100, spdlog::level::info); });
+    std::this_thread::sleep_for(20ms);
+    EXPECT_FALSE(admitted.load());
+
+    budget.configure(2000, BudgetPolicy::Block);
+    producer.join();
+    EXPECT_TRUE(admitted.load());
+}
+
+/**
+ * @brief ShrinkRings runs the hooks once per record, then retries and drops if it still does not fit.
+ */
+TEST(LogMemoryBudgetTest, ShrinkRingsRunsHooksBeforeDropping) {
+    LogMemoryBudget budget{1000, BudgetPolicy::ShrinkRings};
+    budget.charge(900);
+
+    int calls     = 0;
+    const auto id = budget.add_shrink_hook([&] {
+        ++calls;
+        if (calls == 1) budget.release(300);
+    });
+
+    EXPECT_TRUE(budget.try_charge(200, spdlog::level::info));
+    EXPECT_EQ(calls, 1);
+    EXPECT_FALSE(budget.try_charge(300, spdlog::level::info));
+    EXPECT_EQ(calls, 2);
+
+    budget.remove_shrink_hook(id);
+    EXPECT_FALSE(budget.try_charge(300, spdlog::level::info));
+    EXPECT_EQ(calls, 2);
+
+    const auto stats = budget.stats();
+    EXPECT_EQ(stats.shrinks, 3u);
+    EXPECT_EQ(stats.dropped, 2u);
+}
+
+/**
+ * @brief The async logger charges its ring, holds spilled records until written, and returns everything.
+ */
+TEST(LogMemoryBudgetTest, AsyncLoggerChargesRingAndSpilledRecords) {
+    LogMemoryBudget budget;
+    const auto sink = std::make_shared<GateSink>();
+    std::size_t ring_bytes;
+    {
+        BatchAsyncLogger logger{"test", {sink}, 64, 16, budget};
+        ring_bytes = budget.usage();
+        EXPECT_GT(ring_bytes, 64 * sizeof(spdlog::details::log_msg));
+
+        logger.info("short");
+        const std::string text(1000, 'x');
+        for (int i = 0; i < 10; ++i) {
+            logger.info(text);
+        }
+        EXPECT_EQ(budget.usage(), ring_bytes + 10 * (1000 + logger.name().size()));
+
+        sink->open = true;
+        logger.flush();
+        EXPECT_EQ(budget.usage(), ring_bytes);
+        EXPECT_EQ(sink->written, 11u);
+    }
+    EXPECT_EQ(budget.usage(), 0u);
+    EXPECT_GE(budget.stats().peak, ring_bytes + 10'000);
+}
+
+/**
+ * @brief With a tight budget, records that do not fit are dropped and counted, low severity first.
+ */
+TEST(LogMemoryBudgetTest, AsyncLoggerDropsRecordsOverBudget) {
+    LogMemoryBudget budget;
+    const auto sink = std::make_shared<GateSink>();
+    BatchAsyncLogger logger{"test", {sink}, 64, 16, budget};
+    const auto record = 1000 + logger.name().size();
+    budget.configure(budget.usage() + 3 * record + 100, BudgetPolicy::DropLowSeverity);
+
+    const std::string text(1000, 'x');
+    for (int i = 0; i < 10; ++i) {
+        logger.warn(text);
+    }
+    logger.info("short record, but usage is above 75%");
+    EXPECT_EQ(logger.stats().dropped, 8u);
+    EXPECT_EQ(budget.stats().dropped, 8u);
+
+    sink->open = true;
+    logger.flush();
+    EXPECT_EQ(sink->written, 3u);
+}
+
+/**
+ * @brief Log::init applies the budget, sizes the async ring within half of it, and reports usage.
+ */
+TEST(LogMemoryBudgetTest, LogInitAppliesBudget) {
+    Log::reset_logger();
+    constexpr std::size_t budget = std::size_t{1} << 20;
+    Log::init(Level::Info, Mode::Async, "%v", {.memory_budget = budget, .budget_policy = BudgetPolicy::Block});
+
+    auto stats = Log::memory_usage();
+    EXPECT_EQ(stats.limit, budget);
+    EXPECT_EQ(stats.policy, BudgetPolicy::Block);
+    EXPECT_GT(stats.usage, 0u);
+    EXPECT_LE(stats.usage, budget / 2);
+
+    Log::reset_logger();
+    stats = Log::memory_usage();
+    EXPECT_EQ(stats.usage, 0u);
+    EXPECT_EQ(stats.limit, 0u);
+}
+
+/** @} */
@@ -4,12 +4,17 @@
  *
  */
 
+#include "batch_async_logger.hpp"
+#include "log_capture.hpp"
 #include "logger.hpp"
 
 #include <gtest/gtest.h>
 #include <spdlog/sinks/ostream_sink.h>
 
+#include <atomic>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 using namespace project_template::utils::log;
 
@@ -46,11 +51,10 @@ class LoggerTest : public ::testing::Test {
         logger_ = Log::instance();
 
         // Replace all sinks with our test sink
-        logger_->sinks().clear();
         oss_.str("");
         oss_.clear();
         oss_sink_ = std::make_shared<spdlog::sinks::ostream_sink_mt>(oss_);
-        logger_->sinks().push_back(oss_sink_);
+        test_support::capture_only({oss_sink_});
 
         // Capture every level and flush on each message
         logger_->set_level(spdlog::level::trace);
@@ -175,14 +179,32 @@ TEST_F(LoggerTest, MacrosIncludeFilenameAndLine) {
     EXPECT_NE(l[0].find("logger.unit.cpp@line:"), std::string::npos);
 }
 
+/**
+ * @brief The compiled LOG_* formats produce the exact `[file@line:N]` prefix and argument formatting,
+ *        and respect the level filter.
+ */
+TEST_F(LoggerTest, CompiledMacroFormatting) {
+    const int line = __LINE__ + 1;
+    LOG_INFO("a={} b={} c={:.2f} d={:>4}", 1, "x", 2.5, 7);
+    LOG_ERROR("no arguments");
+    const auto l = lines();
+    ASSERT_EQ(l.size(), 2u);
+    EXPECT_EQ(l[0], "[logger.unit.cpp@line:" + std::to_string(line) + "] a=1 b=x c=2.50 d=   7");
+    EXPECT_EQ(l[1], "[logger.unit.cpp@line:" + std::to_string(line + 1) + "] no arguments");
+
+    logger_->set_level(spdlog::level::warn);
+    LOG_INFO("filtered {}", 1);
+    LOG_DEBUG("filtered");
+    EXPECT_EQ(lines().size(), 2u);
+}
+
 /**
  * @brief Re-initializing with a new pattern should override the old pattern.
  */
 TEST_F(LoggerTest, ReinitAppliesNewPattern) {
     // Initial pattern without prefix
     Log::init(Level::Info, Mode::Sync, "%v");
-    logger_->sinks().clear();
-    logger_->sinks().push_back(oss_sink_);
+    test_support::capture_only({oss_sink_});
     Log::info("foo");
     EXPECT_EQ(lines().back(), "foo");
 
@@ -192,8 +214,7 @@ TEST_F(LoggerTest, ReinitAppliesNewPattern) {
     Log::reset_logger();
     Log::init(Level::Info, Mode::Sync, "PRE:%v");
     logger_ = Log::instance();
-    logger_->sinks().clear();
-    logger_->sinks().push_back(oss_sink_);
+    test_support::capture_only({oss_sink_});
     logger_->set_level(spdlog::level::info);
     logger_->flush_on(spdlog::level::info);
     Log::info("bar");
@@ -207,8 +228,7 @@ TEST_F(LoggerTest, LogsRespectLevelFilter) {
     Log::reset_logger();
     Log::init(Level::Warn, Mode::Sync, "%v");
     const auto lgr = Log::instance();
-    lgr->sinks().clear();
-    lgr->sinks().push_back(oss_sink_);
+    test_support::capture_only({oss_sink_});
     lgr->set_level(spdlog::level::warn);
     lgr->flush_on(spdlog::level::warn);
 
@@ -230,8 +250,7 @@ TEST_F(LoggerTest, OffLevelDisablesAllLogging) {
     Log::reset_logger();
     Log::init(Level::Off, Mode::Sync, "%v");
     const auto lgr = Log::instance();
-    lgr->sinks().clear();
-    lgr->sinks().push_back(oss_sink_);
+    test_support::capture_only({oss_sink_});
     lgr->set_level(spdlog::level::off);
     lgr->flush_on(spdlog::level::off);
 
@@ -262,16 +281,13 @@ TEST_F(LoggerTest, InitIsIdempotent) {
 TEST_F(LoggerTest, PatternPropagatesToNewSink) {
     Log::reset_logger();
     Log::init(Level::Info, Mode::Sync, "[%l] %v");
-    const auto lgr = Log::instance();
-    lgr->sinks().clear();
-
-    lgr->sinks().push_back(oss_sink_);
+    test_support::capture_only({oss_sink_});
     Log::info("foo");
     EXPECT_EQ(lines().back(), "[info] foo");
 
     std::ostringstream oss2;
     const auto sink2 = std::make_shared<spdlog::sinks::ostream_sink_mt>(oss2);
-    lgr->sinks().push_back(sink2);
+    Log::add_sink(sink2);
     Log::info("bar");
     const auto out1 = lines().back();
     std::string line2;
@@ -280,6 +296,46 @@ TEST_F(LoggerTest, PatternPropagatesToNewSink) {
     EXPECT_EQ(line2, "[info] bar");
 }
 
+/**
+ * @brief A capture sink attached and detached while other threads log through the async worker sees the
+ *        records in between and nothing after `remove_sink()` returns.
+ */
+TEST_F(LoggerTest, AddAndRemoveSinkWhileLogging) {
+    Log::reset_logger();
+    Log::init(Level::Info, Mode::Async, "%v");
+    test_support::capture_only({oss_sink_});
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 3; ++t) {
+        producers.emplace_back([&stop, t] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                Log::info("producer {}", t);
+            }
+        });
+    }
+
+    std::ostringstream captured;
+    const auto capture = std::make_shared<spdlog::sinks::ostream_sink_mt>(captured);
+    for (int round = 0; round < 20; ++round) {
+        Log::add_sink(capture);
+        Log::info("marker {}", round);
+        Log::flush();
+        ASSERT_TRUE(Log::remove_sink(capture));
+        EXPECT_FALSE(Log::remove_sink(capture));
+    }
+    const auto seen = captured.str();
+    stop = true;
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    Log::flush();
+
+    EXPECT_EQ(captured.str(), seen);
+    EXPECT_NE(seen.find("marker 19\n"), std::string::npos);
+    EXPECT_EQ(Log::sinks(), std::vector<spdlog::sink_ptr>{oss_sink_});
+}
+
 /**
  * @brief Verifies error() triggers a flush on buffered sinks, while info() does not.
  */
@@ -287,10 +343,8 @@ TEST_F(LoggerTest, ErrorAndCriticalOnlyFlushSinkOnError) {
     Log::reset_logger();
     Log::init(Level::Trace, Mode::Sync, "%v");
     const auto lgr = Log::instance();
-    lgr->sinks().clear();
-
     const auto buf_sink = std::make_shared<BufferedSink>();
-    lgr->sinks().push_back(buf_sink);
+    test_support::capture_only({buf_sink});
     lgr->flush_on(spdlog::level::off);
 
     Log::info("nope");
@@ -320,11 +374,11 @@ TEST_F(LoggerTest, DefaultInitUsesInfoAndAsync) {
 TEST_F(LoggerTest, CanReinitModeSyncAfterAsync) {
     Log::reset_logger();
     Log::init(Level::Info, Mode::Async, "%v");
-    auto* const async_ptr = dynamic_cast<spdlog::async_logger*>(Log::instance().get());
+    auto* const async_ptr = dynamic_cast<BatchAsyncLogger*>(Log::instance().get());
     ASSERT_NE(async_ptr, nullptr);
 
     Log::init(Level::Info, Mode::Sync, "%v");
-    auto* const sync_ptr = dynamic_cast<spdlog::async_logger*>(Log::instance().get());
+    auto* const sync_ptr = dynamic_cast<BatchAsyncLogger*>(Log::instance().get());
     EXPECT_EQ(sync_ptr, nullptr);
 }
 
@@ -334,9 +388,7 @@ TEST_F(LoggerTest, CanReinitModeSyncAfterAsync) {
 TEST_F(LoggerTest, OffLevelSilencesOstreamSink) {
     Log::reset_logger();
     Log::init(Level::Off, Mode::Sync, "%v");
-    const auto l = Log::instance();
-    l->sinks().clear();
-    l->sinks().push_back(oss_sink_);
+    test_support::capture_only({oss_sink_});
     Log::warn("won't show");
     EXPECT_TRUE(lines().empty());
 }
@@ -0,0 +1,154 @@
+/**
+ * @file memory_accounting.unit.cpp
+ * @brief Unit tests for project_template::utils::metrics memory accounts, the registry and the sampler.
+ */
+
+#include "memory_accounting.hpp"
+#include "worker_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace project_template::utils::metrics;
+using namespace std::chrono_literals;
+
+/** @defgroup MemoryAccountingTests Memory accounting tests
+ *  @brief Tests for current/peak accounting, registry aggregation, process figures and the sampler.
+ *  @{
+ */
+
+/**
+ * @brief An account tracks its current bytes and the peak, which reset_peak() restarts.
+ */
+TEST(MemoryAccountingTest, TracksCurrentAndPeak) {
+    MemoryRegistry registry;
+    MemoryAccount account{"cache", registry};
+    account.add(100);
+    account.add(50);
+    account.sub(120);
+    EXPECT_EQ(account.current(), 30u);
+    EXPECT_EQ(account.peak(), 150u);
+
+    account.reset_peak();
+    EXPECT_EQ(account.peak(), 30u);
+    account.add(10);
+    EXPECT_EQ(account.peak(), 40u);
+}
+
+/**
+ * @brief Accounts of the same name are summed; destroyed accounts leave the registry.
+ */
+TEST(MemoryAccountingTest, RegistryAggregatesByName) {
+    MemoryRegistry registry;
+    MemoryAccount queue{"pool.queue", registry};
+    queue.add(10);
+    {
+        MemoryAccount a{"cache", registry};
+        MemoryAccount b{"cache", registry};
+        a.add(100);
+        b.add(200);
+        b.sub(50);
+
+        const auto entries = registry.snapshot();
+        ASSERT_EQ(entries.size(), 2u);
+        EXPECT_EQ(entries[0].name, "cache"); // sorted by name
+        EXPECT_EQ(entries[0].current, 250u);
+        EXPECT_EQ(entries[0].peak, 300u);
+        EXPECT_EQ(entries[0].count, 2u);
+        EXPECT_EQ(entries[1].name, "pool.queue");
+        EXPECT_EQ(registry.total(), 260u);
+    }
+    ASSERT_EQ(registry.snapshot().size(), 1u);
+    EXPECT_EQ(registry.total(), 10u);
+}
+
+/**
+ * @brief Concurrent updates are not lost and the peak is never below the final value.
+ */
+TEST(MemoryAccountingTest, ConcurrentUpdates) {
+    MemoryRegistry registry;
+    MemoryAccount account{"shared", registry};
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&account] {
+            for (int i = 0; i < 10000; ++i) {
+                account.add(3);
+                account.sub(1);
+            }
+        });
+    }
+    threads.clear();
+    EXPECT_EQ(account.current(), 4u * 10000u * 2u);
+    EXPECT_GE(account.peak(), account.current());
+}
+
+/**
+ * @brief Worker pools report their queued tasks in the global registry.
+ */
+TEST(MemoryAccountingTest, WorkerPoolQueueIsAccounted) {
+    using project_template::utils::concurrency::WorkerPool;
+    const auto queued = [] {
+        for (const auto& entry : MemoryRegistry::global().snapshot()) {
+            if (entry.name == "worker_pool.queue") return entry.current;
+        }
+        return std::size_t{0};
+    };
+    const auto before = queued();
+    std::atomic<bool> release{false};
+    {
+        WorkerPool pool{1, 16};
+        ASSERT_TRUE(pool.try_submit([&release] {
+            while (!release) std::this_thread::yield();
+        }));
+        while (pool.queued() > 0) std::this_thread::yield(); // the worker holds the first task
+        ASSERT_TRUE(pool.try_submit([] {}));
+        ASSERT_TRUE(pool.try_submit([] {}));
+        EXPECT_EQ(queued(), before + 2 * sizeof(WorkerPool::Task));
+        release = true;
+        EXPECT_EQ(pool.drain(WorkerPool::Clock::now() + 10s), 0u);
+        EXPECT_EQ(queued(), before);
+    }
+}
+
+/**
+ * @brief The process figures are plausible where /proc is available, and the JSON lists the accounts.
+ */
+TEST(MemoryAccountingTest, SampleAndJson) {
+    MemoryRegistry registry;
+    MemoryAccount account{"log \"buffers\"", registry};
+    account.add(4096);
+    const auto sample = sample_memory(registry);
+#if defined(__linux__)
+    EXPECT_GT(sample.process.rss_bytes, 0u);
+    EXPECT_GE(sample.process.size_bytes, sample.process.rss_bytes);
+    EXPECT_GT(sample.peak_rss_bytes, 0u);
+    if (sample.process.rollup) EXPECT_GT(sample.process.pss_bytes, 0u);
+#endif
+    const auto json = memory_sample_json(sample);
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_NE(json.find("\"rss_bytes\": "), std::string::npos);
+    EXPECT_NE(json.find(R"("log \"buffers\"": {"current": 4096, "peak": 4096})"), std::string::npos) << json;
+}
+
+/**
+ * @brief The sampler calls back periodically until stopped.
+ */
+TEST(MemoryAccountingTest, SamplerRunsPeriodically) {
+    std::atomic<int> samples{0};
+    MemorySampler sampler{5ms, [&samples](const MemorySample&) { ++samples; }};
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (samples < 3 && std::chrono::steady_clock::now() < deadline) std::this_thread::sleep_for(1ms);
+    sampler.stop();
+    const int stopped = samples;
+    EXPECT_GE(stopped, 3);
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(samples, stopped);
+}
+
+/** @} */
@@ -0,0 +1,228 @@
+/**
+ * @file per_cpu_logger.unit.cpp
+ * @brief Unit tests for project_template::utils::log::PerCpuRing and PerCpuLogger.
+ */
+
+#include "per_cpu_logger.hpp"
+
+#include <gtest/gtest.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace project_template::utils::log;
+
+/** @defgroup PerCpuLoggerTests Per-CPU logger tests
+ *  @brief Tests for the per-CPU rings (rseq and spinlock paths) and the logger draining them.
+ *  @{
+ */
+
+namespace {
+
+std::span<const std::byte> bytes(const std::string_view text) {
+    return {reinterpret_cast<const std::byte*>(text.data()), text.size()};
+}
+
+std::vector<std::string> drain_all(PerCpuRing& ring) {
+    std::vector<std::string> out;
+    ring.drain([&](const std::span<const std::span<const std::byte>> records) {
+        for (const auto record : records) {
+            out.emplace_back(reinterpret_cast<const char*>(record.data()), record.size());
+        }
+    });
+    return out;
+}
+
+/// Records payloads.
+class CaptureSink final : public spdlog::sinks::base_sink<std::mutex> {
+  public:
+    std::vector<std::string> payloads;
+
+  protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        payloads.emplace_back(msg.payload.data(), msg.payload.size());
+    }
+
+    void flush_() override {}
+};
+
+/// Runs each test with rseq appends (where available) and with the spinlock fallback.
+class PerCpuRingTest : public ::testing::TestWithParam<bool> {};
+
+} // namespace
+
+/**
+ * @brief Records come back unchanged, across many ring wraps.
+ */
+TEST_P(PerCpuRingTest, AppendAndDrainRoundTrip) {
+    PerCpuRing ring{4096, GetParam()};
+    EXPECT_EQ(ring.uses_rseq(), GetParam() && PerCpuRing::rseq_available());
+
+    std::vector<std::string> expected;
+    std::vector<std::string> received;
+    for (int i = 0; i < 2000; ++i) {
+        expected.push_back("record " + std::to_string(i) + std::string(static_cast<std::size_t>(i % 37), '.'));
+        ASSERT_TRUE(ring.try_append(bytes(expected.back())));
+        if (i % 7 == 0) {
+            for (auto& record : drain_all(ring)) {
+                received.push_back(std::move(record));
+            }
+        }
+    }
+    for (auto& record : drain_all(ring)) {
+        received.push_back(std::move(record));
+    }
+
+    // a migrating thread spreads its records over several rings; only the set is guaranteed
+    std::ranges::sort(expected);
+    std::ranges::sort(received);
+    EXPECT_EQ(received, expected);
+    EXPECT_TRUE(ring.try_append({})) << "empty records are allowed";
+    EXPECT_EQ(drain_all(ring), std::vector<std::string>{""});
+}
+
+/**
+ * @brief A full ring drops and counts records; oversize records are rejected without counting.
+ */
+TEST_P(PerCpuRingTest, FullRingDropsRecords) {
+    PerCpuRing ring{4096, GetParam()};
+    const std::string record(100, 'x'); // 112-byte frames
+    int appended = 0;
+    while (ring.try_append(bytes(record))) {
+        ++appended;
+        ASSERT_LT(appended, 10'000);
+    }
+    // the thread may have migrated; only the calling CPU's ring is full
+    EXPECT_GE(appended, 4096 / 112);
+    EXPECT_EQ(ring.dropped(), 1u);
+
+    EXPECT_FALSE(ring.try_append(std::vector<std::byte>(PerCpuRing::max_record + 1)));
+    EXPECT_EQ(ring.dropped(), 1u);
+    EXPECT_EQ(drain_all(ring).size(), static_cast<std::size_t>(appended));
+}
+
+/**
+ * @brief Many more threads than CPUs (preemption and migration mid-append) lose and duplicate nothing.
+ */
+TEST_P(PerCpuRingTest, ConcurrentProducersDeliverEveryRecordOnce) {
+    constexpr int producers  = 8;
+    constexpr int per_thread = 20'000;
+    PerCpuRing ring{std::size_t{64} << 10, GetParam()};
+
+    std::vector<std::vector<bool>> seen(producers, std::vector<bool>(per_thread, false));
+    int received       = 0;
+    const auto consume = [&](const std::span<const std::span<const std::byte>> records) {
+        for (const auto record : records) {
+            const std::string text(reinterpret_cast<const char*>(record.data()), record.size());
+            const auto colon = text.find(':');
+            const auto p     = static_cast<std::size_t>(std::stoi(text.substr(0, colon)));
+            const auto i     = static_cast<std::size_t>(std::stoi(text.substr(colon + 1)));
+            EXPECT_FALSE(seen[p][i]) << text;
+            seen[p][i] = true;
+            ++received;
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&ring, p] {
+                for (int i = 0; i < per_thread; ++i) {
+                    const auto text = std::to_string(p) + ":" + std::to_string(i);
+                    while (!ring.try_append(bytes(text))) {
+                        std::this_thread::yield(); // the test wants every record; the logger drops
+                    }
+                }
+            });
+        }
+        while (received < producers * per_thread) {
+            ring.drain(consume);
+            std::this_thread::yield();
+        }
+    }
+    EXPECT_EQ(received, producers * per_thread);
+}
+
+INSTANTIATE_TEST_SUITE_P(AppendPaths, PerCpuRingTest, ::testing::Values(true, false),
+                         [](const auto& info) { return info.param ? "Rseq" : "Spinlock"; });
+
+/**
+ * @brief The logger writes every record once flushed, in time order, and truncates oversize payloads.
+ */
+TEST(PerCpuLoggerTest, FlushWritesRecordsInTimeOrder) {
+    const auto sink = std::make_shared<CaptureSink>();
+    PerCpuLogger logger{"test", {sink}};
+
+    for (int i = 0; i < 500; ++i) {
+        logger.info("record {}", i);
+    }
+    logger.warn(std::string(10'000, 'y'));
+    logger.flush();
+
+    ASSERT_EQ(sink->payloads.size(), 501u);
+    for (int i = 0; i < 500; ++i) {
+        EXPECT_EQ(sink->payloads[static_cast<std::size_t>(i)], "record " + std::to_string(i));
+    }
+    EXPECT_GT(sink->payloads.back().size(), 3000u);
+    EXPECT_LT(sink->payloads.back().size(), PerCpuRing::max_record);
+}
+
+/**
+ * @brief Short-lived threads need no setup; the destructor writes what is still buffered.
+ */
+TEST(PerCpuLoggerTest, ShortLivedThreadsAndDrainOnDestruction) {
+    const auto sink = std::make_shared<CaptureSink>();
+    {
+        PerCpuLogger logger{"test", {sink}};
+        for (int t = 0; t < 200; ++t) {
+            std::jthread([&logger, t] { logger.info("thread {}", t); });
+        }
+    }
+    ASSERT_EQ(sink->payloads.size(), 200u);
+    EXPECT_EQ(sink->payloads.front(), "thread 0");
+    EXPECT_EQ(sink->payloads.back(), "thread 199");
+}
+
+/**
+ * @brief Rings sized for half a small budget leave room for info records, even with many CPUs.
+ *
+ * The rings' charge, slack and headers included, must stay below the point
+ * where `DropLowSeverity` starts dropping (3/4 of the limit).
+ */
+TEST(PerCpuLoggerTest, RingsSizedForBudgetKeepInfoRecords) {
+    constexpr std::size_t KiB = 1024;
+    for (const auto [cpus, limit] : {std::pair{std::size_t{8}, 128 * KiB}, std::pair{std::size_t{64}, 1024 * KiB},
+                                     std::pair{std::size_t{256}, 8192 * KiB}}) {
+        const auto capacity = PerCpuRing::capacity_for(limit / 2, cpus);
+        const auto charged  = PerCpuRing::memory_bytes_for(capacity, cpus);
+
+        LogMemoryBudget budget{limit, BudgetPolicy::DropLowSeverity};
+        budget.charge(charged);
+        EXPECT_TRUE(budget.try_charge(0, spdlog::level::info)) << cpus << " CPUs, " << charged << " bytes charged";
+        budget.release(charged);
+    }
+
+    // and on this machine's CPUs, through the logger: 16 KiB per CPU
+    const auto limit = 16 * KiB * PerCpuRing{}.cpu_count();
+    const auto sink  = std::make_shared<CaptureSink>();
+    LogMemoryBudget budget{limit, BudgetPolicy::DropLowSeverity};
+    {
+        PerCpuLogger logger{"test", {sink}, PerCpuRing::capacity_for(limit / 2), true, budget};
+        logger.info("kept");
+        logger.flush();
+    }
+    ASSERT_EQ(sink->payloads.size(), 1u);
+    EXPECT_EQ(sink->payloads.front(), "kept");
+    EXPECT_EQ(budget.stats().dropped, 0u);
+}
+
+/** @} */
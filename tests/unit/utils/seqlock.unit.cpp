@@ -0,0 +1,90 @@
+/**
+ * @file seqlock.unit.cpp
+ * @brief Unit tests for project_template::utils::concurrency::SeqLock.
+ */
+
+#include "seqlock.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace project_template::utils::concurrency;
+
+namespace {
+
+/// Written with all fields equal, so a torn read shows as differing fields.
+struct Payload {
+    std::array<std::uint64_t, 7> values{};
+    std::uint16_t tag = 0;
+};
+
+Payload uniform(const std::uint64_t value) {
+    Payload payload;
+    payload.values.fill(value);
+    payload.tag = static_cast<std::uint16_t>(value);
+    return payload;
+}
+
+} // namespace
+
+/** @defgroup SeqLockTests Seqlock tests
+ *  @brief Tests for stores, read-modify-write and consistent reads under a concurrent writer.
+ *  @{
+ */
+
+/**
+ * @brief Stores and updates are visible to the next load; the version counts completed stores.
+ */
+TEST(SeqLockTest, StoreUpdateAndVersion) {
+    SeqLock<Payload> lock{uniform(3)};
+    EXPECT_EQ(lock.load().values[6], 3u);
+    EXPECT_EQ(lock.load().tag, 3u);
+    EXPECT_EQ(lock.version(), 0u);
+
+    lock.store(uniform(5));
+    lock.update([](Payload& payload) { payload.tag = 9; });
+    const auto value = lock.load();
+    EXPECT_EQ(value.values[0], 5u);
+    EXPECT_EQ(value.tag, 9u);
+    EXPECT_EQ(lock.version(), 2u);
+}
+
+/**
+ * @brief Readers racing a writer never observe a half-written payload.
+ */
+TEST(SeqLockTest, ReadersNeverSeeTornValues) {
+    SeqLock<Payload> lock{uniform(0)};
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+
+    std::vector<std::jthread> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.emplace_back([&] {
+            std::uint64_t last = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                const auto value = lock.load();
+                bool consistent  = value.tag == static_cast<std::uint16_t>(value.values[0]) && value.values[0] >= last;
+                for (const auto v : value.values) {
+                    consistent = consistent && v == value.values[0];
+                }
+                if (!consistent) torn.fetch_add(1);
+                last = value.values[0];
+            }
+        });
+    }
+    for (std::uint64_t i = 1; i <= 20000; ++i) {
+        lock.store(uniform(i));
+    }
+    done = true;
+    readers.clear();
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(lock.load().values[3], 20000u);
+}
+
+/** @} */
@@ -0,0 +1,198 @@
+/**
+ * @file sink_group.unit.cpp
+ * @brief Unit tests for SinkGroupFormatter and SinkGroupScope: one formatting pass per pattern, not per sink.
+ */
+
+#include "sink_group.hpp"
+#include "sink_registry.hpp"
+#include "terminal_safe_sink.hpp"
+
+#include <gtest/gtest.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/pattern_formatter.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace project_template::utils::log;
+
+namespace {
+
+/// `%*` flag that counts how often the pattern is formatted.
+class CountingFlag final : public spdlog::custom_flag_formatter {
+  public:
+    explicit CountingFlag(std::atomic<int>& count) : count_(count) {}
+
+    void format(const spdlog::details::log_msg&, const std::tm&, spdlog::memory_buf_t& dest) override {
+        count_.fetch_add(1);
+        dest.push_back('#');
+    }
+
+    [[nodiscard]] std::unique_ptr<spdlog::custom_flag_formatter> clone() const override {
+        return std::make_unique<CountingFlag>(count_);
+    }
+
+  private:
+    std::atomic<int>& count_;
+};
+
+std::unique_ptr<spdlog::formatter> counting_formatter(std::atomic<int>& count) {
+    auto formatter = std::make_unique<spdlog::pattern_formatter>();
+    formatter->add_flag<CountingFlag>('*', count).set_pattern("%*%^%l%$ %v");
+    return formatter;
+}
+
+/// Formats behind a prefix, as a framed file does, and keeps each line and its colored part.
+class CaptureSink final : public spdlog::sinks::base_sink<std::mutex> {
+  public:
+    std::vector<std::string> lines;
+    std::vector<std::string> colored;
+
+  protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        spdlog::memory_buf_t buf;
+        buf.append(std::string_view{">>"});
+        formatter_->format(msg, buf);
+        lines.emplace_back(buf.data() + 2, buf.size() - 2);
+        colored.emplace_back(buf.data() + msg.color_range_start, msg.color_range_end - msg.color_range_start);
+    }
+    void flush_() override {}
+};
+
+std::vector<std::shared_ptr<CaptureSink>> capture_sinks(const std::size_t count) {
+    std::vector<std::shared_ptr<CaptureSink>> sinks;
+    for (std::size_t i = 0; i < count; ++i) {
+        sinks.push_back(std::make_shared<CaptureSink>());
+    }
+    return sinks;
+}
+
+spdlog::details::log_msg make_msg(const spdlog::string_view_t text) {
+    return spdlog::details::log_msg{"test", spdlog::level::info, text};
+}
+
+} // namespace
+
+/** @defgroup SinkGroupTests Sink group tests
+ *  @brief Tests for formatting each record once per sink group, also for batches and concurrent loggers.
+ *  @{
+ */
+
+/**
+ * @brief Sinks of a registry share one formatting pass per record, and each gets the same text and color range.
+ */
+TEST(SinkGroupTest, RegistryFormatsOncePerRecord) {
+    std::atomic<int> formats{0};
+    const auto sinks = capture_sinks(3);
+    SinkRegistry registry{{sinks.begin(), sinks.end()}};
+    registry.set_formatter(std::make_unique<SinkGroupFormatter>(counting_formatter(formats)));
+
+    registry.log(make_msg("first"));
+    registry.log(make_msg("second"));
+
+    EXPECT_EQ(formats.load(), 2);
+    for (const auto& sink : sinks) {
+        ASSERT_EQ(sink->lines.size(), 2u);
+        EXPECT_EQ(sink->lines[0], "#info first\n");
+        EXPECT_EQ(sink->lines[1], "#info second\n");
+        EXPECT_EQ(sink->colored[1], "info") << "color range shifted to where the text lands";
+    }
+}
+
+/**
+ * @brief A sink given its own pattern leaves the group and formats for itself; outside a scope every sink formats.
+ */
+TEST(SinkGroupTest, OtherPatternsAndUnscopedRecordsFormatSeparately) {
+    std::atomic<int> formats{0};
+    const auto sinks = capture_sinks(3);
+    SinkRegistry registry{{sinks.begin(), sinks.end()}};
+    registry.set_formatter(std::make_unique<SinkGroupFormatter>(counting_formatter(formats)));
+    sinks[2]->set_pattern("%v");
+
+    registry.log(make_msg("grouped"));
+    EXPECT_EQ(formats.load(), 1);
+    EXPECT_EQ(sinks[0]->lines.back(), "#info grouped\n");
+    EXPECT_EQ(sinks[2]->lines.back(), "grouped\n");
+
+    const auto msg = make_msg("unscoped");
+    sinks[0]->log(msg);
+    sinks[1]->log(msg);
+    EXPECT_EQ(formats.load(), 3);
+    EXPECT_EQ(sinks[1]->lines.back(), "#info unscoped\n");
+}
+
+/**
+ * @brief A batch scope covers sink-major loops: each record is formatted once however many sinks take the batch.
+ */
+TEST(SinkGroupTest, BatchScopeCoversSinkMajorLoops) {
+    std::atomic<int> formats{0};
+    const auto sinks = capture_sinks(2);
+    const SinkGroupFormatter formatter{counting_formatter(formats)};
+    for (const auto& sink : sinks) {
+        sink->set_formatter(formatter.clone());
+    }
+    const std::vector<spdlog::details::log_msg> batch{make_msg("a"), make_msg("b"), make_msg("c")};
+
+    {
+        const SinkGroupScope scope{std::span<const spdlog::details::log_msg>{batch}};
+        for (const auto& sink : sinks) {
+            for (const auto& msg : batch) {
+                sink->log(msg);
+            }
+        }
+    }
+    EXPECT_EQ(formats.load(), 3);
+    EXPECT_EQ(sinks[0]->lines, sinks[1]->lines);
+    EXPECT_EQ(sinks[1]->lines[2], "#info c\n");
+}
+
+/**
+ * @brief A decorator that rewrites the payload passes a copy, which is formatted on its own, not served the original.
+ */
+TEST(SinkGroupTest, RewrittenCopiesAreNotShared) {
+    const auto raw  = std::make_shared<CaptureSink>();
+    const auto safe = std::make_shared<CaptureSink>();
+    SinkRegistry registry{{raw, std::make_shared<TerminalSafeSink>(safe)}};
+    registry.set_pattern("%v");
+
+    registry.log(make_msg("red \x1b[31m"));
+    EXPECT_NE(raw->lines.back().find('\x1b'), std::string::npos);
+    EXPECT_EQ(safe->lines.back().find('\x1b'), std::string::npos);
+}
+
+/**
+ * @brief Threads logging concurrently through one group each format with their own clone of the pattern.
+ */
+TEST(SinkGroupTest, ConcurrentLoggersFormatIndependently) {
+    std::atomic<int> formats{0};
+    const auto sinks = capture_sinks(2);
+    SinkRegistry registry{{sinks.begin(), sinks.end()}};
+    registry.set_formatter(std::make_unique<SinkGroupFormatter>(counting_formatter(formats)));
+
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&registry, t] {
+                const auto text = "thread " + std::to_string(t);
+                for (int i = 0; i < 500; ++i) {
+                    registry.log(make_msg(text));
+                }
+            });
+        }
+    }
+    EXPECT_EQ(formats.load(), 2000);
+    for (const auto& sink : sinks) {
+        ASSERT_EQ(sink->lines.size(), 2000u);
+        for (const auto& line : sink->lines) {
+            EXPECT_EQ(line.rfind("#info thread ", 0), 0u) << line;
+        }
+    }
+}
+
+/** @} */
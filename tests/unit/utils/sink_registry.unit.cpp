@@ -0,0 +1,168 @@
+/**
+ * @file sink_registry.unit.cpp
+ * @brief Unit tests for SinkRegistry: copy-on-write sink lists attached and detached while logging.
+ */
+
+#include "sink_registry.hpp"
+
+#include <gtest/gtest.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/ostream_sink.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace project_template::utils::log;
+
+/** @defgroup SinkRegistryTests Sink registry tests
+ *  @brief Tests for attaching, detaching and fanning out to sinks under concurrent logging.
+ *  @{
+ */
+
+namespace {
+
+spdlog::details::log_msg make_msg(const spdlog::string_view_t text) {
+    return spdlog::details::log_msg{"test", spdlog::level::info, text};
+}
+
+/// Counts records; optionally blocks inside log() until released.
+class CountingSink final : public spdlog::sinks::sink {
+  public:
+    void log(const spdlog::details::log_msg&) override {
+        entered.store(true);
+        while (hold.load()) {
+            std::this_thread::yield();
+        }
+        count.fetch_add(1);
+    }
+    void flush() override {}
+    void set_pattern(const std::string&) override {}
+    void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<bool> hold{false};
+    std::atomic<bool> entered{false};
+};
+
+class ThrowingSink final : public spdlog::sinks::base_sink<std::mutex> {
+  protected:
+    void sink_it_(const spdlog::details::log_msg&) override {
+        throw std::runtime_error("disk full");
+    }
+    void flush_() override {}
+};
+
+} // namespace
+
+/**
+ * @brief Sinks are attached once, take the registry's pattern, and can be detached again.
+ */
+TEST(SinkRegistryTest, AddRemoveAndPattern) {
+    std::ostringstream first_out;
+    std::ostringstream second_out;
+    const auto first  = std::make_shared<spdlog::sinks::ostream_sink_st>(first_out);
+    const auto second = std::make_shared<spdlog::sinks::ostream_sink_st>(second_out);
+
+    SinkRegistry registry{{first}};
+    registry.set_pattern("[%l] %v");
+    registry.add(second);
+    registry.add(second);
+    EXPECT_EQ(registry.snapshot(), (std::vector<spdlog::sink_ptr>{first, second}));
+
+    registry.log(make_msg("both"));
+    EXPECT_TRUE(registry.remove(first));
+    EXPECT_FALSE(registry.remove(first));
+    registry.log(make_msg("second only"));
+
+    EXPECT_EQ(first_out.str(), "[info] both\n");
+    EXPECT_EQ(second_out.str(), "[info] both\n[info] second only\n");
+    EXPECT_EQ(registry.snapshot(), std::vector<spdlog::sink_ptr>{second});
+}
+
+/**
+ * @brief remove() does not return while a record is still being written to the removed sink.
+ */
+TEST(SinkRegistryTest, RemoveWaitsForWritesInProgress) {
+    const auto slow = std::make_shared<CountingSink>();
+    SinkRegistry registry{{slow}};
+
+    slow->hold = true;
+    std::thread writer{[&] { registry.log(make_msg("slow")); }};
+    while (!slow->entered.load()) {
+        std::this_thread::yield();
+    }
+
+    std::atomic<bool> removed{false};
+    std::thread remover{[&] { removed = registry.remove(slow); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(removed.load());
+
+    slow->hold = false;
+    remover.join();
+    writer.join();
+    EXPECT_TRUE(removed.load());
+    EXPECT_EQ(slow->count.load(), 1u);
+
+    registry.log(make_msg("after"));
+    EXPECT_EQ(slow->count.load(), 1u);
+    EXPECT_EQ(slow.use_count(), 1);
+}
+
+/**
+ * @brief A throwing sink does not keep the record from the sinks after it; the error still reaches the caller.
+ */
+TEST(SinkRegistryTest, ThrowingSinkDoesNotStopOthers) {
+    const auto counter = std::make_shared<CountingSink>();
+    SinkRegistry registry{{std::make_shared<ThrowingSink>(), counter}};
+
+    EXPECT_THROW(registry.log(make_msg("x")), std::runtime_error);
+    EXPECT_EQ(counter->count.load(), 1u);
+}
+
+/**
+ * @brief Under constant add/remove churn every record reaches the permanent sink exactly once.
+ */
+TEST(SinkRegistryTest, ChurnWhileLogging) {
+    const auto permanent = std::make_shared<CountingSink>();
+    SinkRegistry registry{{permanent}};
+
+    constexpr std::uint64_t threads    = 4;
+    constexpr std::uint64_t per_thread = 20000;
+    std::vector<std::thread> writers;
+    for (std::uint64_t t = 0; t < threads; ++t) {
+        writers.emplace_back([&] {
+            for (std::uint64_t i = 0; i < per_thread; ++i) {
+                registry.log(make_msg("record"));
+            }
+        });
+    }
+
+    std::uint64_t transient_records = 0;
+    for (int round = 0; round < 200; ++round) {
+        const auto transient = std::make_shared<CountingSink>();
+        registry.add(transient);
+        std::this_thread::yield();
+        EXPECT_TRUE(registry.remove(transient));
+        const auto seen = transient->count.load();
+        std::this_thread::yield();
+        EXPECT_EQ(transient->count.load(), seen);
+        transient_records += seen;
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    EXPECT_EQ(permanent->count.load(), threads * per_thread);
+    EXPECT_LE(transient_records, threads * per_thread);
+    EXPECT_EQ(registry.snapshot(), std::vector<spdlog::sink_ptr>{permanent});
+}
+
+/** @} */
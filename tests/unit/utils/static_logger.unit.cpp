@@ -0,0 +1,101 @@
+/**
+ * @file static_logger.unit.cpp
+ * @brief Unit tests for StaticLogger: a compile-time sink list behind the LOG_* macros.
+ */
+
+// route this file's LOG_* macros to `captured_logger` below
+#define PROJECT_LOG_FRONTEND ::project_template::utils::log::StaticLogFrontend<captured_logger>
+
+#include "static_logger.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace project_template::utils::log;
+
+namespace {
+
+/// Keeps every formatted record.
+struct CaptureSink {
+    std::vector<std::string>* lines;
+
+    void write(const spdlog::details::log_msg&, const std::string_view text) {
+        lines->emplace_back(text);
+    }
+    void flush() {}
+};
+
+std::vector<std::string> captured_lines;
+StaticLogger<CaptureSink, StaticCountingSink> captured_logger{"%l %v", CaptureSink{&captured_lines},
+                                                              StaticCountingSink{}};
+
+std::string read_file(const std::filesystem::path& path) {
+    std::ifstream in(path);
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+} // namespace
+
+/** @defgroup StaticLoggerTests Static logger tests
+ *  @brief Tests for formatting, level filtering, flushing and the LOG_* macro frontend.
+ *  @{
+ */
+
+/**
+ * @brief Records reach every sink formatted with the logger's pattern; filtered levels reach none.
+ */
+TEST(StaticLoggerTest, WritesFormattedRecordsToEverySink) {
+    const auto path = std::filesystem::temp_directory_path() / "project_template_static_logger.log";
+    StaticLogger<StaticFileSink, StaticCountingSink> logger{"[%l] %v", StaticFileSink{path.string(), true},
+                                                            StaticCountingSink{}};
+    logger.info("request {} finished", 42);
+    logger.debug("not written");
+    logger.set_level(spdlog::level::debug);
+    logger.debug("written");
+    logger.flush();
+
+    EXPECT_EQ(read_file(path), "[info] request 42 finished\n[debug] written\n");
+    const auto& counts = logger.sink<StaticCountingSink>();
+    EXPECT_EQ(counts.records(), 2u);
+    EXPECT_EQ(counts.records(spdlog::level::debug), 1u);
+    EXPECT_EQ(counts.bytes(), read_file(path).size());
+    std::filesystem::remove(path);
+}
+
+/**
+ * @brief Error records are flushed at once, without an explicit flush().
+ */
+TEST(StaticLoggerTest, ErrorsFlush) {
+    const auto path = std::filesystem::temp_directory_path() / "project_template_static_logger_error.log";
+    StaticLogger<StaticFileSink> logger{"%v", StaticFileSink{path.string(), true}};
+    logger.info("buffered");
+    logger.error("disk {} failing", "sda");
+    EXPECT_EQ(read_file(path), "buffered\ndisk sda failing\n");
+    std::filesystem::remove(path);
+}
+
+/**
+ * @brief With PROJECT_LOG_FRONTEND pointing at a StaticLogger, the LOG_* macros log through it.
+ */
+TEST(StaticLoggerTest, MacrosRouteToFrontend) {
+    captured_lines.clear();
+    const auto before = captured_logger.sink<StaticCountingSink>().records();
+    LOG_INFO("user {} logged in", "alice");
+    LOG_DEBUG("below the level");
+    LOG_WARN_IF(true, "quota at {}%", 93);
+
+    ASSERT_EQ(captured_lines.size(), 2u);
+    EXPECT_EQ(captured_lines[0].rfind("info [static_logger.unit.cpp@line:", 0), 0u) << captured_lines[0];
+    EXPECT_NE(captured_lines[0].find("] user alice logged in\n"), std::string::npos);
+    EXPECT_NE(captured_lines[1].find("quota at 93%"), std::string::npos);
+    EXPECT_EQ(captured_logger.sink<StaticCountingSink>().records() - before, 2u);
+}
+
+/** @} */
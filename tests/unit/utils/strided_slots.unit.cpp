@@ -0,0 +1,129 @@
+/**
+ * @file strided_slots.unit.cpp
+ * @brief Unit tests for project_template::utils::container::StridedSlots.
+ */
+
+#include "strided_slots.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace project_template::utils::container;
+
+namespace {
+
+/// Restores the process-wide stride override when a test ends.
+class StrideOverride {
+  public:
+    explicit StrideOverride(const std::size_t stride) : previous_(slot_stride_override().exchange(stride)) {}
+    ~StrideOverride() {
+        slot_stride_override().store(previous_);
+    }
+
+  private:
+    std::size_t previous_;
+};
+
+} // namespace
+
+/** @defgroup StridedSlotsTests Strided slots tests
+ *  @brief Tests for slot placement, the stride override and false-sharing detection.
+ *  @{
+ */
+
+/**
+ * @brief By default every slot starts on its own cache line and no two slots share one.
+ */
+TEST(StridedSlotsTest, DefaultPadsToCacheLines) {
+    const StrideOverride none{0};
+    StridedSlots<std::atomic<std::uint64_t>> slots{8};
+    EXPECT_EQ(slots.stride(), cache_line_size);
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&slots[i]) % cache_line_size, 0u);
+        EXPECT_EQ(slots[i].load(), 0u) << "slots are value-initialized";
+        if (i > 0) {
+            EXPECT_FALSE(slots.shares_line(i - 1, i));
+        }
+    }
+
+    struct Wide {
+        char bytes[100];
+    };
+    EXPECT_EQ(StridedSlots<Wide>{2}.stride(), 2 * cache_line_size) << "wide slots are padded to whole lines";
+}
+
+/**
+ * @brief A packed stride puts neighbours into one line; `shares_line()` reports exactly those pairs.
+ */
+TEST(StridedSlotsTest, PackedStrideSharesLines) {
+    StridedSlots<std::uint64_t> slots{16, 16};
+    EXPECT_EQ(reinterpret_cast<std::byte*>(&slots[1]) - reinterpret_cast<std::byte*>(&slots[0]), 16);
+    EXPECT_TRUE(slots.shares_line(0, 3));
+    EXPECT_TRUE(slots.shares_line(3, 0));
+    EXPECT_FALSE(slots.shares_line(3, 4));
+    EXPECT_FALSE(slots.shares_line(2, 2));
+
+    StridedSlots<std::uint64_t> uneven{4, 40}; // bytes 0, 40 | 80, 120
+    EXPECT_TRUE(uneven.shares_line(0, 1));
+    EXPECT_FALSE(uneven.shares_line(1, 2));
+    EXPECT_TRUE(uneven.shares_line(2, 3));
+}
+
+/**
+ * @brief Strides smaller than the element or not a multiple of its alignment are rejected.
+ */
+TEST(StridedSlotsTest, RejectsStridesThatDoNotFit) {
+    EXPECT_THROW((StridedSlots<std::uint64_t>{4, 4}), std::invalid_argument);
+    EXPECT_THROW((StridedSlots<std::uint64_t>{4, 12}), std::invalid_argument);
+    EXPECT_NO_THROW((StridedSlots<std::uint64_t>{4, 8}));
+    EXPECT_NO_THROW((StridedSlots<std::uint64_t>{0}));
+}
+
+/**
+ * @brief The process-wide override changes the default stride, rounded up to fit the element.
+ */
+TEST(StridedSlotsTest, OverrideChangesDefaultStride) {
+    {
+        const StrideOverride packed{8};
+        EXPECT_EQ(StridedSlots<std::uint64_t>::default_stride(), 8u);
+        EXPECT_EQ(StridedSlots<std::uint64_t[2]>::default_stride(), 16u) << "never smaller than the element";
+        EXPECT_EQ(StridedSlots<std::uint64_t>{4}.stride(), 8u);
+    }
+    {
+        const StrideOverride spread{128};
+        EXPECT_EQ(StridedSlots<std::uint64_t>::default_stride(), 128u);
+    }
+}
+
+/**
+ * @brief Threads incrementing their own slot never lose updates, packed or padded.
+ */
+TEST(StridedSlotsTest, PerThreadSlotsUnderConcurrency) {
+    for (const std::size_t stride : {std::size_t{8}, cache_line_size}) {
+        constexpr std::size_t threads = 4;
+        constexpr int increments      = 100'000;
+        StridedSlots<std::atomic<std::uint64_t>> slots{threads, stride};
+
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&slots, t] {
+                for (int i = 0; i < increments; ++i) {
+                    slots[t].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (std::size_t t = 0; t < threads; ++t) {
+            EXPECT_EQ(slots[t].load(), static_cast<std::uint64_t>(increments)) << "stride " << stride;
+        }
+    }
+}
+
+/** @} */
@@ -0,0 +1,169 @@
+/**
+ * @file text_escape.unit.cpp
+ * @brief Unit tests for JSON / terminal escaping, UTF-8 validation and TerminalSafeSink.
+ */
+
+#include "terminal_safe_sink.hpp"
+#include "text_escape.hpp"
+
+#include <gtest/gtest.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/sinks/ostream_sink.h>
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+using namespace project_template::utils;
+
+/** @defgroup TextEscapeTests Text escaping tests
+ *  @brief Tests for escaping, U+FFFD substitution, UTF-8 validation and the SIMD vs. portable scans.
+ *  @{
+ */
+
+namespace {
+
+const std::string fffd = "\xEF\xBF\xBD";
+
+template <class Append> std::string escaped(const Append append, const std::string_view text) {
+    spdlog::memory_buf_t out;
+    append(out, text);
+    return {out.data(), out.size()};
+}
+
+std::string json(const std::string_view text) {
+    return escaped(text::append_json_escaped, text);
+}
+
+std::string terminal(const std::string_view text) {
+    return escaped(text::append_terminal_safe, text);
+}
+
+} // namespace
+
+/**
+ * @brief JSON escaping handles quotes, backslashes and control characters on both sides of the SIMD block size.
+ */
+TEST(TextEscapeTest, JsonEscapes) {
+    EXPECT_EQ(json(""), "");
+    EXPECT_EQ(json("plain text"), "plain text");
+    EXPECT_EQ(json("say \"hi\"\\\n\r\t\x01\x1F"), R"(say \"hi\"\\\n\r\t\u0001\u001f)");
+    EXPECT_EQ(json("\x7F"), "\x7F"); // DEL is valid in a JSON string
+
+    const std::string clean(40, 'a');
+    EXPECT_EQ(json(clean + "\"" + clean), clean + "\\\"" + clean);
+    EXPECT_EQ(json(clean + "\x1b[31m"), clean + "\\u001b[31m");
+}
+
+/**
+ * @brief Terminal escaping keeps newlines, tabs and valid UTF-8 but neutralizes escape sequences and DEL.
+ */
+TEST(TextEscapeTest, TerminalSafe) {
+    EXPECT_EQ(terminal("line 1\n\tline 2 \"quoted\" \\"), "line 1\n\tline 2 \"quoted\" \\");
+    EXPECT_EQ(terminal("\x1b]0;pwned\x07 red \x1b[31m\r\x7F"), "\\x1b]0;pwned\\x07 red \\x1b[31m\\x0d\\x7f");
+    EXPECT_EQ(terminal("grüße 日本 🙂"), "grüße 日本 🙂");
+
+    EXPECT_FALSE(text::needs_terminal_escaping("grüße\n"));
+    EXPECT_FALSE(text::needs_terminal_escaping(std::string(100, 'x') + "日本"));
+    EXPECT_TRUE(text::needs_terminal_escaping(std::string(100, 'x') + "\x1b"));
+    EXPECT_TRUE(text::needs_terminal_escaping("日本\xE6"));
+}
+
+/**
+ * @brief Ill-formed UTF-8 is replaced by one U+FFFD per maximal ill-formed subsequence.
+ */
+TEST(TextEscapeTest, ReplacesIllFormedUtf8) {
+    // string literals are split where a hex escape would otherwise swallow the next letter
+    EXPECT_EQ(json("a\xFF" "b"), "a" + fffd + "b");
+    EXPECT_EQ(json("\xC0\xAF"), fffd + fffd);                       // overlong '/': C0 is never valid
+    EXPECT_EQ(json("\xE2\x82" "x"), fffd + "x");                    // truncated euro sign: one subpart
+    EXPECT_EQ(json("\xED\xA0\x80"), fffd + fffd + fffd);            // surrogate D800
+    EXPECT_EQ(json("\xF4\x90\x80\x80"), fffd + fffd + fffd + fffd); // above U+10FFFF
+    EXPECT_EQ(json("\xF0\x9F\x99"), fffd);                          // emoji cut off at the end
+    EXPECT_EQ(terminal("\x80\x80"), fffd + fffd);
+}
+
+/**
+ * @brief UTF-8 validation accepts every well-formed boundary value and rejects the classic failure cases.
+ */
+TEST(TextEscapeTest, ValidatesUtf8) {
+    for (const std::string_view valid : {"", "ascii", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF",
+                                         "\xEE\x80\x80", "\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF"}) {
+        EXPECT_TRUE(text::is_valid_utf8(valid)) << valid;
+        EXPECT_TRUE(text::is_valid_utf8(std::string(33, 'x') + std::string(valid))) << valid;
+    }
+    for (const std::string_view invalid : {"\x80", "\xC1\xBF", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xF0\x8F\xBF\xBF",
+                                           "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xE2\x82", "\xC2" "a"}) {
+        EXPECT_FALSE(text::is_valid_utf8(invalid)) << invalid;
+        EXPECT_FALSE(text::is_valid_utf8(std::string(33, 'x') + std::string(invalid))) << invalid;
+    }
+}
+
+/**
+ * @brief Corrupting any single byte of multi-byte text is judged the same by the block validator and the
+ *        sequence decoder, including sequences that straddle 32-byte blocks.
+ */
+TEST(TextEscapeTest, ValidatorAgreesOnCorruptions) {
+    std::string text;
+    while (text.size() < 130) {
+        text += "aé日🙂"; // 1-, 2-, 3- and 4-byte sequences
+    }
+    ASSERT_TRUE(text::is_valid_utf8(text));
+
+    for (const unsigned char replacement : {0x00, 0x41, 0x80, 0xBF, 0xC0, 0xC3, 0xE0, 0xED, 0xF0, 0xF4, 0xFF}) {
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            auto corrupted = text;
+            corrupted[i]   = static_cast<char>(replacement);
+            ASSERT_EQ(text::is_valid_utf8(corrupted), text::is_valid_utf8_portable(corrupted)) << i << ":" << +replacement;
+            ASSERT_EQ(text::is_valid_utf8(std::string_view{corrupted}.substr(0, i + 1)),
+                      text::is_valid_utf8_portable(std::string_view{corrupted}.substr(0, i + 1)))
+                << i << ":" << +replacement;
+        }
+    }
+}
+
+/**
+ * @brief The dispatched SIMD scans produce the same output as the portable ones for every length and offset.
+ */
+TEST(TextEscapeTest, SimdMatchesPortable) {
+    // mostly ASCII with occasional quotes, controls, UTF-8 and stray high bytes
+    constexpr std::string_view alphabet[] = {"a", "b", " ", "\"", "\\", "\n", "\x1b", "\x7F", "ü", "日", "\xFF", "\xE2"};
+    std::mt19937 rng{7};
+    std::string text;
+    for (int i = 0; i < 400; ++i) {
+        const auto pick = rng() % 40;
+        text += pick < std::size(alphabet) ? alphabet[pick] : "x";
+    }
+
+    for (std::size_t offset = 0; offset < 8; ++offset) {
+        for (std::size_t size = 0; size + offset <= 200; ++size) {
+            const auto piece = std::string_view{text}.substr(offset, size);
+            ASSERT_EQ(json(piece), escaped(text::append_json_escaped_portable, piece)) << offset << "+" << size;
+            ASSERT_EQ(terminal(piece), escaped(text::append_terminal_safe_portable, piece)) << offset << "+" << size;
+            ASSERT_EQ(text::is_valid_utf8(piece), text::is_valid_utf8_portable(piece)) << offset << "+" << size;
+        }
+    }
+
+    const auto impl = text::escape_implementation();
+    EXPECT_TRUE(impl == "avx2" || impl == "sse2" || impl == "portable") << impl;
+}
+
+/**
+ * @brief TerminalSafeSink escapes the payload only; pattern and clean records pass through unchanged.
+ */
+TEST(TextEscapeTest, TerminalSafeSinkEscapesPayload) {
+    std::ostringstream oss;
+    const auto inner = std::make_shared<spdlog::sinks::ostream_sink_st>(oss);
+    log::TerminalSafeSink sink{inner};
+    sink.set_pattern("[%n] %v");
+
+    sink.log(spdlog::details::log_msg{"test", spdlog::level::info, "clean ünïcode"});
+    sink.log(spdlog::details::log_msg{"test", spdlog::level::info, "user=\x1b[2Jadmin\xFF"});
+    sink.flush();
+    EXPECT_EQ(oss.str(), "[test] clean ünïcode\n[test] user=\\x1b[2Jadmin" + fffd + "\n");
+}
+
+/** @} */
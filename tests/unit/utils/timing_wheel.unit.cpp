@@ -0,0 +1,191 @@
+/**
+ * @file timing_wheel.unit.cpp
+ * @brief Unit tests for project_template::utils::timer::TimingWheel and TimerThread.
+ */
+
+#include "timing_wheel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace project_template::utils::timer;
+using namespace std::chrono_literals;
+
+namespace {
+
+/**
+ * @brief Fixture with a 1 ms wheel anchored at a fixed origin, so tests can
+ *        advance deterministically without touching the real clock.
+ */
+class TimingWheelTest : public ::testing::Test {
+  protected:
+    TimingWheel::Clock::time_point origin_ = TimingWheel::Clock::now();
+    TimingWheel wheel_{1ms, origin_};
+    std::vector<int> fired_;
+};
+
+} // namespace
+
+/** @defgroup TimingWheelTests Timing wheel tests
+ *  @brief Tests for the hierarchical timing wheel and its driver thread.
+ *  @{
+ */
+
+/**
+ * @brief A one-shot timer fires exactly at its expiry tick and only once.
+ */
+TEST_F(TimingWheelTest, OneShotFiresOnceAtExpiry) {
+    wheel_.schedule_after(5ms, [this] { fired_.push_back(1); });
+    EXPECT_EQ(wheel_.size(), 1u);
+
+    EXPECT_EQ(wheel_.advance(4), 0u);
+    EXPECT_TRUE(fired_.empty());
+
+    EXPECT_EQ(wheel_.advance(1), 1u);
+    ASSERT_EQ(fired_.size(), 1u);
+    EXPECT_TRUE(wheel_.empty());
+
+    wheel_.advance(1000);
+    EXPECT_EQ(fired_.size(), 1u);
+}
+
+/**
+ * @brief Timers far enough out to live in higher wheels are cascaded down and
+ *        fire at the exact tick, including timers beyond the 2^32-tick horizon.
+ */
+TEST_F(TimingWheelTest, CascadesFromHigherWheels) {
+    const std::vector<std::uint64_t> delays = {255, 256, 257, 1000, 65'535, 65'536, 70'000, 16'777'300};
+    std::vector<std::uint64_t> fired_at;
+    for (const auto d : delays) {
+        wheel_.schedule_after(std::chrono::milliseconds{d}, [&] { fired_at.push_back(wheel_.current_tick()); });
+    }
+
+    wheel_.advance(16'777'300);
+    EXPECT_EQ(fired_at, delays);
+
+    // overflow list: beyond the span of all four wheels
+    const std::uint64_t far = (std::uint64_t{1} << 32) + 17;
+    std::uint64_t fired_tick = 0;
+    wheel_.schedule_after(std::chrono::milliseconds{far}, [&] { fired_tick = wheel_.current_tick(); });
+    const auto start = wheel_.current_tick();
+    wheel_.advance(far);
+    EXPECT_EQ(fired_tick, start + far);
+}
+
+/**
+ * @brief Cancelled timers never fire, and stale ids are rejected.
+ */
+TEST_F(TimingWheelTest, CancelPreventsFiring) {
+    const auto a = wheel_.schedule_after(10ms, [this] { fired_.push_back(1); });
+    const auto b = wheel_.schedule_after(10ms, [this] { fired_.push_back(2); });
+    EXPECT_TRUE(wheel_.cancel(a));
+    EXPECT_FALSE(wheel_.cancel(a));
+    EXPECT_FALSE(wheel_.cancel(TimingWheel::invalid_timer));
+
+    wheel_.advance(10);
+    EXPECT_EQ(fired_, std::vector<int>{2});
+    EXPECT_FALSE(wheel_.cancel(b)) << "already fired";
+}
+
+/**
+ * @brief A slab slot reused after cancellation must not be cancellable through the old id.
+ */
+TEST_F(TimingWheelTest, ReusedSlotRejectsStaleId) {
+    const auto old_id = wheel_.schedule_after(3ms, [this] { fired_.push_back(1); });
+    ASSERT_TRUE(wheel_.cancel(old_id));
+    const auto new_id = wheel_.schedule_after(3ms, [this] { fired_.push_back(2); });
+    EXPECT_NE(old_id, new_id);
+    EXPECT_FALSE(wheel_.cancel(old_id));
+
+    wheel_.advance(3);
+    EXPECT_EQ(fired_, std::vector<int>{2});
+}
+
+/**
+ * @brief Periodic timers re-arm themselves and may cancel themselves from inside the callback.
+ */
+TEST_F(TimingWheelTest, PeriodicTimerRearmsAndSelfCancels) {
+    TimingWheel::TimerId id = TimingWheel::invalid_timer;
+    int count               = 0;
+    id                      = wheel_.schedule_every(3ms, [&] {
+        ++count;
+        if (count == 4) EXPECT_TRUE(wheel_.cancel(id));
+    });
+
+    wheel_.advance(9);
+    EXPECT_EQ(count, 3);
+    wheel_.advance(100);
+    EXPECT_EQ(count, 4);
+    EXPECT_TRUE(wheel_.empty());
+}
+
+/**
+ * @brief advance_to() converts wall time into ticks relative to the origin.
+ */
+TEST_F(TimingWheelTest, AdvanceToUsesOrigin) {
+    wheel_.schedule_after(20ms, [this] { fired_.push_back(1); });
+    EXPECT_EQ(wheel_.advance_to(origin_ + 19ms), 0u);
+    EXPECT_EQ(wheel_.advance_to(origin_ + 20ms), 1u);
+    EXPECT_EQ(wheel_.current_tick(), 20u);
+}
+
+/**
+ * @brief TimerThread fires scheduled callbacks on its own thread and honors cancel().
+ */
+TEST(TimerThreadTest, FiresAndCancels) {
+    TimerThread timers{1ms};
+    std::atomic<int> fired{0};
+    std::atomic<int> cancelled{0};
+
+    timers.schedule_after(5ms, [&] { fired.fetch_add(1); });
+    const auto id = timers.schedule_after(50ms, [&] { cancelled.fetch_add(1); });
+    EXPECT_TRUE(timers.cancel(id));
+
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (fired.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(fired.load(), 1);
+
+    std::this_thread::sleep_for(60ms);
+    EXPECT_EQ(cancelled.load(), 0);
+    timers.stop();
+    EXPECT_EQ(timers.size(), 0u);
+}
+
+/**
+ * @brief A timer scheduled while the thread sleeps towards a later one counts its delay from now and fires first.
+ */
+TEST(TimerThreadTest, SleepsUntilNextEventAndHonorsNewDelays) {
+    TimerThread timers{1ms};
+    std::atomic<bool> late{false};
+    std::atomic<bool> early{false};
+    std::atomic<std::int64_t> early_after_ms{-1};
+
+    timers.schedule_after(400ms, [&] { late.store(true); });
+    std::this_thread::sleep_for(100ms); // the wheel is not advanced meanwhile
+
+    const auto scheduled = std::chrono::steady_clock::now();
+    timers.schedule_after(50ms, [&] {
+        early_after_ms.store(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 std::chrono::steady_clock::now() - scheduled)
+                                 .count());
+        early.store(true);
+    });
+
+    const auto deadline = scheduled + 2s;
+    while (!early.load() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    ASSERT_TRUE(early.load());
+    EXPECT_GE(early_after_ms.load(), 49);
+    EXPECT_FALSE(late.load());
+    timers.stop();
+}
+
+/** @} */
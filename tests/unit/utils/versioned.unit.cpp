@@ -0,0 +1,113 @@
+/**
+ * @file versioned.unit.cpp
+ * @brief Unit tests for project_template::utils::concurrency::Versioned and EpochDomain.
+ */
+
+#include "versioned.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace project_template::utils::concurrency;
+
+namespace {
+
+/// Non-trivial payload that counts its destructions.
+struct Config {
+    static inline std::atomic<int> destroyed{0};
+
+    std::string name;
+    std::vector<std::uint64_t> values;
+
+    Config(std::string config_name, std::vector<std::uint64_t> config_values)
+      : name(std::move(config_name)), values(std::move(config_values)) {}
+    Config(const Config&) = default;
+    ~Config() {
+        destroyed.fetch_add(1);
+    }
+};
+
+} // namespace
+
+/** @defgroup VersionedTests Versioned tests
+ *  @brief Tests for publishing versions, consistent reads and epoch-based reclamation.
+ *  @{
+ */
+
+/**
+ * @brief `store()` and `update()` publish new versions; `read()` and `load()` see the latest.
+ */
+TEST(VersionedTest, StoreAndUpdatePublish) {
+    Versioned<Config> config{Config{"initial", {1}}};
+    EXPECT_EQ(config.read()->name, "initial");
+    EXPECT_EQ(config.version(), 1u);
+
+    config.store(Config{"stored", {1, 2}});
+    config.update([](Config& c) { c.values.push_back(3); });
+    const auto current = config.read();
+    EXPECT_EQ(current->name, "stored");
+    EXPECT_EQ(current->values.size(), 3u);
+    EXPECT_EQ(config.load().values.back(), 3u);
+    EXPECT_EQ(config.version(), 3u);
+}
+
+/**
+ * @brief A replaced version survives while a guard pins it and is freed once no reader holds it.
+ */
+TEST(VersionedTest, PinnedVersionIsNotFreed) {
+    EpochDomain::global().reclaim();
+    Versioned<Config> config{Config{"old", {7, 7, 7}}};
+    const auto destroyed = Config::destroyed.load();
+    {
+        const auto old = config.read();
+        config.store(Config{"new", {8}});
+        config.store(Config{"newer", {9}});
+        EXPECT_EQ(Config::destroyed.load(), destroyed + 2) << "only the arguments of store()";
+        EXPECT_EQ(old->name, "old");
+        EXPECT_EQ(old->values[2], 7u);
+        EXPECT_EQ(config.read()->name, "newer") << "nested pins see the current version";
+    }
+    EXPECT_EQ(EpochDomain::global().reclaim(), 0u);
+    EXPECT_EQ(Config::destroyed.load(), destroyed + 4) << "both temporaries and both replaced versions";
+}
+
+/**
+ * @brief Readers racing a writer see complete versions, and every replaced version is eventually freed.
+ */
+TEST(VersionedTest, ConcurrentReadsAreConsistent) {
+    constexpr std::uint64_t versions = 5000;
+    const auto destroyed             = Config::destroyed.load();
+    {
+        Versioned<Config> config{Config{"0", {0, 0, 0, 0}}};
+        std::atomic<bool> done{false};
+        std::atomic<int> inconsistent{0};
+
+        std::vector<std::jthread> readers;
+        for (int i = 0; i < 3; ++i) {
+            readers.emplace_back([&] {
+                while (!done.load(std::memory_order_relaxed)) {
+                    const auto current = config.read();
+                    for (const auto value : current->values) {
+                        if (std::to_string(value) != current->name) inconsistent.fetch_add(1);
+                    }
+                }
+            });
+        }
+        for (std::uint64_t i = 1; i <= versions; ++i) {
+            config.store(Config{std::to_string(i), {i, i, i, i}});
+        }
+        done = true;
+        readers.clear();
+        EXPECT_EQ(inconsistent.load(), 0);
+    }
+    EXPECT_EQ(EpochDomain::global().reclaim(), 0u);
+    // per store: its argument and the version it replaced; plus the constructor's argument and the last version
+    EXPECT_EQ(Config::destroyed.load(), destroyed + static_cast<int>(2 * versions) + 2);
+}
+
+/** @} */
@@ -0,0 +1,107 @@
+/**
+ * @file worker_pool.unit.cpp
+ * @brief Unit tests for project_template::utils::concurrency::WorkerPool.
+ */
+
+#include "worker_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+using namespace project_template::utils::concurrency;
+using namespace std::chrono_literals;
+
+/** @defgroup WorkerPoolTests Worker pool tests
+ *  @brief Tests for task execution, backpressure and the deadline-bound drain.
+ *  @{
+ */
+
+/**
+ * @brief Every submitted task runs once, on a worker thread with a valid index.
+ */
+TEST(WorkerPoolTest, RunsAllTasks) {
+    std::atomic<int> runs{0};
+    std::atomic<bool> bad_index{false};
+    {
+        WorkerPool pool{3, 1000};
+        EXPECT_EQ(pool.threads(), 3u);
+        for (int i = 0; i < 500; ++i) {
+            ASSERT_TRUE(pool.try_submit([&] {
+                if (WorkerPool::worker_index() >= 3) bad_index = true;
+                ++runs;
+            }));
+        }
+        EXPECT_EQ(pool.drain(WorkerPool::Clock::now() + 10s), 0u);
+        EXPECT_EQ(pool.completed(), 500u);
+    }
+    EXPECT_EQ(runs.load(), 500);
+    EXPECT_FALSE(bad_index.load());
+    EXPECT_EQ(WorkerPool::worker_index(), WorkerPool::not_a_worker);
+}
+
+/**
+ * @brief A full queue and a draining pool refuse tasks instead of blocking.
+ */
+TEST(WorkerPoolTest, RefusesWhenFullOrDraining) {
+    std::promise<void> release;
+    const auto gate = release.get_future().share();
+    WorkerPool pool{1, 2};
+
+    std::promise<void> started;
+    ASSERT_TRUE(pool.try_submit([&] {
+        started.set_value();
+        gate.wait();
+    }));
+    started.get_future().wait(); // the worker is busy, the queue is empty
+
+    EXPECT_TRUE(pool.try_submit([] {}));
+    EXPECT_TRUE(pool.try_submit([] {}));
+    EXPECT_FALSE(pool.try_submit([] {})) << "queue of 2 is full";
+    EXPECT_EQ(pool.queued(), 2u);
+
+    release.set_value();
+    EXPECT_EQ(pool.drain(WorkerPool::Clock::now() + 10s), 0u);
+    EXPECT_FALSE(pool.try_submit([] {})) << "drained pool accepts nothing";
+    EXPECT_EQ(pool.completed(), 3u);
+}
+
+/**
+ * @brief At the drain deadline queued tasks are discarded unstarted; the running one finishes.
+ */
+TEST(WorkerPoolTest, DrainDeadlineAbandonsQueuedTasks) {
+    std::atomic<int> runs{0};
+    WorkerPool pool{1, 100};
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(pool.try_submit([&] {
+            std::this_thread::sleep_for(50ms);
+            ++runs;
+        }));
+    }
+
+    const auto abandoned = pool.drain(WorkerPool::Clock::now() + 75ms);
+    EXPECT_GE(abandoned, 7u);
+    EXPECT_LE(abandoned, 9u);
+    EXPECT_EQ(static_cast<std::size_t>(runs.load()) + abandoned, 10u);
+    EXPECT_EQ(pool.drain(WorkerPool::Clock::now()), 0u) << "second drain is a no-op";
+}
+
+/**
+ * @brief An exception escaping a task is counted and the worker keeps serving the queue.
+ */
+TEST(WorkerPoolTest, ThrowingTaskDoesNotStopWorker) {
+    std::atomic<int> runs{0};
+    WorkerPool pool{1, 10};
+    ASSERT_TRUE(pool.try_submit([] { throw std::runtime_error("boom"); }));
+    ASSERT_TRUE(pool.try_submit([&] { ++runs; }));
+    pool.drain(WorkerPool::Clock::now() + 10s);
+    EXPECT_EQ(pool.failed(), 1u);
+    EXPECT_EQ(pool.completed(), 2u);
+    EXPECT_EQ(runs.load(), 1);
+}
+
+/** @} */
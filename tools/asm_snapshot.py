@@ -0,0 +1,283 @@
+#!/usr/bin/env python3
+"""
+Assembly snapshots of hot functions for project_template.
+
+Disassembles the functions listed in the manifest written by the CMake
+target 'asm-snapshot' (see cmake/AsmSnapshot.cmake) and stores one
+normalized listing per configured name:
+
+    <out>/<target>/<name>.s
+
+Normalization removes everything that changes without the code changing:
+addresses, raw bytes, alignment padding and PC-relative displacements.
+Branches inside a function jump to labels (.L<n>) and calls name their
+targets. This way a diff between two builds shows only real codegen changes,
+for example a loop that is no longer vectorized.
+
+Each listing starts with a short header. The header gives the number of
+instructions and how many of them use vector registers. When llvm-mca is
+available, it adds a throughput estimate in cycles per iteration for the
+innermost loop, or for the whole function if it has no loop.
+
+Usage (normally through the CMake target):
+
+    ./tools/asm_snapshot.py --manifest build/benchmark/asm_snapshot.json
+
+Compare two snapshot directories:
+
+    ./tools/asm_snapshot.py diff <baseline-dir> <current-dir>
+"""
+
+import argparse
+import difflib
+import json
+import re
+import subprocess
+import sys
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+INSTRUCTION_RE = re.compile(r"^\s*([0-9a-f]+):\s+(.*)$")
+BRANCH_TARGET_RE = re.compile(r"^([0-9a-f]+) <([^>]+)>$")
+RIP_COMMENT_RE = re.compile(r"^(.*?)(-?0x[0-9a-f]+)\(%rip\)(.*?)\s*#\s*[0-9a-f]+ <([^>]+)>$")
+VECTOR_REG_RE = re.compile(r"%[xyz]mm\d+")
+PADDING_RE = re.compile(r"^(?:(?:cs|ds|data16)\s+)*(?:nop[wl]?|xchg\s+%ax,%ax)\b")
+
+
+# ---------------------------------------------------------------------------
+# Symbol lookup
+# ---------------------------------------------------------------------------
+
+
+def demangle(names: List[str]) -> List[str]:
+    """Demangle a batch of symbol names with c++filt (unchanged if not mangled)."""
+    out = subprocess.run(
+        ["c++filt"], input="\n".join(names), text=True, capture_output=True, check=True
+    ).stdout
+    return out.splitlines()
+
+
+def function_symbols(binary: Path) -> List[Tuple[str, str]]:
+    """All defined functions of `binary` as (mangled, demangled), without compiler-split cold parts."""
+    out = subprocess.run(
+        ["nm", "--defined-only", str(binary)], text=True, capture_output=True, check=True
+    ).stdout
+    mangled = sorted(
+        {
+            parts[2]
+            for parts in (line.split() for line in out.splitlines())
+            if len(parts) == 3 and parts[1] in "tTwW" and "." not in parts[2]
+        }
+    )
+    return list(zip(mangled, demangle(mangled)))
+
+
+def matches(name: str, demangled: str) -> bool:
+    """True if `name` (a qualified function name) names `demangled`: followed by its parameters or template args."""
+    start = demangled.find(name)
+    while start != -1:
+        end = start + len(name)
+        before_ok = start == 0 or demangled[start - 1] in " :&*"
+        if before_ok and end < len(demangled) and demangled[end] in "(<":
+            return True
+        start = demangled.find(name, start + 1)
+    return False
+
+
+# ---------------------------------------------------------------------------
+# Disassembly and normalization
+# ---------------------------------------------------------------------------
+
+
+def disassemble(objdump: str, binary: Path, mangled: str) -> List[Tuple[int, str]]:
+    """(address, instruction) of one function, AT&T syntax, without raw bytes."""
+    out = subprocess.run(
+        [objdump, "-d", "--no-show-raw-insn", f"--disassemble={mangled}", str(binary)],
+        text=True,
+        capture_output=True,
+        check=True,
+    ).stdout
+    lines = []
+    for line in out.splitlines():
+        m = INSTRUCTION_RE.match(line)
+        if m:
+            lines.append((int(m.group(1), 16), m.group(2).strip()))
+    return lines
+
+
+def normalize(lines: List[Tuple[int, str]], mangled: str) -> List[str]:
+    """Replace addresses by labels and symbols, drop padding, collapse whitespace."""
+    instructions = [(addr, re.sub(r"\s+", " ", text)) for addr, text in lines]
+    instructions = [(addr, text) for addr, text in instructions if not PADDING_RE.match(text)]
+
+    # branch targets inside the function become labels, numbered in address order
+    local_targets = set()
+    for _, text in instructions:
+        mnemonic, _, operand = text.partition(" ")
+        m = BRANCH_TARGET_RE.match(operand)
+        if m and (m.group(2) == mangled or m.group(2).startswith(mangled + "+")):
+            local_targets.add(int(m.group(1), 16))
+    labels = {addr: f".L{i}" for i, addr in enumerate(sorted(local_targets))}
+
+    result = []
+    for addr, text in instructions:
+        if addr in labels:
+            result.append(f"{labels[addr]}:")
+        mnemonic, _, operand = text.partition(" ")
+        m = BRANCH_TARGET_RE.match(operand)
+        if m:
+            target = int(m.group(1), 16)
+            operand = labels.get(target, m.group(2).split("+")[0])
+        elif "%rip" in operand:
+            # keep the symbol, not its offset: unnamed constants are attributed to the nearest symbol before them
+            rip = RIP_COMMENT_RE.match(operand)
+            operand = f"{rip.group(1)}{rip.group(4).split('+')[0]}(%rip){rip.group(3)}" if rip else re.sub(
+                r"-?0x[0-9a-f]+\(%rip\)", "<pc-rel>(%rip)", operand
+            )
+        result.append(f"    {mnemonic} {operand}".rstrip())
+    return result
+
+
+def innermost_loop(listing: List[str]) -> List[str]:
+    """Instructions of the shortest backward-branch range (the innermost loop); the whole listing if none."""
+    positions = {line[:-1]: i for i, line in enumerate(listing) if line.endswith(":")}
+    best: Optional[Tuple[int, int]] = None
+    for i, line in enumerate(listing):
+        parts = line.split()
+        if len(parts) == 2 and parts[0].startswith("j") and parts[1] in positions:
+            start = positions[parts[1]]
+            if start < i and (best is None or i - start < best[1] - best[0]):
+                best = (start, i)
+    if best is None:
+        return listing
+    return listing[best[0] : best[1] + 1]
+
+
+def mca_estimate(llvm_mca: str, body: List[str]) -> Optional[str]:
+    """llvm-mca cycles per iteration of `body` for the host CPU, or None if it cannot be analyzed."""
+    # labels are dropped, so branches get a placeholder target (their cost is kept); calls leave the function
+    code = [
+        re.sub(r"^(\s+j\w+) .*$", r"\1 0", line)
+        for line in body
+        if not line.endswith(":") and line.split()[0] not in ("call", "ret")
+    ]
+    if not code:
+        return None
+    try:
+        out = subprocess.run(
+            [llvm_mca, "-mcpu=native", "-iterations=100"],
+            input="\n".join(code) + "\n",
+            text=True,
+            capture_output=True,
+            check=True,
+        ).stdout
+    except (subprocess.CalledProcessError, FileNotFoundError):
+        return None
+    m = re.search(r"Block RThroughput:\s*([0-9.]+)", out)
+    return m.group(1) if m else None
+
+
+def snapshot_function(objdump: str, llvm_mca: Optional[str], binary: Path, mangled: str, demangled: str) -> List[str]:
+    listing = normalize(disassemble(objdump, binary, mangled), mangled)
+    listing = demangle(listing) if listing else listing
+    instructions = [line for line in listing if not line.endswith(":")]
+    vector = sum(1 for line in instructions if VECTOR_REG_RE.search(line))
+
+    header = [f"# {demangled}", f"# {len(instructions)} instructions, {vector} with vector registers"]
+    if llvm_mca:
+        loop = innermost_loop(listing)
+        scope = "innermost loop" if loop is not listing else "whole function"
+        estimate = mca_estimate(llvm_mca, loop)
+        if estimate is not None:
+            size = sum(1 for line in loop if not line.endswith(":"))
+            header.append(f"# llvm-mca ({scope}, {size} instructions): {estimate} cycles/iteration")
+    return header + listing
+
+
+# ---------------------------------------------------------------------------
+# snapshot / diff commands
+# ---------------------------------------------------------------------------
+
+
+def file_name(name: str) -> str:
+    return re.sub(r"[^A-Za-z0-9_.]+", "_", name.replace("::", ".")).strip("_.") + ".s"
+
+
+def take_snapshot(args: argparse.Namespace) -> None:
+    manifest = json.loads(args.manifest.read_text(encoding="utf-8"))
+    out_dir = Path(manifest["output"])
+    objdump = manifest.get("objdump") or "objdump"
+    llvm_mca = manifest.get("llvm_mca") or None
+
+    for target in manifest["targets"]:
+        binary = Path(target["file"])
+        target_dir = out_dir / target["name"]
+        target_dir.mkdir(parents=True, exist_ok=True)
+        for stale in target_dir.glob("*.s"):
+            stale.unlink()
+
+        symbols = function_symbols(binary)
+        for name in target["symbols"]:
+            found = [(m, d) for m, d in symbols if matches(name, d)]
+            if not found:
+                print(f"[asm] {target['name']}: no function named '{name}' (inlined or renamed?)")
+                continue
+            text: List[str] = []
+            for mangled, demangled in sorted(found, key=lambda s: s[1]):
+                text += snapshot_function(objdump, llvm_mca, binary, mangled, demangled) + [""]
+            (target_dir / file_name(name)).write_text("\n".join(text), encoding="utf-8")
+            print(f"[asm] {target['name']}: {name} ({len(found)} function(s))")
+
+    print(f"[asm] Snapshots written to '{out_dir}'.")
+
+
+def listings(directory: Path) -> Dict[str, str]:
+    return {
+        str(p.relative_to(directory)): p.read_text(encoding="utf-8") for p in sorted(directory.rglob("*.s"))
+    }
+
+
+def diff_snapshots(baseline_dir: Path, current_dir: Path) -> int:
+    """Print a unified diff per changed listing; returns the number of changed, added or removed listings."""
+    baseline = listings(baseline_dir)
+    current = listings(current_dir)
+    changed = 0
+    for name in sorted(set(baseline) | set(current)):
+        before = baseline.get(name, "").splitlines()
+        after = current.get(name, "").splitlines()
+        if before == after:
+            continue
+        changed += 1
+        sys.stdout.writelines(
+            line + "\n"
+            for line in difflib.unified_diff(before, after, f"baseline/{name}", f"current/{name}", lineterm="")
+        )
+    print(f"[asm] {changed} of {len(set(baseline) | set(current))} listing(s) changed.")
+    return changed
+
+
+def parse_args() -> argparse.Namespace:
+    parser = argparse.ArgumentParser(
+        description="Normalized assembly snapshots of hot functions, and diffs between them.",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+    )
+    subparsers = parser.add_subparsers(dest="command")
+    diff_parser = subparsers.add_parser("diff", help="Diff two snapshot directories.")
+    diff_parser.add_argument("baseline", type=Path)
+    diff_parser.add_argument("current", type=Path)
+    parser.add_argument("--manifest", type=Path, help="Manifest written by the 'asm-snapshot' CMake target.")
+    return parser.parse_args()
+
+
+def main() -> None:
+    args = parse_args()
+    if args.command == "diff":
+        diff_snapshots(args.baseline, args.current)
+    elif args.manifest:
+        take_snapshot(args)
+    else:
+        raise SystemExit("Either --manifest or the 'diff' command is required.")
+
+
+if __name__ == "__main__":
+    main()
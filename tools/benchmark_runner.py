@@ -14,6 +14,16 @@ Subcommands:
     Example:
       ./tools/benchmark_runner.py run
 
+    With --cores, the benchmarks are sharded instead: one benchmark process
+    per listed core, each pinned to its core, running one benchmark family
+    at a time; the shard outputs are merged into the usual *_bench.json
+    files. Multi-threaded families run afterwards, alone, on all listed
+    cores. Cores that share a last-level cache are reported (and recorded
+    in the JSON context), since memory-bound benchmarks on them interfere.
+
+    Example:
+      ./tools/benchmark_runner.py run --cores 2-5
+
   compare-json
     Compare two sets of Google Benchmark JSON outputs and print a table of
     speedup and percentage change per benchmark.
@@ -32,7 +42,9 @@ Subcommands:
       - create (or reuse) a git worktree under build/benchmark/benchmark_worktrees/
       - configure, build, and run the 'benchmark' preset
       - collect JSON benchmark results from build/benchmark
-    Then compare their performance and print a table.
+      - build the 'asm-snapshot' target (normalized assembly of hot functions)
+    Then compare their performance and print a table, followed by a diff of
+    the assembly listings that changed (skip it with --no-asm).
 
     Example:
       ./tools/benchmark_runner.py compare-commits <baseline-commit> <current-commit>
@@ -47,15 +59,26 @@ Use -h/--help after the main command or any subcommand for detailed options:
 
 import argparse
 import json
+import os
+import queue
+import re
 import subprocess
+import threading
 from pathlib import Path
-from typing import Dict, Tuple
+from typing import Dict, List, Optional, Tuple
+
+from asm_snapshot import diff_snapshots
 
 # Fixed configuration for this project
 BUILD_SUBDIR = Path("build/benchmark")
 CMAKE_PRESET = "benchmark"
 BENCH_TARGET = "run-benchmark"
+ASM_TARGET = "asm-snapshot"
+ASM_SUBDIR = "asm"
 BENCH_WORKTREES_DIR_NAME = "benchmark_worktrees"
+BENCH_MANIFEST = "benchmark_executables.json"
+SHARD_DIR_NAME = "shards"
+SYSFS_CPU = Path("/sys/devices/system/cpu")
 
 
 # ---------------------------------------------------------------------------
@@ -89,12 +112,12 @@ def short_ref(ref: str) -> str:
 # ---------------------------------------------------------------------------
 
 
-def run_benchmarks(project_root: Path) -> None:
+def run_benchmarks(project_root: Path, cores: Optional[List[int]] = None) -> None:
     build_dir = project_root / BUILD_SUBDIR
     print(f"[bench:run] Project root: {project_root}")
     print(f"[bench:run] Build dir:    {build_dir}")
     print(f"[bench:run] Preset:       {CMAKE_PRESET}")
-    print(f"[bench:run] Target:       {BENCH_TARGET}")
+    print(f"[bench:run] Target:       {BENCH_TARGET if not cores else 'sharded on cores ' + format_cpu_list(cores)}")
 
     # 1) Run Conan install for this preset inside the given tree
     conan_install = project_root / "conan" / "conan_install.py"
@@ -115,18 +138,265 @@ def run_benchmarks(project_root: Path) -> None:
     print("[bench:run] Building benchmarks...")
     run_cmd(["cmake", "--build", "--preset", CMAKE_PRESET], cwd=project_root)
 
-    # 4) Run the aggregate benchmark target
-    print(f"[bench:run] Running aggregate benchmark target '{BENCH_TARGET}'...")
-    run_cmd(
-        ["cmake", "--build", str(build_dir), "--target", BENCH_TARGET],
-        cwd=project_root,
-    )
+    # 4) Run the aggregate benchmark target, or shard the benchmarks across the given cores
+    if cores:
+        run_sharded(build_dir, cores)
+    else:
+        print(f"[bench:run] Running aggregate benchmark target '{BENCH_TARGET}'...")
+        run_cmd(
+            ["cmake", "--build", str(build_dir), "--target", BENCH_TARGET],
+            cwd=project_root,
+        )
 
     print(
         f"[bench:run] Done. JSON outputs should be in '{build_dir}' (e.g. *_bench.json)."
     )
 
 
+# ---------------------------------------------------------------------------
+# Sharded runner: one pinned benchmark process per core
+# ---------------------------------------------------------------------------
+
+
+def parse_cpu_list(text: str) -> List[int]:
+    """Parse a CPU list such as '2,3,6-7' (the format of taskset and sysfs)."""
+    cpus: List[int] = []
+    for part in text.split(","):
+        part = part.strip()
+        if not part:
+            continue
+        first, _, last = part.partition("-")
+        cpus.extend(range(int(first), int(last or first) + 1))
+    return sorted(set(cpus))
+
+
+def format_cpu_list(cpus: List[int]) -> str:
+    return ",".join(str(c) for c in cpus)
+
+
+def cores_phrase(cpus: List[int]) -> str:
+    return f"core{'s' if len(cpus) > 1 else ''} {format_cpu_list(cpus)}"
+
+
+def read_sysfs(path: Path) -> Optional[str]:
+    try:
+        return path.read_text(encoding="utf-8").strip()
+    except OSError:
+        return None
+
+
+def last_level_cache(cpu: int) -> Optional[Tuple[str, str]]:
+    """(level name, shared_cpu_list) of the largest-level cache of `cpu`, from sysfs."""
+    best: Optional[Tuple[int, str, str]] = None
+    for index in sorted((SYSFS_CPU / f"cpu{cpu}" / "cache").glob("index*")):
+        level = read_sysfs(index / "level")
+        shared = read_sysfs(index / "shared_cpu_list")
+        if level is None or shared is None or read_sysfs(index / "type") == "Instruction":
+            continue
+        if best is None or int(level) > best[0]:
+            best = (int(level), f"L{level}", shared)
+    return (best[1], best[2]) if best else None
+
+
+def interference_warnings(cores: List[int]) -> Tuple[List[str], List[str]]:
+    """
+    Ways in which benchmarks on `cores` can disturb each other, as (shared last-level
+    caches, other: SMT siblings and cores the kernel does not isolate).
+    """
+    llc_warnings = []
+    warnings = []
+
+    groups: Dict[Tuple[str, str], List[int]] = {}
+    for cpu in cores:
+        llc = last_level_cache(cpu)
+        if llc:
+            groups.setdefault(llc, []).append(cpu)
+    for (level, shared), members in sorted(groups.items(), key=lambda g: g[1]):
+        if len(members) > 1:
+            llc_warnings.append(
+                f"cores {format_cpu_list(members)} share one {level} (cpus {shared}): memory-bound benchmarks "
+                "running concurrently on them compete for its capacity and bandwidth"
+            )
+
+    for cpu in cores:
+        siblings = read_sysfs(SYSFS_CPU / f"cpu{cpu}" / "topology" / "thread_siblings_list")
+        if siblings:
+            paired = [c for c in parse_cpu_list(siblings) if c != cpu and c in cores]
+            if paired and cpu < min(paired):
+                warnings.append(f"cores {format_cpu_list([cpu] + paired)} are SMT siblings of one physical core")
+
+    isolated = parse_cpu_list(read_sysfs(SYSFS_CPU / "isolated") or "")
+    not_isolated = [c for c in cores if c not in isolated]
+    if not_isolated:
+        warnings.append(
+            f"{cores_phrase(not_isolated)} not isolated (isolcpus=); other processes may be scheduled there"
+        )
+    return llc_warnings, warnings
+
+
+class Job:
+    """One benchmark family of one executable, run in its own process."""
+
+    def __init__(self, exec_name: str, exec_file: str, family: str, names: List[str], threaded: bool):
+        self.exec_name = exec_name
+        self.exec_file = exec_file
+        self.family = family
+        self.names = names
+        self.threaded = threaded
+
+    def filter(self) -> str:
+        # Google Benchmark uses POSIX extended regular expressions
+        escaped = re.sub(r"([.\[\](){}*+?|^$\\])", r"\\\1", self.family)
+        return f"^{escaped}(/|$)"
+
+
+def list_jobs(executables: List[Dict[str, str]]) -> List[Job]:
+    """Benchmark families of every executable, in registration order."""
+    jobs = []
+    for exe in executables:
+        out = subprocess.run(
+            [exe["file"], "--benchmark_list_tests=true"], text=True, capture_output=True, check=True
+        ).stdout
+        families: Dict[str, List[str]] = {}
+        for name in out.split():
+            families.setdefault(name.split("/")[0], []).append(name)
+        for family, names in families.items():
+            threaded = any(re.search(r"/threads:(\d+)", n) and not n.endswith("/threads:1") for n in names)
+            jobs.append(Job(exe["name"], exe["file"], family, names, threaded))
+    return jobs
+
+
+def run_job(job: Job, cpus: List[int], out_file: Path, context: str) -> None:
+    """Run `job` on `cpus`. Call it on a thread pinned to `cpus` (see `pin_thread`): the child inherits the mask."""
+    print(f"[bench:shard] cpu {format_cpu_list(cpus)}: {job.exec_name} {job.family}")
+    subprocess.run(
+        [
+            job.exec_file,
+            f"--benchmark_filter={job.filter()}",
+            "--benchmark_format=json",
+            f"--benchmark_out={out_file}",
+            f"--benchmark_context={context}",
+        ],
+        check=True,
+        stdout=subprocess.DEVNULL,
+    )
+
+
+def pin_thread(cpus: List[int]) -> None:
+    """
+    Pin the calling thread to `cpus`; processes it starts afterwards inherit the mask.
+
+    On Linux, sched_setaffinity(0, ...) applies to the calling thread only. Pinning here
+    instead of in Popen's preexec_fn keeps Python code out of the window between fork and
+    exec, which is not safe while other threads are starting processes.
+    """
+    os.sched_setaffinity(0, cpus)
+
+
+def merge_shards(
+    exec_name: str, shard_files: List[Path], cores: List[int], llc_warnings: List[str], warnings: List[str]
+) -> Dict:
+    """One Google Benchmark JSON document from the shard outputs of one executable, in the order given."""
+    merged: Dict = {"context": {}, "benchmarks": []}
+    for path in shard_files:
+        data = json.loads(path.read_text(encoding="utf-8"))
+        if not merged["context"]:
+            merged["context"] = {k: v for k, v in data.get("context", {}).items() if k != "shard_cpus"}
+        shard_cpus = data.get("context", {}).get("shard_cpus", "")
+        for entry in data.get("benchmarks", []):
+            entry["shard_cpus"] = shard_cpus
+            merged["benchmarks"].append(entry)
+    merged["context"]["executable"] = exec_name
+    merged["context"]["shard_cores"] = format_cpu_list(cores)
+    merged["context"]["llc_interference"] = "; ".join(llc_warnings) if llc_warnings else "none"
+    merged["context"]["shard_warnings"] = "; ".join(warnings) if warnings else "none"
+    return merged
+
+
+def run_sharded(build_dir: Path, cores: List[int]) -> None:
+    """
+    Run every benchmark family of the build on `cores`: one process per core at a time, pinned to it.
+    Families with multi-threaded runs go last, one at a time, on all cores. Writes <exec>_bench.json,
+    with the benchmarks in registration order.
+    """
+    manifest_path = build_dir / BENCH_MANIFEST
+    if not manifest_path.is_file():
+        raise SystemExit(f"'{manifest_path}' not found; configure with BUILD_BENCHMARKS=ON first.")
+    manifest = json.loads(manifest_path.read_text(encoding="utf-8"))
+    out_dir = Path(manifest["output"])
+    shard_dir = out_dir / SHARD_DIR_NAME
+    shard_dir.mkdir(parents=True, exist_ok=True)
+    for stale in shard_dir.glob("*.json"):
+        stale.unlink()
+
+    llc_warnings, warnings = interference_warnings(cores)
+    for warning in llc_warnings + warnings:
+        print(f"[bench:shard] WARNING: {warning}")
+    llc_note = "shared" if llc_warnings else "private"
+
+    # numbered in registration order, which is also the order the shards are merged in
+    jobs = list(enumerate(list_jobs(manifest["executables"])))
+    pinned = [(number, job) for number, job in jobs if not job.threaded]
+    exclusive = [(number, job) for number, job in jobs if job.threaded]
+    print(f"[bench:shard] {len(pinned)} families on cores {format_cpu_list(cores)}, {len(exclusive)} multi-threaded")
+
+    outputs: Dict[str, List[Path]] = {}
+    lock = threading.Lock()
+    pending: "queue.Queue[Tuple[int, Job]]" = queue.Queue()
+    for numbered in pinned:
+        pending.put(numbered)
+    errors: List[BaseException] = []
+
+    def shard_out(number: int, job: Job) -> Path:
+        path = shard_dir / f"{job.exec_name}.{number:04d}.json"
+        with lock:
+            outputs.setdefault(job.exec_name, []).append(path)
+        return path
+
+    def worker(cpu: int) -> None:
+        pin_thread([cpu])
+        while not errors:
+            try:
+                number, job = pending.get_nowait()
+            except queue.Empty:
+                return
+            try:
+                run_job(job, [cpu], shard_out(number, job), f"shard_cpus={cpu},shard_llc={llc_note}")
+            except BaseException as error:  # stop the other workers at their next job
+                errors.append(error)
+
+    threads = [threading.Thread(target=worker, args=(cpu,)) for cpu in cores]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    if errors:
+        raise errors[0]
+
+    def run_exclusive() -> None:
+        pin_thread(cores)
+        for number, job in exclusive:
+            context = f"shard_cpus={'+'.join(map(str, cores))},shard_llc={llc_note}"
+            try:
+                run_job(job, cores, shard_out(number, job), context)
+            except BaseException as error:
+                errors.append(error)
+                return
+
+    # on a thread of its own, so the main thread keeps its affinity
+    exclusive_thread = threading.Thread(target=run_exclusive)
+    exclusive_thread.start()
+    exclusive_thread.join()
+    if errors:
+        raise errors[0]
+
+    for exec_name, files in outputs.items():
+        merged = merge_shards(exec_name, sorted(files), cores, llc_warnings, warnings)
+        out_file = out_dir / f"{exec_name}_bench.json"
+        out_file.write_text(json.dumps(merged, indent=2), encoding="utf-8")
+        print(f"[bench:shard] Merged {len(files)} shard(s) -> {out_file}")
+
+
 # ---------------------------------------------------------------------------
 # Benchmark loading and comparison
 # ---------------------------------------------------------------------------
@@ -328,11 +598,8 @@ def handle_compare_json(args: argparse.Namespace) -> None:
 # ---------------------------------------------------------------------------
 
 
-def run_benchmarks_for_commit(ref: str, time_key: str) -> Dict[str, float]:
-    """
-    Create or reuse a git worktree for a given ref, run benchmarks there,
-    and return the loaded benchmark results from build/benchmark.
-    """
+def prepare_worktree(ref: str) -> Path:
+    """Create or reuse the git worktree for `ref` under build/benchmark/benchmark_worktrees/."""
     repo_root = ensure_repo_root()
     short = short_ref(ref)
 
@@ -352,16 +619,42 @@ def run_benchmarks_for_commit(ref: str, time_key: str) -> Dict[str, float]:
         print(
             f"[bench:commits] Reusing existing worktree '{worktree_dir}' for ref '{ref}'."
         )
+    return worktree_dir
 
-    run_benchmarks(worktree_dir)
+
+def run_benchmarks_for_commit(
+    ref: str, time_key: str, cores: Optional[List[int]] = None
+) -> Tuple[Dict[str, float], Path]:
+    """
+    Run benchmarks in the worktree of a given ref and return the loaded
+    benchmark results from build/benchmark, plus the worktree directory.
+    """
+    worktree_dir = prepare_worktree(ref)
+    run_benchmarks(worktree_dir, cores)
 
     results_dir = worktree_dir / BUILD_SUBDIR
-    return load_benchmarks_from_dir(results_dir, time_key=time_key)
+    return load_benchmarks_from_dir(results_dir, time_key=time_key), worktree_dir
+
+
+def snapshot_asm(worktree_dir: Path) -> Optional[Path]:
+    """
+    Build the 'asm-snapshot' target in an already configured worktree and
+    return the directory with the listings, or None if the commit has no
+    such target (e.g. it predates it).
+    """
+    build_dir = worktree_dir / BUILD_SUBDIR
+    try:
+        run_cmd(["cmake", "--build", str(build_dir), "--target", ASM_TARGET], cwd=worktree_dir)
+    except subprocess.CalledProcessError:
+        print(f"[bench:asm] No '{ASM_TARGET}' target in '{worktree_dir}', skipping assembly diff.")
+        return None
+    return build_dir / ASM_SUBDIR
 
 
 def handle_compare_commits(args: argparse.Namespace) -> None:
     """
-    Run benchmarks for two commits (via git worktrees) and compare the results.
+    Run benchmarks for two commits (via git worktrees) and compare the results,
+    then diff the assembly listings of the hot functions.
     """
     baseline_ref = args.baseline_commit
     current_ref = args.current_commit
@@ -371,12 +664,21 @@ def handle_compare_commits(args: argparse.Namespace) -> None:
     print(f"[bench:commits] Current  commit: {current_ref}")
     print(f"[bench:commits] Time key:        {time_key}")
 
-    baseline = run_benchmarks_for_commit(baseline_ref, time_key=time_key)
-    current = run_benchmarks_for_commit(current_ref, time_key=time_key)
+    baseline, baseline_tree = run_benchmarks_for_commit(baseline_ref, time_key=time_key, cores=args.cores)
+    current, current_tree = run_benchmarks_for_commit(current_ref, time_key=time_key, cores=args.cores)
 
     comparison = compare_results(baseline, current)
     print_comparison_table(comparison, time_key=time_key)
 
+    if args.no_asm:
+        return
+    baseline_asm = snapshot_asm(baseline_tree)
+    current_asm = snapshot_asm(current_tree)
+    if baseline_asm and current_asm:
+        print(f"Assembly of hot functions ({baseline_ref} -> {current_ref})")
+        print("=" * 80)
+        diff_snapshots(baseline_asm, current_asm)
+
 
 # ---------------------------------------------------------------------------
 # CLI setup
@@ -401,16 +703,25 @@ def parse_args() -> argparse.Namespace:
         help="Subcommand to execute. Use '<command> -h' for detailed help.",
     )
 
+    cores_help = (
+        "Shard the benchmarks across these (ideally isolated) cores instead of running them serially, "
+        "e.g. '2,3,6-7': one pinned benchmark process per core, outputs merged per executable."
+    )
+
     # run
-    subparsers.add_parser(
+    run_parser = subparsers.add_parser(
         "run",
         help="Configure, build, and run benchmarks for the current working tree.",
         description=(
             "Configure (if needed), build, and run benchmarks for the current Git checkout.\n\n"
-            "Uses CMake preset 'benchmark', build directory 'build/benchmark', and target 'run-benchmark'."
+            "Uses CMake preset 'benchmark', build directory 'build/benchmark', and target 'run-benchmark'.\n\n"
+            "With --cores, each benchmark family runs in its own process pinned to one of the cores, "
+            "several at a time; multi-threaded families run alone on all of them. Shard outputs are kept "
+            "under 'build/benchmark/tests/benchmark/shards' and merged into the usual '*_bench.json'."
         ),
         formatter_class=argparse.RawDescriptionHelpFormatter,
     )
+    run_parser.add_argument("--cores", type=parse_cpu_list, help=cores_help)
 
     # compare-json
     compare_json_parser = subparsers.add_parser(
@@ -438,10 +749,11 @@ def parse_args() -> argparse.Namespace:
     compare_json_parser.add_argument(
         "--time-key",
         default="real_time",
-        choices=["real_time", "cpu_time"],
+        choices=["real_time", "cpu_time", "peak_rss"],
         help=(
             "JSON time field to use for comparison. "
             "Use 'real_time' for wall-clock time or 'cpu_time' for CPU time. "
+            "'peak_rss' compares the peak resident memory of each benchmark instead. "
             "Default: 'real_time'."
         ),
     )
@@ -455,7 +767,9 @@ def parse_args() -> argparse.Namespace:
             "For each commit, a git worktree is created (or reused) under "
             "'build/benchmark/benchmark_worktrees/<short-ref>'. "
             "Benchmarks are built and executed there using the 'benchmark' preset. "
-            "JSON outputs are loaded from 'build/benchmark'.\n"
+            "JSON outputs are loaded from 'build/benchmark'.\n\n"
+            "Afterwards the 'asm-snapshot' target is built in both worktrees and the normalized "
+            "assembly of the hot functions is diffed (listings under 'build/benchmark/asm').\n"
         ),
         formatter_class=argparse.RawDescriptionHelpFormatter,
     )
@@ -470,13 +784,20 @@ def parse_args() -> argparse.Namespace:
     compare_commits_parser.add_argument(
         "--time-key",
         default="real_time",
-        choices=["real_time", "cpu_time"],
+        choices=["real_time", "cpu_time", "peak_rss"],
         help=(
             "JSON time field to use for comparison. "
             "Use 'real_time' for wall-clock time or 'cpu_time' for CPU time. "
+            "'peak_rss' compares the peak resident memory of each benchmark instead. "
             "Default: 'real_time'."
         ),
     )
+    compare_commits_parser.add_argument("--cores", type=parse_cpu_list, help=cores_help)
+    compare_commits_parser.add_argument(
+        "--no-asm",
+        action="store_true",
+        help="Skip the assembly snapshot diff of the hot functions.",
+    )
 
     return parser.parse_args()
 
@@ -486,7 +807,7 @@ def main() -> None:
 
     if args.command == "run":
         project_root = ensure_repo_root()
-        run_benchmarks(project_root)
+        run_benchmarks(project_root, args.cores)
     elif args.command == "compare-json":
         handle_compare_json(args)
     elif args.command == "compare-commits":